@@ -103,6 +103,21 @@
 #define CH_CFG_ST_TIMEDELTA                 0
 #endif
 
+/**
+ * @brief   Virtual timers wheel slots.
+ * @details If non-zero then virtual timers are hashed in a timing wheel
+ *          with the specified number of slots instead of being kept in
+ *          the delta list, arming and disarming a timer become constant
+ *          time operations regardless of the number of armed timers.
+ * @note    The value must be zero or a power of two.
+ * @note    The delay of a timer is limited to half of the system time
+ *          numeric range, longer delays are shortened.
+ * @note    The default is zero, the delta list is used.
+ */
+#if !defined(CH_CFG_VT_WHEEL_SLOTS)
+#define CH_CFG_VT_WHEEL_SLOTS               0
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -160,6 +175,19 @@
 #define CH_CFG_OPTIMIZE_SPEED               TRUE
 #endif
 
+/**
+ * @brief   Bitmap-indexed ready list.
+ * @details If enabled then the ready list is indexed by a priority levels
+ *          bitmap, threads insertion in the ready list becomes a constant
+ *          time operation regardless of the number of ready threads.
+ *
+ * @note    Requires about 1kB of RAM for each OS instance.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_READY_BITMAP)
+#define CH_CFG_USE_READY_BITMAP             FALSE
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -180,6 +208,29 @@
 #define CH_CFG_USE_TM                       TRUE
 #endif
 
+/**
+ * @brief   Time Measurement histograms.
+ * @details If enabled then histograms can be attached to time measurement
+ *          objects in order to collect the distribution of measurements.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_TM.
+ */
+#if !defined(CH_CFG_USE_TM_HISTOGRAMS)
+#define CH_CFG_USE_TM_HISTOGRAMS            FALSE
+#endif
+
+/**
+ * @brief   Time Measurement histograms resolution.
+ * @details Each power of two range is split in 2^N linear buckets, the
+ *          relative error of the reported percentiles is below 2^-N.
+ *
+ * @note    The default is @p 3.
+ */
+#if !defined(CH_CFG_TM_HISTOGRAM_SUB_BITS)
+#define CH_CFG_TM_HISTOGRAM_SUB_BITS        3
+#endif
+
 /**
  * @brief   Time Stamps APIs.
  * @details If enabled then the time stamps APIs are included in the kernel.
@@ -200,6 +251,18 @@
 #define CH_CFG_USE_REGISTRY                 TRUE
 #endif
 
+/**
+ * @brief   Size of the threads registry names hash index.
+ * @details If non-zero then @p chRegFindThreadByName() uses an hash index
+ *          instead of scanning the registry.
+ * @note    The value must be zero or a power of two.
+ * @note    The default is zero.
+ * @note    Requires @p CH_CFG_USE_REGISTRY.
+ */
+#if !defined(CH_CFG_REGISTRY_HASH_SIZE)
+#define CH_CFG_REGISTRY_HASH_SIZE           0
+#endif
+
 /**
  * @brief   Threads synchronization APIs.
  * @details If enabled then the @p chThdWait() function is included in
@@ -339,6 +402,19 @@
 #define CH_CFG_USE_DYNAMIC                  TRUE
 #endif
 
+/**
+ * @brief   Thread Pools APIs.
+ * @details If enabled then the thread pools APIs are included in the
+ *          kernel.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_DYNAMIC.
+ * @note    Requires @p CH_CFG_USE_MEMPOOLS.
+ */
+#if !defined(CH_CFG_USE_THREAD_POOLS)
+#define CH_CFG_USE_THREAD_POOLS             TRUE
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -400,6 +476,30 @@
 #define CH_CFG_USE_HEAP                     TRUE
 #endif
 
+/**
+ * @brief   TLSF heap allocator.
+ * @details If enabled then heaps use a Two-Level Segregated Fit allocator
+ *          instead of the first-fit one, allocation and release become
+ *          constant time operations.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP.
+ */
+#if !defined(CH_CFG_USE_HEAP_TLSF)
+#define CH_CFG_USE_HEAP_TLSF                FALSE
+#endif
+
+/**
+ * @brief   Largest TLSF heap block size as log2.
+ * @details Larger heap areas are split in multiple blocks, this value
+ *          determines the size of the free lists table in each heap.
+ *
+ * @note    The default is 20, blocks up to 1MB.
+ */
+#if !defined(CH_CFG_HEAP_TLSF_MAX_LOG2)
+#define CH_CFG_HEAP_TLSF_MAX_LOG2           20
+#endif
+
 /**
  * @brief   Memory Pools Allocator APIs.
  * @details If enabled then the memory pools allocator APIs are included
@@ -433,6 +533,17 @@
 #define CH_CFG_USE_PIPES                    TRUE
 #endif
 
+/**
+ * @brief   Lock-free rings APIs.
+ * @details If enabled then the single producer single consumer rings APIs
+ *          are included in the kernel.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_RINGS)
+#define CH_CFG_USE_RINGS                    TRUE
+#endif
+
 /**
  * @brief   Objects Caches APIs.
  * @details If enabled then the objects caches APIs are included
@@ -466,6 +577,18 @@
 #define CH_CFG_USE_JOBS                     TRUE
 #endif
 
+/**
+ * @brief   Job Pools APIs.
+ * @details If enabled then the work-stealing job pools APIs are included
+ *          in the kernel.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_JOBS.
+ */
+#if !defined(CH_CFG_USE_JOB_POOLS)
+#define CH_CFG_USE_JOB_POOLS                TRUE
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -537,6 +660,16 @@
 #define CH_CFG_FACTORY_PIPES                TRUE
 #endif
 
+/**
+ * @brief   Size of the names hash index of each factory objects list.
+ * @details If non-zero then lookups by name use an hash index instead of
+ *          scanning the objects lists.
+ * @note    The value must be zero or a power of two.
+ */
+#if !defined(CH_CFG_FACTORY_HASH_SIZE) || defined(__DOXYGEN__)
+#define CH_CFG_FACTORY_HASH_SIZE            0
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -550,9 +683,12 @@
  * @brief   Debug option, kernel statistics.
  *
  * @note    The default is @p FALSE.
+ * @note    Enabled in this demo for the shell "stats" command, it must be
+ *          set here because rt.mk selects the kernel sources from this
+ *          file.
  */
 #if !defined(CH_DBG_STATISTICS)
-#define CH_DBG_STATISTICS                   FALSE
+#define CH_DBG_STATISTICS                   TRUE
 #endif
 
 /**
@@ -640,8 +776,8 @@
  *          counts the system ticks occurred while executing the thread.
  *
  * @note    The default is @p FALSE.
- * @note    This debug option is not currently compatible with the
- *          tickless mode.
+ * @note    In tickless mode the time is accounted on context switches
+ *          instead of being sampled on ticks.
  */
 #if !defined(CH_DBG_THREADS_PROFILING)
 #define CH_DBG_THREADS_PROFILING            FALSE
@@ -745,6 +745,27 @@ struct port_context {
  */
 #define port_is_locked(sts) !__port_irq_enabled(sts)
 
+/**
+ * @brief   Count of trailing zeros of a non-zero 32 bits word.
+ *
+ * @param[in] x         the word, it must not be zero
+ * @return              The number of trailing zero bits.
+ */
+#define port_ctz32(x) ((unsigned)__CLZ(__RBIT((uint32_t)(x))))
+
+/**
+ * @brief   Count of leading zeros of a non-zero 32 bits word.
+ *
+ * @param[in] x         the word, it must not be zero
+ * @return              The number of leading zero bits.
+ */
+#define port_clz32(x) ((unsigned)__CLZ((uint32_t)(x)))
+
+/**
+ * @brief   Full memory barrier.
+ */
+#define port_memory_barrier() __DMB()
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -282,6 +282,44 @@ struct port_context {
 #define PORT_FAST_IRQ_HANDLER(id) void id(void)
 #endif
 
+/**
+ * @brief   Count of trailing zeros of a non-zero 32 bits word.
+ *
+ * @param[in] x         the word, it must not be zero
+ * @return              The number of trailing zero bits.
+ */
+#define port_ctz32(x) ((unsigned)__builtin_ctz((unsigned)(x)))
+
+/**
+ * @brief   Count of leading zeros of a non-zero 32 bits word.
+ *
+ * @param[in] x         the word, it must not be zero
+ * @return              The number of leading zero bits.
+ */
+#define port_clz32(x) ((unsigned)__builtin_clz((unsigned)(x)))
+
+/**
+ * @brief   Full memory barrier.
+ */
+#define port_memory_barrier() __sync_synchronize()
+
+/**
+ * @brief   Returns a word representing a critical section status.
+ *
+ * @return              The critical section status.
+ */
+#define port_get_lock_status() port_get_irq_status()
+
+/**
+ * @brief   Determines if in a critical section.
+ *
+ * @param[in] sts       status word returned by @p port_get_lock_status()
+ * @return              The current status.
+ * @retval false        if running outside a critical section.
+ * @retval true         if running within a critical section.
+ */
+#define port_is_locked(sts) !port_irq_enabled(sts)
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -303,6 +341,7 @@ extern "C" {
   /*lint -restore*/
   rtcnt_t port_rt_get_counter_value(void);
   void _sim_check_for_interrupts(void);
+  void _sim_wait_for_interrupts(void);
 #ifdef __cplusplus
 }
 #endif
@@ -432,11 +471,12 @@ static inline void port_enable(void) {
  *          The simplest implementation is an empty function or macro but this
  *          would not take advantage of architecture-specific power saving
  *          modes.
- * @note    Implemented as an inlined @p WFI instruction.
+ * @note    In the simulator the host thread is blocked until the next
+ *          simulated interrupt source becomes ready.
  */
 static inline void port_wait_for_interrupt(void) {
 
-  _sim_check_for_interrupts();
+  _sim_wait_for_interrupts();
 }
 
 #endif /* !defined(_FROM_ASM_) */
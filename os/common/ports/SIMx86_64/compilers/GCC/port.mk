@@ -0,0 +1,13 @@
+# List of the ChibiOS/RT SIMx86_64 port files.
+PORTSRC = ${CHIBIOS}/os/common/ports/SIMx86_64/chcore.c
+
+PORTASM = 
+
+PORTINC = $(CHIBIOS)/os/common/portability/GCC \
+          ${CHIBIOS}/os/common/ports/SIMx86_64/compilers/GCC \
+          ${CHIBIOS}/os/common/ports/SIMx86_64
+
+# Shared variables
+ALLXASMSRC += $(PORTASM)
+ALLCSRC    += $(PORTSRC)
+ALLINC     += $(PORTINC)
@@ -0,0 +1,159 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    crc.h
+ * @brief   CRC engine header file.
+ * @details Table-driven CRC kernels shared by the file systems and the
+ *          storage drivers:
+ *          - CRC16-CCITT, polynomial 0x1021, MSB first.
+ *          - CRC32-IEEE, polynomial 0x04C11DB7, LSB first (reflected).
+ *          .
+ *          Neither function applies an initial or final inversion, the
+ *          initial value is passed by the caller and the returned value
+ *          can be chained over multiple buffers.
+ *
+ * @addtogroup UTILS_CRC
+ * @{
+ */
+
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of bytes processed for each step of the software kernels.
+ * @details Valid values are:
+ *          - 1, classic byte-wise algorithm, 512 bytes CRC16 table and
+ *            1kB CRC32 table.
+ *          - 4, slice-by-4 algorithm, tables are four times larger.
+ *          - 8, slice-by-8 algorithm, tables are eight times larger.
+ *          .
+ */
+#if !defined(CRC_CFG_SLICES) || defined(__DOXYGEN__)
+#define CRC_CFG_SLICES                      8
+#endif
+
+#if defined(__DOXYGEN__)
+/**
+ * @brief   CRC16-CCITT hardware hook.
+ * @details If defined then @p crc16_ccitt() calls the specified function
+ *          instead of the software kernel, the function must have the same
+ *          signature as @p crc16_ccitt_sw() and can call it for buffers the
+ *          hardware unit cannot handle.
+ */
+#define CRC_CFG_CRC16_CCITT_HOOK            crc16_ccitt_hw
+
+/**
+ * @brief   CRC32-IEEE hardware hook.
+ * @details If defined then @p crc32_ieee() calls the specified function
+ *          instead of the software kernel, the function must have the same
+ *          signature as @p crc32_ieee_sw() and can call it for buffers the
+ *          hardware unit cannot handle.
+ */
+#define CRC_CFG_CRC32_IEEE_HOOK             crc32_ieee_hw
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (CRC_CFG_SLICES != 1) && (CRC_CFG_SLICES != 4) && (CRC_CFG_SLICES != 8)
+#error "invalid CRC_CFG_SLICES value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  uint16_t crc16_ccitt_sw(uint16_t crc, const void *data, size_t n);
+  uint32_t crc32_ieee_sw(uint32_t crc, const void *data, size_t n);
+#if defined(CRC_CFG_CRC16_CCITT_HOOK)
+  uint16_t CRC_CFG_CRC16_CCITT_HOOK(uint16_t crc, const void *data, size_t n);
+#endif
+#if defined(CRC_CFG_CRC32_IEEE_HOOK)
+  uint32_t CRC_CFG_CRC32_IEEE_HOOK(uint32_t crc, const void *data, size_t n);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   CRC16-CCITT update.
+ * @details Uses the hardware hook if defined, the software kernel
+ *          otherwise.
+ *
+ * @param[in] crc       initial or previous CRC value
+ * @param[in] data      pointer to the data buffer
+ * @param[in] n         number of bytes in the buffer
+ * @return              The updated CRC value.
+ */
+static inline uint16_t crc16_ccitt(uint16_t crc, const void *data, size_t n) {
+
+#if defined(CRC_CFG_CRC16_CCITT_HOOK)
+  return CRC_CFG_CRC16_CCITT_HOOK(crc, data, n);
+#else
+  return crc16_ccitt_sw(crc, data, n);
+#endif
+}
+
+/**
+ * @brief   CRC32-IEEE update.
+ * @details Uses the hardware hook if defined, the software kernel
+ *          otherwise.
+ *
+ * @param[in] crc       initial or previous CRC value
+ * @param[in] data      pointer to the data buffer
+ * @param[in] n         number of bytes in the buffer
+ * @return              The updated CRC value.
+ */
+static inline uint32_t crc32_ieee(uint32_t crc, const void *data, size_t n) {
+
+#if defined(CRC_CFG_CRC32_IEEE_HOOK)
+  return CRC_CFG_CRC32_IEEE_HOOK(crc, data, n);
+#else
+  return crc32_ieee_sw(crc, data, n);
+#endif
+}
+
+#endif /* CRC_H */
+
+/** @} */
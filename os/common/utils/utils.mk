@@ -11,6 +11,11 @@ ifndef UTILSSRC
     ifneq ($(filter sglob,$(UTILSSELECT)),)
       UTILSSRC += ${CHIBIOS}/os/common/utils/src/sglob.c
     endif
+    ifneq ($(filter crc,$(UTILSSELECT)),)
+      ifeq ($(findstring os/common/utils/src/crc.c,$(ALLCSRC)),)
+        UTILSSRC += ${CHIBIOS}/os/common/utils/src/crc.c
+      endif
+    endif
   endif
   ALLCSRC += $(UTILSSRC)
 endif
@@ -30,7 +30,8 @@ ifneq ($(findstring HAL_USE_CAN TRUE,$(HALCONF)),)
 HALSRC += $(CHIBIOS)/os/hal/src/hal_can.c
 endif
 ifneq ($(findstring HAL_USE_CRY TRUE,$(HALCONF)),)
-HALSRC += $(CHIBIOS)/os/hal/src/hal_crypto.c
+HALSRC += $(CHIBIOS)/os/hal/src/hal_crypto.c \
+          $(CHIBIOS)/os/hal/src/hal_crypto_fallback.c
 endif
 ifneq ($(findstring HAL_USE_DAC TRUE,$(HALCONF)),)
 HALSRC += $(CHIBIOS)/os/hal/src/hal_dac.c
@@ -108,6 +109,7 @@ HALSRC = $(CHIBIOS)/os/hal/src/hal.c \
          $(CHIBIOS)/os/hal/src/hal_adc.c \
          $(CHIBIOS)/os/hal/src/hal_can.c \
          $(CHIBIOS)/os/hal/src/hal_crypto.c \
+         $(CHIBIOS)/os/hal/src/hal_crypto_fallback.c \
          $(CHIBIOS)/os/hal/src/hal_dac.c \
          $(CHIBIOS)/os/hal/src/hal_efl.c \
          $(CHIBIOS)/os/hal/src/hal_gpt.c \
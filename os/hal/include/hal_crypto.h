@@ -31,6 +31,12 @@
 /* Driver constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Maximum HMAC key size accepted by the fall-back.
+ * @note    It is the SHA512 block size, longer keys are rejected.
+ */
+#define CRY_FALLBACK_HMAC_MAX_KEY_SIZE      128U
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -107,6 +113,48 @@ typedef enum {
   cry_algo_hmac                             /**< HMAC variable size.        */
 } cryalgorithm_t;
 
+#if (HAL_CRY_USE_FALLBACK == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a fall-back AES transient key.
+ * @note    It is part of the @p CRYDriver structure when the LLD does not
+ *          support AES.
+ */
+typedef struct {
+  /**
+   * @brief   Encryption round keys.
+   */
+  uint32_t                  ek[60];
+  /**
+   * @brief   Decryption round keys, equivalent inverse cipher.
+   */
+  uint32_t                  dk[60];
+  /**
+   * @brief   Number of rounds, zero if no key has been loaded.
+   */
+  unsigned                  nr;
+} cry_fallback_aes_key_t;
+
+/**
+ * @brief   Type of a fall-back HMAC transient key.
+ * @note    It is part of the @p CRYDriver structure when the LLD does not
+ *          support both HMAC algorithms.
+ */
+typedef struct {
+  /**
+   * @brief   Key loaded.
+   */
+  bool                      loaded;
+  /**
+   * @brief   Key size in bytes.
+   */
+  size_t                    size;
+  /**
+   * @brief   Key data.
+   */
+  uint8_t                   buf[CRY_FALLBACK_HMAC_MAX_KEY_SIZE];
+} cry_fallback_hmac_key_t;
+#endif /* HAL_CRY_USE_FALLBACK == TRUE */
+
 #if HAL_CRY_ENFORCE_FALLBACK == FALSE
 /* Use the defined low level driver.*/
 #include "hal_crypto_lld.h"
@@ -157,6 +205,8 @@ typedef struct {
 struct CRYDriver {
   crystate_t                state;
   const CRYConfig           *config;
+  cry_fallback_aes_key_t    fb_aes_key;
+  cry_fallback_hmac_key_t   fb_hmac_key;
 };
 #endif /* HAL_CRY_ENFORCE_FALLBACK == TRUE */
 
@@ -0,0 +1,317 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_crypto_fallback.h
+ * @brief   Cryptographic Driver software fall-back macros and structures.
+ *
+ * @addtogroup CRYPTO
+ * @{
+ */
+
+#ifndef HAL_CRYPTO_FALLBACK_H
+#define HAL_CRYPTO_FALLBACK_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a software SHA1 state.
+ */
+typedef struct {
+  uint32_t                  h[5];
+  uint64_t                  length;
+  uint8_t                   buf[64];
+} cry_sha1_state_t;
+
+/**
+ * @brief   Type of a software SHA256 state.
+ */
+typedef struct {
+  uint32_t                  h[8];
+  uint64_t                  length;
+  uint8_t                   buf[64];
+} cry_sha256_state_t;
+
+/**
+ * @brief   Type of a software SHA512 state.
+ * @note    Messages are limited to 2^64 bits.
+ */
+typedef struct {
+  uint64_t                  h[8];
+  uint64_t                  length;
+  uint8_t                   buf[128];
+} cry_sha512_state_t;
+
+#if (CRY_LLD_SUPPORTS_SHA1 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a SHA1 context.
+ */
+typedef struct {
+  cry_sha1_state_t          sha;
+} SHA1Context;
+#endif
+
+#if (CRY_LLD_SUPPORTS_SHA256 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a SHA256 context.
+ */
+typedef struct {
+  cry_sha256_state_t        sha;
+} SHA256Context;
+#endif
+
+#if (CRY_LLD_SUPPORTS_SHA512 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a SHA512 context.
+ */
+typedef struct {
+  cry_sha512_state_t        sha;
+} SHA512Context;
+#endif
+
+#if (CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a HMAC_SHA256 context.
+ */
+typedef struct {
+  cry_sha256_state_t        inner;
+  cry_sha256_state_t        outer;
+} HMACSHA256Context;
+#endif
+
+#if (CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a HMAC_SHA512 context.
+ */
+typedef struct {
+  cry_sha512_state_t        inner;
+  cry_sha512_state_t        outer;
+} HMACSHA512Context;
+#endif
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#if (CRY_LLD_SUPPORTS_AES == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_aes_loadkey(CRYDriver *cryp,
+                                      size_t size,
+                                      const uint8_t *keyp);
+  cryerror_t cry_fallback_encrypt_AES(CRYDriver *cryp,
+                                      crykey_t key_id,
+                                      const uint8_t *in,
+                                      uint8_t *out);
+  cryerror_t cry_fallback_decrypt_AES(CRYDriver *cryp,
+                                      crykey_t key_id,
+                                      const uint8_t *in,
+                                      uint8_t *out);
+#endif
+#if (CRY_LLD_SUPPORTS_AES_ECB == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_encrypt_AES_ECB(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out);
+  cryerror_t cry_fallback_decrypt_AES_ECB(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out);
+#endif
+#if (CRY_LLD_SUPPORTS_AES_CBC == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_encrypt_AES_CBC(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+  cryerror_t cry_fallback_decrypt_AES_CBC(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+#endif
+#if (CRY_LLD_SUPPORTS_AES_CFB == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_encrypt_AES_CFB(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+  cryerror_t cry_fallback_decrypt_AES_CFB(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+#endif
+#if (CRY_LLD_SUPPORTS_AES_CTR == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_encrypt_AES_CTR(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+  cryerror_t cry_fallback_decrypt_AES_CTR(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+#endif
+#if (CRY_LLD_SUPPORTS_AES_GCM == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_encrypt_AES_GCM(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t auth_size,
+                                          const uint8_t *auth_in,
+                                          size_t text_size,
+                                          const uint8_t *text_in,
+                                          uint8_t *text_out,
+                                          const uint8_t *iv,
+                                          size_t tag_size,
+                                          uint8_t *tag_out);
+  cryerror_t cry_fallback_decrypt_AES_GCM(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t auth_size,
+                                          const uint8_t *auth_in,
+                                          size_t text_size,
+                                          const uint8_t *text_in,
+                                          uint8_t *text_out,
+                                          const uint8_t *iv,
+                                          size_t tag_size,
+                                          const uint8_t *tag_in);
+#endif
+#if (CRY_LLD_SUPPORTS_DES == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_des_loadkey(CRYDriver *cryp,
+                                      size_t size,
+                                      const uint8_t *keyp);
+  cryerror_t cry_fallback_encrypt_DES(CRYDriver *cryp,
+                                      crykey_t key_id,
+                                      const uint8_t *in,
+                                      uint8_t *out);
+  cryerror_t cry_fallback_decrypt_DES(CRYDriver *cryp,
+                                      crykey_t key_id,
+                                      const uint8_t *in,
+                                      uint8_t *out);
+#endif
+#if (CRY_LLD_SUPPORTS_DES_ECB == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_encrypt_DES_ECB(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out);
+  cryerror_t cry_fallback_decrypt_DES_ECB(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out);
+#endif
+#if (CRY_LLD_SUPPORTS_DES_CBC == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_encrypt_DES_CBC(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+  cryerror_t cry_fallback_decrypt_DES_CBC(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+#endif
+#if (CRY_LLD_SUPPORTS_SHA1 == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_SHA1_init(CRYDriver *cryp, SHA1Context *sha1ctxp);
+  cryerror_t cry_fallback_SHA1_update(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                                      size_t size, const uint8_t *in);
+  cryerror_t cry_fallback_SHA1_final(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                                     uint8_t *out);
+#endif
+#if (CRY_LLD_SUPPORTS_SHA256 == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_SHA256_init(CRYDriver *cryp,
+                                      SHA256Context *sha256ctxp);
+  cryerror_t cry_fallback_SHA256_update(CRYDriver *cryp,
+                                        SHA256Context *sha256ctxp,
+                                        size_t size, const uint8_t *in);
+  cryerror_t cry_fallback_SHA256_final(CRYDriver *cryp,
+                                       SHA256Context *sha256ctxp,
+                                       uint8_t *out);
+#endif
+#if (CRY_LLD_SUPPORTS_SHA512 == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_SHA512_init(CRYDriver *cryp,
+                                      SHA512Context *sha512ctxp);
+  cryerror_t cry_fallback_SHA512_update(CRYDriver *cryp,
+                                        SHA512Context *sha512ctxp,
+                                        size_t size, const uint8_t *in);
+  cryerror_t cry_fallback_SHA512_final(CRYDriver *cryp,
+                                       SHA512Context *sha512ctxp,
+                                       uint8_t *out);
+#endif
+#if ((CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE) &&                             \
+     (CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE)) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_hmac_loadkey(CRYDriver *cryp,
+                                       size_t size,
+                                       const uint8_t *keyp);
+#endif
+#if (CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_HMACSHA256_init(CRYDriver *cryp,
+                                          HMACSHA256Context *hmacsha256ctxp);
+  cryerror_t cry_fallback_HMACSHA256_update(CRYDriver *cryp,
+                                            HMACSHA256Context *hmacsha256ctxp,
+                                            size_t size, const uint8_t *in);
+  cryerror_t cry_fallback_HMACSHA256_final(CRYDriver *cryp,
+                                           HMACSHA256Context *hmacsha256ctxp,
+                                           uint8_t *out);
+#endif
+#if (CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE) || defined(__DOXYGEN__)
+  cryerror_t cry_fallback_HMACSHA512_init(CRYDriver *cryp,
+                                          HMACSHA512Context *hmacsha512ctxp);
+  cryerror_t cry_fallback_HMACSHA512_update(CRYDriver *cryp,
+                                            HMACSHA512Context *hmacsha512ctxp,
+                                            size_t size, const uint8_t *in);
+  cryerror_t cry_fallback_HMACSHA512_final(CRYDriver *cryp,
+                                           HMACSHA512Context *hmacsha512ctxp,
+                                           uint8_t *out);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_CRYPTO_FALLBACK_H */
+
+/** @} */
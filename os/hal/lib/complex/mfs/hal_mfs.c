@@ -38,6 +38,7 @@
 #include "hal.h"
 
 #include "hal_mfs.h"
+#include "crc.h"
 
 /*===========================================================================*/
 /* Driver local definitions.                                                 */
@@ -61,6 +62,19 @@
 #define ALIGNED_SIZEOF(t)                                                   \
   (((sizeof (t) - 1U) | MFS_ALIGN_MASK) + 1U)
 
+/**
+ * @name    Bulk transfers buffer
+ * @{
+ */
+#if (MFS_CFG_SCRATCH_SIZE > 0) || defined(__DOXYGEN__)
+#define MFS_XBUF_SIZE                       MFS_CFG_SCRATCH_SIZE
+#define MFS_XBUF(mfsp)                      ((mfsp)->ncbuf->scratch.data8)
+#else
+#define MFS_XBUF_SIZE                       MFS_CFG_BUFFER_SIZE
+#define MFS_XBUF(mfsp)                      ((mfsp)->ncbuf->data8)
+#endif
+/** @} */
+
 /**
  * @brief   Combines two values (0..3) in one (0..15).
  */
@@ -104,56 +118,10 @@ static void mfs_flash_release(MFSDriver *mfsp) {
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
-static const uint16_t crc16_table[256] = {
-  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
-  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
-  0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
-  0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
-  0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
-  0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
-  0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
-  0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
-  0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
-  0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
-  0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
-  0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
-  0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
-  0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
-  0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
-  0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
-  0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
-  0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
-  0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
-  0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
-  0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
-  0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
-  0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
-  0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
-  0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
-  0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
-  0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
-  0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
-  0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
-  0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
-  0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
-  0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
-};
-
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
-uint16_t crc16(uint16_t crc, const uint8_t *data, size_t n) {
-
-  while (n > 0U) {
-    crc = (crc << 8U) ^ crc16_table[(crc >> 8U) ^ (uint16_t)*data];
-    data++;
-    n--;
-  }
-
-  return crc;
-}
-
 static void mfs_state_reset(MFSDriver *mfsp) {
   unsigned i;
 
@@ -162,6 +130,13 @@ static void mfs_state_reset(MFSDriver *mfsp) {
   mfsp->next_offset     = 0U;
   mfsp->used_space      = 0U;
 
+#if (MFS_CFG_INCREMENTAL_GC == TRUE)
+  mfsp->gc_state       = MFS_GC_IDLE;
+  mfsp->gc_next_record = 0U;
+  mfsp->gc_next_offset = 0U;
+  mfsp->gc_sectors     = 0U;
+#endif
+
 #if (MFS_CFG_TRANSACTION_MAX > 0)
   mfsp->tr_nops = 0U;
   mfsp->tr_next_offset = 0U;
@@ -246,19 +221,33 @@ static mfs_error_t mfs_flash_write(MFSDriver *mfsp,
   mfs_flash_release(mfsp);
 
 #if MFS_CFG_WRITE_VERIFY == TRUE
-  /* Verifying the written data by reading it back and comparing.*/
-  while (n > 0U) {
-    size_t chunk = n <= MFS_CFG_BUFFER_SIZE ? n : MFS_CFG_BUFFER_SIZE;
+  {
+    uint8_t *vbuf = mfsp->ncbuf->data8;
+    size_t vsize = MFS_CFG_BUFFER_SIZE;
+
+#if MFS_CFG_SCRATCH_SIZE > 0
+    /* The scratch buffer is used for verification unless it is the
+       source of the written data.*/
+    if (wp != MFS_XBUF(mfsp)) {
+      vbuf  = MFS_XBUF(mfsp);
+      vsize = MFS_XBUF_SIZE;
+    }
+#endif
 
-    RET_ON_ERROR(mfs_flash_read(mfsp, offset, chunk, mfsp->ncbuf->data8));
+    /* Verifying the written data by reading it back and comparing.*/
+    while (n > 0U) {
+      size_t chunk = n <= vsize ? n : vsize;
 
-    if (memcmp((void *)mfsp->ncbuf->data8, (void *)wp, chunk)) {
-      mfsp->state = MFS_ERROR;
-      return MFS_ERR_FLASH_FAILURE;
+      RET_ON_ERROR(mfs_flash_read(mfsp, offset, chunk, vbuf));
+
+      if (memcmp((void *)vbuf, (void *)wp, chunk)) {
+        mfsp->state = MFS_ERROR;
+        return MFS_ERR_FLASH_FAILURE;
+      }
+      n -= chunk;
+      offset += (flash_offset_t)chunk;
+      wp += chunk;
     }
-    n -= chunk;
-    offset += (flash_offset_t)chunk;
-    wp += chunk;
   }
 #endif
 
@@ -287,14 +276,14 @@ static mfs_error_t mfs_flash_copy(MFSDriver *mfsp,
      small.*/
   while (n > 0U) {
     /* Data size that can be written in a single program page operation.*/
-    size_t chunk = (size_t)(((doffset | (MFS_CFG_BUFFER_SIZE - 1U)) + 1U) -
+    size_t chunk = (size_t)(((doffset | (MFS_XBUF_SIZE - 1U)) + 1U) -
                             doffset);
     if (chunk > n) {
       chunk = n;
     }
 
-    RET_ON_ERROR(mfs_flash_read(mfsp, soffset, chunk, mfsp->ncbuf->data8));
-    RET_ON_ERROR(mfs_flash_write(mfsp, doffset, chunk, mfsp->ncbuf->data8));
+    RET_ON_ERROR(mfs_flash_read(mfsp, soffset, chunk, MFS_XBUF(mfsp)));
+    RET_ON_ERROR(mfs_flash_write(mfsp, doffset, chunk, MFS_XBUF(mfsp)));
 
     /* Next page.*/
     soffset += chunk;
@@ -305,6 +294,44 @@ static mfs_error_t mfs_flash_copy(MFSDriver *mfsp,
   return MFS_NO_ERROR;
 }
 
+/**
+ * @brief   Erases and verifies a sector.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] sector    sector to be erased
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_sector_erase(MFSDriver *mfsp, flash_sector_t sector) {
+  flash_error_t ferr;
+
+  mfs_flash_acquire(mfsp);
+
+  ferr = flashStartEraseSector(mfsp->config->flashp, sector);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    mfs_flash_release(mfsp);
+    return MFS_ERR_FLASH_FAILURE;
+  }
+  ferr = flashWaitErase(mfsp->config->flashp);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    mfs_flash_release(mfsp);
+    return MFS_ERR_FLASH_FAILURE;
+  }
+  ferr = flashVerifyErase(mfsp->config->flashp, sector);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    mfs_flash_release(mfsp);
+    return MFS_ERR_FLASH_FAILURE;
+  }
+
+  mfs_flash_release(mfsp);
+
+  return MFS_NO_ERROR;
+}
+
 /**
  * @brief   Erases and verifies all sectors belonging to a bank.
  *
@@ -327,31 +354,7 @@ static mfs_error_t mfs_bank_erase(MFSDriver *mfsp, mfs_bank_t bank) {
   }
 
   while (sector < end) {
-    flash_error_t ferr;
-
-    mfs_flash_acquire(mfsp);
-
-    ferr = flashStartEraseSector(mfsp->config->flashp, sector);
-    if (ferr != FLASH_NO_ERROR) {
-      mfsp->state = MFS_ERROR;
-      mfs_flash_release(mfsp);
-      return MFS_ERR_FLASH_FAILURE;
-    }
-    ferr = flashWaitErase(mfsp->config->flashp);
-    if (ferr != FLASH_NO_ERROR) {
-      mfsp->state = MFS_ERROR;
-      mfs_flash_release(mfsp);
-      return MFS_ERR_FLASH_FAILURE;
-    }
-    ferr = flashVerifyErase(mfsp->config->flashp, sector);
-    if (ferr != FLASH_NO_ERROR) {
-      mfsp->state = MFS_ERROR;
-      mfs_flash_release(mfsp);
-      return MFS_ERR_FLASH_FAILURE;
-    }
-
-    mfs_flash_release(mfsp);
-
+    RET_ON_ERROR(mfs_sector_erase(mfsp, sector));
     sector++;
   }
 
@@ -403,8 +406,74 @@ static mfs_error_t mfs_bank_verify_erase(MFSDriver *mfsp, mfs_bank_t bank) {
   return MFS_NO_ERROR;
 }
 
+#if (MFS_CFG_PERSISTENT_INDEX == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Writes the records index in a bank.
+ * @note    The records must have been already copied after the index area
+ *          in ascending identifier order.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] bank      the bank identifier
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_bank_write_index(MFSDriver *mfsp, mfs_bank_t bank) {
+  flash_offset_t idx_offset, ent_offset;
+  uint16_t crc, n;
+  unsigned i, j;
+
+  idx_offset = mfs_flash_get_bank_offset(mfsp, bank) +
+               ALIGNED_SIZEOF(mfs_bank_header_t);
+  ent_offset = idx_offset + (flash_offset_t)sizeof (mfs_data_header_t);
+
+  /* Writing the entries in chunks because the buffer is small.*/
+  crc = 0xFFFFU;
+  n   = 0U;
+  i   = 0U;
+  do {
+    j = 0U;
+    while ((i < MFS_CFG_MAX_RECORDS) &&
+           (j < MFS_CFG_BUFFER_SIZE / sizeof (mfs_index_entry_t))) {
+      if (mfsp->descriptors[i].offset != 0U) {
+        mfsp->ncbuf->ientries[j].id        = (uint16_t)(i + 1U);
+        mfsp->ncbuf->ientries[j].reserved1 = (uint16_t)mfsp->config->erased;
+        mfsp->ncbuf->ientries[j].size      = mfsp->descriptors[i].size;
+        j++;
+      }
+      i++;
+    }
+    if (j > 0U) {
+      size_t chunk = (size_t)j * sizeof (mfs_index_entry_t);
+
+      /* CRC calculated before writing, the buffer is reused for
+         verification.*/
+      crc = crc16_ccitt(crc, mfsp->ncbuf->data8, chunk);
+      RET_ON_ERROR(mfs_flash_write(mfsp, ent_offset, chunk,
+                                   mfsp->ncbuf->data8));
+      ent_offset += (flash_offset_t)chunk;
+      n = (uint16_t)(n + j);
+    }
+  } while (i < MFS_CFG_MAX_RECORDS);
+
+  /* Index header, the index is validated by the bank header written
+     afterward.*/
+  mfsp->ncbuf->dhdr.fields.magic1 = (uint32_t)MFS_INDEX_MAGIC_1;
+  mfsp->ncbuf->dhdr.fields.magic2 = (uint32_t)MFS_INDEX_MAGIC_2;
+  mfsp->ncbuf->dhdr.fields.id     = n;
+  mfsp->ncbuf->dhdr.fields.crc    = crc;
+  mfsp->ncbuf->dhdr.fields.size   = (uint32_t)MFS_INDEX_SPACE;
+
+  return mfs_flash_write(mfsp, idx_offset,
+                         sizeof (mfs_data_header_t),
+                         mfsp->ncbuf->data8);
+}
+#endif /* MFS_CFG_PERSISTENT_INDEX == TRUE */
+
 /**
  * @brief   Writes the validation header in a bank.
+ * @note    If the option @p MFS_CFG_PERSISTENT_INDEX is enabled then the
+ *          index of the current records is written before the header.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @param[in] bank      bank to be validated
@@ -425,13 +494,17 @@ static mfs_error_t mfs_bank_write_header(MFSDriver *mfsp,
     sector = mfsp->config->bank1_start;
   }
 
+#if MFS_CFG_PERSISTENT_INDEX == TRUE
+  RET_ON_ERROR(mfs_bank_write_index(mfsp, bank));
+#endif
+
   mfsp->ncbuf->bhdr.fields.magic1    = MFS_BANK_MAGIC_1;
   mfsp->ncbuf->bhdr.fields.magic2    = MFS_BANK_MAGIC_2;
   mfsp->ncbuf->bhdr.fields.counter   = cnt;
   mfsp->ncbuf->bhdr.fields.reserved1 = (uint16_t)mfsp->config->erased;
-  mfsp->ncbuf->bhdr.fields.crc       = crc16(0xFFFFU,
-                                             mfsp->ncbuf->bhdr.hdr8,
-                                             sizeof (mfs_bank_header_t) - sizeof (uint16_t));
+  mfsp->ncbuf->bhdr.fields.crc       = crc16_ccitt(0xFFFFU,
+                                                   mfsp->ncbuf->bhdr.hdr8,
+                                                   sizeof (mfs_bank_header_t) - sizeof (uint16_t));
 
   return mfs_flash_write(mfsp,
                          flashGetSectorOffset(mfsp->config->flashp, sector),
@@ -466,8 +539,8 @@ static mfs_bank_state_t mfs_bank_check_header(MFSDriver *mfsp) {
   }
 
   /* Verifying header CRC.*/
-  crc = crc16(0xFFFFU, mfsp->ncbuf->bhdr.hdr8,
-              sizeof (mfs_bank_header_t) - sizeof (uint16_t));
+  crc = crc16_ccitt(0xFFFFU, mfsp->ncbuf->bhdr.hdr8,
+                    sizeof (mfs_bank_header_t) - sizeof (uint16_t));
   if (crc != mfsp->ncbuf->bhdr.fields.crc) {
     return MFS_BANK_GARBAGE;
   }
@@ -475,9 +548,123 @@ static mfs_bank_state_t mfs_bank_check_header(MFSDriver *mfsp) {
   return MFS_BANK_OK;
 }
 
+/**
+ * @brief   Loads the records index of a bank, if present.
+ * @details The descriptors of the indexed records are initialized from the
+ *          index and the scan start offset is moved after the last indexed
+ *          record.
+ * @note    If the option @p MFS_CFG_PERSISTENT_INDEX is disabled then the
+ *          index area is just skipped and all records are scanned.
+ *
+ * @param[in] mfsp          pointer to the @p MFSDriver object
+ * @param[in] end_offset    end offset of the bank
+ * @param[in,out] offsetp   offset of the first header in the bank, on
+ *                          return the offset where scanning must start
+ * @param[out] wflagp       warning flag on anomalies
+ * @return                  The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_bank_load_index(MFSDriver *mfsp,
+                                       flash_offset_t end_offset,
+                                       flash_offset_t *offsetp,
+                                       bool *wflagp) {
+  mfs_data_header_t ihdr;
+
+  /* The index, if present, is in place of the first record.*/
+  RET_ON_ERROR(mfs_flash_read(mfsp, *offsetp,
+                              sizeof (mfs_data_header_t),
+                              mfsp->ncbuf->data8));
+  if ((mfsp->ncbuf->dhdr.fields.magic1 != MFS_INDEX_MAGIC_1) ||
+      (mfsp->ncbuf->dhdr.fields.magic2 != MFS_INDEX_MAGIC_2)) {
+    return MFS_NO_ERROR;
+  }
+  ihdr = mfsp->ncbuf->dhdr;
+
+  /* Checking the index area boundaries, if not valid then nothing can
+     be trusted after the bank header.*/
+  if ((ihdr.fields.size < ALIGNED_REC_SIZE((size_t)ihdr.fields.id *
+                                           sizeof (mfs_index_entry_t))) ||
+      (ihdr.fields.size > end_offset - *offsetp)) {
+    *offsetp = end_offset;
+    *wflagp  = true;
+    return MFS_NO_ERROR;
+  }
+
+#if MFS_CFG_PERSISTENT_INDEX == TRUE
+  {
+    flash_offset_t ent_offset, rec_offset;
+    uint32_t n;
+    uint16_t crc;
+    unsigned i;
+
+    ent_offset = *offsetp + (flash_offset_t)sizeof (mfs_data_header_t);
+    rec_offset = *offsetp + ihdr.fields.size;
+    crc = 0xFFFFU;
+    n   = ihdr.fields.id;
+    while (n > 0U) {
+      uint32_t chunk = n > MFS_CFG_BUFFER_SIZE / sizeof (mfs_index_entry_t) ?
+                       MFS_CFG_BUFFER_SIZE / sizeof (mfs_index_entry_t) : n;
+
+      /* Reading the entries chunk.*/
+      RET_ON_ERROR(mfs_flash_read(mfsp, ent_offset,
+                                  chunk * sizeof (mfs_index_entry_t),
+                                  mfsp->ncbuf->data8));
+      crc = crc16_ccitt(crc, mfsp->ncbuf->data8,
+                        chunk * sizeof (mfs_index_entry_t));
+
+      /* Records are placed after the index in the same order as the
+         entries.*/
+      for (i = 0U; i < chunk; i++) {
+        mfs_index_entry_t *iep = &mfsp->ncbuf->ientries[i];
+
+        if ((iep->id < 1U) ||
+            (iep->id > (uint32_t)MFS_CFG_MAX_RECORDS) ||
+            (iep->size == 0U) ||
+            (iep->size > (uint32_t)MFS_CFG_MAX_RECORD_SIZE) ||
+            (ALIGNED_REC_SIZE(iep->size) > end_offset - rec_offset)) {
+          break;
+        }
+        mfsp->descriptors[iep->id - 1U].offset = rec_offset;
+        mfsp->descriptors[iep->id - 1U].size   = iep->size;
+        rec_offset += ALIGNED_REC_SIZE(iep->size);
+      }
+      if (i < chunk) {
+        break;
+      }
+
+      /* Next chunk.*/
+      ent_offset += chunk * sizeof (mfs_index_entry_t);
+      n -= chunk;
+    }
+
+    if ((n == 0U) && (crc == ihdr.fields.crc)) {
+      /* Index valid, scanning continues after the indexed records.*/
+      *offsetp = rec_offset;
+      return MFS_NO_ERROR;
+    }
+
+    /* Index corrupted, discarding it and falling back to a full scan,
+       the index is rewritten by the repair procedure.*/
+    for (i = 0U; i < MFS_CFG_MAX_RECORDS; i++) {
+      mfsp->descriptors[i].offset = 0U;
+      mfsp->descriptors[i].size   = 0U;
+    }
+    *wflagp = true;
+  }
+#endif /* MFS_CFG_PERSISTENT_INDEX == TRUE */
+
+  /* Skipping the index area.*/
+  *offsetp += ihdr.fields.size;
+
+  return MFS_NO_ERROR;
+}
+
 /**
  * @brief   Scans blocks searching for records.
- * @note    The block integrity is strongly checked.
+ * @note    The data integrity is checked only if the option
+ *          @p MFS_CFG_STRONG_CHECKING is enabled, else only headers are
+ *          checked and data errors are detected on read.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @param[in] bank      the bank identifier
@@ -500,6 +687,9 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
   hdr_offset   = start_offset + (flash_offset_t)ALIGNED_SIZEOF(mfs_bank_header_t);
   end_offset   = start_offset + mfsp->config->bank_size;
 
+  /* Records covered by the index, if any, are not scanned.*/
+  RET_ON_ERROR(mfs_bank_load_index(mfsp, end_offset, &hdr_offset, wflagp));
+
   /* Scanning records until there is there is not enough space left for an
      header.*/
   while (hdr_offset < end_offset - ALIGNED_DHDR_SIZE) {
@@ -540,6 +730,7 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
     /* Copying the non-cached buffer locally.*/
     dhdr = mfsp->ncbuf->dhdr;
 
+#if MFS_CFG_STRONG_CHECKING == TRUE
     /* Finally checking the CRC, we need to perform it in chunks because
        we have a limited buffer.*/
     crc = 0xFFFFU;
@@ -547,21 +738,25 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
       uint32_t total = dhdr.fields.size;
 
       while (total > 0U) {
-        uint32_t chunk = total > MFS_CFG_BUFFER_SIZE ? MFS_CFG_BUFFER_SIZE :
-                                                       total;
+        uint32_t chunk = total > MFS_XBUF_SIZE ? MFS_XBUF_SIZE : total;
 
         /* Reading the data chunk.*/
         RET_ON_ERROR(mfs_flash_read(mfsp, data_offset, chunk,
-                                    mfsp->ncbuf->data8));
+                                    MFS_XBUF(mfsp)));
 
         /* CRC on the read data chunk.*/
-        crc = crc16(crc, &mfsp->ncbuf->data8[0], chunk);
+        crc = crc16_ccitt(crc, MFS_XBUF(mfsp), chunk);
 
         /* Next chunk.*/
         data_offset += chunk;
         total -= chunk;
       }
     }
+#else
+    /* The data CRC is checked on read, the header has been sealed by
+       the magic numbers so it is trusted here.*/
+    crc = dhdr.fields.crc;
+#endif
     if (crc != dhdr.fields.crc) {
       /* If the CRC is invalid then this record is ignored but scanning
          continues because there could be more valid records afterward.*/
@@ -634,9 +829,137 @@ static mfs_error_t mfs_bank_get_state(MFSDriver *mfsp,
   return MFS_NO_ERROR;
 }
 
+#if (MFS_CFG_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Performs a garbage collection step.
+ * @details A step either copies up to @p MFS_CFG_GC_STEP_RECORDS records
+ *          into the other bank or erases one sector of the old bank. The
+ *          bank swap happens on the step copying the last record.
+ * @note    The old bank is erased starting from its last sector, its header
+ *          is erased last so an interrupted erase is handled on mount as
+ *          two valid banks with different counters.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_step(MFSDriver *mfsp) {
+  mfs_bank_t sbank, dbank;
+
+  sbank = mfsp->current_bank;
+  if (sbank == MFS_BANK_0) {
+    dbank = MFS_BANK_1;
+  }
+  else {
+    dbank = MFS_BANK_0;
+  }
+
+  if (mfsp->gc_state == MFS_GC_ERASE) {
+    flash_sector_t sector;
+
+    /* Erasing the next sector of the old bank, now the "other" one.*/
+    if (dbank == MFS_BANK_0) {
+      sector = mfsp->config->bank0_start;
+    }
+    else {
+      sector = mfsp->config->bank1_start;
+    }
+    mfsp->gc_sectors--;
+    RET_ON_ERROR(mfs_sector_erase(mfsp, sector + mfsp->gc_sectors));
+    if (mfsp->gc_sectors == 0U) {
+      mfsp->gc_state = MFS_GC_IDLE;
+    }
+
+    return MFS_NO_ERROR;
+  }
+
+  if (mfsp->gc_state == MFS_GC_IDLE) {
+    /* Starting a new cycle, the other bank is erased, the records index
+       area is skipped.*/
+    mfsp->gc_state       = MFS_GC_COPY;
+    mfsp->gc_next_record = 0U;
+    mfsp->gc_next_offset = mfs_flash_get_bank_offset(mfsp, dbank) +
+                           ALIGNED_SIZEOF(mfs_bank_header_t) + MFS_INDEX_SPACE;
+  }
+
+  /* Copying the most recent record instances only.*/
+  {
+    unsigned n = 0U;
+
+    while ((mfsp->gc_next_record < MFS_CFG_MAX_RECORDS) &&
+           (n < MFS_CFG_GC_STEP_RECORDS)) {
+      mfs_record_descriptor_t *dp = &mfsp->descriptors[mfsp->gc_next_record];
+
+      if (dp->offset != 0U) {
+        uint32_t totsize = ALIGNED_REC_SIZE(dp->size);
+
+        RET_ON_ERROR(mfs_flash_copy(mfsp, mfsp->gc_next_offset,
+                                    dp->offset, totsize));
+        dp->offset = mfsp->gc_next_offset;
+        mfsp->gc_next_offset += totsize;
+        n++;
+      }
+      mfsp->gc_next_record++;
+    }
+  }
+
+  if (mfsp->gc_next_record >= MFS_CFG_MAX_RECORDS) {
+    /* New current bank.*/
+    mfsp->current_bank = dbank;
+    mfsp->current_counter += 1U;
+    mfsp->next_offset = mfsp->gc_next_offset;
+
+    /* The header is written after the data.*/
+    RET_ON_ERROR(mfs_bank_write_header(mfsp, dbank, mfsp->current_counter));
+
+    /* The old bank is erased by the next steps.*/
+    mfsp->gc_state = MFS_GC_ERASE;
+    if (sbank == MFS_BANK_0) {
+      mfsp->gc_sectors = mfsp->config->bank0_sectors;
+    }
+    else {
+      mfsp->gc_sectors = mfsp->config->bank1_sectors;
+    }
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Checks if a record can be modified in the current bank.
+ * @details If a garbage collection is copying records and the specified
+ *          record has already been copied then the copy is completed
+ *          before the record is modified.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] id        record numeric identifier
+ * @param[out] wflagp   set if a garbage collection has been completed
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_sync_record(MFSDriver *mfsp, mfs_id_t id,
+                                      bool *wflagp) {
+
+  if ((mfsp->gc_state == MFS_GC_COPY) &&
+      ((uint32_t)id - 1U < mfsp->gc_next_record)) {
+    *wflagp = true;
+    while (mfsp->gc_state == MFS_GC_COPY) {
+      RET_ON_ERROR(mfs_gc_step(mfsp));
+    }
+  }
+
+  return MFS_NO_ERROR;
+}
+#endif /* MFS_CFG_INCREMENTAL_GC == TRUE */
+
 /**
  * @brief   Enforces a garbage collection.
  * @details Storage data is compacted into a single bank.
+ * @note    If the option @p MFS_CFG_INCREMENTAL_GC is enabled then a cycle
+ *          in progress is completed, else a new cycle is performed, the
+ *          old bank erase is left to the following steps in both cases.
  *
  * @param[out] mfsp     pointer to the @p MFSDriver object
  * @return              The operation status.
@@ -644,6 +967,21 @@ static mfs_error_t mfs_bank_get_state(MFSDriver *mfsp,
  * @notapi
  */
 static mfs_error_t mfs_garbage_collect(MFSDriver *mfsp) {
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+
+  /* The other bank must be erased before starting a new cycle.*/
+  while (mfsp->gc_state == MFS_GC_ERASE) {
+    RET_ON_ERROR(mfs_gc_step(mfsp));
+  }
+
+  /* Copying all records, note that the first step starts the cycle if
+     there is not one in progress.*/
+  do {
+    RET_ON_ERROR(mfs_gc_step(mfsp));
+  } while (mfsp->gc_state == MFS_GC_COPY);
+
+  return MFS_NO_ERROR;
+#else
   unsigned i;
   mfs_bank_t sbank, dbank;
   flash_offset_t dest_offset;
@@ -656,9 +994,9 @@ static mfs_error_t mfs_garbage_collect(MFSDriver *mfsp) {
     dbank = MFS_BANK_0;
   }
 
-  /* Write address.*/
+  /* Write address, the records index area is skipped.*/
   dest_offset = mfs_flash_get_bank_offset(mfsp, dbank) +
-                ALIGNED_SIZEOF(mfs_bank_header_t);
+                ALIGNED_SIZEOF(mfs_bank_header_t) + MFS_INDEX_SPACE;
 
   /* Copying the most recent record instances only.*/
   for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
@@ -684,6 +1022,7 @@ static mfs_error_t mfs_garbage_collect(MFSDriver *mfsp) {
   RET_ON_ERROR(mfs_bank_erase(mfsp, sbank));
 
   return MFS_NO_ERROR;
+#endif
 }
 
 /**
@@ -718,6 +1057,22 @@ static mfs_error_t mfs_try_mount(MFSDriver *mfsp) {
     break;
 
   case PAIR(MFS_BANK_OK, MFS_BANK_OK):
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+    /* Both banks appear to be valid but one must be newer, this is the
+       normal state after a garbage collection, the older bank erase is
+       left to the garbage collection steps.*/
+    mfsp->gc_state = MFS_GC_ERASE;
+    if (cnt0 > cnt1) {
+      /* Bank 0 is newer.*/
+      mfsp->gc_sectors = mfsp->config->bank1_sectors;
+      bank = MFS_BANK_0;
+    }
+    else {
+      /* Bank 1 is newer.*/
+      mfsp->gc_sectors = mfsp->config->bank0_sectors;
+      bank = MFS_BANK_1;
+    }
+#else
     /* Both banks appear to be valid but one must be newer, erasing the
        older one.*/
     if (cnt0 > cnt1) {
@@ -731,6 +1086,7 @@ static mfs_error_t mfs_try_mount(MFSDriver *mfsp) {
       bank = MFS_BANK_1;
     }
     w1 = true;
+#endif
     break;
 
   case PAIR(MFS_BANK_GARBAGE, MFS_BANK_GARBAGE):
@@ -808,7 +1164,7 @@ static mfs_error_t mfs_try_mount(MFSDriver *mfsp) {
     RET_ON_ERROR(mfs_bank_scan_records(mfsp, bank, &w2));
 
     /* Calculating the effective used size.*/
-    mfsp->used_space = ALIGNED_SIZEOF(mfs_bank_header_t);
+    mfsp->used_space = ALIGNED_SIZEOF(mfs_bank_header_t) + MFS_INDEX_SPACE;
     for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
       if (mfsp->descriptors[i].offset != 0U) {
         mfsp->used_space += ALIGNED_REC_SIZE(mfsp->descriptors[i].size);
@@ -1018,6 +1374,16 @@ mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
                               sizeof (mfs_data_header_t),
                               mfsp->ncbuf->data8));
 
+  /* Checking the header against the descriptor, records data is not
+     necessarily verified on mount.*/
+  if ((mfsp->ncbuf->dhdr.fields.magic1 != MFS_HEADER_MAGIC_1) ||
+      (mfsp->ncbuf->dhdr.fields.magic2 != MFS_HEADER_MAGIC_2) ||
+      (mfsp->ncbuf->dhdr.fields.id != (uint16_t)id) ||
+      (mfsp->ncbuf->dhdr.fields.size != mfsp->descriptors[id - 1U].size)) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+
   /* Data read from flash.*/
   *np = mfsp->descriptors[id - 1U].size;
   RET_ON_ERROR(mfs_flash_read(mfsp,
@@ -1026,7 +1392,7 @@ mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
                               buffer));
 
   /* Checking CRC.*/
-  crc = crc16(0xFFFFU, buffer, *np);
+  crc = crc16_ccitt(0xFFFFU, buffer, *np);
   if (crc != mfsp->ncbuf->dhdr.fields.crc) {
     mfsp->state = MFS_ERROR;
     return MFS_ERR_FLASH_FAILURE;
@@ -1088,6 +1454,12 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
       return MFS_ERR_OUT_OF_MEM;
     }
 
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+    /* The record could have already been copied by a garbage collection
+       in progress.*/
+    RET_ON_ERROR(mfs_gc_sync_record(mfsp, id, &warning));
+#endif
+
     /* Checking for immediately (not compacted) available space.*/
     free = (mfs_flash_get_bank_offset(mfsp, mfsp->current_bank) +
             mfsp->config->bank_size) - mfsp->next_offset;
@@ -1101,7 +1473,7 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
     /* Writing the data header without the magic, it will be written last.*/
     mfsp->ncbuf->dhdr.fields.id     = (uint16_t)id;
     mfsp->ncbuf->dhdr.fields.size   = (uint32_t)n;
-    mfsp->ncbuf->dhdr.fields.crc    = crc16(0xFFFFU, buffer, n);
+    mfsp->ncbuf->dhdr.fields.crc    = crc16_ccitt(0xFFFFU, buffer, n);
     RET_ON_ERROR(mfs_flash_write(mfsp,
                                  mfsp->next_offset + (sizeof (uint32_t) * 2U),
                                  sizeof (mfs_data_header_t) - (sizeof (uint32_t) * 2U),
@@ -1159,7 +1531,7 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
     /* Writing the data header without the magic, it will be written last.*/
     mfsp->ncbuf->dhdr.fields.id     = (uint16_t)id;
     mfsp->ncbuf->dhdr.fields.size   = (uint32_t)n;
-    mfsp->ncbuf->dhdr.fields.crc    = crc16(0xFFFFU, buffer, n);
+    mfsp->ncbuf->dhdr.fields.crc    = crc16_ccitt(0xFFFFU, buffer, n);
     RET_ON_ERROR(mfs_flash_write(mfsp,
                                  mfsp->tr_next_offset + (sizeof (uint32_t) * 2U),
                                  sizeof (mfs_data_header_t) - (sizeof (uint32_t) * 2U),
@@ -1240,6 +1612,12 @@ mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
       return MFS_ERR_INTERNAL;
     }
 
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+    /* The record could have already been copied by a garbage collection
+       in progress.*/
+    RET_ON_ERROR(mfs_gc_sync_record(mfsp, id, &warning));
+#endif
+
     /* Checking for immediately (not compacted) available space.*/
     free = (mfs_flash_get_bank_offset(mfsp, mfsp->current_bank) +
             mfsp->config->bank_size) - mfsp->next_offset;
@@ -1349,9 +1727,72 @@ mfs_error_t mfsPerformGarbageCollection(MFSDriver *mfsp) {
     return MFS_ERR_INV_STATE;
   }
 
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  /* The collection is fully performed, including the old bank erase.*/
+  RET_ON_ERROR(mfs_garbage_collect(mfsp));
+  while (mfsp->gc_state != MFS_GC_IDLE) {
+    RET_ON_ERROR(mfs_gc_step(mfsp));
+  }
+
+  return MFS_NO_ERROR;
+#else
   return mfs_garbage_collect(mfsp);
+#endif
 }
 
+#if (MFS_CFG_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Performs a garbage collection step.
+ * @details A step copies up to @p MFS_CFG_GC_STEP_RECORDS records into the
+ *          other bank or erases one sector of the old bank. If there is no
+ *          collection in progress then a new one is started when the space
+ *          occupied by obsolete records exceeds the free space.
+ * @note    This function is meant to be called periodically by a low
+ *          priority thread, write and erase operations then never wait
+ *          for a bank erase.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ * @retval MFS_NO_ERROR             if there is no garbage collection in
+ *                                  progress after the step.
+ * @retval MFS_WARN_GC              if a garbage collection is in progress
+ *                                  and more steps are required.
+ * @retval MFS_ERR_INV_STATE        if the driver is in not in @p MFS_READY
+ *                                  state.
+ * @retval MFS_ERR_FLASH_FAILURE    if the flash memory is unusable because HW
+ *                                  failures. Makes the driver enter the
+ *                                  @p MFS_ERROR state.
+ * @retval MFS_ERR_INTERNAL         if an internal logic failure is detected.
+ *
+ * @api
+ */
+mfs_error_t mfsPerformGarbageCollectionStep(MFSDriver *mfsp) {
+
+  osalDbgCheck(mfsp != NULL);
+
+  if (mfsp->state != MFS_READY) {
+    return MFS_ERR_INV_STATE;
+  }
+
+  if (mfsp->gc_state == MFS_GC_IDLE) {
+    flash_offset_t bank_offset, written, free;
+
+    /* Starting a new collection only if it is worth it.*/
+    bank_offset = mfs_flash_get_bank_offset(mfsp, mfsp->current_bank);
+    written     = mfsp->next_offset - bank_offset;
+    free        = mfsp->config->bank_size - written;
+    if ((written <= mfsp->used_space) ||
+        (written - mfsp->used_space <= free)) {
+      return MFS_NO_ERROR;
+    }
+  }
+
+  RET_ON_ERROR(mfs_gc_step(mfsp));
+
+  return mfsp->gc_state == MFS_GC_IDLE ? MFS_NO_ERROR : MFS_WARN_GC;
+}
+#endif /* MFS_CFG_INCREMENTAL_GC == TRUE */
+
 #if (MFS_CFG_TRANSACTION_MAX > 0) || defined(__DOXYGEN__)
 /**
  * @brief   Puts the driver in transaction mode.
@@ -1402,6 +1843,14 @@ mfs_error_t mfsStartTransaction(MFSDriver *mfsp, size_t size) {
     return MFS_ERR_OUT_OF_MEM;
   }
 
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  /* Any record could be written in the transaction, a garbage collection
+     copying records is completed first.*/
+  while (mfsp->gc_state == MFS_GC_COPY) {
+    RET_ON_ERROR(mfs_gc_step(mfsp));
+  }
+#endif
+
   /* Checking for immediately (not compacted) available space.*/
   free = (mfs_flash_get_bank_offset(mfsp, mfsp->current_bank) +
           mfsp->config->bank_size) - mfsp->next_offset;
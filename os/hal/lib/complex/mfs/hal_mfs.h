@@ -41,6 +41,8 @@
 #define MFS_BANK_MAGIC_2                    0xF0339CC5U
 #define MFS_HEADER_MAGIC_1                  0x5FAE45F0U
 #define MFS_HEADER_MAGIC_2                  0xF045AE5FU
+#define MFS_INDEX_MAGIC_1                   0x1D7E5A0CU
+#define MFS_INDEX_MAGIC_2                   0xC0A5E71DU
 
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
@@ -89,6 +91,43 @@
 #define MFS_CFG_STRONG_CHECKING             TRUE
 #endif
 
+/**
+ * @brief   Enables the persisted records index.
+ * @details When enabled, each garbage collection writes an index of the
+ *          compacted records in a reserved area after the bank header. On
+ *          mount the descriptors are loaded from the index and only the
+ *          records appended after the last garbage collection are scanned,
+ *          data integrity of indexed records is verified on read.
+ * @note    The reserved area takes @p MFS_CFG_MAX_RECORDS * 8 + 16 bytes
+ *          of each bank.
+ * @note    Partitions written with this option enabled cannot be mounted
+ *          by older driver versions, newer versions skip the index if the
+ *          option is disabled.
+ */
+#if !defined(MFS_CFG_PERSISTENT_INDEX) || defined(__DOXYGEN__)
+#define MFS_CFG_PERSISTENT_INDEX            FALSE
+#endif
+
+/**
+ * @brief   Enables the incremental garbage collection.
+ * @details When enabled, garbage collection is performed as a sequence of
+ *          bounded steps by @p mfsPerformGarbageCollectionStep(), each step
+ *          copies up to @p MFS_CFG_GC_STEP_RECORDS records or erases a
+ *          single sector of the old bank. Garbage collections triggered by
+ *          write and erase operations only perform the copy part, the old
+ *          bank erase is left to the following steps.
+ */
+#if !defined(MFS_CFG_INCREMENTAL_GC) || defined(__DOXYGEN__)
+#define MFS_CFG_INCREMENTAL_GC              FALSE
+#endif
+
+/**
+ * @brief   Maximum number of records copied in a garbage collection step.
+ */
+#if !defined(MFS_CFG_GC_STEP_RECORDS) || defined(__DOXYGEN__)
+#define MFS_CFG_GC_STEP_RECORDS             4
+#endif
+
 /**
  * @brief   Size of the buffer used for data copying.
  * @note    The buffer size must be a power of two and not smaller than
@@ -100,6 +139,19 @@
 #define MFS_CFG_BUFFER_SIZE                 32
 #endif
 
+/**
+ * @brief   Size of the scratch buffer used for bulk data transfers.
+ * @details If non-zero then the non-cacheable buffer is enlarged with a
+ *          scratch area of the specified size, the area is used for
+ *          records copy, write verification and data CRC checks, larger
+ *          transfers mean fewer flash operations.
+ * @note    The buffer size must be a power of two and not smaller than
+ *          @p MFS_CFG_BUFFER_SIZE.
+ */
+#if !defined(MFS_CFG_SCRATCH_SIZE) || defined(__DOXYGEN__)
+#define MFS_CFG_SCRATCH_SIZE                0
+#endif
+
 /**
  * @brief   Enforced memory alignment.
  * @details This value must be a power of two, it enforces a memory alignment
@@ -151,6 +203,12 @@
 #error "MFS_CFG_BUFFER_SIZE is not a power of two"
 #endif
 
+#if (MFS_CFG_SCRATCH_SIZE != 0) &&                                          \
+    ((MFS_CFG_SCRATCH_SIZE < MFS_CFG_BUFFER_SIZE) ||                        \
+     ((MFS_CFG_SCRATCH_SIZE & (MFS_CFG_SCRATCH_SIZE - 1)) != 0))
+#error "invalid MFS_CFG_SCRATCH_SIZE value"
+#endif
+
 #if (MFS_CFG_MEMORY_ALIGNMENT < 1) ||                                       \
     (MFS_CFG_MEMORY_ALIGNMENT > MFS_CFG_BUFFER_SIZE)
 #error "invalid MFS_CFG_MEMORY_ALIGNMENT value"
@@ -165,6 +223,10 @@
 #error "invalid MFS_CFG_TRANSACTION_MAX value"
 #endif
 
+#if MFS_CFG_GC_STEP_RECORDS < 1
+#error "invalid MFS_CFG_GC_STEP_RECORDS value"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -188,6 +250,15 @@ typedef enum {
   MFS_ERROR = 4
 } mfs_state_t;
 
+/**
+ * @brief   Type of a garbage collection state.
+ */
+typedef enum {
+  MFS_GC_IDLE = 0,
+  MFS_GC_COPY = 1,
+  MFS_GC_ERASE = 2
+} mfs_gc_state_t;
+
 /**
  * @brief   Type of an MFS error code.
  * @note    Errors are negative integers, informative warnings are positive
@@ -287,6 +358,33 @@ typedef union {
   uint32_t                  hdr32[4];
 } mfs_data_header_t;
 
+/**
+ * @brief   Type of a records index entry.
+ * @details The index is a sequence of entries placed after an header
+ *          having @p MFS_INDEX_MAGIC_1 and @p MFS_INDEX_MAGIC_2 as magic
+ *          numbers, the number of entries in the @p id field, the entries
+ *          CRC in the @p crc field and the size of the whole index area
+ *          in the @p size field. Indexed records follow the index area
+ *          in the same order as the entries.
+ */
+typedef struct {
+  /**
+   * @brief   Record identifier.
+   */
+  uint16_t                  id;
+  /**
+   * @brief   Reserved field.
+   */
+  uint16_t                  reserved1;
+  /**
+   * @brief   Record data size.
+   */
+  uint32_t                  size;
+} mfs_index_entry_t;
+
+/**
+ * @brief   Type of a record descriptor.
+ */
 typedef struct {
   /**
    * @brief   Offset of the record header.
@@ -360,9 +458,21 @@ typedef struct {
 typedef union mfs_nocache_buffer {
   mfs_data_header_t       dhdr;
   mfs_bank_header_t       bhdr;
+  mfs_index_entry_t       ientries[MFS_CFG_BUFFER_SIZE / sizeof (mfs_index_entry_t)];
   uint8_t                 data8[MFS_CFG_BUFFER_SIZE];
   uint16_t                data16[MFS_CFG_BUFFER_SIZE / sizeof (uint16_t)];
   uint32_t                data32[MFS_CFG_BUFFER_SIZE / sizeof (uint32_t)];
+#if (MFS_CFG_SCRATCH_SIZE > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Scratch area for bulk data transfers.
+   * @note    The area follows the header buffer, the two can be used at
+   *          the same time.
+   */
+  struct {
+    uint8_t               hdr8[MFS_CFG_BUFFER_SIZE];
+    uint8_t               data8[MFS_CFG_SCRATCH_SIZE];
+  } scratch;
+#endif
 } mfs_nocache_buffer_t;
 
 /**
@@ -398,6 +508,24 @@ typedef struct {
    * @note    Zero means that there is not a record with that id.
    */
   mfs_record_descriptor_t   descriptors[MFS_CFG_MAX_RECORDS];
+#if (MFS_CFG_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Garbage collection state.
+   */
+  mfs_gc_state_t            gc_state;
+  /**
+   * @brief   Next record to be copied by the garbage collection.
+   */
+  uint32_t                  gc_next_record;
+  /**
+   * @brief   Next write offset in the destination bank.
+   */
+  flash_offset_t            gc_next_offset;
+  /**
+   * @brief   Sectors of the old bank still to be erased.
+   */
+  flash_sector_t            gc_sectors;
+#endif
 #if (MFS_CFG_TRANSACTION_MAX > 0) || defined(__DOXYGEN__)
   /**
    * @brief   Next write offset for current transaction.
@@ -445,6 +573,17 @@ typedef struct {
                                             MFS_CFG_MEMORY_ALIGNMENT)
 /** @} */
 
+/**
+ * @brief   Space reserved for the records index after the bank header.
+ */
+#if (MFS_CFG_PERSISTENT_INDEX == TRUE) || defined(__DOXYGEN__)
+#define MFS_INDEX_SPACE                                                     \
+  MFS_ALIGN_NEXT(sizeof (mfs_data_header_t) +                               \
+                 (MFS_CFG_MAX_RECORDS * sizeof (mfs_index_entry_t)))
+#else
+#define MFS_INDEX_SPACE     0U
+#endif
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -462,6 +601,9 @@ extern "C" {
                              size_t n, const uint8_t *buffer);
   mfs_error_t mfsEraseRecord(MFSDriver *devp, mfs_id_t id);
   mfs_error_t mfsPerformGarbageCollection(MFSDriver *mfsp);
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  mfs_error_t mfsPerformGarbageCollectionStep(MFSDriver *mfsp);
+#endif
 #if MFS_CFG_TRANSACTION_MAX > 0
   mfs_error_t mfsStartTransaction(MFSDriver *mfsp, size_t size);
   mfs_error_t mfsCommitTransaction(MFSDriver *mfsp);
@@ -1,8 +1,14 @@
 # List of all the MFS subsystem files.
 MFSSRC := $(CHIBIOS)/os/hal/lib/complex/mfs/hal_mfs.c
 
+# CRC engine, it could be already included by other subsystems.
+ifeq ($(findstring os/common/utils/src/crc.c,$(ALLCSRC)),)
+MFSSRC += $(CHIBIOS)/os/common/utils/src/crc.c
+endif
+
 # Required include directories
-MFSINC := $(CHIBIOS)/os/hal/lib/complex/mfs
+MFSINC := $(CHIBIOS)/os/hal/lib/complex/mfs \
+          $(CHIBIOS)/os/common/utils/include
 
 # Shared variables
 ALLCSRC += $(MFSSRC)
@@ -28,50 +28,123 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 #include "chprintf.h"
 #include "memstreams.h"
 
-#define MAX_FILLER 11
+#define MAX_FILLER ((sizeof (long) * 8U + 2U) / 3U)
 #define FLOAT_PRECISION 9
 
-static char *long_to_string_with_divisor(char *p,
-                                         long num,
-                                         unsigned radix,
-                                         long divisor) {
-  int i;
+/* Output context, it hides the staging buffer, if enabled.*/
+typedef struct {
+  BaseSequentialStream  *chp;
+  int                   n;
+#if CHPRINTF_BUFFER_SIZE > 0
+  size_t                cnt;
+  uint8_t               buf[CHPRINTF_BUFFER_SIZE];
+#endif
+} out_context_t;
+
+static const char hex_digits[16] = {
+  '0', '1', '2', '3', '4', '5', '6', '7',
+  '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+static const char digit_pairs[200] = {
+  '0','0', '0','1', '0','2', '0','3', '0','4',
+  '0','5', '0','6', '0','7', '0','8', '0','9',
+  '1','0', '1','1', '1','2', '1','3', '1','4',
+  '1','5', '1','6', '1','7', '1','8', '1','9',
+  '2','0', '2','1', '2','2', '2','3', '2','4',
+  '2','5', '2','6', '2','7', '2','8', '2','9',
+  '3','0', '3','1', '3','2', '3','3', '3','4',
+  '3','5', '3','6', '3','7', '3','8', '3','9',
+  '4','0', '4','1', '4','2', '4','3', '4','4',
+  '4','5', '4','6', '4','7', '4','8', '4','9',
+  '5','0', '5','1', '5','2', '5','3', '5','4',
+  '5','5', '5','6', '5','7', '5','8', '5','9',
+  '6','0', '6','1', '6','2', '6','3', '6','4',
+  '6','5', '6','6', '6','7', '6','8', '6','9',
+  '7','0', '7','1', '7','2', '7','3', '7','4',
+  '7','5', '7','6', '7','7', '7','8', '7','9',
+  '8','0', '8','1', '8','2', '8','3', '8','4',
+  '8','5', '8','6', '8','7', '8','8', '8','9',
+  '9','0', '9','1', '9','2', '9','3', '9','4',
+  '9','5', '9','6', '9','7', '9','8', '9','9'
+};
+
+/*
+ * Unsigned conversion, digits are generated backward then moved in place,
+ * at least "mindigits" digits are generated using zeros as filler.
+ * Decimal conversion uses constant divisors, two digits at time, while
+ * hexadecimal and octal conversions only require shifts.
+ */
+static char *ulong_to_string(char *p,
+                             unsigned long num,
+                             unsigned radix,
+                             unsigned mindigits) {
+  char tmp[MAX_FILLER];
   char *q;
-  long l, ll;
+  size_t n;
+
+  q = tmp + MAX_FILLER;
+  switch (radix) {
+  case 10U:
+    while (num >= 100UL) {
+      unsigned long t = num / 100UL;
+      const char *dp = &digit_pairs[(num - (t * 100UL)) * 2U];
+
+      q -= 2;
+      q[0] = dp[0];
+      q[1] = dp[1];
+      num = t;
+    }
+    if (num >= 10UL) {
+      const char *dp = &digit_pairs[num * 2U];
 
-  l = num;
-  if (divisor == 0) {
-    ll = num;
-  } else {
-    ll = divisor;
+      q -= 2;
+      q[0] = dp[0];
+      q[1] = dp[1];
+    }
+    else {
+      *--q = (char)('0' + (int)num);
+    }
+    break;
+  case 16U:
+    do {
+      *--q = hex_digits[num & 15UL];
+      num >>= 4;
+    } while (num != 0UL);
+    break;
+  case 8U:
+    do {
+      *--q = (char)('0' + (int)(num & 7UL));
+      num >>= 3;
+    } while (num != 0UL);
+    break;
+  default:
+    do {
+      *--q = hex_digits[num % radix];
+      num /= radix;
+    } while (num != 0UL);
+    break;
   }
 
-  q = p + MAX_FILLER;
-  do {
-    i = (int)(l % radix);
-    i += '0';
-    if (i > '9') {
-      i += 'A' - '0' - 10;
-    }
-    *--q = i;
-    l /= radix;
-  } while ((ll /= radix) != 0);
+  while ((q > tmp) && ((size_t)(tmp + MAX_FILLER - q) < mindigits)) {
+    *--q = '0';
+  }
 
-  i = (int)(p + MAX_FILLER - q);
-  do
-    *p++ = *q++;
-  while (--i);
+  n = (size_t)(tmp + MAX_FILLER - q);
+  memcpy(p, q, n);
 
-  return p;
+  return p + n;
 }
 
-static char *ch_ltoa(char *p, long num, unsigned radix) {
+static char *ch_ltoa(char *p, unsigned long num, unsigned radix) {
 
-  return long_to_string_with_divisor(p, num, radix, 0);
+  return ulong_to_string(p, num, radix, 0U);
 }
 
 #if CHPRINTF_USE_FLOAT
@@ -84,48 +157,82 @@ static char *ftoa(char *p, double num, unsigned long precision) {
   if ((precision == 0) || (precision > FLOAT_PRECISION)) {
     precision = FLOAT_PRECISION;
   }
-  precision = chpow10[precision - 1];
 
   l = (long)num;
-  p = long_to_string_with_divisor(p, l, 10, 0);
+  p = ulong_to_string(p, (unsigned long)l, 10U, 0U);
   *p++ = '.';
-  l = (long)((num - l) * precision);
+  l = (long)((num - l) * chpow10[precision - 1]);
 
-  return long_to_string_with_divisor(p, l, 10, precision / 10);
+  return ulong_to_string(p, (unsigned long)l, 10U, (unsigned)precision);
 }
 #endif
 
-/**
- * @brief   System formatted output function.
- * @details This function implements a minimal @p vprintf()-like functionality
- *          with output on a @p BaseSequentialStream.
- *          The general parameters format is: %[-][width|*][.precision|*][l|L]p.
- *          The following parameter types (p) are supported:
- *          - <b>x</b> hexadecimal integer.
- *          - <b>X</b> hexadecimal long.
- *          - <b>o</b> octal integer.
- *          - <b>O</b> octal long.
- *          - <b>d</b> decimal signed integer.
- *          - <b>D</b> decimal signed long.
- *          - <b>u</b> decimal unsigned integer.
- *          - <b>U</b> decimal unsigned long.
- *          - <b>c</b> character.
- *          - <b>s</b> string.
- *          .
- *
- * @param[in] chp       pointer to a @p BaseSequentialStream implementing object
- * @param[in] fmt       formatting string
- * @param[in] ap        list of parameters
- * @return              The number of bytes that would have been
- *                      written to @p chp if no stream error occurs
- *
- * @api
- */
-int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
+#if CHPRINTF_BUFFER_SIZE > 0
+static void out_flush(out_context_t *ocp) {
+
+  if (ocp->cnt > 0U) {
+    (void) streamWrite(ocp->chp, ocp->buf, ocp->cnt);
+    ocp->cnt = 0U;
+  }
+}
+
+static void out_put(out_context_t *ocp, char c) {
+
+  if (ocp->cnt >= (size_t)CHPRINTF_BUFFER_SIZE) {
+    out_flush(ocp);
+  }
+  ocp->buf[ocp->cnt++] = (uint8_t)c;
+  ocp->n++;
+}
+
+static void out_write(out_context_t *ocp, const char *s, size_t n) {
+
+  ocp->n += (int)n;
+
+  /* Large blocks bypass the staging buffer.*/
+  if (n >= (size_t)CHPRINTF_BUFFER_SIZE) {
+    out_flush(ocp);
+    (void) streamWrite(ocp->chp, (const uint8_t *)s, n);
+    return;
+  }
+
+  if (ocp->cnt + n > (size_t)CHPRINTF_BUFFER_SIZE) {
+    out_flush(ocp);
+  }
+  memcpy(&ocp->buf[ocp->cnt], s, n);
+  ocp->cnt += n;
+}
+#else
+#define out_flush(ocp)
+
+static void out_put(out_context_t *ocp, char c) {
+
+  streamPut(ocp->chp, (uint8_t)c);
+  ocp->n++;
+}
+
+static void out_write(out_context_t *ocp, const char *s, size_t n) {
+
+  if (n > 0U) {
+    (void) streamWrite(ocp->chp, (const uint8_t *)s, n);
+    ocp->n += (int)n;
+  }
+}
+#endif
+
+static void out_fill(out_context_t *ocp, char c, int n) {
+
+  while (n > 0) {
+    out_put(ocp, c);
+    n--;
+  }
+}
+
+static void out_format(out_context_t *ocp, const char *fmt, va_list ap) {
   char *p, *s, c, filler;
   int i, precision, width;
-  int n = 0;
   bool is_long, left_align, do_sign;
+  unsigned long ul;
   long l;
 #if CHPRINTF_USE_FLOAT
   float f;
@@ -137,15 +244,20 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
   while (true) {
     c = *fmt++;
     if (c == 0) {
-      return n;
+      return;
     }
-    
+
+    /* Literal text is output in runs.*/
     if (c != '%') {
-      streamPut(chp, (uint8_t)c);
-      n++;
+      const char *start = fmt - 1;
+
+      while ((*fmt != '\0') && (*fmt != '%')) {
+        fmt++;
+      }
+      out_write(ocp, start, (size_t)(fmt - start));
       continue;
     }
-    
+
     p = tmpbuf;
     s = tmpbuf;
 
@@ -169,7 +281,7 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
       fmt++;
       filler = '0';
     }
-    
+
     /* Width modifier.*/
     if ( *fmt == '*') {
       width = va_arg(ap, int);
@@ -181,7 +293,7 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
       while (true) {
         c = *fmt++;
         if (c == 0) {
-          return n;
+          return;
         }
         if (c >= '0' && c <= '9') {
           c -= '0';
@@ -192,13 +304,13 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
         }
       }
     }
-    
+
     /* Precision modifier.*/
     precision = 0;
     if (c == '.') {
       c = *fmt++;
       if (c == 0) {
-        return n;
+        return;
       }
       if (c == '*') {
         precision = va_arg(ap, int);
@@ -210,18 +322,18 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
           precision = precision * 10 + c;
           c = *fmt++;
           if (c == 0) {
-            return n;
+            return;
           }
         }
       }
     }
-    
+
     /* Long modifier.*/
     if (c == 'l' || c == 'L') {
       is_long = true;
       c = *fmt++;
       if (c == 0) {
-        return n;
+        return;
       }
     }
     else {
@@ -257,13 +369,15 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
       }
       if (l < 0) {
         *p++ = '-';
-        l = -l;
+        ul = 0UL - (unsigned long)l;
       }
-      else
+      else {
         if (do_sign) {
           *p++ = '+';
         }
-      p = ch_ltoa(p, l, 10);
+        ul = (unsigned long)l;
+      }
+      p = ch_ltoa(p, ul, 10);
       break;
 #if CHPRINTF_USE_FLOAT
     case 'f':
@@ -295,12 +409,12 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
       c = 8;
 unsigned_common:
       if (is_long) {
-        l = va_arg(ap, unsigned long);
+        ul = va_arg(ap, unsigned long);
       }
       else {
-        l = va_arg(ap, unsigned int);
+        ul = va_arg(ap, unsigned int);
       }
-      p = ch_ltoa(p, l, c);
+      p = ch_ltoa(p, ul, c);
       break;
     default:
       *p++ = c;
@@ -311,32 +425,59 @@ unsigned_common:
       width = 0;
     }
     if (left_align == false) {
-      width = -width;
-    }
-    if (width < 0) {
-      if ((*s == '-' || *s == '+') && filler == '0') {
-        streamPut(chp, (uint8_t)*s++);
-        n++;
+      if ((width > 0) && (*s == '-' || *s == '+') && filler == '0') {
+        out_put(ocp, *s++);
         i--;
       }
-      do {
-        streamPut(chp, (uint8_t)filler);
-        n++;
-      } while (++width != 0);
-    }
-    while (--i >= 0) {
-      streamPut(chp, (uint8_t)*s++);
-      n++;
-    }
-
-    while (width) {
-      streamPut(chp, (uint8_t)filler);
-      n++;
-      width--;
+      out_fill(ocp, filler, width);
+      width = 0;
     }
+    out_write(ocp, s, (size_t)i);
+    out_fill(ocp, filler, width);
   }
 }
 
+/**
+ * @brief   System formatted output function.
+ * @details This function implements a minimal @p vprintf()-like functionality
+ *          with output on a @p BaseSequentialStream.
+ *          The general parameters format is: %[-][width|*][.precision|*][l|L]p.
+ *          The following parameter types (p) are supported:
+ *          - <b>x</b> hexadecimal integer.
+ *          - <b>X</b> hexadecimal long.
+ *          - <b>o</b> octal integer.
+ *          - <b>O</b> octal long.
+ *          - <b>d</b> decimal signed integer.
+ *          - <b>D</b> decimal signed long.
+ *          - <b>u</b> decimal unsigned integer.
+ *          - <b>U</b> decimal unsigned long.
+ *          - <b>c</b> character.
+ *          - <b>s</b> string.
+ *          .
+ *
+ * @param[in] chp       pointer to a @p BaseSequentialStream implementing object
+ * @param[in] fmt       formatting string
+ * @param[in] ap        list of parameters
+ * @return              The number of bytes that would have been
+ *                      written to @p chp if no stream error occurs
+ *
+ * @api
+ */
+int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
+  out_context_t oc;
+
+  oc.chp = chp;
+  oc.n   = 0;
+#if CHPRINTF_BUFFER_SIZE > 0
+  oc.cnt = 0U;
+#endif
+
+  out_format(&oc, fmt, ap);
+  out_flush(&oc);
+
+  return oc.n;
+}
+
 /**
  * @brief   System formatted output function.
  * @details This function implements a minimal @p printf() like functionality
@@ -36,6 +36,30 @@
 #define CHPRINTF_USE_FLOAT          FALSE
 #endif
 
+/**
+ * @brief   Size of the output staging buffer.
+ * @details When zero, literal runs between conversions and converted
+ *          fields are written using @p streamWrite(), padding and sign
+ *          characters using @p streamPut(), a record takes a few stream
+ *          calls.
+ *          When non-zero the output is accumulated in a buffer allocated
+ *          on the caller stack, a record shorter than the buffer takes a
+ *          single @p streamWrite() call.
+ * @note    The buffer adds a copy of the output, it only pays off when
+ *          each stream call has a high fixed cost, for example streams
+ *          taking a lock or starting a transfer on each call, or when
+ *          records must reach the stream in a single write. On streams
+ *          with cheap calls, like buffered serial drivers, it can be
+ *          slower than zero.
+ */
+#if !defined(CHPRINTF_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define CHPRINTF_BUFFER_SIZE        0
+#endif
+
+#if CHPRINTF_BUFFER_SIZE < 0
+#error "invalid CHPRINTF_BUFFER_SIZE value"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
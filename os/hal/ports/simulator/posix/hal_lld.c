@@ -24,10 +24,32 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <sys/time.h>
+#include <limits.h>
+#if defined(__linux__)
+#include <sys/timerfd.h>
+#endif
 
 #include "hal.h"
 
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Timer deadlines are waited using a @p timerfd.
+ * @note    Other hosts use a relative @p poll() timeout.
+ */
+#if defined(__linux__) || defined(__DOXYGEN__)
+#define SIM_USE_TIMERFD                     TRUE
+#else
+#define SIM_USE_TIMERFD                     FALSE
+#endif
+
+/**
+ * @brief   Maximum number of descriptors waited by the idle thread.
+ */
+#define SIM_MAX_POLLFDS                     3
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -36,13 +58,109 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
-static struct timeval nextcnt;
-static struct timeval tick = {0UL, 1000000UL / OSAL_ST_FREQUENCY};
+#if (SIM_USE_TIMERFD == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Timer descriptor used for tick and alarm deadlines.
+ */
+static int timer_fd = -1;
+#endif
 
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Serves all pending simulated interrupt sources.
+ *
+ * @return              The interrupts state.
+ * @retval false        if no interrupt occurred.
+ * @retval true         if at least one interrupt has been served.
+ */
+static bool sim_serve_interrupts(void) {
+  bool int_occurred = false;
+
+#if HAL_USE_SERIAL
+  while (sd_lld_interrupt_pending()) {
+    int_occurred = true;
+  }
+#endif
+
+#if OSAL_ST_MODE != OSAL_ST_MODE_NONE
+  if (st_lld_serve_interrupt(st_lld_get_host_time())) {
+    int_occurred = true;
+  }
+#endif
+
+  return int_occurred;
+}
+
+/**
+ * @brief   Blocks the host thread until an interrupt source becomes ready.
+ * @details The wait ends when the next timer deadline is reached or when
+ *          one of the simulated serial ports has something to do.
+ */
+static void sim_wait_events(void) {
+  struct pollfd fds[SIM_MAX_POLLFDS];
+  nfds_t n = 0;
+  uint64_t deadline;
+  bool timed = false;
+  int timeout = -1;
+
+#if OSAL_ST_MODE != OSAL_ST_MODE_NONE
+  timed = st_lld_get_deadline(&deadline);
+#endif
+
+#if HAL_USE_SERIAL
+  n = sd_lld_get_pollfds(fds);
+#endif
+
+#if SIM_USE_TIMERFD == TRUE
+  if (timed) {
+    struct itimerspec its;
+
+    /* One-shot absolute expiration, re-arming resets the expirations
+       count so the descriptor does not need to be read.*/
+    its.it_interval.tv_sec  = 0;
+    its.it_interval.tv_nsec = 0;
+    its.it_value.tv_sec     = (time_t)(deadline / ST_LLD_NS_PER_SEC);
+    its.it_value.tv_nsec    = (long)(deadline % ST_LLD_NS_PER_SEC);
+    (void) timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &its, NULL);
+    fds[n].fd      = timer_fd;
+    fds[n].events  = POLLIN;
+    fds[n].revents = 0;
+    n++;
+  }
+#else
+  if (timed) {
+    uint64_t now = st_lld_get_host_time();
+
+    if (deadline <= now) {
+      timeout = 0;
+    }
+    else if ((deadline - now) / 1000000ULL >= (uint64_t)INT_MAX) {
+      timeout = INT_MAX;
+    }
+    else {
+      /* Rounded up, waking up early would just cause another wait.*/
+      timeout = (int)((deadline - now + 999999ULL) / 1000000ULL);
+    }
+  }
+#endif
+
+  (void) poll(fds, n, timeout);
+}
+
+/**
+ * @brief   Performs a preemption if required after an interrupt.
+ */
+static void sim_reschedule(void) {
+
+  __dbg_check_lock();
+  if (chSchIsPreemptionRequired())
+    chSchDoPreemption();
+  __dbg_check_unlock();
+}
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -61,43 +179,43 @@ void hal_lld_init(void) {
 #else
   puts("ChibiOS/RT simulator (Linux)\n");
 #endif
-  gettimeofday(&nextcnt, NULL);
-  timeradd(&nextcnt, &tick, &nextcnt);
+
+#if SIM_USE_TIMERFD == TRUE
+  timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (timer_fd == -1) {
+    printf("Unable to create the simulator timer\n");
+    exit(1);
+  }
+#endif
 }
 
 /**
  * @brief   Interrupt simulation.
+ * @details Serves the pending interrupt sources without blocking, this is
+ *          meant to be invoked by threads polling for events.
  */
 void _sim_check_for_interrupts(void) {
-  struct timeval tv;
-  bool int_occurred = false;
 
-#if HAL_USE_SERIAL
-  while (sd_lld_interrupt_pending()) {
-    int_occurred = true;
+  if (sim_serve_interrupts()) {
+    sim_reschedule();
   }
-#endif
-
-  gettimeofday(&tv, NULL);
-  if (timercmp(&tv, &nextcnt, >=)) {
-    int_occurred = true;
-    timeradd(&nextcnt, &tick, &nextcnt);
-
-    CH_IRQ_PROLOGUE();
-
-    chSysLockFromISR();
-    chSysTimerHandlerI();
-    chSysUnlockFromISR();
+}
 
-    CH_IRQ_EPILOGUE();
-  }
+/**
+ * @brief   Waits for a simulated interrupt.
+ * @details Invoked from the idle thread, the host thread is blocked until
+ *          the next timer deadline or serial port activity so that an idle
+ *          simulator does not consume host CPU time.
+ */
+void _sim_wait_for_interrupts(void) {
 
-  if (int_occurred) {
-    __dbg_check_lock();
-    if (chSchIsPreemptionRequired())
-      chSchDoPreemption();
-    __dbg_check_unlock();
+  if (!sim_serve_interrupts()) {
+    sim_wait_events();
+    if (!sim_serve_interrupts()) {
+      return;
+    }
   }
+  sim_reschedule();
 }
 
 /** @} */
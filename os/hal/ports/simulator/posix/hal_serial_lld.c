@@ -226,6 +226,40 @@ static bool outint(SerialDriver *sdp) {
   return false;
 }
 
+static nfds_t getpollfd(SerialDriver *sdp, struct pollfd *pfdp) {
+  short events = 0;
+
+  if (sdp->com_data != -1) {
+    osalSysLock();
+    if (iqGetEmptyI(&sdp->iqueue) > 0U) {
+      events |= POLLIN;
+    }
+    if (!oqIsEmptyI(&sdp->oqueue)) {
+      events |= POLLOUT;
+    }
+    osalSysUnlock();
+
+    /* A connected port with full input queue and nothing to transmit is
+       not waited, hang-ups are detected when there is space again.*/
+    if (events == 0) {
+      return 0;
+    }
+    pfdp->fd = sdp->com_data;
+  }
+  else if (sdp->com_listen != -1) {
+    events = POLLIN;
+    pfdp->fd = sdp->com_listen;
+  }
+  else {
+    return 0;
+  }
+
+  pfdp->events  = events;
+  pfdp->revents = 0;
+
+  return 1;
+}
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -308,6 +342,28 @@ bool sd_lld_interrupt_pending(void) {
   return b;
 }
 
+/**
+ * @brief   Returns the descriptors to be waited for serial activity.
+ * @note    Must be invoked from thread context with the kernel unlocked.
+ *
+ * @param[out] pfdp     array of @p pollfd structures, it must be large
+ *                      enough for one descriptor per enabled port
+ * @return              The number of filled descriptors.
+ */
+nfds_t sd_lld_get_pollfds(struct pollfd *pfdp) {
+  nfds_t n = 0;
+
+#if USE_SIM_SERIAL1
+  n += getpollfd(&SD1, &pfdp[n]);
+#endif
+
+#if USE_SIM_SERIAL2
+  n += getpollfd(&SD2, &pfdp[n]);
+#endif
+
+  return n;
+}
+
 #endif /* HAL_USE_SERIAL */
 
 /** @} */
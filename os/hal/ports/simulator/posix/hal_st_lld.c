@@ -0,0 +1,317 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/posix/hal_st_lld.c
+ * @brief   Posix simulator ST subsystem low level driver source.
+ *
+ * @addtogroup ST
+ * @{
+ */
+
+#include <time.h>
+
+#include "hal.h"
+
+#if (OSAL_ST_MODE != OSAL_ST_MODE_NONE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Host time of the simulated counter zero.
+ */
+static uint64_t st_base;
+
+#if (OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC) || defined(__DOXYGEN__)
+/**
+ * @brief   Number of ticks served since initialization.
+ */
+static uint64_t st_ticks;
+#endif
+
+#if (OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING) || defined(__DOXYGEN__)
+/**
+ * @brief   Counter value at the previous interrupt check.
+ */
+static systime_t st_last;
+
+/**
+ * @brief   Alarm compare value.
+ */
+static systime_t st_alarm;
+
+/**
+ * @brief   Alarm enable flag.
+ */
+static bool st_alarm_active;
+#endif
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+#if (OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING) || defined(__DOXYGEN__)
+/**
+ * @brief   Converts an host time in a number of ticks since initialization.
+ *
+ * @param[in] now       host time in nanoseconds
+ * @return              The number of elapsed ticks.
+ */
+static uint64_t st_ns2ticks(uint64_t now) {
+  uint64_t ns = now - st_base;
+
+  return ((ns / ST_LLD_NS_PER_SEC) * (uint64_t)OSAL_ST_FREQUENCY) +
+         (((ns % ST_LLD_NS_PER_SEC) * (uint64_t)OSAL_ST_FREQUENCY) /
+          ST_LLD_NS_PER_SEC);
+}
+#endif
+
+/**
+ * @brief   Converts a number of ticks since initialization in an host time.
+ * @note    The result is rounded up so that the returned time is never
+ *          before the tick boundary.
+ *
+ * @param[in] ticks     number of ticks since initialization
+ * @return              The host time in nanoseconds.
+ */
+static uint64_t st_ticks2ns(uint64_t ticks) {
+
+  return st_base +
+         ((ticks / (uint64_t)OSAL_ST_FREQUENCY) * ST_LLD_NS_PER_SEC) +
+         ((((ticks % (uint64_t)OSAL_ST_FREQUENCY) * ST_LLD_NS_PER_SEC) +
+           (uint64_t)OSAL_ST_FREQUENCY - 1ULL) / (uint64_t)OSAL_ST_FREQUENCY);
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level ST driver initialization.
+ *
+ * @notapi
+ */
+void st_lld_init(void) {
+
+  st_base = st_lld_get_host_time();
+#if OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC
+  st_ticks = 0ULL;
+#else
+  st_last         = (systime_t)0;
+  st_alarm        = (systime_t)0;
+  st_alarm_active = false;
+#endif
+}
+
+/**
+ * @brief   Returns the host monotonic time.
+ *
+ * @return              The host time in nanoseconds.
+ *
+ * @notapi
+ */
+uint64_t st_lld_get_host_time(void) {
+  struct timespec ts;
+
+  (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ((uint64_t)ts.tv_sec * ST_LLD_NS_PER_SEC) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief   Returns the host time of the next timer interrupt.
+ *
+ * @param[out] nsp      pointer to the host time in nanoseconds
+ * @return              The deadline state.
+ * @retval false        if no timer interrupt is expected.
+ * @retval true         if a timer interrupt is expected at @p *nsp.
+ *
+ * @notapi
+ */
+bool st_lld_get_deadline(uint64_t *nsp) {
+
+#if OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC
+  *nsp = st_ticks2ns(st_ticks + 1ULL);
+
+  return true;
+#else
+  uint64_t ticks;
+  systime_t cnt;
+
+  if (!st_alarm_active) {
+    return false;
+  }
+
+  /* An alarm already passed but not yet served is reported as an immediate
+     deadline.*/
+  ticks = st_ns2ticks(st_lld_get_host_time());
+  cnt   = (systime_t)ticks;
+  if (((systime_t)(st_alarm - st_last) != (systime_t)0) &&
+      ((systime_t)(st_alarm - st_last) <= (systime_t)(cnt - st_last))) {
+    *nsp = st_ticks2ns(ticks);
+  }
+  else {
+    *nsp = st_ticks2ns(ticks + (uint64_t)(systime_t)(st_alarm - cnt));
+  }
+
+  return true;
+#endif
+}
+
+/**
+ * @brief   Simulated ST interrupt.
+ * @details Invokes the system timer handler if the tick period elapsed or,
+ *          in free running mode, if the counter went past the alarm value
+ *          since the previous check.
+ *
+ * @param[in] now       current host time in nanoseconds
+ * @return              The interrupt state.
+ * @retval false        if the interrupt was not triggered.
+ * @retval true         if the interrupt has been served.
+ *
+ * @notapi
+ */
+bool st_lld_serve_interrupt(uint64_t now) {
+
+#if OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC
+  /* Late ticks are recovered one per check, same as an hardware timer with
+     a pending interrupt.*/
+  if (now < st_ticks2ns(st_ticks + 1ULL)) {
+    return false;
+  }
+  st_ticks++;
+#else
+  systime_t cnt = (systime_t)st_ns2ticks(now);
+  systime_t last = st_last;
+
+  st_last = cnt;
+  if (!st_alarm_active ||
+      ((systime_t)(st_alarm - last) == (systime_t)0) ||
+      ((systime_t)(st_alarm - last) > (systime_t)(cnt - last))) {
+    return false;
+  }
+#endif
+
+  OSAL_IRQ_PROLOGUE();
+
+  osalSysLockFromISR();
+  osalOsTimerHandlerI();
+  osalSysUnlockFromISR();
+
+  OSAL_IRQ_EPILOGUE();
+
+  return true;
+}
+
+#if (OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the time counter value.
+ *
+ * @return              The counter value.
+ *
+ * @notapi
+ */
+systime_t st_lld_get_counter(void) {
+
+  return (systime_t)st_ns2ticks(st_lld_get_host_time());
+}
+
+/**
+ * @brief   Starts the alarm.
+ * @note    Makes sure that no spurious alarms are triggered after
+ *          this call.
+ *
+ * @param[in] time      the time to be set for the first alarm
+ *
+ * @notapi
+ */
+void st_lld_start_alarm(systime_t time) {
+
+  st_last         = st_lld_get_counter();
+  st_alarm        = time;
+  st_alarm_active = true;
+}
+
+/**
+ * @brief   Stops the alarm interrupt.
+ *
+ * @notapi
+ */
+void st_lld_stop_alarm(void) {
+
+  st_alarm_active = false;
+}
+
+/**
+ * @brief   Sets the alarm time.
+ *
+ * @param[in] time      the time to be set for the next alarm
+ *
+ * @notapi
+ */
+void st_lld_set_alarm(systime_t time) {
+
+  st_alarm = time;
+}
+
+/**
+ * @brief   Returns the current alarm time.
+ *
+ * @return              The currently set alarm time.
+ *
+ * @notapi
+ */
+systime_t st_lld_get_alarm(void) {
+
+  return st_alarm;
+}
+
+/**
+ * @brief   Determines if the alarm is active.
+ *
+ * @return              The alarm status.
+ * @retval false        if the alarm is not active.
+ * @retval true         is the alarm is active
+ *
+ * @notapi
+ */
+bool st_lld_is_alarm_active(void) {
+
+  return st_alarm_active;
+}
+#endif /* OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING */
+
+#endif /* OSAL_ST_MODE != OSAL_ST_MODE_NONE */
+
+/** @} */
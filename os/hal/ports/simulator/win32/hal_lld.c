@@ -107,4 +107,13 @@ void _sim_check_for_interrupts(void) {
   }
 }
 
+/**
+ * @brief   Waits for a simulated interrupt.
+ * @note    Interrupt sources are polled in this implementation.
+ */
+void _sim_wait_for_interrupts(void) {
+
+  _sim_check_for_interrupts();
+}
+
 /** @} */
@@ -71,6 +71,15 @@ void cryObjectInit(CRYDriver *cryp) {
 
   cryp->state    = CRY_STOP;
   cryp->config   = NULL;
+#if HAL_CRY_USE_FALLBACK == TRUE
+#if CRY_LLD_SUPPORTS_AES == FALSE
+  cryp->fb_aes_key.nr = 0U;
+#endif
+#if (CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE) ||                              \
+    (CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE)
+  cryp->fb_hmac_key.loaded = false;
+#endif
+#endif
 #if defined(CRY_DRIVER_EXT_INIT_HOOK)
   CRY_DRIVER_EXT_INIT_HOOK(cryp);
 #endif
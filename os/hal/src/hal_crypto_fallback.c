@@ -0,0 +1,2384 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_crypto_fallback.c
+ * @brief   Cryptographic Driver software fall-back code.
+ * @details Portable implementations of the algorithms not supported by the
+ *          underlying LLD:
+ *          - AES uses a single 1kB T-table for each direction, the other
+ *            three tables are obtained by rotation.
+ *          - SHA compression functions are fully unrolled.
+ *          - GHASH uses 4 bits tables precomputed for each operation.
+ *          .
+ *          If the LLD supports the AES block operations then the AES modes
+ *          are built over the LLD single block functions and the keys are
+ *          handled by the LLD.
+ * @note    The AES and HMAC transient keys are stored in the @p CRYDriver
+ *          structure, each driver instance has its own keys.
+ * @note    DES is not implemented, the related functions return
+ *          @p CRY_ERR_INV_ALGO.
+ *
+ * @addtogroup CRYPTO
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#if ((HAL_USE_CRY == TRUE) && (HAL_CRY_USE_FALLBACK == TRUE)) ||            \
+    defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Software AES required.
+ */
+#define CRY_FB_AES_SW       (CRY_LLD_SUPPORTS_AES == FALSE)
+
+/**
+ * @brief   AES block primitives required by some mode.
+ */
+#define CRY_FB_AES          ((CRY_LLD_SUPPORTS_AES == FALSE) ||             \
+                             (CRY_LLD_SUPPORTS_AES_ECB == FALSE) ||         \
+                             (CRY_LLD_SUPPORTS_AES_CBC == FALSE) ||         \
+                             (CRY_LLD_SUPPORTS_AES_CFB == FALSE) ||         \
+                             (CRY_LLD_SUPPORTS_AES_CTR == FALSE) ||         \
+                             (CRY_LLD_SUPPORTS_AES_GCM == FALSE))
+
+/**
+ * @brief   AES block decryption required by some mode.
+ */
+#define CRY_FB_AES_DEC      ((CRY_LLD_SUPPORTS_AES == FALSE) ||             \
+                             (CRY_LLD_SUPPORTS_AES_ECB == FALSE) ||         \
+                             (CRY_LLD_SUPPORTS_AES_CBC == FALSE))
+
+/**
+ * @brief   Software SHA256 required.
+ */
+#define CRY_FB_SHA256       ((CRY_LLD_SUPPORTS_SHA256 == FALSE) ||          \
+                             (CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE))
+
+/**
+ * @brief   Software SHA512 required.
+ */
+#define CRY_FB_SHA512       ((CRY_LLD_SUPPORTS_SHA512 == FALSE) ||          \
+                             (CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE))
+
+/**
+ * @brief   Software HMAC required.
+ */
+#define CRY_FB_HMAC         ((CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE) ||     \
+                             (CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE))
+
+#define ROR32(x, n)         (((x) >> (n)) | ((x) << (32U - (n))))
+#define ROL32(x, n)         (((x) << (n)) | ((x) >> (32U - (n))))
+#define ROR64(x, n)         (((x) >> (n)) | ((x) << (64U - (n))))
+#define SHA_CH(x, y, z)     ((z) ^ ((x) & ((y) ^ (z))))
+#define SHA_MAJ(x, y, z)    (((x) & (y)) | ((z) & ((x) | (y))))
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+#if (CRY_FB_AES_SW == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   AES S-box.
+ */
+static const uint8_t aes_sbox[256] = {
+  0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5,
+  0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+  0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0,
+  0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+  0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC,
+  0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+  0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A,
+  0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+  0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0,
+  0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+  0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B,
+  0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+  0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85,
+  0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+  0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5,
+  0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+  0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17,
+  0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+  0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88,
+  0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+  0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C,
+  0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+  0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9,
+  0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+  0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6,
+  0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+  0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E,
+  0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+  0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94,
+  0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+  0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68,
+  0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+/**
+ * @brief   AES inverse S-box.
+ */
+static const uint8_t aes_inv_sbox[256] = {
+  0x52, 0x09, 0x6A, 0xD5, 0x30, 0x36, 0xA5, 0x38,
+  0xBF, 0x40, 0xA3, 0x9E, 0x81, 0xF3, 0xD7, 0xFB,
+  0x7C, 0xE3, 0x39, 0x82, 0x9B, 0x2F, 0xFF, 0x87,
+  0x34, 0x8E, 0x43, 0x44, 0xC4, 0xDE, 0xE9, 0xCB,
+  0x54, 0x7B, 0x94, 0x32, 0xA6, 0xC2, 0x23, 0x3D,
+  0xEE, 0x4C, 0x95, 0x0B, 0x42, 0xFA, 0xC3, 0x4E,
+  0x08, 0x2E, 0xA1, 0x66, 0x28, 0xD9, 0x24, 0xB2,
+  0x76, 0x5B, 0xA2, 0x49, 0x6D, 0x8B, 0xD1, 0x25,
+  0x72, 0xF8, 0xF6, 0x64, 0x86, 0x68, 0x98, 0x16,
+  0xD4, 0xA4, 0x5C, 0xCC, 0x5D, 0x65, 0xB6, 0x92,
+  0x6C, 0x70, 0x48, 0x50, 0xFD, 0xED, 0xB9, 0xDA,
+  0x5E, 0x15, 0x46, 0x57, 0xA7, 0x8D, 0x9D, 0x84,
+  0x90, 0xD8, 0xAB, 0x00, 0x8C, 0xBC, 0xD3, 0x0A,
+  0xF7, 0xE4, 0x58, 0x05, 0xB8, 0xB3, 0x45, 0x06,
+  0xD0, 0x2C, 0x1E, 0x8F, 0xCA, 0x3F, 0x0F, 0x02,
+  0xC1, 0xAF, 0xBD, 0x03, 0x01, 0x13, 0x8A, 0x6B,
+  0x3A, 0x91, 0x11, 0x41, 0x4F, 0x67, 0xDC, 0xEA,
+  0x97, 0xF2, 0xCF, 0xCE, 0xF0, 0xB4, 0xE6, 0x73,
+  0x96, 0xAC, 0x74, 0x22, 0xE7, 0xAD, 0x35, 0x85,
+  0xE2, 0xF9, 0x37, 0xE8, 0x1C, 0x75, 0xDF, 0x6E,
+  0x47, 0xF1, 0x1A, 0x71, 0x1D, 0x29, 0xC5, 0x89,
+  0x6F, 0xB7, 0x62, 0x0E, 0xAA, 0x18, 0xBE, 0x1B,
+  0xFC, 0x56, 0x3E, 0x4B, 0xC6, 0xD2, 0x79, 0x20,
+  0x9A, 0xDB, 0xC0, 0xFE, 0x78, 0xCD, 0x5A, 0xF4,
+  0x1F, 0xDD, 0xA8, 0x33, 0x88, 0x07, 0xC7, 0x31,
+  0xB1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xEC, 0x5F,
+  0x60, 0x51, 0x7F, 0xA9, 0x19, 0xB5, 0x4A, 0x0D,
+  0x2D, 0xE5, 0x7A, 0x9F, 0x93, 0xC9, 0x9C, 0xEF,
+  0xA0, 0xE0, 0x3B, 0x4D, 0xAE, 0x2A, 0xF5, 0xB0,
+  0xC8, 0xEB, 0xBB, 0x3C, 0x83, 0x53, 0x99, 0x61,
+  0x17, 0x2B, 0x04, 0x7E, 0xBA, 0x77, 0xD6, 0x26,
+  0xE1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0C, 0x7D
+};
+
+/**
+ * @brief   AES encryption T-table, the other three are rotations.
+ */
+static const uint32_t aes_te[256] = {
+  0xC66363A5U, 0xF87C7C84U, 0xEE777799U, 0xF67B7B8DU,
+  0xFFF2F20DU, 0xD66B6BBDU, 0xDE6F6FB1U, 0x91C5C554U,
+  0x60303050U, 0x02010103U, 0xCE6767A9U, 0x562B2B7DU,
+  0xE7FEFE19U, 0xB5D7D762U, 0x4DABABE6U, 0xEC76769AU,
+  0x8FCACA45U, 0x1F82829DU, 0x89C9C940U, 0xFA7D7D87U,
+  0xEFFAFA15U, 0xB25959EBU, 0x8E4747C9U, 0xFBF0F00BU,
+  0x41ADADECU, 0xB3D4D467U, 0x5FA2A2FDU, 0x45AFAFEAU,
+  0x239C9CBFU, 0x53A4A4F7U, 0xE4727296U, 0x9BC0C05BU,
+  0x75B7B7C2U, 0xE1FDFD1CU, 0x3D9393AEU, 0x4C26266AU,
+  0x6C36365AU, 0x7E3F3F41U, 0xF5F7F702U, 0x83CCCC4FU,
+  0x6834345CU, 0x51A5A5F4U, 0xD1E5E534U, 0xF9F1F108U,
+  0xE2717193U, 0xABD8D873U, 0x62313153U, 0x2A15153FU,
+  0x0804040CU, 0x95C7C752U, 0x46232365U, 0x9DC3C35EU,
+  0x30181828U, 0x379696A1U, 0x0A05050FU, 0x2F9A9AB5U,
+  0x0E070709U, 0x24121236U, 0x1B80809BU, 0xDFE2E23DU,
+  0xCDEBEB26U, 0x4E272769U, 0x7FB2B2CDU, 0xEA75759FU,
+  0x1209091BU, 0x1D83839EU, 0x582C2C74U, 0x341A1A2EU,
+  0x361B1B2DU, 0xDC6E6EB2U, 0xB45A5AEEU, 0x5BA0A0FBU,
+  0xA45252F6U, 0x763B3B4DU, 0xB7D6D661U, 0x7DB3B3CEU,
+  0x5229297BU, 0xDDE3E33EU, 0x5E2F2F71U, 0x13848497U,
+  0xA65353F5U, 0xB9D1D168U, 0x00000000U, 0xC1EDED2CU,
+  0x40202060U, 0xE3FCFC1FU, 0x79B1B1C8U, 0xB65B5BEDU,
+  0xD46A6ABEU, 0x8DCBCB46U, 0x67BEBED9U, 0x7239394BU,
+  0x944A4ADEU, 0x984C4CD4U, 0xB05858E8U, 0x85CFCF4AU,
+  0xBBD0D06BU, 0xC5EFEF2AU, 0x4FAAAAE5U, 0xEDFBFB16U,
+  0x864343C5U, 0x9A4D4DD7U, 0x66333355U, 0x11858594U,
+  0x8A4545CFU, 0xE9F9F910U, 0x04020206U, 0xFE7F7F81U,
+  0xA05050F0U, 0x783C3C44U, 0x259F9FBAU, 0x4BA8A8E3U,
+  0xA25151F3U, 0x5DA3A3FEU, 0x804040C0U, 0x058F8F8AU,
+  0x3F9292ADU, 0x219D9DBCU, 0x70383848U, 0xF1F5F504U,
+  0x63BCBCDFU, 0x77B6B6C1U, 0xAFDADA75U, 0x42212163U,
+  0x20101030U, 0xE5FFFF1AU, 0xFDF3F30EU, 0xBFD2D26DU,
+  0x81CDCD4CU, 0x180C0C14U, 0x26131335U, 0xC3ECEC2FU,
+  0xBE5F5FE1U, 0x359797A2U, 0x884444CCU, 0x2E171739U,
+  0x93C4C457U, 0x55A7A7F2U, 0xFC7E7E82U, 0x7A3D3D47U,
+  0xC86464ACU, 0xBA5D5DE7U, 0x3219192BU, 0xE6737395U,
+  0xC06060A0U, 0x19818198U, 0x9E4F4FD1U, 0xA3DCDC7FU,
+  0x44222266U, 0x542A2A7EU, 0x3B9090ABU, 0x0B888883U,
+  0x8C4646CAU, 0xC7EEEE29U, 0x6BB8B8D3U, 0x2814143CU,
+  0xA7DEDE79U, 0xBC5E5EE2U, 0x160B0B1DU, 0xADDBDB76U,
+  0xDBE0E03BU, 0x64323256U, 0x743A3A4EU, 0x140A0A1EU,
+  0x924949DBU, 0x0C06060AU, 0x4824246CU, 0xB85C5CE4U,
+  0x9FC2C25DU, 0xBDD3D36EU, 0x43ACACEFU, 0xC46262A6U,
+  0x399191A8U, 0x319595A4U, 0xD3E4E437U, 0xF279798BU,
+  0xD5E7E732U, 0x8BC8C843U, 0x6E373759U, 0xDA6D6DB7U,
+  0x018D8D8CU, 0xB1D5D564U, 0x9C4E4ED2U, 0x49A9A9E0U,
+  0xD86C6CB4U, 0xAC5656FAU, 0xF3F4F407U, 0xCFEAEA25U,
+  0xCA6565AFU, 0xF47A7A8EU, 0x47AEAEE9U, 0x10080818U,
+  0x6FBABAD5U, 0xF0787888U, 0x4A25256FU, 0x5C2E2E72U,
+  0x381C1C24U, 0x57A6A6F1U, 0x73B4B4C7U, 0x97C6C651U,
+  0xCBE8E823U, 0xA1DDDD7CU, 0xE874749CU, 0x3E1F1F21U,
+  0x964B4BDDU, 0x61BDBDDCU, 0x0D8B8B86U, 0x0F8A8A85U,
+  0xE0707090U, 0x7C3E3E42U, 0x71B5B5C4U, 0xCC6666AAU,
+  0x904848D8U, 0x06030305U, 0xF7F6F601U, 0x1C0E0E12U,
+  0xC26161A3U, 0x6A35355FU, 0xAE5757F9U, 0x69B9B9D0U,
+  0x17868691U, 0x99C1C158U, 0x3A1D1D27U, 0x279E9EB9U,
+  0xD9E1E138U, 0xEBF8F813U, 0x2B9898B3U, 0x22111133U,
+  0xD26969BBU, 0xA9D9D970U, 0x078E8E89U, 0x339494A7U,
+  0x2D9B9BB6U, 0x3C1E1E22U, 0x15878792U, 0xC9E9E920U,
+  0x87CECE49U, 0xAA5555FFU, 0x50282878U, 0xA5DFDF7AU,
+  0x038C8C8FU, 0x59A1A1F8U, 0x09898980U, 0x1A0D0D17U,
+  0x65BFBFDAU, 0xD7E6E631U, 0x844242C6U, 0xD06868B8U,
+  0x824141C3U, 0x299999B0U, 0x5A2D2D77U, 0x1E0F0F11U,
+  0x7BB0B0CBU, 0xA85454FCU, 0x6DBBBBD6U, 0x2C16163AU
+};
+
+/**
+ * @brief   AES decryption T-table, the other three are rotations.
+ */
+static const uint32_t aes_td[256] = {
+  0x51F4A750U, 0x7E416553U, 0x1A17A4C3U, 0x3A275E96U,
+  0x3BAB6BCBU, 0x1F9D45F1U, 0xACFA58ABU, 0x4BE30393U,
+  0x2030FA55U, 0xAD766DF6U, 0x88CC7691U, 0xF5024C25U,
+  0x4FE5D7FCU, 0xC52ACBD7U, 0x26354480U, 0xB562A38FU,
+  0xDEB15A49U, 0x25BA1B67U, 0x45EA0E98U, 0x5DFEC0E1U,
+  0xC32F7502U, 0x814CF012U, 0x8D4697A3U, 0x6BD3F9C6U,
+  0x038F5FE7U, 0x15929C95U, 0xBF6D7AEBU, 0x955259DAU,
+  0xD4BE832DU, 0x587421D3U, 0x49E06929U, 0x8EC9C844U,
+  0x75C2896AU, 0xF48E7978U, 0x99583E6BU, 0x27B971DDU,
+  0xBEE14FB6U, 0xF088AD17U, 0xC920AC66U, 0x7DCE3AB4U,
+  0x63DF4A18U, 0xE51A3182U, 0x97513360U, 0x62537F45U,
+  0xB16477E0U, 0xBB6BAE84U, 0xFE81A01CU, 0xF9082B94U,
+  0x70486858U, 0x8F45FD19U, 0x94DE6C87U, 0x527BF8B7U,
+  0xAB73D323U, 0x724B02E2U, 0xE31F8F57U, 0x6655AB2AU,
+  0xB2EB2807U, 0x2FB5C203U, 0x86C57B9AU, 0xD33708A5U,
+  0x302887F2U, 0x23BFA5B2U, 0x02036ABAU, 0xED16825CU,
+  0x8ACF1C2BU, 0xA779B492U, 0xF307F2F0U, 0x4E69E2A1U,
+  0x65DAF4CDU, 0x0605BED5U, 0xD134621FU, 0xC4A6FE8AU,
+  0x342E539DU, 0xA2F355A0U, 0x058AE132U, 0xA4F6EB75U,
+  0x0B83EC39U, 0x4060EFAAU, 0x5E719F06U, 0xBD6E1051U,
+  0x3E218AF9U, 0x96DD063DU, 0xDD3E05AEU, 0x4DE6BD46U,
+  0x91548DB5U, 0x71C45D05U, 0x0406D46FU, 0x605015FFU,
+  0x1998FB24U, 0xD6BDE997U, 0x894043CCU, 0x67D99E77U,
+  0xB0E842BDU, 0x07898B88U, 0xE7195B38U, 0x79C8EEDBU,
+  0xA17C0A47U, 0x7C420FE9U, 0xF8841EC9U, 0x00000000U,
+  0x09808683U, 0x322BED48U, 0x1E1170ACU, 0x6C5A724EU,
+  0xFD0EFFFBU, 0x0F853856U, 0x3DAED51EU, 0x362D3927U,
+  0x0A0FD964U, 0x685CA621U, 0x9B5B54D1U, 0x24362E3AU,
+  0x0C0A67B1U, 0x9357E70FU, 0xB4EE96D2U, 0x1B9B919EU,
+  0x80C0C54FU, 0x61DC20A2U, 0x5A774B69U, 0x1C121A16U,
+  0xE293BA0AU, 0xC0A02AE5U, 0x3C22E043U, 0x121B171DU,
+  0x0E090D0BU, 0xF28BC7ADU, 0x2DB6A8B9U, 0x141EA9C8U,
+  0x57F11985U, 0xAF75074CU, 0xEE99DDBBU, 0xA37F60FDU,
+  0xF701269FU, 0x5C72F5BCU, 0x44663BC5U, 0x5BFB7E34U,
+  0x8B432976U, 0xCB23C6DCU, 0xB6EDFC68U, 0xB8E4F163U,
+  0xD731DCCAU, 0x42638510U, 0x13972240U, 0x84C61120U,
+  0x854A247DU, 0xD2BB3DF8U, 0xAEF93211U, 0xC729A16DU,
+  0x1D9E2F4BU, 0xDCB230F3U, 0x0D8652ECU, 0x77C1E3D0U,
+  0x2BB3166CU, 0xA970B999U, 0x119448FAU, 0x47E96422U,
+  0xA8FC8CC4U, 0xA0F03F1AU, 0x567D2CD8U, 0x223390EFU,
+  0x87494EC7U, 0xD938D1C1U, 0x8CCAA2FEU, 0x98D40B36U,
+  0xA6F581CFU, 0xA57ADE28U, 0xDAB78E26U, 0x3FADBFA4U,
+  0x2C3A9DE4U, 0x5078920DU, 0x6A5FCC9BU, 0x547E4662U,
+  0xF68D13C2U, 0x90D8B8E8U, 0x2E39F75EU, 0x82C3AFF5U,
+  0x9F5D80BEU, 0x69D0937CU, 0x6FD52DA9U, 0xCF2512B3U,
+  0xC8AC993BU, 0x10187DA7U, 0xE89C636EU, 0xDB3BBB7BU,
+  0xCD267809U, 0x6E5918F4U, 0xEC9AB701U, 0x834F9AA8U,
+  0xE6956E65U, 0xAAFFE67EU, 0x21BCCF08U, 0xEF15E8E6U,
+  0xBAE79BD9U, 0x4A6F36CEU, 0xEA9F09D4U, 0x29B07CD6U,
+  0x31A4B2AFU, 0x2A3F2331U, 0xC6A59430U, 0x35A266C0U,
+  0x744EBC37U, 0xFC82CAA6U, 0xE090D0B0U, 0x33A7D815U,
+  0xF104984AU, 0x41ECDAF7U, 0x7FCD500EU, 0x1791F62FU,
+  0x764DD68DU, 0x43EFB04DU, 0xCCAA4D54U, 0xE49604DFU,
+  0x9ED1B5E3U, 0x4C6A881BU, 0xC12C1FB8U, 0x4665517FU,
+  0x9D5EEA04U, 0x018C355DU, 0xFA877473U, 0xFB0B412EU,
+  0xB3671D5AU, 0x92DBD252U, 0xE9105633U, 0x6DD64713U,
+  0x9AD7618CU, 0x37A10C7AU, 0x59F8148EU, 0xEB133C89U,
+  0xCEA927EEU, 0xB761C935U, 0xE11CE5EDU, 0x7A47B13CU,
+  0x9CD2DF59U, 0x55F2733FU, 0x1814CE79U, 0x73C737BFU,
+  0x53F7CDEAU, 0x5FFDAA5BU, 0xDF3D6F14U, 0x7844DB86U,
+  0xCAAFF381U, 0xB968C43EU, 0x3824342CU, 0xC2A3405FU,
+  0x161DC372U, 0xBCE2250CU, 0x283C498BU, 0xFF0D9541U,
+  0x39A80171U, 0x080CB3DEU, 0xD8B4E49CU, 0x6456C190U,
+  0x7BCB8461U, 0xD532B670U, 0x486C5C74U, 0xD0B85742U
+};
+#endif /* CRY_FB_AES_SW == TRUE */
+
+#if (CRY_LLD_SUPPORTS_AES_GCM == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   GHASH reduction of a 4 bits shift.
+ */
+static const uint16_t gcm_last4[16] = {
+  0x0000, 0x1C20, 0x3840, 0x2460, 0x7080, 0x6CA0, 0x48C0, 0x54E0,
+  0xE100, 0xFD20, 0xD940, 0xC560, 0x9180, 0x8DA0, 0xA9C0, 0xB5E0
+};
+
+/**
+ * @brief   GHASH multiplication tables for a given H.
+ */
+typedef struct {
+  uint64_t                  hl[16];
+  uint64_t                  hh[16];
+} gcm_table_t;
+#endif /* CRY_LLD_SUPPORTS_AES_GCM == FALSE */
+
+#if (CRY_FB_SHA256 == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   SHA256 round constants.
+ */
+static const uint32_t sha256_k[64] = {
+  0x428A2F98U, 0x71374491U, 0xB5C0FBCFU, 0xE9B5DBA5U,
+  0x3956C25BU, 0x59F111F1U, 0x923F82A4U, 0xAB1C5ED5U,
+  0xD807AA98U, 0x12835B01U, 0x243185BEU, 0x550C7DC3U,
+  0x72BE5D74U, 0x80DEB1FEU, 0x9BDC06A7U, 0xC19BF174U,
+  0xE49B69C1U, 0xEFBE4786U, 0x0FC19DC6U, 0x240CA1CCU,
+  0x2DE92C6FU, 0x4A7484AAU, 0x5CB0A9DCU, 0x76F988DAU,
+  0x983E5152U, 0xA831C66DU, 0xB00327C8U, 0xBF597FC7U,
+  0xC6E00BF3U, 0xD5A79147U, 0x06CA6351U, 0x14292967U,
+  0x27B70A85U, 0x2E1B2138U, 0x4D2C6DFCU, 0x53380D13U,
+  0x650A7354U, 0x766A0ABBU, 0x81C2C92EU, 0x92722C85U,
+  0xA2BFE8A1U, 0xA81A664BU, 0xC24B8B70U, 0xC76C51A3U,
+  0xD192E819U, 0xD6990624U, 0xF40E3585U, 0x106AA070U,
+  0x19A4C116U, 0x1E376C08U, 0x2748774CU, 0x34B0BCB5U,
+  0x391C0CB3U, 0x4ED8AA4AU, 0x5B9CCA4FU, 0x682E6FF3U,
+  0x748F82EEU, 0x78A5636FU, 0x84C87814U, 0x8CC70208U,
+  0x90BEFFFAU, 0xA4506CEBU, 0xBEF9A3F7U, 0xC67178F2U
+};
+#endif /* CRY_FB_SHA256 == TRUE */
+
+#if (CRY_FB_SHA512 == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   SHA512 round constants.
+ */
+static const uint64_t sha512_k[80] = {
+  0x428A2F98D728AE22U, 0x7137449123EF65CDU, 0xB5C0FBCFEC4D3B2FU,
+  0xE9B5DBA58189DBBCU, 0x3956C25BF348B538U, 0x59F111F1B605D019U,
+  0x923F82A4AF194F9BU, 0xAB1C5ED5DA6D8118U, 0xD807AA98A3030242U,
+  0x12835B0145706FBEU, 0x243185BE4EE4B28CU, 0x550C7DC3D5FFB4E2U,
+  0x72BE5D74F27B896FU, 0x80DEB1FE3B1696B1U, 0x9BDC06A725C71235U,
+  0xC19BF174CF692694U, 0xE49B69C19EF14AD2U, 0xEFBE4786384F25E3U,
+  0x0FC19DC68B8CD5B5U, 0x240CA1CC77AC9C65U, 0x2DE92C6F592B0275U,
+  0x4A7484AA6EA6E483U, 0x5CB0A9DCBD41FBD4U, 0x76F988DA831153B5U,
+  0x983E5152EE66DFABU, 0xA831C66D2DB43210U, 0xB00327C898FB213FU,
+  0xBF597FC7BEEF0EE4U, 0xC6E00BF33DA88FC2U, 0xD5A79147930AA725U,
+  0x06CA6351E003826FU, 0x142929670A0E6E70U, 0x27B70A8546D22FFCU,
+  0x2E1B21385C26C926U, 0x4D2C6DFC5AC42AEDU, 0x53380D139D95B3DFU,
+  0x650A73548BAF63DEU, 0x766A0ABB3C77B2A8U, 0x81C2C92E47EDAEE6U,
+  0x92722C851482353BU, 0xA2BFE8A14CF10364U, 0xA81A664BBC423001U,
+  0xC24B8B70D0F89791U, 0xC76C51A30654BE30U, 0xD192E819D6EF5218U,
+  0xD69906245565A910U, 0xF40E35855771202AU, 0x106AA07032BBD1B8U,
+  0x19A4C116B8D2D0C8U, 0x1E376C085141AB53U, 0x2748774CDF8EEB99U,
+  0x34B0BCB5E19B48A8U, 0x391C0CB3C5C95A63U, 0x4ED8AA4AE3418ACBU,
+  0x5B9CCA4F7763E373U, 0x682E6FF3D6B2B8A3U, 0x748F82EE5DEFB2FCU,
+  0x78A5636F43172F60U, 0x84C87814A1F0AB72U, 0x8CC702081A6439ECU,
+  0x90BEFFFA23631E28U, 0xA4506CEBDE82BDE9U, 0xBEF9A3F7B2C67915U,
+  0xC67178F2E372532BU, 0xCA273ECEEA26619CU, 0xD186B8C721C0C207U,
+  0xEADA7DD6CDE0EB1EU, 0xF57D4F7FEE6ED178U, 0x06F067AA72176FBAU,
+  0x0A637DC5A2C898A6U, 0x113F9804BEF90DAEU, 0x1B710B35131C471BU,
+  0x28DB77F523047D84U, 0x32CAAB7B40C72493U, 0x3C9EBE0A15C9BEBCU,
+  0x431D67C49C100D4CU, 0x4CC5D4BECB3E42B6U, 0x597F299CFC657E2AU,
+  0x5FCB6FAB3AD6FAECU, 0x6C44198C4A475817U
+};
+#endif /* CRY_FB_SHA512 == TRUE */
+
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static inline uint32_t get_u32_be(const uint8_t *p) {
+
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8)  | (uint32_t)p[3];
+}
+
+static inline void put_u32_be(uint8_t *p, uint32_t v) {
+
+  p[0] = (uint8_t)(v >> 24);
+  p[1] = (uint8_t)(v >> 16);
+  p[2] = (uint8_t)(v >> 8);
+  p[3] = (uint8_t)v;
+}
+
+static inline uint64_t get_u64_be(const uint8_t *p) {
+
+  return ((uint64_t)get_u32_be(p) << 32) | (uint64_t)get_u32_be(p + 4);
+}
+
+static inline void put_u64_be(uint8_t *p, uint64_t v) {
+
+  put_u32_be(p, (uint32_t)(v >> 32));
+  put_u32_be(p + 4, (uint32_t)v);
+}
+
+static inline void xor_block(uint8_t *dp, const uint8_t *ap,
+                             const uint8_t *bp) {
+  unsigned i;
+
+  for (i = 0U; i < 16U; i++) {
+    dp[i] = ap[i] ^ bp[i];
+  }
+}
+
+#if (CRY_FB_AES_SW == TRUE) || defined(__DOXYGEN__)
+#define TE0(x)              aes_te[x]
+#define TE1(x)              ROR32(aes_te[x], 8U)
+#define TE2(x)              ROR32(aes_te[x], 16U)
+#define TE3(x)              ROR32(aes_te[x], 24U)
+#define TD0(x)              aes_td[x]
+#define TD1(x)              ROR32(aes_td[x], 8U)
+#define TD2(x)              ROR32(aes_td[x], 16U)
+#define TD3(x)              ROR32(aes_td[x], 24U)
+#define B0(x)               ((x) >> 24)
+#define B1(x)               (((x) >> 16) & 0xFFU)
+#define B2(x)               (((x) >> 8) & 0xFFU)
+#define B3(x)               ((x) & 0xFFU)
+
+static uint32_t aes_sub_word(uint32_t w) {
+
+  return ((uint32_t)aes_sbox[B0(w)] << 24) |
+         ((uint32_t)aes_sbox[B1(w)] << 16) |
+         ((uint32_t)aes_sbox[B2(w)] << 8) |
+         (uint32_t)aes_sbox[B3(w)];
+}
+
+static void aes_expand_key(cry_fallback_aes_key_t *kp,
+                           const uint8_t *keyp, size_t size) {
+  uint32_t *ek = kp->ek, *dk = kp->dk;
+  unsigned i, j, nk, nw;
+  uint32_t rcon = 0x01U;
+
+  nk = (unsigned)size / 4U;
+  kp->nr = nk + 6U;
+  nw = (kp->nr + 1U) * 4U;
+
+  /* Encryption schedule.*/
+  for (i = 0U; i < nk; i++) {
+    ek[i] = get_u32_be(&keyp[i * 4U]);
+  }
+  for (i = nk; i < nw; i++) {
+    uint32_t t = ek[i - 1U];
+
+    if ((i % nk) == 0U) {
+      t = aes_sub_word(ROL32(t, 8U)) ^ (rcon << 24);
+      rcon = (rcon << 1) ^ (((rcon >> 7) & 1U) * 0x11BU);
+    }
+    else if ((nk > 6U) && ((i % nk) == 4U)) {
+      t = aes_sub_word(t);
+    }
+    ek[i] = ek[i - nk] ^ t;
+  }
+
+  /* Decryption schedule, round keys in reverse order with InvMixColumns
+     applied to the inner rounds.*/
+  for (i = 0U; i <= kp->nr; i++) {
+    for (j = 0U; j < 4U; j++) {
+      uint32_t w = ek[((kp->nr - i) * 4U) + j];
+
+      if ((i > 0U) && (i < kp->nr)) {
+        w = TD0(aes_sbox[B0(w)]) ^ TD1(aes_sbox[B1(w)]) ^
+            TD2(aes_sbox[B2(w)]) ^ TD3(aes_sbox[B3(w)]);
+      }
+      dk[(i * 4U) + j] = w;
+    }
+  }
+}
+
+static void aes_encrypt_block(const cry_fallback_aes_key_t *kp,
+                              const uint8_t *in, uint8_t *out) {
+  const uint32_t *rk = kp->ek;
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+  unsigned r;
+
+  s0 = get_u32_be(&in[0])  ^ rk[0];
+  s1 = get_u32_be(&in[4])  ^ rk[1];
+  s2 = get_u32_be(&in[8])  ^ rk[2];
+  s3 = get_u32_be(&in[12]) ^ rk[3];
+
+  for (r = kp->nr - 1U; r > 0U; r--) {
+    rk += 4;
+    t0 = TE0(B0(s0)) ^ TE1(B1(s1)) ^ TE2(B2(s2)) ^ TE3(B3(s3)) ^ rk[0];
+    t1 = TE0(B0(s1)) ^ TE1(B1(s2)) ^ TE2(B2(s3)) ^ TE3(B3(s0)) ^ rk[1];
+    t2 = TE0(B0(s2)) ^ TE1(B1(s3)) ^ TE2(B2(s0)) ^ TE3(B3(s1)) ^ rk[2];
+    t3 = TE0(B0(s3)) ^ TE1(B1(s0)) ^ TE2(B2(s1)) ^ TE3(B3(s2)) ^ rk[3];
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+
+  /* Last round, no MixColumns.*/
+  rk += 4;
+  t0 = ((uint32_t)aes_sbox[B0(s0)] << 24) ^
+       ((uint32_t)aes_sbox[B1(s1)] << 16) ^
+       ((uint32_t)aes_sbox[B2(s2)] << 8)  ^
+       (uint32_t)aes_sbox[B3(s3)];
+  t1 = ((uint32_t)aes_sbox[B0(s1)] << 24) ^
+       ((uint32_t)aes_sbox[B1(s2)] << 16) ^
+       ((uint32_t)aes_sbox[B2(s3)] << 8)  ^
+       (uint32_t)aes_sbox[B3(s0)];
+  t2 = ((uint32_t)aes_sbox[B0(s2)] << 24) ^
+       ((uint32_t)aes_sbox[B1(s3)] << 16) ^
+       ((uint32_t)aes_sbox[B2(s0)] << 8)  ^
+       (uint32_t)aes_sbox[B3(s1)];
+  t3 = ((uint32_t)aes_sbox[B0(s3)] << 24) ^
+       ((uint32_t)aes_sbox[B1(s0)] << 16) ^
+       ((uint32_t)aes_sbox[B2(s1)] << 8)  ^
+       (uint32_t)aes_sbox[B3(s2)];
+  put_u32_be(&out[0],  t0 ^ rk[0]);
+  put_u32_be(&out[4],  t1 ^ rk[1]);
+  put_u32_be(&out[8],  t2 ^ rk[2]);
+  put_u32_be(&out[12], t3 ^ rk[3]);
+}
+
+static void aes_decrypt_block(const cry_fallback_aes_key_t *kp,
+                              const uint8_t *in, uint8_t *out) {
+  const uint32_t *rk = kp->dk;
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+  unsigned r;
+
+  s0 = get_u32_be(&in[0])  ^ rk[0];
+  s1 = get_u32_be(&in[4])  ^ rk[1];
+  s2 = get_u32_be(&in[8])  ^ rk[2];
+  s3 = get_u32_be(&in[12]) ^ rk[3];
+
+  for (r = kp->nr - 1U; r > 0U; r--) {
+    rk += 4;
+    t0 = TD0(B0(s0)) ^ TD1(B1(s3)) ^ TD2(B2(s2)) ^ TD3(B3(s1)) ^ rk[0];
+    t1 = TD0(B0(s1)) ^ TD1(B1(s0)) ^ TD2(B2(s3)) ^ TD3(B3(s2)) ^ rk[1];
+    t2 = TD0(B0(s2)) ^ TD1(B1(s1)) ^ TD2(B2(s0)) ^ TD3(B3(s3)) ^ rk[2];
+    t3 = TD0(B0(s3)) ^ TD1(B1(s2)) ^ TD2(B2(s1)) ^ TD3(B3(s0)) ^ rk[3];
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+
+  /* Last round, no InvMixColumns.*/
+  rk += 4;
+  t0 = ((uint32_t)aes_inv_sbox[B0(s0)] << 24) ^
+       ((uint32_t)aes_inv_sbox[B1(s3)] << 16) ^
+       ((uint32_t)aes_inv_sbox[B2(s2)] << 8)  ^
+       (uint32_t)aes_inv_sbox[B3(s1)];
+  t1 = ((uint32_t)aes_inv_sbox[B0(s1)] << 24) ^
+       ((uint32_t)aes_inv_sbox[B1(s0)] << 16) ^
+       ((uint32_t)aes_inv_sbox[B2(s3)] << 8)  ^
+       (uint32_t)aes_inv_sbox[B3(s2)];
+  t2 = ((uint32_t)aes_inv_sbox[B0(s2)] << 24) ^
+       ((uint32_t)aes_inv_sbox[B1(s1)] << 16) ^
+       ((uint32_t)aes_inv_sbox[B2(s0)] << 8)  ^
+       (uint32_t)aes_inv_sbox[B3(s3)];
+  t3 = ((uint32_t)aes_inv_sbox[B0(s3)] << 24) ^
+       ((uint32_t)aes_inv_sbox[B1(s2)] << 16) ^
+       ((uint32_t)aes_inv_sbox[B2(s1)] << 8)  ^
+       (uint32_t)aes_inv_sbox[B3(s0)];
+  put_u32_be(&out[0],  t0 ^ rk[0]);
+  put_u32_be(&out[4],  t1 ^ rk[1]);
+  put_u32_be(&out[8],  t2 ^ rk[2]);
+  put_u32_be(&out[12], t3 ^ rk[3]);
+}
+#endif /* CRY_FB_AES_SW == TRUE */
+
+#if (CRY_FB_AES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Verifies that a key is usable for AES operations.
+ */
+static cryerror_t aes_check_key(CRYDriver *cryp, crykey_t key_id) {
+
+#if CRY_FB_AES_SW == TRUE
+  if ((key_id != (crykey_t)0) || (cryp->fb_aes_key.nr == 0U)) {
+    return CRY_ERR_INV_KEY_ID;
+  }
+#else
+  /* Keys are checked by the LLD.*/
+  (void)cryp;
+  (void)key_id;
+#endif
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   AES single block encryption.
+ */
+static inline cryerror_t aes_encrypt(CRYDriver *cryp, crykey_t key_id,
+                                     const uint8_t *in, uint8_t *out) {
+
+#if CRY_FB_AES_SW == TRUE
+  (void)key_id;
+
+  aes_encrypt_block(&cryp->fb_aes_key, in, out);
+
+  return CRY_NOERROR;
+#else
+  return cry_lld_encrypt_AES(cryp, key_id, in, out);
+#endif
+}
+#endif /* CRY_FB_AES == TRUE */
+
+#if (CRY_FB_AES_DEC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   AES single block decryption.
+ */
+static inline cryerror_t aes_decrypt(CRYDriver *cryp, crykey_t key_id,
+                                     const uint8_t *in, uint8_t *out) {
+
+#if CRY_FB_AES_SW == TRUE
+  (void)key_id;
+
+  aes_decrypt_block(&cryp->fb_aes_key, in, out);
+
+  return CRY_NOERROR;
+#else
+  return cry_lld_decrypt_AES(cryp, key_id, in, out);
+#endif
+}
+#endif /* CRY_FB_AES_DEC == TRUE */
+
+#if ((CRY_LLD_SUPPORTS_AES_CTR == FALSE) ||                                 \
+     (CRY_LLD_SUPPORTS_AES_GCM == FALSE)) || defined(__DOXYGEN__)
+/**
+ * @brief   Increments the 32 bits counter part of a counter block.
+ */
+static inline void ctr_inc32(uint8_t *ctr) {
+
+  put_u32_be(&ctr[12], get_u32_be(&ctr[12]) + 1U);
+}
+
+/**
+ * @brief   AES counter mode keystream application.
+ */
+static cryerror_t ctr_crypt(CRYDriver *cryp, crykey_t key_id, uint8_t *ctr,
+                            size_t size, const uint8_t *in, uint8_t *out) {
+  uint8_t ks[16];
+  cryerror_t err;
+  size_t i;
+
+  while (size >= 16U) {
+    err = aes_encrypt(cryp, key_id, ctr, ks);
+    if (err != CRY_NOERROR) {
+      return err;
+    }
+    ctr_inc32(ctr);
+    xor_block(out, in, ks);
+    in   += 16;
+    out  += 16;
+    size -= 16U;
+  }
+
+  if (size > 0U) {
+    err = aes_encrypt(cryp, key_id, ctr, ks);
+    if (err != CRY_NOERROR) {
+      return err;
+    }
+    ctr_inc32(ctr);
+    for (i = 0U; i < size; i++) {
+      out[i] = in[i] ^ ks[i];
+    }
+  }
+
+  return CRY_NOERROR;
+}
+#endif
+
+#if (CRY_LLD_SUPPORTS_AES_GCM == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Builds the GHASH tables for the specified H.
+ */
+static void gcm_init_table(gcm_table_t *tp, const uint8_t *h) {
+  uint64_t vh, vl;
+  unsigned i, j;
+
+  vh = get_u64_be(&h[0]);
+  vl = get_u64_be(&h[8]);
+
+  /* The tables are indexed by nibbles in reflected bit order, entry 8 is
+     H itself and entries 4, 2, 1 are H times x, x^2, x^3.*/
+  tp->hl[8] = vl;
+  tp->hh[8] = vh;
+  tp->hl[0] = 0U;
+  tp->hh[0] = 0U;
+  for (i = 4U; i > 0U; i >>= 1) {
+    uint64_t t = (vl & 1U) * 0xE100000000000000U;
+
+    vl = (vh << 63) | (vl >> 1);
+    vh = (vh >> 1) ^ t;
+    tp->hl[i] = vl;
+    tp->hh[i] = vh;
+  }
+  for (i = 2U; i <= 8U; i <<= 1) {
+    for (j = 1U; j < i; j++) {
+      tp->hh[i + j] = tp->hh[i] ^ tp->hh[j];
+      tp->hl[i + j] = tp->hl[i] ^ tp->hl[j];
+    }
+  }
+}
+
+/**
+ * @brief   Multiplies a GHASH accumulator by H.
+ */
+static void gcm_mult(const gcm_table_t *tp, uint8_t *x) {
+  uint64_t zh, zl;
+  unsigned i, lo, hi, rem;
+
+  lo = x[15] & 0x0FU;
+  zh = tp->hh[lo];
+  zl = tp->hl[lo];
+
+  for (i = 16U; i > 0U; i--) {
+    lo = x[i - 1U] & 0x0FU;
+    hi = (x[i - 1U] >> 4) & 0x0FU;
+
+    if (i != 16U) {
+      rem = (unsigned)zl & 0x0FU;
+      zl = (zh << 60) | (zl >> 4);
+      zh = (zh >> 4) ^ ((uint64_t)gcm_last4[rem] << 48);
+      zh ^= tp->hh[lo];
+      zl ^= tp->hl[lo];
+    }
+
+    rem = (unsigned)zl & 0x0FU;
+    zl = (zh << 60) | (zl >> 4);
+    zh = (zh >> 4) ^ ((uint64_t)gcm_last4[rem] << 48);
+    zh ^= tp->hh[hi];
+    zl ^= tp->hl[hi];
+  }
+
+  put_u64_be(&x[0], zh);
+  put_u64_be(&x[8], zl);
+}
+
+/**
+ * @brief   Accumulates a buffer into GHASH, the last block is zero padded.
+ */
+static void gcm_ghash(const gcm_table_t *tp, uint8_t *x,
+                      const uint8_t *p, size_t size) {
+  size_t i;
+
+  while (size >= 16U) {
+    xor_block(x, x, p);
+    gcm_mult(tp, x);
+    p    += 16;
+    size -= 16U;
+  }
+
+  if (size > 0U) {
+    for (i = 0U; i < size; i++) {
+      x[i] ^= p[i];
+    }
+    gcm_mult(tp, x);
+  }
+}
+
+/**
+ * @brief   GCM setup and authentication tag computation.
+ * @details Computes H, the initial counter block and the tag over the
+ *          additional data and the ciphertext.
+ */
+static cryerror_t gcm_tag(CRYDriver *cryp, crykey_t key_id,
+                          size_t auth_size, const uint8_t *auth_in,
+                          size_t text_size, const uint8_t *cipher,
+                          const uint8_t *iv, uint8_t *j0, uint8_t *tag) {
+  gcm_table_t table;
+  uint8_t h[16];
+  cryerror_t err;
+
+  /* H is the encryption of the zero block.*/
+  memset(h, 0, sizeof (h));
+  err = aes_encrypt(cryp, key_id, h, h);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+  gcm_init_table(&table, h);
+
+  /* J0 is the 96 bits IV followed by a 32 bits counter set to one.*/
+  memcpy(j0, iv, 12U);
+  put_u32_be(&j0[12], 1U);
+
+  /* GHASH over the additional data, the ciphertext and the lengths.*/
+  memset(tag, 0, 16U);
+  gcm_ghash(&table, tag, auth_in, auth_size);
+  gcm_ghash(&table, tag, cipher, text_size);
+  put_u64_be(&h[0], (uint64_t)auth_size * 8U);
+  put_u64_be(&h[8], (uint64_t)text_size * 8U);
+  gcm_ghash(&table, tag, h, 16U);
+
+  /* Final masking using the encrypted J0.*/
+  err = aes_encrypt(cryp, key_id, j0, h);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+  xor_block(tag, tag, h);
+
+  return CRY_NOERROR;
+}
+#endif /* CRY_LLD_SUPPORTS_AES_GCM == FALSE */
+
+#if (CRY_LLD_SUPPORTS_SHA1 == FALSE) || defined(__DOXYGEN__)
+#define SHA1_F0(b, c, d)    ((d) ^ ((b) & ((c) ^ (d))))
+#define SHA1_F1(b, c, d)    ((b) ^ (c) ^ (d))
+#define SHA1_F2(b, c, d)    (((b) & (c)) | ((d) & ((b) | (c))))
+
+#define SHA1_W(i)                                                           \
+  (w[(i) & 15U] = ROL32(w[((i) + 13U) & 15U] ^ w[((i) + 8U) & 15U] ^        \
+                        w[((i) + 2U) & 15U] ^ w[(i) & 15U], 1U))
+
+#define SHA1_R(a, b, c, d, e, f, k, x) do {                                 \
+  (e) += ROL32(a, 5U) + f(b, c, d) + (k) + (x);                             \
+  (b) = ROL32(b, 30U);                                                      \
+} while (false)
+
+static void sha1_compress(uint32_t *h, const uint8_t *p) {
+  uint32_t a, b, c, d, e, w[16];
+  unsigned i;
+
+  for (i = 0U; i < 16U; i++) {
+    w[i] = get_u32_be(&p[i * 4U]);
+  }
+
+  a = h[0];
+  b = h[1];
+  c = h[2];
+  d = h[3];
+  e = h[4];
+
+  for (i = 0U; i < 15U; i += 5U) {
+    SHA1_R(a, b, c, d, e, SHA1_F0, 0x5A827999U, w[i + 0U]);
+    SHA1_R(e, a, b, c, d, SHA1_F0, 0x5A827999U, w[i + 1U]);
+    SHA1_R(d, e, a, b, c, SHA1_F0, 0x5A827999U, w[i + 2U]);
+    SHA1_R(c, d, e, a, b, SHA1_F0, 0x5A827999U, w[i + 3U]);
+    SHA1_R(b, c, d, e, a, SHA1_F0, 0x5A827999U, w[i + 4U]);
+  }
+  SHA1_R(a, b, c, d, e, SHA1_F0, 0x5A827999U, w[15]);
+  SHA1_R(e, a, b, c, d, SHA1_F0, 0x5A827999U, SHA1_W(16U));
+  SHA1_R(d, e, a, b, c, SHA1_F0, 0x5A827999U, SHA1_W(17U));
+  SHA1_R(c, d, e, a, b, SHA1_F0, 0x5A827999U, SHA1_W(18U));
+  SHA1_R(b, c, d, e, a, SHA1_F0, 0x5A827999U, SHA1_W(19U));
+  for (i = 20U; i < 40U; i += 5U) {
+    SHA1_R(a, b, c, d, e, SHA1_F1, 0x6ED9EBA1U, SHA1_W(i + 0U));
+    SHA1_R(e, a, b, c, d, SHA1_F1, 0x6ED9EBA1U, SHA1_W(i + 1U));
+    SHA1_R(d, e, a, b, c, SHA1_F1, 0x6ED9EBA1U, SHA1_W(i + 2U));
+    SHA1_R(c, d, e, a, b, SHA1_F1, 0x6ED9EBA1U, SHA1_W(i + 3U));
+    SHA1_R(b, c, d, e, a, SHA1_F1, 0x6ED9EBA1U, SHA1_W(i + 4U));
+  }
+  for (i = 40U; i < 60U; i += 5U) {
+    SHA1_R(a, b, c, d, e, SHA1_F2, 0x8F1BBCDCU, SHA1_W(i + 0U));
+    SHA1_R(e, a, b, c, d, SHA1_F2, 0x8F1BBCDCU, SHA1_W(i + 1U));
+    SHA1_R(d, e, a, b, c, SHA1_F2, 0x8F1BBCDCU, SHA1_W(i + 2U));
+    SHA1_R(c, d, e, a, b, SHA1_F2, 0x8F1BBCDCU, SHA1_W(i + 3U));
+    SHA1_R(b, c, d, e, a, SHA1_F2, 0x8F1BBCDCU, SHA1_W(i + 4U));
+  }
+  for (i = 60U; i < 80U; i += 5U) {
+    SHA1_R(a, b, c, d, e, SHA1_F1, 0xCA62C1D6U, SHA1_W(i + 0U));
+    SHA1_R(e, a, b, c, d, SHA1_F1, 0xCA62C1D6U, SHA1_W(i + 1U));
+    SHA1_R(d, e, a, b, c, SHA1_F1, 0xCA62C1D6U, SHA1_W(i + 2U));
+    SHA1_R(c, d, e, a, b, SHA1_F1, 0xCA62C1D6U, SHA1_W(i + 3U));
+    SHA1_R(b, c, d, e, a, SHA1_F1, 0xCA62C1D6U, SHA1_W(i + 4U));
+  }
+
+  h[0] += a;
+  h[1] += b;
+  h[2] += c;
+  h[3] += d;
+  h[4] += e;
+}
+
+static void sha1_init(cry_sha1_state_t *sp) {
+
+  sp->h[0]   = 0x67452301U;
+  sp->h[1]   = 0xEFCDAB89U;
+  sp->h[2]   = 0x98BADCFEU;
+  sp->h[3]   = 0x10325476U;
+  sp->h[4]   = 0xC3D2E1F0U;
+  sp->length = 0U;
+}
+
+static void sha1_update(cry_sha1_state_t *sp, const uint8_t *p, size_t n) {
+  size_t used = (size_t)(sp->length & 63U);
+
+  sp->length += (uint64_t)n;
+
+  /* Completing a partial block.*/
+  if (used > 0U) {
+    size_t fill = 64U - used;
+
+    if (n < fill) {
+      memcpy(&sp->buf[used], p, n);
+      return;
+    }
+    memcpy(&sp->buf[used], p, fill);
+    sha1_compress(sp->h, sp->buf);
+    p += fill;
+    n -= fill;
+  }
+
+  /* Whole blocks are processed in place.*/
+  while (n >= 64U) {
+    sha1_compress(sp->h, p);
+    p += 64;
+    n -= 64U;
+  }
+  memcpy(sp->buf, p, n);
+}
+
+static void sha1_final(cry_sha1_state_t *sp, uint8_t *out) {
+  size_t used = (size_t)(sp->length & 63U);
+  unsigned i;
+
+  sp->buf[used++] = 0x80U;
+  if (used > 56U) {
+    memset(&sp->buf[used], 0, 64U - used);
+    sha1_compress(sp->h, sp->buf);
+    used = 0U;
+  }
+  memset(&sp->buf[used], 0, 56U - used);
+  put_u64_be(&sp->buf[56], sp->length * 8U);
+  sha1_compress(sp->h, sp->buf);
+
+  for (i = 0U; i < 5U; i++) {
+    put_u32_be(&out[i * 4U], sp->h[i]);
+  }
+}
+#endif /* CRY_LLD_SUPPORTS_SHA1 == FALSE */
+
+#if (CRY_FB_SHA256 == TRUE) || defined(__DOXYGEN__)
+#define SHA256_S0(x)        (ROR32(x, 2U) ^ ROR32(x, 13U) ^ ROR32(x, 22U))
+#define SHA256_S1(x)        (ROR32(x, 6U) ^ ROR32(x, 11U) ^ ROR32(x, 25U))
+#define SHA256_G0(x)        (ROR32(x, 7U) ^ ROR32(x, 18U) ^ ((x) >> 3))
+#define SHA256_G1(x)        (ROR32(x, 17U) ^ ROR32(x, 19U) ^ ((x) >> 10))
+
+#define SHA256_W(i)                                                         \
+  (w[(i) & 15U] += SHA256_G1(w[((i) + 14U) & 15U]) + w[((i) + 9U) & 15U] +  \
+                   SHA256_G0(w[((i) + 1U) & 15U]))
+
+#define SHA256_R(a, b, c, d, e, f, g, h, k, x) do {                         \
+  uint32_t t1 = (h) + SHA256_S1(e) + SHA_CH(e, f, g) + (k) + (x);        \
+  (d) += t1;                                                                \
+  (h) = t1 + SHA256_S0(a) + SHA_MAJ(a, b, c);                            \
+} while (false)
+
+static void sha256_compress(uint32_t *hp, const uint8_t *p) {
+  uint32_t a, b, c, d, e, f, g, h, w[16];
+  unsigned i;
+
+  for (i = 0U; i < 16U; i++) {
+    w[i] = get_u32_be(&p[i * 4U]);
+  }
+
+  a = hp[0];
+  b = hp[1];
+  c = hp[2];
+  d = hp[3];
+  e = hp[4];
+  f = hp[5];
+  g = hp[6];
+  h = hp[7];
+
+  for (i = 0U; i < 16U; i += 8U) {
+    SHA256_R(a, b, c, d, e, f, g, h, sha256_k[i + 0U], w[i + 0U]);
+    SHA256_R(h, a, b, c, d, e, f, g, sha256_k[i + 1U], w[i + 1U]);
+    SHA256_R(g, h, a, b, c, d, e, f, sha256_k[i + 2U], w[i + 2U]);
+    SHA256_R(f, g, h, a, b, c, d, e, sha256_k[i + 3U], w[i + 3U]);
+    SHA256_R(e, f, g, h, a, b, c, d, sha256_k[i + 4U], w[i + 4U]);
+    SHA256_R(d, e, f, g, h, a, b, c, sha256_k[i + 5U], w[i + 5U]);
+    SHA256_R(c, d, e, f, g, h, a, b, sha256_k[i + 6U], w[i + 6U]);
+    SHA256_R(b, c, d, e, f, g, h, a, sha256_k[i + 7U], w[i + 7U]);
+  }
+  for (i = 16U; i < 64U; i += 8U) {
+    SHA256_R(a, b, c, d, e, f, g, h, sha256_k[i + 0U], SHA256_W(i + 0U));
+    SHA256_R(h, a, b, c, d, e, f, g, sha256_k[i + 1U], SHA256_W(i + 1U));
+    SHA256_R(g, h, a, b, c, d, e, f, sha256_k[i + 2U], SHA256_W(i + 2U));
+    SHA256_R(f, g, h, a, b, c, d, e, sha256_k[i + 3U], SHA256_W(i + 3U));
+    SHA256_R(e, f, g, h, a, b, c, d, sha256_k[i + 4U], SHA256_W(i + 4U));
+    SHA256_R(d, e, f, g, h, a, b, c, sha256_k[i + 5U], SHA256_W(i + 5U));
+    SHA256_R(c, d, e, f, g, h, a, b, sha256_k[i + 6U], SHA256_W(i + 6U));
+    SHA256_R(b, c, d, e, f, g, h, a, sha256_k[i + 7U], SHA256_W(i + 7U));
+  }
+
+  hp[0] += a;
+  hp[1] += b;
+  hp[2] += c;
+  hp[3] += d;
+  hp[4] += e;
+  hp[5] += f;
+  hp[6] += g;
+  hp[7] += h;
+}
+
+static void sha256_init(cry_sha256_state_t *sp) {
+
+  sp->h[0]   = 0x6A09E667U;
+  sp->h[1]   = 0xBB67AE85U;
+  sp->h[2]   = 0x3C6EF372U;
+  sp->h[3]   = 0xA54FF53AU;
+  sp->h[4]   = 0x510E527FU;
+  sp->h[5]   = 0x9B05688CU;
+  sp->h[6]   = 0x1F83D9ABU;
+  sp->h[7]   = 0x5BE0CD19U;
+  sp->length = 0U;
+}
+
+static void sha256_update(cry_sha256_state_t *sp, const uint8_t *p,
+                          size_t n) {
+  size_t used = (size_t)(sp->length & 63U);
+
+  sp->length += (uint64_t)n;
+
+  /* Completing a partial block.*/
+  if (used > 0U) {
+    size_t fill = 64U - used;
+
+    if (n < fill) {
+      memcpy(&sp->buf[used], p, n);
+      return;
+    }
+    memcpy(&sp->buf[used], p, fill);
+    sha256_compress(sp->h, sp->buf);
+    p += fill;
+    n -= fill;
+  }
+
+  /* Whole blocks are processed in place.*/
+  while (n >= 64U) {
+    sha256_compress(sp->h, p);
+    p += 64;
+    n -= 64U;
+  }
+  memcpy(sp->buf, p, n);
+}
+
+static void sha256_final(cry_sha256_state_t *sp, uint8_t *out) {
+  size_t used = (size_t)(sp->length & 63U);
+  unsigned i;
+
+  sp->buf[used++] = 0x80U;
+  if (used > 56U) {
+    memset(&sp->buf[used], 0, 64U - used);
+    sha256_compress(sp->h, sp->buf);
+    used = 0U;
+  }
+  memset(&sp->buf[used], 0, 56U - used);
+  put_u64_be(&sp->buf[56], sp->length * 8U);
+  sha256_compress(sp->h, sp->buf);
+
+  for (i = 0U; i < 8U; i++) {
+    put_u32_be(&out[i * 4U], sp->h[i]);
+  }
+}
+#endif /* CRY_FB_SHA256 == TRUE */
+
+#if (CRY_FB_SHA512 == TRUE) || defined(__DOXYGEN__)
+#define SHA512_S0(x)        (ROR64(x, 28U) ^ ROR64(x, 34U) ^ ROR64(x, 39U))
+#define SHA512_S1(x)        (ROR64(x, 14U) ^ ROR64(x, 18U) ^ ROR64(x, 41U))
+#define SHA512_G0(x)        (ROR64(x, 1U) ^ ROR64(x, 8U) ^ ((x) >> 7))
+#define SHA512_G1(x)        (ROR64(x, 19U) ^ ROR64(x, 61U) ^ ((x) >> 6))
+
+#define SHA512_W(i)                                                         \
+  (w[(i) & 15U] += SHA512_G1(w[((i) + 14U) & 15U]) + w[((i) + 9U) & 15U] +  \
+                   SHA512_G0(w[((i) + 1U) & 15U]))
+
+#define SHA512_R(a, b, c, d, e, f, g, h, k, x) do {                         \
+  uint64_t t1 = (h) + SHA512_S1(e) + SHA_CH(e, f, g) + (k) + (x);        \
+  (d) += t1;                                                                \
+  (h) = t1 + SHA512_S0(a) + SHA_MAJ(a, b, c);                            \
+} while (false)
+
+static void sha512_compress(uint64_t *hp, const uint8_t *p) {
+  uint64_t a, b, c, d, e, f, g, h, w[16];
+  unsigned i;
+
+  for (i = 0U; i < 16U; i++) {
+    w[i] = get_u64_be(&p[i * 8U]);
+  }
+
+  a = hp[0];
+  b = hp[1];
+  c = hp[2];
+  d = hp[3];
+  e = hp[4];
+  f = hp[5];
+  g = hp[6];
+  h = hp[7];
+
+  for (i = 0U; i < 16U; i += 8U) {
+    SHA512_R(a, b, c, d, e, f, g, h, sha512_k[i + 0U], w[i + 0U]);
+    SHA512_R(h, a, b, c, d, e, f, g, sha512_k[i + 1U], w[i + 1U]);
+    SHA512_R(g, h, a, b, c, d, e, f, sha512_k[i + 2U], w[i + 2U]);
+    SHA512_R(f, g, h, a, b, c, d, e, sha512_k[i + 3U], w[i + 3U]);
+    SHA512_R(e, f, g, h, a, b, c, d, sha512_k[i + 4U], w[i + 4U]);
+    SHA512_R(d, e, f, g, h, a, b, c, sha512_k[i + 5U], w[i + 5U]);
+    SHA512_R(c, d, e, f, g, h, a, b, sha512_k[i + 6U], w[i + 6U]);
+    SHA512_R(b, c, d, e, f, g, h, a, sha512_k[i + 7U], w[i + 7U]);
+  }
+  for (i = 16U; i < 80U; i += 8U) {
+    SHA512_R(a, b, c, d, e, f, g, h, sha512_k[i + 0U], SHA512_W(i + 0U));
+    SHA512_R(h, a, b, c, d, e, f, g, sha512_k[i + 1U], SHA512_W(i + 1U));
+    SHA512_R(g, h, a, b, c, d, e, f, sha512_k[i + 2U], SHA512_W(i + 2U));
+    SHA512_R(f, g, h, a, b, c, d, e, sha512_k[i + 3U], SHA512_W(i + 3U));
+    SHA512_R(e, f, g, h, a, b, c, d, sha512_k[i + 4U], SHA512_W(i + 4U));
+    SHA512_R(d, e, f, g, h, a, b, c, sha512_k[i + 5U], SHA512_W(i + 5U));
+    SHA512_R(c, d, e, f, g, h, a, b, sha512_k[i + 6U], SHA512_W(i + 6U));
+    SHA512_R(b, c, d, e, f, g, h, a, sha512_k[i + 7U], SHA512_W(i + 7U));
+  }
+
+  hp[0] += a;
+  hp[1] += b;
+  hp[2] += c;
+  hp[3] += d;
+  hp[4] += e;
+  hp[5] += f;
+  hp[6] += g;
+  hp[7] += h;
+}
+
+static void sha512_init(cry_sha512_state_t *sp) {
+
+  sp->h[0]   = 0x6A09E667F3BCC908U;
+  sp->h[1]   = 0xBB67AE8584CAA73BU;
+  sp->h[2]   = 0x3C6EF372FE94F82BU;
+  sp->h[3]   = 0xA54FF53A5F1D36F1U;
+  sp->h[4]   = 0x510E527FADE682D1U;
+  sp->h[5]   = 0x9B05688C2B3E6C1FU;
+  sp->h[6]   = 0x1F83D9ABFB41BD6BU;
+  sp->h[7]   = 0x5BE0CD19137E2179U;
+  sp->length = 0U;
+}
+
+static void sha512_update(cry_sha512_state_t *sp, const uint8_t *p,
+                          size_t n) {
+  size_t used = (size_t)(sp->length & 127U);
+
+  sp->length += (uint64_t)n;
+
+  /* Completing a partial block.*/
+  if (used > 0U) {
+    size_t fill = 128U - used;
+
+    if (n < fill) {
+      memcpy(&sp->buf[used], p, n);
+      return;
+    }
+    memcpy(&sp->buf[used], p, fill);
+    sha512_compress(sp->h, sp->buf);
+    p += fill;
+    n -= fill;
+  }
+
+  /* Whole blocks are processed in place.*/
+  while (n >= 128U) {
+    sha512_compress(sp->h, p);
+    p += 128;
+    n -= 128U;
+  }
+  memcpy(sp->buf, p, n);
+}
+
+static void sha512_final(cry_sha512_state_t *sp, uint8_t *out) {
+  size_t used = (size_t)(sp->length & 127U);
+  unsigned i;
+
+  sp->buf[used++] = 0x80U;
+  if (used > 112U) {
+    memset(&sp->buf[used], 0, 128U - used);
+    sha512_compress(sp->h, sp->buf);
+    used = 0U;
+  }
+  memset(&sp->buf[used], 0, 120U - used);
+  put_u64_be(&sp->buf[120], sp->length * 8U);
+  sha512_compress(sp->h, sp->buf);
+
+  for (i = 0U; i < 8U; i++) {
+    put_u64_be(&out[i * 8U], sp->h[i]);
+  }
+}
+#endif /* CRY_FB_SHA512 == TRUE */
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+#if (CRY_LLD_SUPPORTS_AES == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes the AES transient key.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] size              key size in bytes
+ * @param[in] keyp              pointer to the key data
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_SIZE if the size of the key is not 16, 24 or 32.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_aes_loadkey(CRYDriver *cryp,
+                                    size_t size,
+                                    const uint8_t *keyp) {
+
+  if ((size != 16U) && (size != 24U) && (size != 32U)) {
+    return CRY_ERR_INV_KEY_SIZE;
+  }
+
+  aes_expand_key(&cryp->fb_aes_key, keyp, size);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Encryption of a single block using AES.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES(CRYDriver *cryp,
+                                    crykey_t key_id,
+                                    const uint8_t *in,
+                                    uint8_t *out) {
+  cryerror_t err;
+
+  err = aes_check_key(cryp, key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  return aes_encrypt(cryp, key_id, in, out);
+}
+
+/**
+ * @brief   Decryption of a single block using AES.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES(CRYDriver *cryp,
+                                    crykey_t key_id,
+                                    const uint8_t *in,
+                                    uint8_t *out) {
+  cryerror_t err;
+
+  err = aes_check_key(cryp, key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  return aes_decrypt(cryp, key_id, in, out);
+}
+#endif /* CRY_LLD_SUPPORTS_AES == FALSE */
+
+#if (CRY_LLD_SUPPORTS_AES_ECB == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption operation using AES-ECB.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers, this number must be a
+ *                              multiple of 16
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_ECB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out) {
+  cryerror_t err;
+
+  err = aes_check_key(cryp, key_id);
+  while ((err == CRY_NOERROR) && (size >= 16U)) {
+    err = aes_encrypt(cryp, key_id, in, out);
+    in   += 16;
+    out  += 16;
+    size -= 16U;
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Decryption operation using AES-ECB.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers, this number must be a
+ *                              multiple of 16
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_ECB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out) {
+  cryerror_t err;
+
+  err = aes_check_key(cryp, key_id);
+  while ((err == CRY_NOERROR) && (size >= 16U)) {
+    err = aes_decrypt(cryp, key_id, in, out);
+    in   += 16;
+    out  += 16;
+    size -= 16U;
+  }
+
+  return err;
+}
+#endif /* CRY_LLD_SUPPORTS_AES_ECB == FALSE */
+
+#if (CRY_LLD_SUPPORTS_AES_CBC == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption operation using AES-CBC.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers, this number must be a
+ *                              multiple of 16
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @param[in] iv                128 bits initial vector
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_CBC(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  uint8_t buf[16];
+  cryerror_t err;
+
+  err = aes_check_key(cryp, key_id);
+  while ((err == CRY_NOERROR) && (size >= 16U)) {
+    xor_block(buf, in, iv);
+    err = aes_encrypt(cryp, key_id, buf, out);
+    iv    = out;
+    in   += 16;
+    out  += 16;
+    size -= 16U;
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Decryption operation using AES-CBC.
+ * @note    The operation can be performed in place.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers, this number must be a
+ *                              multiple of 16
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @param[in] iv                128 bits initial vector
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_CBC(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  uint8_t chain[16], buf[16];
+  cryerror_t err;
+
+  memcpy(chain, iv, 16U);
+  err = aes_check_key(cryp, key_id);
+  while ((err == CRY_NOERROR) && (size >= 16U)) {
+    err = aes_decrypt(cryp, key_id, in, buf);
+    xor_block(buf, buf, chain);
+    memcpy(chain, in, 16U);
+    memcpy(out, buf, 16U);
+    in   += 16;
+    out  += 16;
+    size -= 16U;
+  }
+
+  return err;
+}
+#endif /* CRY_LLD_SUPPORTS_AES_CBC == FALSE */
+
+#if (CRY_LLD_SUPPORTS_AES_CFB == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption operation using AES-CFB.
+ * @note    This is a stream cipher, there are no size restrictions.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @param[in] iv                128 bits initial vector
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_CFB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  uint8_t ks[16];
+  cryerror_t err;
+  size_t i, n;
+
+  err = aes_check_key(cryp, key_id);
+  while ((err == CRY_NOERROR) && (size > 0U)) {
+    err = aes_encrypt(cryp, key_id, iv, ks);
+    n = size < 16U ? size : 16U;
+    for (i = 0U; i < n; i++) {
+      out[i] = in[i] ^ ks[i];
+    }
+    iv    = out;
+    in   += n;
+    out  += n;
+    size -= n;
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Decryption operation using AES-CFB.
+ * @note    This is a stream cipher, there are no size restrictions.
+ * @note    The operation can be performed in place.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @param[in] iv                128 bits initial vector
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_CFB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  uint8_t chain[16], ks[16];
+  cryerror_t err;
+  size_t i, n;
+
+  memcpy(chain, iv, 16U);
+  err = aes_check_key(cryp, key_id);
+  while ((err == CRY_NOERROR) && (size > 0U)) {
+    err = aes_encrypt(cryp, key_id, chain, ks);
+    n = size < 16U ? size : 16U;
+    for (i = 0U; i < n; i++) {
+      chain[i] = in[i];
+      out[i]   = in[i] ^ ks[i];
+    }
+    in   += n;
+    out  += n;
+    size -= n;
+  }
+
+  return err;
+}
+#endif /* CRY_LLD_SUPPORTS_AES_CFB == FALSE */
+
+#if (CRY_LLD_SUPPORTS_AES_CTR == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption operation using AES-CTR.
+ * @note    This is a stream cipher, there are no size restrictions.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @param[in] iv                128 bits initial vector + counter, it contains
+ *                              a 96 bits IV and a 32 bits counter
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_CTR(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  uint8_t ctr[16];
+  cryerror_t err;
+
+  err = aes_check_key(cryp, key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  memcpy(ctr, iv, 16U);
+
+  return ctr_crypt(cryp, key_id, ctr, size, in, out);
+}
+
+/**
+ * @brief   Decryption operation using AES-CTR.
+ * @note    This is a stream cipher, there are no size restrictions.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @param[in] iv                128 bits initial vector + counter, it contains
+ *                              a 96 bits IV and a 32 bits counter
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_CTR(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+
+  return cry_fallback_encrypt_AES_CTR(cryp, key_id, size, in, out, iv);
+}
+#endif /* CRY_LLD_SUPPORTS_AES_CTR == FALSE */
+
+#if (CRY_LLD_SUPPORTS_AES_GCM == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption operation using AES-GCM.
+ * @note    This is a stream cipher, there are no size restrictions.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] auth_size         size of the data buffer to be authenticated
+ * @param[in] auth_in           buffer containing the data to be authenticated
+ * @param[in] text_size         size of the text buffer
+ * @param[in] text_in           buffer containing the input plaintext
+ * @param[out] text_out         buffer for the output ciphertext
+ * @param[in] iv                128 bits input vector, the first 96 bits are
+ *                              the GCM IV, the counter part is ignored
+ * @param[in] tag_size          size of the authentication tag, this number
+ *                              must be between 1 and 16
+ * @param[out] tag_out          buffer for the generated authentication tag
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_GCM(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t auth_size,
+                                        const uint8_t *auth_in,
+                                        size_t text_size,
+                                        const uint8_t *text_in,
+                                        uint8_t *text_out,
+                                        const uint8_t *iv,
+                                        size_t tag_size,
+                                        uint8_t *tag_out) {
+  uint8_t ctr[16], tag[16];
+  cryerror_t err;
+
+  err = aes_check_key(cryp, key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  /* Encryption starts from the counter block following J0.*/
+  memcpy(ctr, iv, 12U);
+  put_u32_be(&ctr[12], 2U);
+  err = ctr_crypt(cryp, key_id, ctr, text_size, text_in, text_out);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  err = gcm_tag(cryp, key_id, auth_size, auth_in, text_size, text_out,
+                iv, ctr, tag);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+  memcpy(tag_out, tag, tag_size);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Decryption operation using AES-GCM.
+ * @note    This is a stream cipher, there are no size restrictions.
+ * @note    The tag is verified before decrypting, the output buffer is
+ *          not written if the authentication fails.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] auth_size         size of the data buffer to be authenticated
+ * @param[in] auth_in           buffer containing the data to be authenticated
+ * @param[in] text_size         size of the text buffer
+ * @param[in] text_in           buffer containing the input ciphertext
+ * @param[out] text_out         buffer for the output plaintext
+ * @param[in] iv                128 bits input vector, the first 96 bits are
+ *                              the GCM IV, the counter part is ignored
+ * @param[in] tag_size          size of the authentication tag, this number
+ *                              must be between 1 and 16
+ * @param[in] tag_in            buffer for the authentication tag
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ * @retval CRY_ERR_AUTH_FAILED  authentication failed.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_GCM(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t auth_size,
+                                        const uint8_t *auth_in,
+                                        size_t text_size,
+                                        const uint8_t *text_in,
+                                        uint8_t *text_out,
+                                        const uint8_t *iv,
+                                        size_t tag_size,
+                                        const uint8_t *tag_in) {
+  uint8_t ctr[16], tag[16], diff;
+  cryerror_t err;
+  size_t i;
+
+  err = aes_check_key(cryp, key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  err = gcm_tag(cryp, key_id, auth_size, auth_in, text_size, text_in,
+                iv, ctr, tag);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  /* Constant time comparison.*/
+  diff = 0U;
+  for (i = 0U; i < tag_size; i++) {
+    diff |= tag[i] ^ tag_in[i];
+  }
+  if (diff != 0U) {
+    return CRY_ERR_AUTH_FAILED;
+  }
+
+  ctr_inc32(ctr);
+
+  return ctr_crypt(cryp, key_id, ctr, text_size, text_in, text_out);
+}
+#endif /* CRY_LLD_SUPPORTS_AES_GCM == FALSE */
+
+#if (CRY_LLD_SUPPORTS_DES == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes the DES transient key.
+ * @note    Not supported by the fall-back.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] size              key size in bytes
+ * @param[in] keyp              pointer to the key data
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the algorithm is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_des_loadkey(CRYDriver *cryp,
+                                    size_t size,
+                                    const uint8_t *keyp) {
+
+  (void)cryp;
+  (void)size;
+  (void)keyp;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Encryption of a single block using (T)DES.
+ * @note    Not supported by the fall-back.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_DES(CRYDriver *cryp,
+                                    crykey_t key_id,
+                                    const uint8_t *in,
+                                    uint8_t *out) {
+
+  (void)cryp;
+  (void)key_id;
+  (void)in;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Decryption of a single block using (T)DES.
+ * @note    Not supported by the fall-back.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_DES(CRYDriver *cryp,
+                                    crykey_t key_id,
+                                    const uint8_t *in,
+                                    uint8_t *out) {
+
+  (void)cryp;
+  (void)key_id;
+  (void)in;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+#endif /* CRY_LLD_SUPPORTS_DES == FALSE */
+
+#if (CRY_LLD_SUPPORTS_DES_ECB == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption operation using (T)DES-ECB.
+ * @note    Not supported by the fall-back.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_DES_ECB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out) {
+
+  (void)cryp;
+  (void)key_id;
+  (void)size;
+  (void)in;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Decryption operation using (T)DES-ECB.
+ * @note    Not supported by the fall-back.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_DES_ECB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out) {
+
+  (void)cryp;
+  (void)key_id;
+  (void)size;
+  (void)in;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+#endif /* CRY_LLD_SUPPORTS_DES_ECB == FALSE */
+
+#if (CRY_LLD_SUPPORTS_DES_CBC == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption operation using (T)DES-CBC.
+ * @note    Not supported by the fall-back.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @param[in] iv                64 bits input vector
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_DES_CBC(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+
+  (void)cryp;
+  (void)key_id;
+  (void)size;
+  (void)in;
+  (void)out;
+  (void)iv;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Decryption operation using (T)DES-CBC.
+ * @note    Not supported by the fall-back.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @param[in] iv                64 bits input vector
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_DES_CBC(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+
+  (void)cryp;
+  (void)key_id;
+  (void)size;
+  (void)in;
+  (void)out;
+  (void)iv;
+
+  return CRY_ERR_INV_ALGO;
+}
+#endif /* CRY_LLD_SUPPORTS_DES_CBC == FALSE */
+
+#if (CRY_LLD_SUPPORTS_SHA1 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Hash initialization using SHA1.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[out] sha1ctxp         pointer to a SHA1 context to be initialized
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA1_init(CRYDriver *cryp, SHA1Context *sha1ctxp) {
+
+  (void)cryp;
+
+  sha1_init(&sha1ctxp->sha);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using SHA1.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] sha1ctxp          pointer to a SHA1 context
+ * @param[in] size              size of input buffer
+ * @param[in] in                buffer containing the input text
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA1_update(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                                    size_t size, const uint8_t *in) {
+
+  (void)cryp;
+
+  sha1_update(&sha1ctxp->sha, in, size);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using SHA1.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] sha1ctxp          pointer to a SHA1 context
+ * @param[out] out              320 bits output buffer
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA1_final(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                                   uint8_t *out) {
+
+  (void)cryp;
+
+  sha1_final(&sha1ctxp->sha, out);
+
+  return CRY_NOERROR;
+}
+#endif /* CRY_LLD_SUPPORTS_SHA1 == FALSE */
+
+#if (CRY_LLD_SUPPORTS_SHA256 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Hash initialization using SHA256.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[out] sha256ctxp       pointer to a SHA256 context to be initialized
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA256_init(CRYDriver *cryp,
+                                    SHA256Context *sha256ctxp) {
+
+  (void)cryp;
+
+  sha256_init(&sha256ctxp->sha);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using SHA256.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] sha256ctxp        pointer to a SHA256 context
+ * @param[in] size              size of input buffer
+ * @param[in] in                buffer containing the input text
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA256_update(CRYDriver *cryp,
+                                      SHA256Context *sha256ctxp,
+                                      size_t size, const uint8_t *in) {
+
+  (void)cryp;
+
+  sha256_update(&sha256ctxp->sha, in, size);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using SHA256.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] sha256ctxp        pointer to a SHA256 context
+ * @param[out] out              256 bits output buffer
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA256_final(CRYDriver *cryp,
+                                     SHA256Context *sha256ctxp,
+                                     uint8_t *out) {
+
+  (void)cryp;
+
+  sha256_final(&sha256ctxp->sha, out);
+
+  return CRY_NOERROR;
+}
+#endif /* CRY_LLD_SUPPORTS_SHA256 == FALSE */
+
+#if (CRY_LLD_SUPPORTS_SHA512 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Hash initialization using SHA512.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[out] sha512ctxp       pointer to a SHA512 context to be initialized
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA512_init(CRYDriver *cryp,
+                                    SHA512Context *sha512ctxp) {
+
+  (void)cryp;
+
+  sha512_init(&sha512ctxp->sha);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using SHA512.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] sha512ctxp        pointer to a SHA512 context
+ * @param[in] size              size of input buffer
+ * @param[in] in                buffer containing the input text
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA512_update(CRYDriver *cryp,
+                                      SHA512Context *sha512ctxp,
+                                      size_t size, const uint8_t *in) {
+
+  (void)cryp;
+
+  sha512_update(&sha512ctxp->sha, in, size);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using SHA512.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] sha512ctxp        pointer to a SHA512 context
+ * @param[out] out              512 bits output buffer
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA512_final(CRYDriver *cryp,
+                                     SHA512Context *sha512ctxp,
+                                     uint8_t *out) {
+
+  (void)cryp;
+
+  sha512_final(&sha512ctxp->sha, out);
+
+  return CRY_NOERROR;
+}
+#endif /* CRY_LLD_SUPPORTS_SHA512 == FALSE */
+
+#if ((CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE) &&                             \
+     (CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE)) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes the HMAC transient key.
+ * @note    Keys up to @p CRY_FALLBACK_HMAC_MAX_KEY_SIZE bytes are accepted,
+ *          keys longer than the hash block size are hashed when a HMAC
+ *          operation is initialized.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] size              key size in bytes
+ * @param[in] keyp              pointer to the key data
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_SIZE if the specified key size is invalid for
+ *                              the specified algorithm.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_hmac_loadkey(CRYDriver *cryp,
+                                     size_t size,
+                                     const uint8_t *keyp) {
+
+  if (size > (size_t)CRY_FALLBACK_HMAC_MAX_KEY_SIZE) {
+    return CRY_ERR_INV_KEY_SIZE;
+  }
+
+  memcpy(cryp->fb_hmac_key.buf, keyp, size);
+  cryp->fb_hmac_key.size   = size;
+  cryp->fb_hmac_key.loaded = true;
+
+  return CRY_NOERROR;
+}
+#endif
+
+#if (CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Hash initialization using HMAC_SHA256.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[out] hmacsha256ctxp   pointer to a HMAC_SHA256 context to be
+ *                              initialized
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if no HMAC key has been loaded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_HMACSHA256_init(CRYDriver *cryp,
+                                        HMACSHA256Context *hmacsha256ctxp) {
+  const cry_fallback_hmac_key_t *kp = &cryp->fb_hmac_key;
+  uint8_t pad[64];
+  size_t i;
+
+  if (!kp->loaded) {
+    return CRY_ERR_INV_KEY_ID;
+  }
+
+  /* Keys longer than the block size are replaced by their digest.*/
+  memset(pad, 0, sizeof (pad));
+  if (kp->size > sizeof (pad)) {
+    sha256_init(&hmacsha256ctxp->inner);
+    sha256_update(&hmacsha256ctxp->inner, kp->buf, kp->size);
+    sha256_final(&hmacsha256ctxp->inner, pad);
+  }
+  else {
+    memcpy(pad, kp->buf, kp->size);
+  }
+
+  for (i = 0U; i < sizeof (pad); i++) {
+    pad[i] ^= 0x36U;
+  }
+  sha256_init(&hmacsha256ctxp->inner);
+  sha256_update(&hmacsha256ctxp->inner, pad, sizeof (pad));
+
+  for (i = 0U; i < sizeof (pad); i++) {
+    pad[i] ^= 0x36U ^ 0x5CU;
+  }
+  sha256_init(&hmacsha256ctxp->outer);
+  sha256_update(&hmacsha256ctxp->outer, pad, sizeof (pad));
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using HMAC.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] hmacsha256ctxp    pointer to a HMAC_SHA256 context
+ * @param[in] size              size of input buffer
+ * @param[in] in                buffer containing the input text
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_HMACSHA256_update(CRYDriver *cryp,
+                                          HMACSHA256Context *hmacsha256ctxp,
+                                          size_t size, const uint8_t *in) {
+
+  (void)cryp;
+
+  sha256_update(&hmacsha256ctxp->inner, in, size);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using HMAC.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] hmacsha256ctxp    pointer to a HMAC_SHA256 context
+ * @param[out] out              256 bits output buffer
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_HMACSHA256_final(CRYDriver *cryp,
+                                         HMACSHA256Context *hmacsha256ctxp,
+                                         uint8_t *out) {
+  uint8_t digest[32];
+
+  (void)cryp;
+
+  sha256_final(&hmacsha256ctxp->inner, digest);
+  sha256_update(&hmacsha256ctxp->outer, digest, sizeof (digest));
+  sha256_final(&hmacsha256ctxp->outer, out);
+
+  return CRY_NOERROR;
+}
+#endif /* CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE */
+
+#if (CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Hash initialization using HMAC_SHA512.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[out] hmacsha512ctxp   pointer to a HMAC_SHA512 context to be
+ *                              initialized
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if no HMAC key has been loaded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_HMACSHA512_init(CRYDriver *cryp,
+                                        HMACSHA512Context *hmacsha512ctxp) {
+  const cry_fallback_hmac_key_t *kp = &cryp->fb_hmac_key;
+  uint8_t pad[128];
+  size_t i;
+
+  if (!kp->loaded) {
+    return CRY_ERR_INV_KEY_ID;
+  }
+
+  /* The maximum key size is the block size, keys are never hashed.*/
+  memset(pad, 0, sizeof (pad));
+  memcpy(pad, kp->buf, kp->size);
+
+  for (i = 0U; i < sizeof (pad); i++) {
+    pad[i] ^= 0x36U;
+  }
+  sha512_init(&hmacsha512ctxp->inner);
+  sha512_update(&hmacsha512ctxp->inner, pad, sizeof (pad));
+
+  for (i = 0U; i < sizeof (pad); i++) {
+    pad[i] ^= 0x36U ^ 0x5CU;
+  }
+  sha512_init(&hmacsha512ctxp->outer);
+  sha512_update(&hmacsha512ctxp->outer, pad, sizeof (pad));
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using HMAC.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] hmacsha512ctxp    pointer to a HMAC_SHA512 context
+ * @param[in] size              size of input buffer
+ * @param[in] in                buffer containing the input text
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_HMACSHA512_update(CRYDriver *cryp,
+                                          HMACSHA512Context *hmacsha512ctxp,
+                                          size_t size, const uint8_t *in) {
+
+  (void)cryp;
+
+  sha512_update(&hmacsha512ctxp->inner, in, size);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using HMAC.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] hmacsha512ctxp    pointer to a HMAC_SHA512 context
+ * @param[out] out              512 bits output buffer
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_HMACSHA512_final(CRYDriver *cryp,
+                                         HMACSHA512Context *hmacsha512ctxp,
+                                         uint8_t *out) {
+  uint8_t digest[64];
+
+  (void)cryp;
+
+  sha512_final(&hmacsha512ctxp->inner, digest);
+  sha512_update(&hmacsha512ctxp->outer, digest, sizeof (digest));
+  sha512_final(&hmacsha512ctxp->outer, out);
+
+  return CRY_NOERROR;
+}
+#endif /* CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE */
+
+#endif /* (HAL_USE_CRY == TRUE) && (HAL_CRY_USE_FALLBACK == TRUE) */
+
+/** @} */
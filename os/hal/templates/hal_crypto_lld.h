@@ -107,6 +107,21 @@ struct CRYDriver {
    * @brief   Current configuration data.
    */
   const CRYConfig           *config;
+#if (HAL_CRY_USE_FALLBACK == TRUE) || defined(__DOXYGEN__)
+#if (CRY_LLD_SUPPORTS_AES == FALSE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Fall-back AES transient key.
+   */
+  cry_fallback_aes_key_t    fb_aes_key;
+#endif
+#if (CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE) ||                              \
+    (CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Fall-back HMAC transient key.
+   */
+  cry_fallback_hmac_key_t   fb_hmac_key;
+#endif
+#endif
 #if defined(CRY_DRIVER_EXT_FIELDS)
   CRY_DRIVER_EXT_FIELDS
 #endif
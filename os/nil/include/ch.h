@@ -546,6 +546,11 @@ struct nil_thread {
 #endif
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || defined(__DOXYGEN__)
   stkalign_t            *wabase;    /**< @brief Thread stack boundary.      */
+#endif
+#if (defined(CH_CFG_USE_JOB_POOLS) && (CH_CFG_USE_JOB_POOLS == TRUE)) ||   \
+    defined(__DOXYGEN__)
+  struct ch_job_worker  *worker;    /**< @brief Job pool worker served by
+                                                this thread or @p NULL.     */
 #endif
   /* Optional extra fields.*/
   CH_CFG_THREAD_EXT_FIELDS
@@ -1241,7 +1246,7 @@ struct nil_os_instance {
  *
  * @iclass
  */
-#define chThdQueueIsEmptyI(tqp) ((bool)(tqp->cnt >= (cnt_t)0))
+#define chThdQueueIsEmptyI(tqp) ((bool)((tqp)->cnt >= (cnt_t)0))
 
 /**
  * @brief   Current system time.
@@ -1443,6 +1448,82 @@ extern "C" {
 }
 #endif
 
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#if !defined(port_ctz32) || defined(__DOXYGEN__)
+/**
+ * @brief   Count of trailing zeros of a non-zero 32 bits word.
+ * @note    Portable implementation used when the port layer does not
+ *          provide a @p port_ctz32() macro.
+ *
+ * @param[in] x         the word, it must not be zero
+ * @return              The number of trailing zero bits.
+ */
+static inline unsigned port_ctz32(uint32_t x) {
+  unsigned n = 0U;
+
+  if ((x & 0x0000FFFFU) == 0U) {
+    n += 16U;
+    x >>= 16;
+  }
+  if ((x & 0x000000FFU) == 0U) {
+    n += 8U;
+    x >>= 8;
+  }
+  if ((x & 0x0000000FU) == 0U) {
+    n += 4U;
+    x >>= 4;
+  }
+  if ((x & 0x00000003U) == 0U) {
+    n += 2U;
+    x >>= 2;
+  }
+  if ((x & 0x00000001U) == 0U) {
+    n += 1U;
+  }
+
+  return n;
+}
+#endif
+
+#if !defined(port_clz32) || defined(__DOXYGEN__)
+/**
+ * @brief   Count of leading zeros of a non-zero 32 bits word.
+ * @note    Portable implementation used when the port layer does not
+ *          provide a @p port_clz32() macro.
+ *
+ * @param[in] x         the word, it must not be zero
+ * @return              The number of leading zero bits.
+ */
+static inline unsigned port_clz32(uint32_t x) {
+  unsigned n = 0U;
+
+  if ((x & 0xFFFF0000U) == 0U) {
+    n += 16U;
+    x <<= 16;
+  }
+  if ((x & 0xFF000000U) == 0U) {
+    n += 8U;
+    x <<= 8;
+  }
+  if ((x & 0xF0000000U) == 0U) {
+    n += 4U;
+    x <<= 4;
+  }
+  if ((x & 0xC0000000U) == 0U) {
+    n += 2U;
+    x <<= 2;
+  }
+  if ((x & 0x80000000U) == 0U) {
+    n += 1U;
+  }
+
+  return n;
+}
+#endif
+
 /* Optional modules.*/
 #include "chsem.h"
 #include "chevt.h"
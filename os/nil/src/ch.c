@@ -783,6 +783,9 @@ thread_t *chThdCreateI(const thread_descriptor_t *tdp) {
 #if CH_DBG_ENABLE_STACK_CHECK == TRUE
   tp->wabase = (stkalign_t *)tdp->wbase;
 #endif
+#if defined(CH_CFG_USE_JOB_POOLS) && (CH_CFG_USE_JOB_POOLS == TRUE)
+  tp->worker = NULL;
+#endif
 
   /* Port dependent thread initialization.*/
   PORT_SETUP_CONTEXT(tp, tdp->wbase, tdp->wend, tdp->funcp, tdp->arg);
@@ -88,6 +88,20 @@
 #define CH_CFG_FACTORY_PIPES                TRUE
 #endif
 
+/**
+ * @brief   Size of the names hash index of each objects list.
+ * @details If non-zero then each objects list keeps an open addressing
+ *          hash index of the objects names, lookups by name become
+ *          constant time operations regardless of the number of objects.
+ *          Objects exceeding the index capacity are still found by
+ *          scanning the list.
+ * @note    The value must be zero or a power of two.
+ * @note    The default is zero, names lookups scan the lists.
+ */
+#if !defined(CH_CFG_FACTORY_HASH_SIZE) || defined(__DOXYGEN__)
+#define CH_CFG_FACTORY_HASH_SIZE            0
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -135,6 +149,11 @@
 #error "invalid CH_CFG_FACTORY_MAX_NAMES_LENGTH value"
 #endif
 
+#if (CH_CFG_FACTORY_HASH_SIZE < 0) ||                                       \
+    ((CH_CFG_FACTORY_HASH_SIZE & (CH_CFG_FACTORY_HASH_SIZE - 1)) != 0)
+#error "CH_CFG_FACTORY_HASH_SIZE must be zero or a power of two"
+#endif
+
 #if (CH_CFG_USE_MUTEXES == FALSE) && (CH_CFG_USE_SEMAPHORES == FALSE)
 #error "CH_CFG_USE_FACTORY requires CH_CFG_USE_MUTEXES and/or CH_CFG_USE_SEMAPHORES"
 #endif
@@ -179,6 +198,20 @@ typedef struct ch_dyn_element {
  */
 typedef struct ch_dyn_list {
     dyn_element_t       *next;
+#if (CH_CFG_FACTORY_HASH_SIZE > 0) || defined(__DOXYGEN__)
+    /**
+     * @brief   Names hash index, linear probing.
+     */
+    void                *index[CH_CFG_FACTORY_HASH_SIZE];
+    /**
+     * @brief   Number of objects in the index.
+     */
+    unsigned            indexed;
+    /**
+     * @brief   Number of objects not fitting the index.
+     */
+    unsigned            unindexed;
+#endif
 } dyn_list_t;
 
 #if (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE) || defined(__DOXYGEN__)
@@ -0,0 +1,195 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation version 3 of the License.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/include/chhash.h
+ * @brief   Names hash index header.
+ * @details Open addressing hash index with linear probing, used for
+ *          lookups of named objects. The index is an array of pointers to
+ *          the indexed elements, its size must be a power of two. Elements
+ *          are located by hashing their names, the functions in this module
+ *          are not aware of the elements type, the home slot of an element
+ *          is obtained through a caller-provided function.
+ *
+ * @addtogroup oslib_hash
+ * @{
+ */
+
+#ifndef CHHASH_H
+#define CHHASH_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Hashes the whole name.
+ */
+#define CH_HASH_NAME_UNBOUNDED      (~0U)
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a function returning the home slot of an indexed
+ *          element.
+ */
+typedef unsigned (*ch_hash_home_t)(const void *p);
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the home slot of a name.
+ * @details The FNV-1a hash of the first @p n characters of the name is
+ *          masked with the index size.
+ *
+ * @param[in] name      name to be hashed
+ * @param[in] n         maximum number of characters to be hashed or
+ *                      @p CH_HASH_NAME_UNBOUNDED
+ * @param[in] mask      index size minus one
+ * @return              The home slot.
+ *
+ * @notapi
+ */
+static inline unsigned ch_hash_name(const char *name, unsigned n,
+                                    unsigned mask) {
+  uint32_t h = 2166136261U;
+
+  while ((n > 0U) && (*name != (char)0)) {
+    h = (h ^ (uint32_t)(uint8_t)*name) * 16777619U;
+    name++;
+    n--;
+  }
+
+  return (unsigned)h & mask;
+}
+
+/**
+ * @brief   Inserts an element in the index.
+ * @pre     The index must have at least two empty slots, one slot is always
+ *          left empty in order to terminate the probes.
+ *
+ * @param[in] index     pointer to the index slots
+ * @param[in] mask      index size minus one
+ * @param[in] home      home slot of the element
+ * @param[in] p         element to be inserted
+ *
+ * @notapi
+ */
+static inline void ch_hash_insert(void **index, unsigned mask,
+                                  unsigned home, void *p) {
+
+  while (index[home] != NULL) {
+    home = (home + 1U) & mask;
+  }
+  index[home] = p;
+}
+
+/**
+ * @brief   Checks if an element is in the index.
+ *
+ * @param[in] index     pointer to the index slots
+ * @param[in] mask      index size minus one
+ * @param[in] home      home slot of the element
+ * @param[in] p         element to be searched
+ * @return              The search result.
+ * @retval true         if the element is in the index.
+ * @retval false        if the element is not in the index.
+ *
+ * @notapi
+ */
+static inline bool ch_hash_contains(void * const *index, unsigned mask,
+                                    unsigned home, const void *p) {
+
+  while (index[home] != NULL) {
+    if (index[home] == p) {
+      return true;
+    }
+    home = (home + 1U) & mask;
+  }
+
+  return false;
+}
+
+/**
+ * @brief   Removes an element from the index.
+ * @details Backward shift deletion, the following elements of the cluster
+ *          are moved into the hole unless their home slot lies after it,
+ *          no tombstones are left in the index.
+ *
+ * @param[in] index     pointer to the index slots
+ * @param[in] mask      index size minus one
+ * @param[in] home      home slot of the element
+ * @param[in] p         element to be removed
+ * @param[in] homef     function returning the home slot of an element
+ * @return              The operation result.
+ * @retval true         if the element has been removed.
+ * @retval false        if the element was not in the index.
+ *
+ * @notapi
+ */
+static inline bool ch_hash_remove(void **index, unsigned mask,
+                                  unsigned home, const void *p,
+                                  ch_hash_home_t homef) {
+  unsigned i, j, k;
+
+  i = home;
+  while (index[i] != p) {
+    if (index[i] == NULL) {
+      return false;
+    }
+    i = (i + 1U) & mask;
+  }
+
+  j = i;
+  while (true) {
+    index[i] = NULL;
+    do {
+      j = (j + 1U) & mask;
+      if (index[j] == NULL) {
+        return true;
+      }
+      k = homef(index[j]);
+    } while ((i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j)));
+    index[i] = index[j];
+    i = j;
+  }
+}
+
+#endif /* CHHASH_H */
+
+/** @} */
@@ -0,0 +1,319 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation version 3 of the License.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/include/chjobpools.h
+ * @brief   Job Pools structures and macros.
+ *
+ * @addtogroup oslib_job_pools
+ * @{
+ */
+
+#ifndef CHJOBPOOLS_H
+#define CHJOBPOOLS_H
+
+/**
+ * @brief   Job Pools APIs.
+ * @details If enabled then the work-stealing job pools APIs are included
+ *          in the kernel.
+ */
+#if !defined(CH_CFG_USE_JOB_POOLS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_JOB_POOLS                FALSE
+#endif
+
+#if (CH_CFG_USE_JOB_POOLS == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the jobs deque of each worker.
+ * @details Jobs submitted by a worker exceeding the deque capacity are
+ *          queued in the pool shared queue.
+ * @note    The value must be a power of two greater than one.
+ */
+#if !defined(CH_CFG_JOB_POOLS_DEQUE_SIZE) || defined(__DOXYGEN__)
+#define CH_CFG_JOB_POOLS_DEQUE_SIZE         16
+#endif
+
+/**
+ * @brief   Memory barrier used by the lock-free deque paths.
+ * @details Orders the accesses to the deque counters between the worker
+ *          owning the deque and the thieves.
+ * @note    The default is the @p port_memory_barrier() full barrier if
+ *          exported by the port layer, else a call to an empty function
+ *          through a volatile pointer is used, it is only a compiler
+ *          barrier, suitable for single core systems.
+ */
+#if !defined(CH_CFG_JOB_POOLS_BARRIER) || defined(__DOXYGEN__)
+#if defined(port_memory_barrier) || defined(__DOXYGEN__)
+#define CH_CFG_JOB_POOLS_BARRIER()          port_memory_barrier()
+#else
+#define CH_CFG_JOB_POOLS_BARRIER()          __jp_compiler_barrier()
+#endif
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_JOBS == FALSE
+#error "CH_CFG_USE_JOB_POOLS requires CH_CFG_USE_JOBS"
+#endif
+
+#if (CH_CFG_JOB_POOLS_DEQUE_SIZE < 2) ||                                    \
+    ((CH_CFG_JOB_POOLS_DEQUE_SIZE & (CH_CFG_JOB_POOLS_DEQUE_SIZE - 1)) != 0)
+#error "CH_CFG_JOB_POOLS_DEQUE_SIZE must be a power of two greater than one"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a job group.
+ * @details A job group tracks the completion of a set of submitted jobs,
+ *          a thread can join the group waiting for all of them.
+ */
+typedef struct ch_job_group {
+  /**
+   * @brief   Number of submitted jobs not yet completed.
+   */
+  cnt_t                     pending;
+  /**
+   * @brief   Thread joining the group.
+   */
+  thread_reference_t        tr;
+} job_group_t;
+
+/**
+ * @brief   Type of a pooled job.
+ * @note    Pooled jobs are owned by the submitter, an object can be
+ *          submitted again only after its completion.
+ */
+typedef struct ch_pooled_job {
+  /**
+   * @brief   Next job in the pool shared queue.
+   */
+  struct ch_pooled_job      *next;
+  /**
+   * @brief   Job function.
+   */
+  job_function_t            jobfunc;
+  /**
+   * @brief   Argument to be passed to the job function.
+   */
+  void                      *jobarg;
+  /**
+   * @brief   Group the job belongs to or @p NULL.
+   */
+  job_group_t               *group;
+} pooled_job_t;
+
+/**
+ * @brief   Type of a job pool worker.
+ * @details Each worker owns a deque of jobs, the owner pushes and takes
+ *          jobs at the tail while idle workers steal from the head.
+ * @note    The head and tail counters are free running, the slot is
+ *          obtained by masking them with the deque size.
+ */
+typedef struct ch_job_worker {
+  /**
+   * @brief   Jobs deque slots.
+   */
+  pooled_job_t              *jobs[CH_CFG_JOB_POOLS_DEQUE_SIZE];
+  /**
+   * @brief   Oldest job in the deque, written by the thieves.
+   */
+  volatile unsigned         head;
+  /**
+   * @brief   Next free slot of the deque, written by the owner.
+   */
+  volatile unsigned         tail;
+  /**
+   * @brief   Pool the worker belongs to.
+   */
+  struct ch_job_pool        *pool;
+  /**
+   * @brief   Thread serving this worker.
+   */
+  thread_t                  *thread;
+  /**
+   * @brief   Number of jobs stolen from other workers.
+   */
+  uint32_t                  stolen;
+} job_worker_t;
+
+/**
+ * @brief   Type of a job pool.
+ */
+typedef struct ch_job_pool {
+  /**
+   * @brief   Array of workers.
+   */
+  job_worker_t              *workers;
+  /**
+   * @brief   Number of workers.
+   */
+  unsigned                  n;
+  /**
+   * @brief   Oldest job in the shared queue.
+   * @note    The shared queue holds the jobs submitted from outside the
+   *          pool and the jobs exceeding the workers deques capacity.
+   */
+  pooled_job_t              *qhead;
+  /**
+   * @brief   Newest job in the shared queue.
+   */
+  pooled_job_t              *qtail;
+  /**
+   * @brief   Number of workers going idle or waiting for jobs.
+   */
+  volatile unsigned         idle;
+  /**
+   * @brief   Pool stopping.
+   */
+  bool                      stop;
+  /**
+   * @brief   Queue of the idle workers.
+   */
+  threads_queue_t           idleq;
+} job_pool_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void chJobPoolObjectInit(job_pool_t *jpp, job_worker_t *workers,
+                           unsigned n);
+  void chJobPoolSubmitI(job_pool_t *jpp, pooled_job_t *pjp,
+                        job_group_t *jgp);
+  void chJobPoolSubmit(job_pool_t *jpp, pooled_job_t *pjp,
+                       job_group_t *jgp);
+  void chJobPoolSubmitBatchI(job_pool_t *jpp, pooled_job_t *pjps,
+                             size_t n, job_group_t *jgp);
+  void chJobPoolSubmitBatch(job_pool_t *jpp, pooled_job_t *pjps,
+                            size_t n, job_group_t *jgp);
+  msg_t chJobPoolDispatchTimeout(job_pool_t *jpp, job_worker_t *wp,
+                                 sysinterval_t timeout);
+  void chJobPoolStop(job_pool_t *jpp);
+  msg_t chJobGroupJoinTimeout(job_group_t *jgp, sysinterval_t timeout);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a pooled job object.
+ *
+ * @param[out] pjp      pointer to a @p pooled_job_t structure
+ * @param[in] jobfunc   the job function
+ * @param[in] jobarg    argument to be passed to the job function
+ *
+ * @init
+ */
+static inline void chPooledJobObjectInit(pooled_job_t *pjp,
+                                         job_function_t jobfunc,
+                                         void *jobarg) {
+
+  chDbgCheck((pjp != NULL) && (jobfunc != NULL));
+
+  pjp->next    = NULL;
+  pjp->jobfunc = jobfunc;
+  pjp->jobarg  = jobarg;
+  pjp->group   = NULL;
+}
+
+/**
+ * @brief   Initializes a job group object.
+ *
+ * @param[out] jgp      pointer to a @p job_group_t structure
+ *
+ * @init
+ */
+static inline void chJobGroupObjectInit(job_group_t *jgp) {
+
+  chDbgCheck(jgp != NULL);
+
+  jgp->pending = (cnt_t)0;
+  jgp->tr      = NULL;
+}
+
+/**
+ * @brief   Returns the number of jobs in a group not yet completed.
+ *
+ * @param[in] jgp       pointer to a @p job_group_t structure
+ * @return              The number of pending jobs.
+ *
+ * @xclass
+ */
+static inline cnt_t chJobGroupGetPendingX(const job_group_t *jgp) {
+
+  return jgp->pending;
+}
+
+/**
+ * @brief   Waits for all the jobs in a group to complete.
+ *
+ * @param[in] jgp       pointer to a @p job_group_t structure
+ * @return              The operation status.
+ * @retval MSG_OK       if all the jobs have been completed.
+ *
+ * @api
+ */
+static inline msg_t chJobGroupJoin(job_group_t *jgp) {
+
+  return chJobGroupJoinTimeout(jgp, TIME_INFINITE);
+}
+
+/**
+ * @brief   Waits for a job then executes it.
+ *
+ * @param[in] jpp       pointer to a @p job_pool_t structure
+ * @param[in] wp        pointer to the worker served by the calling thread
+ * @return              The function outcome.
+ * @retval MSG_OK       if a job has been executed.
+ * @retval MSG_RESET    if the pool has been stopped and no jobs are left.
+ *
+ * @api
+ */
+static inline msg_t chJobPoolDispatch(job_pool_t *jpp, job_worker_t *wp) {
+
+  return chJobPoolDispatchTimeout(jpp, wp, TIME_INFINITE);
+}
+
+#endif /* CH_CFG_USE_JOB_POOLS == TRUE */
+
+#endif /* CHJOBPOOLS_H */
+
+/** @} */
@@ -182,17 +182,21 @@
 #undef CH_CFG_USE_MEMPOOLS
 #undef CH_CFG_USE_OBJ_FIFOS
 #undef CH_CFG_USE_PIPES
+#undef CH_CFG_USE_RINGS
 #undef CH_CFG_USE_OBJ_CACHES
 #undef CH_CFG_USE_DELEGATES
 #undef CH_CFG_USE_JOBS
+#undef CH_CFG_USE_JOB_POOLS
 
 #define CH_CFG_USE_HEAP                     FALSE
 #define CH_CFG_USE_MEMPOOLS                 FALSE
 #define CH_CFG_USE_OBJ_FIFOS                FALSE
 #define CH_CFG_USE_PIPES                    FALSE
+#define CH_CFG_USE_RINGS                    FALSE
 #define CH_CFG_USE_OBJ_CACHES               FALSE
 #define CH_CFG_USE_DELEGATES                FALSE
 #define CH_CFG_USE_JOBS                     FALSE
+#define CH_CFG_USE_JOB_POOLS                FALSE
 
 #endif /* (CH_CUSTOMER_LIC_OSLIB == FALSE) ||
           (CH_LICENSE_FEATURES == CH_FEATURES_BASIC) */
@@ -224,6 +228,7 @@
 /*===========================================================================*/
 
 /* OS Library headers.*/
+#include "chhash.h"
 #include "chbsem.h"
 #include "chmboxes.h"
 #include "chmemcore.h"
@@ -231,9 +236,11 @@
 #include "chmempools.h"
 #include "chobjfifos.h"
 #include "chpipes.h"
+#include "chrings.h"
 #include "chobjcaches.h"
 #include "chdelegates.h"
 #include "chjobs.h"
+#include "chjobpools.h"
 #include "chfactory.h"
 
 /*===========================================================================*/
@@ -113,9 +113,20 @@ extern "C" {
   msg_t chMBPostAheadTimeout(mailbox_t *mbp, msg_t msg, sysinterval_t timeout);
   msg_t chMBPostAheadTimeoutS(mailbox_t *mbp, msg_t msg, sysinterval_t timeout);
   msg_t chMBPostAheadI(mailbox_t *mbp, msg_t msg);
+  msg_t chMBPostBatchTimeout(mailbox_t *mbp, const msg_t *msgp, size_t n,
+                             size_t *np, sysinterval_t timeout);
+  msg_t chMBPostBatchTimeoutS(mailbox_t *mbp, const msg_t *msgp, size_t n,
+                              size_t *np, sysinterval_t timeout);
+  msg_t chMBPostBatchI(mailbox_t *mbp, const msg_t *msgp, size_t n,
+                       size_t *np);
   msg_t chMBFetchTimeout(mailbox_t *mbp, msg_t *msgp, sysinterval_t timeout);
   msg_t chMBFetchTimeoutS(mailbox_t *mbp, msg_t *msgp, sysinterval_t timeout);
   msg_t chMBFetchI(mailbox_t *mbp, msg_t *msgp);
+  msg_t chMBFetchBatchTimeout(mailbox_t *mbp, msg_t *msgp, size_t n,
+                              size_t *np, sysinterval_t timeout);
+  msg_t chMBFetchBatchTimeoutS(mailbox_t *mbp, msg_t *msgp, size_t n,
+                               size_t *np, sysinterval_t timeout);
+  msg_t chMBFetchBatchI(mailbox_t *mbp, msg_t *msgp, size_t n, size_t *np);
 #ifdef __cplusplus
 }
 #endif
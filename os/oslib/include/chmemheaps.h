@@ -41,14 +41,46 @@
 #define CH_HEAP_ALIGNMENT   8U
 #elif (SIZEOF_PTR == 2)
 #define CH_HEAP_ALIGNMENT   4U
+#elif (SIZEOF_PTR == 8)
+#define CH_HEAP_ALIGNMENT   16U
 #else
 #error "unsupported pointer size"
 #endif
 
+/**
+ * @brief   Number of second level classes of the TLSF heap as log2.
+ */
+#define CH_HEAP_TLSF_SL_LOG2                4U
+
+/**
+ * @brief   Number of second level classes of the TLSF heap.
+ */
+#define CH_HEAP_TLSF_SL_COUNT               (1U << CH_HEAP_TLSF_SL_LOG2)
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   TLSF heap allocator.
+ * @details If enabled then heaps use a Two-Level Segregated Fit allocator
+ *          instead of the first-fit one, allocation and release become
+ *          constant time operations.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_HEAP_TLSF) || defined(__DOXYGEN__)
+#define CH_CFG_USE_HEAP_TLSF                FALSE
+#endif
+
+/**
+ * @brief   Largest TLSF heap block size as log2.
+ * @details Larger heap areas are split in multiple blocks, this value
+ *          determines the size of the free lists table in each heap.
+ */
+#if !defined(CH_CFG_HEAP_TLSF_MAX_LOG2) || defined(__DOXYGEN__)
+#define CH_CFG_HEAP_TLSF_MAX_LOG2           20
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -61,6 +93,42 @@
 #error "CH_CFG_USE_HEAP requires CH_CFG_USE_MUTEXES and/or CH_CFG_USE_SEMAPHORES"
 #endif
 
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Log2 of @p CH_HEAP_ALIGNMENT.
+ */
+#if (CH_HEAP_ALIGNMENT == 8U) || defined(__DOXYGEN__)
+#define CH_HEAP_ALIGNMENT_LOG2              3U
+#elif CH_HEAP_ALIGNMENT == 4U
+#define CH_HEAP_ALIGNMENT_LOG2              2U
+#elif CH_HEAP_ALIGNMENT == 16U
+#define CH_HEAP_ALIGNMENT_LOG2              4U
+#endif
+
+/**
+ * @brief   Log2 of the first block size not belonging to the first level
+ *          class zero.
+ */
+#define CH_HEAP_TLSF_FL_SHIFT               (CH_HEAP_TLSF_SL_LOG2 +         \
+                                             CH_HEAP_ALIGNMENT_LOG2)
+
+/**
+ * @brief   Number of first level classes.
+ */
+#define CH_HEAP_TLSF_FL_COUNT               ((CH_CFG_HEAP_TLSF_MAX_LOG2 -   \
+                                              CH_HEAP_TLSF_FL_SHIFT) + 2U)
+
+/**
+ * @brief   Largest TLSF block size.
+ */
+#define CH_HEAP_TLSF_MAX_SIZE               ((size_t)1 << CH_CFG_HEAP_TLSF_MAX_LOG2)
+
+#if (CH_CFG_HEAP_TLSF_MAX_LOG2 <= CH_HEAP_TLSF_FL_SHIFT) ||                 \
+    (CH_CFG_HEAP_TLSF_MAX_LOG2 > 30)
+#error "invalid CH_CFG_HEAP_TLSF_MAX_LOG2 value"
+#endif
+#endif /* CH_CFG_USE_HEAP_TLSF == TRUE */
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -75,6 +143,7 @@ typedef struct memory_heap memory_heap_t;
  */
 typedef union heap_header heap_header_t;
 
+#if (CH_CFG_USE_HEAP_TLSF == FALSE) || defined(__DOXYGEN__)
 /**
  * @brief   Memory heap block header.
  */
@@ -88,6 +157,29 @@ union heap_header {
     size_t              size;       /**< @brief Size of the area in bytes.  */
   } used;
 };
+#else
+/**
+ * @brief   Memory heap block header.
+ * @note    The first two fields are common to free and used blocks, the
+ *          size of the block is in bytes and includes two flags in the
+ *          least significant bits.
+ */
+union heap_header {
+  struct {
+    heap_header_t       *phys;      /**< @brief Previous physical block.    */
+    size_t              bsize;      /**< @brief Block size and flags.       */
+    heap_header_t       *next;      /**< @brief Next block in free list.    */
+    heap_header_t       *prev;      /**< @brief Previous block in free
+                                                list.                       */
+  } free;
+  struct {
+    heap_header_t       *phys;      /**< @brief Previous physical block.    */
+    size_t              bsize;      /**< @brief Block size and flags.       */
+    memory_heap_t       *heap;      /**< @brief Block owner heap.           */
+    size_t              size;       /**< @brief Size of the area in bytes.  */
+  } used;
+};
+#endif
 
 /**
  * @brief   Structure describing a memory heap.
@@ -95,7 +187,15 @@ union heap_header {
 struct memory_heap {
   memgetfunc2_t         provider;   /**< @brief Memory blocks provider for
                                                 this heap.                  */
+#if (CH_CFG_USE_HEAP_TLSF == FALSE) || defined(__DOXYGEN__)
   heap_header_t         header;     /**< @brief Free blocks list header.    */
+#else
+  uint32_t              fl_map;     /**< @brief First level bitmap.         */
+  uint32_t              sl_map[CH_HEAP_TLSF_FL_COUNT];
+                                    /**< @brief Second level bitmaps.       */
+  heap_header_t         *lists[CH_HEAP_TLSF_FL_COUNT][CH_HEAP_TLSF_SL_COUNT];
+                                    /**< @brief Free lists heads.           */
+#endif
 #if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
   mutex_t               mtx;        /**< @brief Heap access mutex.          */
 #else
@@ -135,8 +235,7 @@ extern "C" {
 /*===========================================================================*/
 
 /**
- * @brief   Allocates a block of memory from the heap by using the first-fit
- *          algorithm.
+ * @brief   Allocates a block of memory from the heap.
  * @details The allocated block is guaranteed to be properly aligned for a
  *          pointer data type.
  *
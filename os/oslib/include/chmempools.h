@@ -69,6 +69,37 @@ typedef struct {
                                                     for this pool.          */
 } memory_pool_t;
 
+/**
+ * @brief   Memory pool magazine descriptor.
+ * @details A magazine is a private cache of objects taken from a memory
+ *          pool. Objects are served from a loaded list of up to @p batch
+ *          objects, a second list holds a full batch in reserve. Objects
+ *          are moved between the magazine and the pool in batches so that
+ *          the pool, and the system lock, are accessed at most once every
+ *          @p batch operations.
+ * @note    A magazine is not protected against concurrent access, it must
+ *          only be used by its owner thread.
+ */
+typedef struct {
+  memory_pool_t         *pool;          /**< @brief Associated memory pool. */
+  struct pool_header    *next;          /**< @brief Pointer to the first
+                                                    object of the loaded
+                                                    list.                   */
+  struct pool_header    *last;          /**< @brief Pointer to the last
+                                                    object of the loaded
+                                                    list.                   */
+  size_t                n;              /**< @brief Number of objects in
+                                                    the loaded list.        */
+  struct pool_header    *full;          /**< @brief Pointer to the first
+                                                    object of the reserve
+                                                    batch or @p NULL.       */
+  struct pool_header    *fulllast;      /**< @brief Pointer to the last
+                                                    object of the reserve
+                                                    batch.                  */
+  size_t                batch;          /**< @brief Objects moved in a
+                                                    single transfer.        */
+} memory_magazine_t;
+
 #if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Guarded memory pool descriptor.
@@ -153,6 +184,12 @@ extern "C" {
   void *chPoolAlloc(memory_pool_t *mp);
   void chPoolFreeI(memory_pool_t *mp, void *objp);
   void chPoolFree(memory_pool_t *mp, void *objp);
+  void chPoolMagazineObjectInit(memory_magazine_t *mgp,
+                                memory_pool_t *mp,
+                                size_t batch);
+  void *__pool_magazine_load(memory_magazine_t *mgp);
+  void __pool_magazine_unload(memory_magazine_t *mgp);
+  void chPoolMagazineFlush(memory_magazine_t *mgp);
 #if CH_CFG_USE_SEMAPHORES == TRUE
   void chGuardedPoolObjectInitAligned(guarded_memory_pool_t *gmp,
                                       size_t size,
@@ -230,6 +267,76 @@ static inline void chPoolAddI(memory_pool_t *mp, void *objp) {
   chPoolFreeI(mp, objp);
 }
 
+/**
+ * @brief   Returns the number of objects cached in a magazine.
+ *
+ * @param[in] mgp       pointer to a @p memory_magazine_t structure
+ * @return              The number of cached objects.
+ *
+ * @xclass
+ */
+static inline size_t chPoolMagazineGetCountX(memory_magazine_t *mgp) {
+
+  return mgp->full != NULL ? mgp->n + mgp->batch : mgp->n;
+}
+
+/**
+ * @brief   Allocates an object using a memory pool magazine.
+ * @details The object is taken from the loaded list, if it is empty then
+ *          it is replaced by the reserve batch or refilled with up to
+ *          @p batch objects taken from the pool in a single critical zone.
+ *          If the pool is empty too then its provider is invoked, if any.
+ * @pre     The magazine must already be initialized.
+ *
+ * @param[in] mgp       pointer to a @p memory_magazine_t structure
+ * @return              The pointer to the allocated object.
+ * @retval NULL         if both the magazine and the pool are empty.
+ *
+ * @api
+ */
+static inline void *chPoolMagazineAlloc(memory_magazine_t *mgp) {
+  struct pool_header *php = mgp->next;
+
+  if (php == NULL) {
+    return __pool_magazine_load(mgp);
+  }
+  mgp->next = php->next;
+  mgp->n--;
+
+  return (void *)php;
+}
+
+/**
+ * @brief   Releases an object using a memory pool magazine.
+ * @details The object is put in the loaded list, if it is full then it
+ *          becomes the reserve batch and the previous reserve batch, if
+ *          any, is returned to the pool in a single critical zone.
+ * @pre     The magazine must already be initialized.
+ * @pre     The freed object must be of the right size for the associated
+ *          memory pool.
+ * @pre     The added object must be properly aligned.
+ *
+ * @param[in] mgp       pointer to a @p memory_magazine_t structure
+ * @param[in] objp      the pointer to the object to be released
+ *
+ * @api
+ */
+static inline void chPoolMagazineFree(memory_magazine_t *mgp, void *objp) {
+  struct pool_header *php = (struct pool_header *)objp;
+
+  chDbgCheck((objp != NULL) && MEM_IS_ALIGNED(objp, mgp->pool->align));
+
+  if (mgp->n >= mgp->batch) {
+    __pool_magazine_unload(mgp);
+  }
+  if (mgp->n == 0U) {
+    mgp->last = php;
+  }
+  php->next = mgp->next;
+  mgp->next = php;
+  mgp->n++;
+}
+
 #if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Initializes an empty guarded memory pool.
@@ -359,6 +359,71 @@ static inline void chFifoSendObjectAhead(objects_fifo_t *ofp, void *objp) {
   chDbgAssert(msg == MSG_OK, "post failed");
 }
 
+/**
+ * @brief   Posts multiple objects.
+ * @details The objects are posted in a single critical zone.
+ * @note    By design the objects can be always immediately posted.
+ *
+ * @param[in] ofp       pointer to a @p objects_fifo_t structure
+ * @param[in] objpp     pointer to an array of pointers to the objects to be
+ *                      posted
+ * @param[in] n         number of objects in the array
+ *
+ * @iclass
+ */
+static inline void chFifoSendObjectBatchI(objects_fifo_t *ofp,
+                                          void * const *objpp, size_t n) {
+  msg_t msg;
+  size_t posted;
+
+  msg = chMBPostBatchI(&ofp->mbx, (const msg_t *)objpp, n, &posted);
+  chDbgAssert((msg == MSG_OK) && (posted == n), "post failed");
+}
+
+/**
+ * @brief   Posts multiple objects.
+ * @details The objects are posted in a single critical zone.
+ * @note    By design the objects can be always immediately posted.
+ *
+ * @param[in] ofp       pointer to a @p objects_fifo_t structure
+ * @param[in] objpp     pointer to an array of pointers to the objects to be
+ *                      posted
+ * @param[in] n         number of objects in the array
+ *
+ * @sclass
+ */
+static inline void chFifoSendObjectBatchS(objects_fifo_t *ofp,
+                                          void * const *objpp, size_t n) {
+  msg_t msg;
+  size_t posted;
+
+  msg = chMBPostBatchTimeoutS(&ofp->mbx, (const msg_t *)objpp, n, &posted,
+                              TIME_IMMEDIATE);
+  chDbgAssert((msg == MSG_OK) && (posted == n), "post failed");
+}
+
+/**
+ * @brief   Posts multiple objects.
+ * @details The objects are posted in a single critical zone.
+ * @note    By design the objects can be always immediately posted.
+ *
+ * @param[in] ofp       pointer to a @p objects_fifo_t structure
+ * @param[in] objpp     pointer to an array of pointers to the objects to be
+ *                      posted
+ * @param[in] n         number of objects in the array
+ *
+ * @api
+ */
+static inline void chFifoSendObjectBatch(objects_fifo_t *ofp,
+                                         void * const *objpp, size_t n) {
+  msg_t msg;
+  size_t posted;
+
+  msg = chMBPostBatchTimeout(&ofp->mbx, (const msg_t *)objpp, n, &posted,
+                             TIME_IMMEDIATE);
+  chDbgAssert((msg == MSG_OK) && (posted == n), "post failed");
+}
+
 /**
  * @brief   Fetches an object.
  *
@@ -422,6 +487,96 @@ static inline msg_t chFifoReceiveObjectTimeout(objects_fifo_t *ofp,
   return chMBFetchTimeout(&ofp->mbx, (msg_t *)objpp, timeout);
 }
 
+/**
+ * @brief   Fetches multiple objects.
+ * @details All the available objects, up to @p n, are fetched in a single
+ *          critical zone.
+ *
+ * @param[in] ofp       pointer to a @p objects_fifo_t structure
+ * @param[out] objpp    pointer to an array receiving the fetched objects
+ *                      references
+ * @param[in] n         number of elements in the array
+ * @param[out] np       pointer to a variable receiving the number of fetched
+ *                      objects
+ * @return              The operation status.
+ * @retval MSG_OK       if at least an object has been correctly fetched.
+ * @retval MSG_TIMEOUT  if the FIFO is empty and objects cannot be fetched.
+ *
+ * @iclass
+ */
+static inline msg_t chFifoReceiveObjectBatchI(objects_fifo_t *ofp,
+                                              void **objpp, size_t n,
+                                              size_t *np) {
+
+  return chMBFetchBatchI(&ofp->mbx, (msg_t *)objpp, n, np);
+}
+
+/**
+ * @brief   Fetches multiple objects.
+ * @details If the FIFO is empty the function waits for an object to be
+ *          posted or for the timeout, then all the available objects, up
+ *          to @p n, are fetched in a single critical zone.
+ * @note    The function can only block while the FIFO is empty, once an
+ *          object is available no further waits are performed.
+ *
+ * @param[in] ofp       pointer to a @p objects_fifo_t structure
+ * @param[out] objpp    pointer to an array receiving the fetched objects
+ *                      references
+ * @param[in] n         number of elements in the array
+ * @param[out] np       pointer to a variable receiving the number of fetched
+ *                      objects
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if at least an object has been correctly fetched.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @sclass
+ */
+static inline msg_t chFifoReceiveObjectBatchTimeoutS(objects_fifo_t *ofp,
+                                                     void **objpp, size_t n,
+                                                     size_t *np,
+                                                     sysinterval_t timeout) {
+
+  return chMBFetchBatchTimeoutS(&ofp->mbx, (msg_t *)objpp, n, np, timeout);
+}
+
+/**
+ * @brief   Fetches multiple objects.
+ * @details If the FIFO is empty the function waits for an object to be
+ *          posted or for the timeout, then all the available objects, up
+ *          to @p n, are fetched in a single critical zone.
+ * @note    The function can only block while the FIFO is empty, once an
+ *          object is available no further waits are performed.
+ *
+ * @param[in] ofp       pointer to a @p objects_fifo_t structure
+ * @param[out] objpp    pointer to an array receiving the fetched objects
+ *                      references
+ * @param[in] n         number of elements in the array
+ * @param[out] np       pointer to a variable receiving the number of fetched
+ *                      objects
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if at least an object has been correctly fetched.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @api
+ */
+static inline msg_t chFifoReceiveObjectBatchTimeout(objects_fifo_t *ofp,
+                                                    void **objpp, size_t n,
+                                                    size_t *np,
+                                                    sysinterval_t timeout) {
+
+  return chMBFetchBatchTimeout(&ofp->mbx, (msg_t *)objpp, n, np, timeout);
+}
+
 #endif /* CH_CFG_USE_OBJ_FIFOS == TRUE */
 
 #endif /* CHOBJFIFOS_H */
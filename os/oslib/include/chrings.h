@@ -0,0 +1,208 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation version 3 of the License.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/include/chrings.h
+ * @brief   Lock-free rings macros and structures.
+ *
+ * @addtogroup oslib_rings
+ * @{
+ */
+
+#ifndef CHRINGS_H
+#define CHRINGS_H
+
+/**
+ * @brief   Lock-free rings APIs.
+ * @details If enabled then the single producer single consumer ring
+ *          buffers APIs are included in the kernel.
+ */
+#if !defined(CH_CFG_USE_RINGS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_RINGS                    FALSE
+#endif
+
+#if (CH_CFG_USE_RINGS == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Memory barrier used by the lock-free paths.
+ * @details Orders the buffer accesses against the publication of the
+ *          ring indexes.
+ * @note    The default is the @p port_memory_barrier() full barrier if
+ *          exported by the port layer, else a call to an empty function
+ *          through a volatile pointer is used, it is only a compiler
+ *          barrier, suitable for single core systems.
+ */
+#if !defined(CH_CFG_RING_BARRIER) || defined(__DOXYGEN__)
+#if defined(port_memory_barrier) || defined(__DOXYGEN__)
+#define CH_CFG_RING_BARRIER()               port_memory_barrier()
+#else
+#define CH_CFG_RING_BARRIER()               __ring_compiler_barrier()
+#endif
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Structure representing a lock-free ring object.
+ * @note    The write and read counters are free running, the buffer
+ *          position is obtained by masking them with the buffer size.
+ */
+typedef struct {
+  uint8_t               *buffer;        /**< @brief Pointer to the ring
+                                                    buffer.                 */
+  size_t                mask;           /**< @brief Buffer size minus one.  */
+  volatile size_t       wrcnt;          /**< @brief Bytes ever committed,
+                                                    owned by the producer.  */
+  volatile size_t       rdcnt;          /**< @brief Bytes ever consumed,
+                                                    owned by the consumer.  */
+  volatile bool         wwait;          /**< @brief Writer about to wait.   */
+  volatile bool         rwait;          /**< @brief Reader about to wait.   */
+  thread_reference_t    wtr;            /**< @brief Waiting writer.         */
+  thread_reference_t    rtr;            /**< @brief Waiting reader.         */
+} ring_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Data part of a static ring initializer.
+ * @details This macro should be used when statically initializing a
+ *          ring that is part of a bigger structure.
+ *
+ * @param[in] name      the name of the ring variable
+ * @param[in] buffer    pointer to the ring buffer array of @p uint8_t
+ * @param[in] size      number of @p uint8_t elements in the buffer array,
+ *                      it must be a power of two
+ */
+#define __RING_DATA(name, buffer, size) {                                   \
+  (uint8_t *)(buffer),                                                      \
+  (size_t)(size) - (size_t)1,                                               \
+  (size_t)0,                                                                \
+  (size_t)0,                                                                \
+  false,                                                                    \
+  false,                                                                    \
+  NULL,                                                                     \
+  NULL                                                                      \
+}
+
+/**
+ * @brief   Static ring initializer.
+ * @details Statically initialized rings require no explicit
+ *          initialization using @p chRingObjectInit().
+ *
+ * @param[in] name      the name of the ring variable
+ * @param[in] buffer    pointer to the ring buffer array of @p uint8_t
+ * @param[in] size      number of @p uint8_t elements in the buffer array,
+ *                      it must be a power of two
+ */
+#define RING_DECL(name, buffer, size)                                       \
+  ring_t name = __RING_DATA(name, buffer, size)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void chRingObjectInit(ring_t *rp, uint8_t *buf, size_t n);
+  size_t chRingWriteReserveX(ring_t *rp, uint8_t **bpp);
+  size_t chRingWriteReserveTimeout(ring_t *rp, uint8_t **bpp,
+                                   sysinterval_t timeout);
+  void chRingWriteCommit(ring_t *rp, size_t n);
+  void chRingWriteCommitFromISR(ring_t *rp, size_t n);
+  size_t chRingReadPeekX(ring_t *rp, uint8_t **bpp);
+  size_t chRingReadPeekTimeout(ring_t *rp, uint8_t **bpp,
+                               sysinterval_t timeout);
+  void chRingReadConsume(ring_t *rp, size_t n);
+  void chRingReadConsumeFromISR(ring_t *rp, size_t n);
+  size_t chRingWriteTimeout(ring_t *rp, const uint8_t *bp,
+                            size_t n, sysinterval_t timeout);
+  size_t chRingReadTimeout(ring_t *rp, uint8_t *bp,
+                           size_t n, sysinterval_t timeout);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the ring buffer size as number of bytes.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @return              The size of the ring.
+ *
+ * @xclass
+ */
+static inline size_t chRingGetSizeX(const ring_t *rp) {
+
+  return rp->mask + (size_t)1;
+}
+
+/**
+ * @brief   Returns the number of used byte slots into a ring.
+ * @note    The value is exact only when invoked by the producer or the
+ *          consumer, any other observer gets a snapshot.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @return              The number of queued bytes.
+ *
+ * @xclass
+ */
+static inline size_t chRingGetUsedCountX(const ring_t *rp) {
+
+  return rp->wrcnt - rp->rdcnt;
+}
+
+/**
+ * @brief   Returns the number of free byte slots into a ring.
+ * @note    The value is exact only when invoked by the producer or the
+ *          consumer, any other observer gets a snapshot.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @return              The number of empty byte slots.
+ *
+ * @xclass
+ */
+static inline size_t chRingGetFreeCountX(const ring_t *rp) {
+
+  return chRingGetSizeX(rp) - chRingGetUsedCountX(rp);
+}
+
+#endif /* CH_CFG_USE_RINGS == TRUE */
+
+#endif /* CHRINGS_H */
+
+/** @} */
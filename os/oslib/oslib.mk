@@ -27,9 +27,15 @@ endif
 ifneq ($(findstring CH_CFG_USE_PIPES TRUE,$(CHLIBCONF)),)
 OSLIBSRC += $(CHIBIOS)/os/oslib/src/chpipes.c
 endif
+ifneq ($(findstring CH_CFG_USE_RINGS TRUE,$(CHLIBCONF)),)
+OSLIBSRC += $(CHIBIOS)/os/oslib/src/chrings.c
+endif
 ifneq ($(findstring CH_CFG_USE_OBJ_CACHES TRUE,$(CHLIBCONF)),)
 OSLIBSRC += $(CHIBIOS)/os/oslib/src/chobjcaches.c
 endif
+ifneq ($(findstring CH_CFG_USE_JOB_POOLS TRUE,$(CHLIBCONF)),)
+OSLIBSRC += $(CHIBIOS)/os/oslib/src/chjobpools.c
+endif
 ifneq ($(findstring CH_CFG_USE_DELEGATES TRUE,$(CHLIBCONF)),)
 OSLIBSRC += $(CHIBIOS)/os/oslib/src/chdelegates.c
 endif
@@ -42,8 +48,10 @@ OSLIBSRC := $(CHIBIOS)/os/oslib/src/chmboxes.c \
             $(CHIBIOS)/os/oslib/src/chmemheaps.c \
             $(CHIBIOS)/os/oslib/src/chmempools.c \
             $(CHIBIOS)/os/oslib/src/chpipes.c \
+            $(CHIBIOS)/os/oslib/src/chrings.c \
             $(CHIBIOS)/os/oslib/src/chobjcaches.c \
             $(CHIBIOS)/os/oslib/src/chdelegates.c \
+            $(CHIBIOS)/os/oslib/src/chjobpools.c \
             $(CHIBIOS)/os/oslib/src/chfactory.c
 endif
 
@@ -59,6 +59,13 @@
 #define F_UNLOCK()      chSemSignal(&ch_factory.sem)
 #endif
 
+#if (CH_CFG_FACTORY_HASH_SIZE > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Mask of the names hash index.
+ */
+#define DYN_INDEX_MASK  ((unsigned)CH_CFG_FACTORY_HASH_SIZE - 1U)
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -136,14 +143,73 @@ static void copy_name(const char *sp, char *dp) {
   } while ((c != (char)0) && (i > 0U));
 }
 
+#if (CH_CFG_FACTORY_HASH_SIZE > 0) || defined(__DOXYGEN__)
+static unsigned dyn_hash(const char *name) {
+
+  /* Only the significant part of the name is hashed.*/
+  return ch_hash_name(name, CH_CFG_FACTORY_MAX_NAMES_LENGTH, DYN_INDEX_MASK);
+}
+
+static unsigned dyn_home(const void *p) {
+
+  return dyn_hash(((const dyn_element_t *)p)->name);
+}
+
+static void dyn_index_insert(dyn_list_t *dlp, dyn_element_t *dep) {
+
+  /* One slot is always left empty in order to terminate the probes.*/
+  if (dlp->indexed >= DYN_INDEX_MASK) {
+    dlp->unindexed++;
+    return;
+  }
+
+  ch_hash_insert(dlp->index, DYN_INDEX_MASK, dyn_hash(dep->name),
+                 (void *)dep);
+  dlp->indexed++;
+}
+
+static void dyn_index_remove(dyn_list_t *dlp, dyn_element_t *dep) {
+
+  if (ch_hash_remove(dlp->index, DYN_INDEX_MASK, dyn_hash(dep->name),
+                     (const void *)dep, dyn_home)) {
+    dlp->indexed--;
+  }
+  else {
+    dlp->unindexed--;
+  }
+}
+#endif /* CH_CFG_FACTORY_HASH_SIZE > 0 */
+
 static inline void dyn_list_init(dyn_list_t *dlp) {
 
   dlp->next = (dyn_element_t *)dlp;
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  memset((void *)dlp->index, 0, sizeof (dlp->index));
+  dlp->indexed   = 0U;
+  dlp->unindexed = 0U;
+#endif
 }
 
 static dyn_element_t *dyn_list_find(const char *name, dyn_list_t *dlp) {
-  dyn_element_t *p = dlp->next;
+  dyn_element_t *p;
+
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  unsigned i = dyn_hash(name);
 
+  while ((p = (dyn_element_t *)dlp->index[i]) != NULL) {
+    if (strncmp(p->name, name, CH_CFG_FACTORY_MAX_NAMES_LENGTH) == 0) {
+      return p;
+    }
+    i = (i + 1U) & DYN_INDEX_MASK;
+  }
+
+  /* The list is scanned only if some objects did not fit the index.*/
+  if (dlp->unindexed == 0U) {
+    return NULL;
+  }
+#endif
+
+  p = dlp->next;
   while (p != (dyn_element_t *)dlp) {
     if (strncmp(p->name, name, CH_CFG_FACTORY_MAX_NAMES_LENGTH) == 0) {
       return p;
@@ -179,6 +245,59 @@ static dyn_element_t *dyn_list_unlink(dyn_element_t *prev) {
   return element;
 }
 
+#if (CH_CFG_FACTORY_HASH_SIZE > 0) || defined(__DOXYGEN__)
+static bool dyn_index_contains(dyn_list_t *dlp, dyn_element_t *dep) {
+
+  if (ch_hash_contains(dlp->index, DYN_INDEX_MASK, dyn_hash(dep->name),
+                       (const void *)dep)) {
+    return true;
+  }
+
+  /* The list is scanned only if some objects did not fit the index.*/
+  return (dlp->unindexed > 0U) && (dyn_list_find_prev(dep, dlp) != NULL);
+}
+#endif
+
+/* Drops a reference, returns the unlinked element if it has to be freed.*/
+static dyn_element_t *dyn_list_release(dyn_element_t *dep,
+                                       dyn_list_t *dlp) {
+
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  /* Checking 1st if the object is known, the list is scanned only when
+     the element has to be unlinked.*/
+  if (dyn_index_contains(dlp, dep)) {
+
+    chDbgAssert(dep->refs > (ucnt_t)0, "invalid references number");
+
+    if (--dep->refs == (ucnt_t)0) {
+      dyn_index_remove(dlp, dep);
+      return dyn_list_unlink(dyn_list_find_prev(dep, dlp));
+    }
+  }
+  else {
+    chDbgAssert(false, "unknown object");
+  }
+#else
+  dyn_element_t *prev;
+
+  /* Checking 1st if the object is in the list.*/
+  prev = dyn_list_find_prev(dep, dlp);
+  if (prev != NULL) {
+
+    chDbgAssert(dep->refs > (ucnt_t)0, "invalid references number");
+
+    if (--dep->refs == (ucnt_t)0) {
+      return dyn_list_unlink(prev);
+    }
+  }
+  else {
+    chDbgAssert(false, "unknown object");
+  }
+#endif
+
+  return NULL;
+}
+
 #if CH_FACTORY_REQUIRES_HEAP || defined(__DOXYGEN__)
 static dyn_element_t *dyn_create_object_heap(const char *name,
                                              dyn_list_t *dlp,
@@ -207,30 +326,21 @@ static dyn_element_t *dyn_create_object_heap(const char *name,
 
   /* Updating factory list.*/
   dlp->next = dep;
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  dyn_index_insert(dlp, dep);
+#endif
 
   return dep;
 }
 
 static void dyn_release_object_heap(dyn_element_t *dep,
                                       dyn_list_t *dlp) {
-  dyn_element_t *prev;
-  ucnt_t refs;
 
   chDbgCheck(dep != NULL);
 
-  /* Checking 1st if the object is in the list.*/
-  prev = dyn_list_find_prev(dep, dlp);
-  if (prev != NULL) {
-
-    chDbgAssert(dep->refs > (ucnt_t)0, "invalid references number");
-
-    refs = --dep->refs;
-    if (refs == (ucnt_t)0) {
-      chHeapFree((void *)dyn_list_unlink(prev));
-    }
-  }
-  else {
-    chDbgAssert(false, "unknown object");
+  dep = dyn_list_release(dep, dlp);
+  if (dep != NULL) {
+    chHeapFree((void *)dep);
   }
 }
 #endif /* CH_FACTORY_REQUIRES_HEAP */
@@ -262,6 +372,9 @@ static dyn_element_t *dyn_create_object_pool(const char *name,
 
   /* Updating factory list.*/
   dlp->next = (dyn_element_t *)dep;
+#if CH_CFG_FACTORY_HASH_SIZE > 0
+  dyn_index_insert(dlp, dep);
+#endif
 
   return dep;
 }
@@ -269,24 +382,12 @@ static dyn_element_t *dyn_create_object_pool(const char *name,
 static void dyn_release_object_pool(dyn_element_t *dep,
                                       dyn_list_t *dlp,
                                       memory_pool_t *mp) {
-  dyn_element_t *prev;
-  ucnt_t refs;
 
   chDbgCheck(dep != NULL);
 
-  /* Checking 1st if the object is in the list.*/
-  prev = dyn_list_find_prev(dep, dlp);
-  if (prev != NULL) {
-
-    chDbgAssert(dep->refs > (ucnt_t)0, "invalid references number");
-
-    refs = --dep->refs;
-    if (refs == (ucnt_t)0) {
-      chPoolFree(mp, (void *)dyn_list_unlink(prev));
-    }
-  }
-  else {
-    chDbgAssert(false, "unknown object");
+  dep = dyn_list_release(dep, dlp);
+  if (dep != NULL) {
+    chPoolFree(mp, (void *)dep);
   }
 }
 #endif /* CH_FACTORY_REQUIRES_POOLS */
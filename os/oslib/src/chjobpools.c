@@ -0,0 +1,675 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation version 3 of the License.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/src/chjobpools.c
+ * @brief   Job Pools code.
+ * @details Work-stealing pools of worker threads.
+ *          <h2>Operation mode</h2>
+ *          A job pool is served by a fixed set of worker threads, each
+ *          worker owns a deque of jobs. Jobs submitted by a worker go in
+ *          its own deque, jobs submitted by other threads or ISRs go in
+ *          a queue shared by the workers. A worker executes the newest job
+ *          in its own deque, when its deque is empty it takes the oldest
+ *          job of the shared queue or steals the oldest job of another
+ *          worker.<br>
+ *          Jobs can be grouped, a thread can join a group waiting for
+ *          all its jobs to complete.
+ *          Operations defined for job pools:
+ *          - <b>Submit</b>: A job, or an array of jobs, is queued to the
+ *            workers.
+ *          - <b>Dispatch</b>: A worker thread executes a job, it waits if
+ *            no job is available.
+ *          - <b>Join</b>: A thread waits for the completion of all the
+ *            jobs in a group.
+ *          - <b>Stop</b>: Workers return after all the queued jobs have
+ *            been executed.
+ *          .
+ * @pre     In order to use the job pools APIs the @p CH_CFG_USE_JOB_POOLS
+ *          option must be enabled in @p chconf.h.
+ * @note    The kernel does not expose compare-and-swap primitives, the
+ *          deques follow the THE protocol: the owner pushes and takes jobs
+ *          at the tail without entering critical zones, thieves take jobs
+ *          at the head within the kernel lock. The owner enters a critical
+ *          zone only when racing with a thief for the last job in its
+ *          deque.
+ * @note    The shared queue, the job groups counters and the idle workers
+ *          queue are protected by the kernel lock. Submissions of jobs
+ *          without a group from a worker enter a critical zone only if
+ *          there are idle workers to be woken up.
+ * @note    Each thread holds a reference to the worker it serves, a
+ *          worker finds its own deque in constant time.
+ * @note    Compatible with RT and NIL.
+ *
+ * @addtogroup oslib_job_pools
+ * @{
+ */
+
+#include "ch.h"
+
+#if (CH_CFG_USE_JOB_POOLS == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Deque counters mask.
+ */
+#define JP_DEQUE_MASK       ((unsigned)CH_CFG_JOB_POOLS_DEQUE_SIZE - 1U)
+
+/**
+ * @brief   Free running counters comparison.
+ *
+ * @param[in] a         first counter
+ * @param[in] b         second counter
+ * @return              The comparison result.
+ * @retval true         if @p a precedes @p b.
+ * @retval false        if @p a does not precede @p b.
+ */
+#define JP_BEFORE(a, b)     ((int)((unsigned)(a) - (unsigned)(b)) < 0)
+
+#if !defined(port_memory_barrier)
+/**
+ * @brief   Compiler-neutral compiler barrier.
+ * @details An empty function is called through a volatile pointer, the
+ *          compiler cannot see the call target so memory accesses are not
+ *          moved across the call.
+ */
+#define __jp_compiler_barrier()             jp_barrier_fn()
+#endif
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+#if !defined(port_memory_barrier)
+static void jp_barrier_stub(void);
+
+/**
+ * @brief   Pointer to the compiler barrier function.
+ */
+static void (* volatile jp_barrier_fn)(void) = jp_barrier_stub;
+#endif
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+#if !defined(port_memory_barrier)
+/**
+ * @brief   Empty function used as compiler barrier.
+ */
+static void jp_barrier_stub(void) {
+}
+#endif
+
+/**
+ * @brief   Returns the worker served by the current thread.
+ *
+ * @param[in] jpp       pointer to a @p job_pool_t structure
+ * @return              The worker pointer.
+ * @retval NULL         if the current thread is not a worker of the pool.
+ *
+ * @notapi
+ */
+static job_worker_t *pool_self(job_pool_t *jpp) {
+  job_worker_t *wp = chThdGetSelfX()->worker;
+
+  if ((wp != NULL) && (wp->pool == jpp)) {
+    return wp;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief   Pushes a job at the tail of a worker deque.
+ * @note    Only the thread serving the worker can push jobs.
+ *
+ * @param[in] wp        pointer to a @p job_worker_t structure
+ * @param[in] pjp       pointer to the job to be pushed
+ * @return              The operation result.
+ * @retval true         if the job has been pushed.
+ * @retval false        if the deque is full.
+ *
+ * @notapi
+ */
+static bool deque_push(job_worker_t *wp, pooled_job_t *pjp) {
+  unsigned t = wp->tail;
+
+  if ((t - wp->head) >= (unsigned)CH_CFG_JOB_POOLS_DEQUE_SIZE) {
+    return false;
+  }
+
+  /* The slot is written before the job is published to the thieves.*/
+  wp->jobs[t & JP_DEQUE_MASK] = pjp;
+  CH_CFG_JOB_POOLS_BARRIER();
+  wp->tail = t + 1U;
+
+  return true;
+}
+
+/**
+ * @brief   Removes the job at the tail of a worker deque.
+ * @note    Only the thread serving the worker can take jobs at the tail,
+ *          the kernel lock is taken only when racing with a thief for the
+ *          last job.
+ *
+ * @param[in] wp        pointer to a @p job_worker_t structure
+ * @return              The removed job or @p NULL if the deque is empty.
+ *
+ * @notapi
+ */
+static pooled_job_t *deque_pop(job_worker_t *wp) {
+  unsigned t = wp->tail;
+
+  /* The owner is the only producer, an empty deque stays empty.*/
+  if (t == wp->head) {
+    return NULL;
+  }
+
+  /* Reserving the newest job then checking for a thief which could have
+     taken the same job.*/
+  t--;
+  wp->tail = t;
+  CH_CFG_JOB_POOLS_BARRIER();
+  if (JP_BEFORE(t, wp->head)) {
+
+    /* Thieves update the head within the kernel lock, the outcome is
+       stable here.*/
+    chSysLock();
+    if (JP_BEFORE(t, wp->head)) {
+      wp->tail = t + 1U;
+      chSysUnlock();
+      return NULL;
+    }
+    chSysUnlock();
+  }
+
+  return wp->jobs[t & JP_DEQUE_MASK];
+}
+
+/**
+ * @brief   Steals the job at the head of a worker deque.
+ * @note    Thieves are serialized by the kernel lock.
+ *
+ * @param[in] wp        pointer to a @p job_worker_t structure
+ * @return              The stolen job or @p NULL if the deque is empty.
+ *
+ * @notapi
+ */
+static pooled_job_t *deque_steal(job_worker_t *wp) {
+  unsigned h = wp->head;
+  pooled_job_t *pjp;
+
+  if (h == wp->tail) {
+    return NULL;
+  }
+
+  /* The job is fetched before releasing the slot to the owner.*/
+  CH_CFG_JOB_POOLS_BARRIER();
+  pjp = wp->jobs[h & JP_DEQUE_MASK];
+  wp->head = h + 1U;
+  CH_CFG_JOB_POOLS_BARRIER();
+  if (JP_BEFORE(wp->tail, h + 1U)) {
+
+    /* The owner took the job.*/
+    wp->head = h;
+    return NULL;
+  }
+
+  return pjp;
+}
+
+/**
+ * @brief   Queues a job to the pool.
+ * @details Jobs from a worker go in its own deque, jobs from outside the
+ *          pool and jobs exceeding the deque capacity go in the shared
+ *          queue.
+ *
+ * @param[in] jpp       pointer to a @p job_pool_t structure
+ * @param[in] wp        pointer to the worker submitting the job or @p NULL
+ * @param[in] pjp       pointer to the job to be queued
+ * @param[in] jgp       pointer to the job group or @p NULL
+ *
+ * @notapi
+ */
+static void pool_submit(job_pool_t *jpp, job_worker_t *wp,
+                        pooled_job_t *pjp, job_group_t *jgp) {
+
+  chDbgCheck((pjp != NULL) && (pjp->jobfunc != NULL));
+
+  /* The group is accounted before the job becomes visible.*/
+  pjp->group = jgp;
+  if (jgp != NULL) {
+    jgp->pending++;
+  }
+
+  if ((wp == NULL) || !deque_push(wp, pjp)) {
+    pjp->next = NULL;
+    if (jpp->qtail != NULL) {
+      jpp->qtail->next = pjp;
+    }
+    else {
+      jpp->qhead = pjp;
+    }
+    jpp->qtail = pjp;
+  }
+}
+
+/**
+ * @brief   Wakes up idle workers.
+ *
+ * @param[in] jpp       pointer to a @p job_pool_t structure
+ * @param[in] n         maximum number of workers to be woken up
+ *
+ * @notapi
+ */
+static void pool_wakeup(job_pool_t *jpp, size_t n) {
+
+  while ((n > (size_t)0) && !chThdQueueIsEmptyI(&jpp->idleq)) {
+    chThdDequeueNextI(&jpp->idleq, MSG_OK);
+    n--;
+  }
+}
+
+/**
+ * @brief   Wakes up idle workers after jobs have been pushed.
+ * @details The kernel lock is taken only if some worker is idle, workers
+ *          going idle raise the counter before checking the deques for
+ *          the last time.
+ *
+ * @param[in] jpp       pointer to a @p job_pool_t structure
+ * @param[in] n         maximum number of workers to be woken up
+ *
+ * @notapi
+ */
+static void pool_signal(job_pool_t *jpp, size_t n) {
+
+  CH_CFG_JOB_POOLS_BARRIER();
+  if (jpp->idle > 0U) {
+    chSysLock();
+    pool_wakeup(jpp, n);
+    chSchRescheduleS();
+    chSysUnlock();
+  }
+}
+
+/**
+ * @brief   Takes a job for a worker with an empty deque.
+ * @details The oldest job in the shared queue is returned, if the queue
+ *          is empty then the oldest job of another worker is stolen.
+ *
+ * @param[in] jpp       pointer to a @p job_pool_t structure
+ * @param[in] wp        pointer to a @p job_worker_t structure
+ * @return              The job or @p NULL if there are no jobs.
+ *
+ * @notapi
+ */
+static pooled_job_t *pool_take(job_pool_t *jpp, job_worker_t *wp) {
+  pooled_job_t *pjp;
+  unsigned i, self;
+
+  pjp = jpp->qhead;
+  if (pjp != NULL) {
+    jpp->qhead = pjp->next;
+    if (jpp->qhead == NULL) {
+      jpp->qtail = NULL;
+    }
+  }
+  else {
+    /*lint -save -e9033 [10.8] Perfectly safe pointers arithmetic.*/
+    self = (unsigned)(wp - jpp->workers);
+    /*lint -restore*/
+    for (i = 1U; i < jpp->n; i++) {
+      unsigned victim = self + i;
+
+      if (victim >= jpp->n) {
+        victim -= jpp->n;
+      }
+      pjp = deque_steal(&jpp->workers[victim]);
+      if (pjp != NULL) {
+        wp->stolen++;
+        break;
+      }
+    }
+  }
+
+  return pjp;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a job pool object.
+ *
+ * @param[out] jpp      pointer to a @p job_pool_t structure
+ * @param[in] workers   pointer to an array of @p job_worker_t structures
+ * @param[in] n         number of workers in the array
+ *
+ * @init
+ */
+void chJobPoolObjectInit(job_pool_t *jpp, job_worker_t *workers,
+                         unsigned n) {
+  unsigned i;
+
+  chDbgCheck((jpp != NULL) && (workers != NULL) && (n > 0U));
+
+  for (i = 0U; i < n; i++) {
+    workers[i].head   = 0U;
+    workers[i].tail   = 0U;
+    workers[i].pool   = jpp;
+    workers[i].thread = NULL;
+    workers[i].stolen = 0U;
+  }
+  jpp->workers = workers;
+  jpp->n       = n;
+  jpp->qhead   = NULL;
+  jpp->qtail   = NULL;
+  jpp->idle    = 0U;
+  jpp->stop    = false;
+  chThdQueueObjectInit(&jpp->idleq);
+}
+
+/**
+ * @brief   Submits a job to a pool.
+ * @note    The job is queued in the pool shared queue.
+ *
+ * @param[in] jpp       pointer to a @p job_pool_t structure
+ * @param[in] pjp       pointer to an initialized @p pooled_job_t object
+ * @param[in] jgp       pointer to the job group or @p NULL
+ *
+ * @iclass
+ */
+void chJobPoolSubmitI(job_pool_t *jpp, pooled_job_t *pjp,
+                      job_group_t *jgp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(jpp != NULL);
+
+  pool_submit(jpp, NULL, pjp, jgp);
+  pool_wakeup(jpp, (size_t)1);
+}
+
+/**
+ * @brief   Submits a job to a pool.
+ * @note    Jobs submitted by a worker are queued in its own deque, if the
+ *          job has no group then no critical zone is entered unless an
+ *          idle worker has to be woken up.
+ *
+ * @param[in] jpp       pointer to a @p job_pool_t structure
+ * @param[in] pjp       pointer to an initialized @p pooled_job_t object
+ * @param[in] jgp       pointer to the job group or @p NULL
+ *
+ * @api
+ */
+void chJobPoolSubmit(job_pool_t *jpp, pooled_job_t *pjp,
+                     job_group_t *jgp) {
+  job_worker_t *wp;
+
+  chDbgCheck(jpp != NULL);
+
+  wp = pool_self(jpp);
+  if ((wp != NULL) && (jgp == NULL)) {
+    chDbgCheck((pjp != NULL) && (pjp->jobfunc != NULL));
+
+    pjp->group = NULL;
+    if (deque_push(wp, pjp)) {
+      pool_signal(jpp, (size_t)1);
+      return;
+    }
+  }
+
+  chSysLock();
+  pool_submit(jpp, wp, pjp, jgp);
+  pool_wakeup(jpp, (size_t)1);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Submits an array of jobs to a pool.
+ * @details The jobs are queued in a single critical zone, at most one
+ *          idle worker is woken up for each job.
+ * @note    The jobs are queued in the pool shared queue.
+ *
+ * @param[in] jpp       pointer to a @p job_pool_t structure
+ * @param[in] pjps      pointer to an array of initialized @p pooled_job_t
+ *                      objects
+ * @param[in] n         number of jobs in the array
+ * @param[in] jgp       pointer to the job group or @p NULL
+ *
+ * @iclass
+ */
+void chJobPoolSubmitBatchI(job_pool_t *jpp, pooled_job_t *pjps,
+                           size_t n, job_group_t *jgp) {
+  size_t i;
+
+  chDbgCheckClassI();
+  chDbgCheck((jpp != NULL) && (pjps != NULL));
+
+  for (i = (size_t)0; i < n; i++) {
+    pool_submit(jpp, NULL, &pjps[i], jgp);
+  }
+  pool_wakeup(jpp, n);
+}
+
+/**
+ * @brief   Submits an array of jobs to a pool.
+ * @details The jobs are queued in a single critical zone, at most one
+ *          idle worker is woken up for each job.
+ * @note    Jobs submitted by a worker are queued in its own deque, if the
+ *          jobs have no group then no critical zone is entered unless
+ *          idle workers have to be woken up.
+ *
+ * @param[in] jpp       pointer to a @p job_pool_t structure
+ * @param[in] pjps      pointer to an array of initialized @p pooled_job_t
+ *                      objects
+ * @param[in] n         number of jobs in the array
+ * @param[in] jgp       pointer to the job group or @p NULL
+ *
+ * @api
+ */
+void chJobPoolSubmitBatch(job_pool_t *jpp, pooled_job_t *pjps,
+                          size_t n, job_group_t *jgp) {
+  job_worker_t *wp;
+  size_t i = (size_t)0;
+
+  chDbgCheck((jpp != NULL) && (pjps != NULL));
+
+  wp = pool_self(jpp);
+  if ((wp != NULL) && (jgp == NULL)) {
+    while (i < n) {
+      chDbgCheck(pjps[i].jobfunc != NULL);
+
+      pjps[i].group = NULL;
+      if (!deque_push(wp, &pjps[i])) {
+        break;
+      }
+      i++;
+    }
+    if (i >= n) {
+      pool_signal(jpp, n);
+      return;
+    }
+  }
+
+  chSysLock();
+  while (i < n) {
+    pool_submit(jpp, wp, &pjps[i], jgp);
+    i++;
+  }
+  pool_wakeup(jpp, n);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Waits for a job then executes it.
+ * @details This function is meant to be invoked in a loop by the thread
+ *          serving a worker, the worker is bound to the thread on the
+ *          first invocation.
+ * @note    Jobs in the worker own deque are taken without entering a
+ *          critical zone.
+ *
+ * @param[in] jpp       pointer to a @p job_pool_t structure
+ * @param[in] wp        pointer to the worker served by the calling thread
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The function outcome.
+ * @retval MSG_OK       if a job has been executed.
+ * @retval MSG_TIMEOUT  if a timeout occurred.
+ * @retval MSG_RESET    if the pool has been stopped and no jobs are left.
+ *
+ * @api
+ */
+msg_t chJobPoolDispatchTimeout(job_pool_t *jpp, job_worker_t *wp,
+                               sysinterval_t timeout) {
+  thread_t *tp = chThdGetSelfX();
+  pooled_job_t *pjp;
+  job_group_t *jgp;
+
+  chDbgCheck((jpp != NULL) && (wp != NULL) && (wp->pool == jpp));
+  chDbgAssert((wp->thread == NULL) || (wp->thread == tp),
+              "worker served by another thread");
+
+  wp->thread = tp;
+  tp->worker = wp;
+
+  pjp = deque_pop(wp);
+  if (pjp == NULL) {
+    chSysLock();
+
+    /* Waiting for a job, stealing if necessary.*/
+    pjp = pool_take(jpp, wp);
+    while (pjp == NULL) {
+      msg_t msg;
+
+      if (jpp->stop) {
+        tp->worker = NULL;
+        chSysUnlock();
+        return MSG_RESET;
+      }
+
+      /* The idle state is announced before checking for jobs again, a
+         worker pushing a job either sees the counter or its job is
+         found here.*/
+      jpp->idle++;
+      CH_CFG_JOB_POOLS_BARRIER();
+      pjp = pool_take(jpp, wp);
+      if (pjp == NULL) {
+        msg = chThdEnqueueTimeoutS(&jpp->idleq, timeout);
+        if (msg == MSG_TIMEOUT) {
+          jpp->idle--;
+          chSysUnlock();
+          return MSG_TIMEOUT;
+        }
+        pjp = pool_take(jpp, wp);
+      }
+      jpp->idle--;
+    }
+
+    chSysUnlock();
+  }
+
+  /* The job object can be reused by its owner as soon as the group is
+     signaled, the group pointer is fetched in advance.*/
+  jgp = pjp->group;
+  pjp->jobfunc(pjp->jobarg);
+
+  if (jgp != NULL) {
+    chSysLock();
+    jgp->pending--;
+    if (jgp->pending == (cnt_t)0) {
+      chThdResumeI(&jgp->tr, MSG_OK);
+      chSchRescheduleS();
+    }
+    chSysUnlock();
+  }
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Stops a job pool.
+ * @details The workers keep executing the queued jobs then their dispatch
+ *          function returns @p MSG_RESET.
+ * @post    The pool must be initialized again before being reused.
+ *
+ * @param[in] jpp       pointer to a @p job_pool_t structure
+ *
+ * @api
+ */
+void chJobPoolStop(job_pool_t *jpp) {
+
+  chDbgCheck(jpp != NULL);
+
+  chSysLock();
+  jpp->stop = true;
+  chThdDequeueAllI(&jpp->idleq, MSG_RESET);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Waits for all the jobs in a group to complete.
+ * @note    Only one thread at time can join a group.
+ *
+ * @param[in] jgp       pointer to a @p job_group_t structure
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if all the jobs have been completed.
+ * @retval MSG_TIMEOUT  if a timeout occurred.
+ *
+ * @api
+ */
+msg_t chJobGroupJoinTimeout(job_group_t *jgp, sysinterval_t timeout) {
+  msg_t msg = MSG_OK;
+
+  chDbgCheck(jgp != NULL);
+
+  chSysLock();
+  if (jgp->pending > (cnt_t)0) {
+    msg = chThdSuspendTimeoutS(&jgp->tr, timeout);
+  }
+  chSysUnlock();
+
+  return msg;
+}
+
+#endif /* CH_CFG_USE_JOB_POOLS == TRUE */
+
+/** @} */
@@ -69,6 +69,78 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Posts as many messages as the free slots allow.
+ * @details The waiting readers are woken up, at most one for each posted
+ *          message, a reschedule is not performed.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @param[in] msgp      pointer to the array of messages to be posted
+ * @param[in] n         number of messages in the array
+ * @return              The number of posted messages.
+ */
+static size_t mb_post_batch(mailbox_t *mbp, const msg_t *msgp, size_t n) {
+  size_t i, empty;
+
+  empty = chMBGetFreeCountI(mbp);
+  if (n > empty) {
+    n = empty;
+  }
+
+  for (i = (size_t)0; i < n; i++) {
+    *mbp->wrptr++ = msgp[i];
+    if (mbp->wrptr >= mbp->top) {
+      mbp->wrptr = mbp->buffer;
+    }
+  }
+  mbp->cnt += n;
+
+  /* Waking up the readers, each one will fetch at least a message.*/
+  i = (size_t)0;
+  while ((i < n) && !chThdQueueIsEmptyI(&mbp->qr)) {
+    chThdDequeueNextI(&mbp->qr, MSG_OK);
+    i++;
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Fetches as many messages as available.
+ * @details The waiting writers are woken up, at most one for each fetched
+ *          message, a reschedule is not performed.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @param[out] msgp     pointer to the array of fetched messages
+ * @param[in] n         number of messages in the array
+ * @return              The number of fetched messages.
+ */
+static size_t mb_fetch_batch(mailbox_t *mbp, msg_t *msgp, size_t n) {
+  size_t i, used;
+
+  used = chMBGetUsedCountI(mbp);
+  if (n > used) {
+    n = used;
+  }
+
+  for (i = (size_t)0; i < n; i++) {
+    msgp[i] = *mbp->rdptr++;
+    if (mbp->rdptr >= mbp->top) {
+      mbp->rdptr = mbp->buffer;
+    }
+  }
+  mbp->cnt -= n;
+
+  /* Waking up the writers, each one will post at least a message.*/
+  i = (size_t)0;
+  while ((i < n) && !chThdQueueIsEmptyI(&mbp->qw)) {
+    chThdDequeueNextI(&mbp->qw, MSG_OK);
+    i++;
+  }
+
+  return n;
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -392,6 +464,138 @@ msg_t chMBPostAheadI(mailbox_t *mbp, msg_t msg) {
   return MSG_TIMEOUT;
 }
 
+/**
+ * @brief   Posts multiple messages into a mailbox.
+ * @details The invoking thread waits until at least an empty slot in the
+ *          mailbox becomes available or the specified time runs out, then
+ *          as many messages as the free slots allow are posted in a single
+ *          critical zone.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @param[in] msgp      pointer to the array of messages to be posted
+ * @param[in] n         number of messages in the array
+ * @param[out] np       pointer to a variable receiving the number of posted
+ *                      messages
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if at least a message has been correctly posted.
+ * @retval MSG_RESET    if the mailbox has been reset.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @api
+ */
+msg_t chMBPostBatchTimeout(mailbox_t *mbp, const msg_t *msgp, size_t n,
+                           size_t *np, sysinterval_t timeout) {
+  msg_t rdymsg;
+
+  chSysLock();
+  rdymsg = chMBPostBatchTimeoutS(mbp, msgp, n, np, timeout);
+  chSysUnlock();
+
+  return rdymsg;
+}
+
+/**
+ * @brief   Posts multiple messages into a mailbox.
+ * @details The invoking thread waits until at least an empty slot in the
+ *          mailbox becomes available or the specified time runs out, then
+ *          as many messages as the free slots allow are posted in a single
+ *          critical zone.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @param[in] msgp      pointer to the array of messages to be posted
+ * @param[in] n         number of messages in the array
+ * @param[out] np       pointer to a variable receiving the number of posted
+ *                      messages
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if at least a message has been correctly posted.
+ * @retval MSG_RESET    if the mailbox has been reset.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @sclass
+ */
+msg_t chMBPostBatchTimeoutS(mailbox_t *mbp, const msg_t *msgp, size_t n,
+                            size_t *np, sysinterval_t timeout) {
+  msg_t rdymsg;
+
+  chDbgCheckClassS();
+  chDbgCheck((mbp != NULL) && (msgp != NULL) && (n > (size_t)0) &&
+             (np != NULL));
+
+  *np = (size_t)0;
+  do {
+    /* If the mailbox is in reset state then returns immediately.*/
+    if (mbp->reset) {
+      return MSG_RESET;
+    }
+
+    /* Are there free message slots in queue? if so then post.*/
+    if (chMBGetFreeCountI(mbp) > (size_t)0) {
+      *np = mb_post_batch(mbp, msgp, n);
+      chSchRescheduleS();
+
+      return MSG_OK;
+    }
+
+    /* No space in the queue, waiting for a slot to become available.*/
+    rdymsg = chThdEnqueueTimeoutS(&mbp->qw, timeout);
+  } while (rdymsg == MSG_OK);
+
+  return rdymsg;
+}
+
+/**
+ * @brief   Posts multiple messages into a mailbox.
+ * @details This variant is non-blocking, the function returns a timeout
+ *          condition if the queue is full.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @param[in] msgp      pointer to the array of messages to be posted
+ * @param[in] n         number of messages in the array
+ * @param[out] np       pointer to a variable receiving the number of posted
+ *                      messages
+ * @return              The operation status.
+ * @retval MSG_OK       if at least a message has been correctly posted.
+ * @retval MSG_RESET    if the mailbox has been reset.
+ * @retval MSG_TIMEOUT  if the mailbox is full and messages cannot be
+ *                      posted.
+ *
+ * @iclass
+ */
+msg_t chMBPostBatchI(mailbox_t *mbp, const msg_t *msgp, size_t n,
+                     size_t *np) {
+
+  chDbgCheckClassI();
+  chDbgCheck((mbp != NULL) && (msgp != NULL) && (n > (size_t)0) &&
+             (np != NULL));
+
+  *np = (size_t)0;
+
+  /* If the mailbox is in reset state then returns immediately.*/
+  if (mbp->reset) {
+    return MSG_RESET;
+  }
+
+  /* Are there free message slots in queue? if so then post.*/
+  if (chMBGetFreeCountI(mbp) > (size_t)0) {
+    *np = mb_post_batch(mbp, msgp, n);
+
+    return MSG_OK;
+  }
+
+  /* No space, immediate timeout.*/
+  return MSG_TIMEOUT;
+}
+
 /**
  * @brief   Retrieves a message from a mailbox.
  * @details The invoking thread waits until a message is posted in the mailbox
@@ -516,6 +720,140 @@ msg_t chMBFetchI(mailbox_t *mbp, msg_t *msgp) {
   /* No message, immediate timeout.*/
   return MSG_TIMEOUT;
 }
+
+/**
+ * @brief   Retrieves multiple messages from a mailbox.
+ * @details The invoking thread waits until at least a message is posted in
+ *          the mailbox or the specified time runs out, then all the
+ *          available messages, up to @p n, are fetched in a single
+ *          critical zone.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @param[out] msgp     pointer to an array of messages receiving the fetched
+ *                      messages
+ * @param[in] n         number of messages in the array
+ * @param[out] np       pointer to a variable receiving the number of fetched
+ *                      messages
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if at least a message has been correctly fetched.
+ * @retval MSG_RESET    if the mailbox has been reset.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @api
+ */
+msg_t chMBFetchBatchTimeout(mailbox_t *mbp, msg_t *msgp, size_t n,
+                            size_t *np, sysinterval_t timeout) {
+  msg_t rdymsg;
+
+  chSysLock();
+  rdymsg = chMBFetchBatchTimeoutS(mbp, msgp, n, np, timeout);
+  chSysUnlock();
+
+  return rdymsg;
+}
+
+/**
+ * @brief   Retrieves multiple messages from a mailbox.
+ * @details The invoking thread waits until at least a message is posted in
+ *          the mailbox or the specified time runs out, then all the
+ *          available messages, up to @p n, are fetched in a single
+ *          critical zone.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @param[out] msgp     pointer to an array of messages receiving the fetched
+ *                      messages
+ * @param[in] n         number of messages in the array
+ * @param[out] np       pointer to a variable receiving the number of fetched
+ *                      messages
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if at least a message has been correctly fetched.
+ * @retval MSG_RESET    if the mailbox has been reset.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @sclass
+ */
+msg_t chMBFetchBatchTimeoutS(mailbox_t *mbp, msg_t *msgp, size_t n,
+                             size_t *np, sysinterval_t timeout) {
+  msg_t rdymsg;
+
+  chDbgCheckClassS();
+  chDbgCheck((mbp != NULL) && (msgp != NULL) && (n > (size_t)0) &&
+             (np != NULL));
+
+  *np = (size_t)0;
+  do {
+    /* If the mailbox is in reset state then returns immediately.*/
+    if (mbp->reset) {
+      return MSG_RESET;
+    }
+
+    /* Are there messages in queue? if so then fetch.*/
+    if (chMBGetUsedCountI(mbp) > (size_t)0) {
+      *np = mb_fetch_batch(mbp, msgp, n);
+      chSchRescheduleS();
+
+      return MSG_OK;
+    }
+
+    /* No message in the queue, waiting for a message to become available.*/
+    rdymsg = chThdEnqueueTimeoutS(&mbp->qr, timeout);
+  } while (rdymsg == MSG_OK);
+
+  return rdymsg;
+}
+
+/**
+ * @brief   Retrieves multiple messages from a mailbox.
+ * @details This variant is non-blocking, the function returns a timeout
+ *          condition if the queue is empty.
+ *
+ * @param[in] mbp       the pointer to an initialized @p mailbox_t object
+ * @param[out] msgp     pointer to an array of messages receiving the fetched
+ *                      messages
+ * @param[in] n         number of messages in the array
+ * @param[out] np       pointer to a variable receiving the number of fetched
+ *                      messages
+ * @return              The operation status.
+ * @retval MSG_OK       if at least a message has been correctly fetched.
+ * @retval MSG_RESET    if the mailbox has been reset.
+ * @retval MSG_TIMEOUT  if the mailbox is empty and messages cannot be
+ *                      fetched.
+ *
+ * @iclass
+ */
+msg_t chMBFetchBatchI(mailbox_t *mbp, msg_t *msgp, size_t n, size_t *np) {
+
+  chDbgCheckClassI();
+  chDbgCheck((mbp != NULL) && (msgp != NULL) && (n > (size_t)0) &&
+             (np != NULL));
+
+  *np = (size_t)0;
+
+  /* If the mailbox is in reset state then returns immediately.*/
+  if (mbp->reset) {
+    return MSG_RESET;
+  }
+
+  /* Are there messages in queue? if so then fetch.*/
+  if (chMBGetUsedCountI(mbp) > (size_t)0) {
+    *np = mb_fetch_batch(mbp, msgp, n);
+
+    return MSG_OK;
+  }
+
+  /* No message, immediate timeout.*/
+  return MSG_TIMEOUT;
+}
 #endif /* CH_CFG_USE_MAILBOXES == TRUE */
 
 /** @} */
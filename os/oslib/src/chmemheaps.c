@@ -28,6 +28,10 @@
  *          library functions. The main difference is that the OS heap APIs
  *          are guaranteed to be thread safe and there is the ability to
  *          return memory blocks aligned to arbitrary powers of two.<br>
+ *          Optionally a Two-Level Segregated Fit allocator can be used
+ *          instead of the first-fit one, see @p CH_CFG_USE_HEAP_TLSF, free
+ *          blocks are kept in segregated lists indexed by bitmaps and both
+ *          allocation and release are performed in constant time.<br>
  * @pre     In order to use the heap APIs the @p CH_CFG_USE_HEAP option must
  *          be enabled in @p chconf.h.
  * @note    Compatible with RT and NIL.
@@ -55,16 +59,55 @@
 
 #define H_BLOCK(hp)     ((hp) + 1U)
 
-#define H_LIMIT(hp)     (H_BLOCK(hp) + H_PAGES(hp))
-
 #define H_NEXT(hp)      ((hp)->free.next)
 
-#define H_PAGES(hp)     ((hp)->free.pages)
-
 #define H_HEAP(hp)      ((hp)->used.heap)
 
 #define H_SIZE(hp)      ((hp)->used.size)
 
+#if (CH_CFG_USE_HEAP_TLSF == FALSE) || defined(__DOXYGEN__)
+#define H_LIMIT(hp)     (H_BLOCK(hp) + H_PAGES(hp))
+
+#define H_PAGES(hp)     ((hp)->free.pages)
+#else
+/*
+ * Block flags stored in the least significant bits of the block size.
+ */
+#define H_FREE          ((size_t)1)
+#define H_PREV_FREE     ((size_t)2)
+#define H_FLAGS         (H_FREE | H_PREV_FREE)
+
+#define H_PREV(hp)      ((hp)->free.prev)
+
+#define H_PHYS(hp)      ((hp)->free.phys)
+
+#define H_BSIZE(hp)     ((hp)->free.bsize & ~H_FLAGS)
+
+#define H_IS_FREE(hp)   (((hp)->free.bsize & H_FREE) != (size_t)0)
+
+#define H_IS_PREV_FREE(hp) (((hp)->free.bsize & H_PREV_FREE) != (size_t)0)
+
+#define H_PHYS_NEXT(hp)                                                     \
+  ((heap_header_t *)(void *)((uint8_t *)H_BLOCK(hp) + H_BSIZE(hp)))
+
+/*
+ * Smallest block that can be split from a larger one, a header plus one
+ * allocation unit.
+ */
+#define H_MIN_SPLIT     (sizeof (heap_header_t) + CH_HEAP_ALIGNMENT)
+
+/*
+ * Blocks smaller than this size all belong to the first level class zero.
+ */
+#define H_SMALL_SIZE    ((size_t)1 << CH_HEAP_TLSF_FL_SHIFT)
+
+/*
+ * Bit scan operations on non-zero 32 bits words.
+ */
+#define H_FFS(x)        port_ctz32((uint32_t)(x))
+#define H_FLS(x)        (31U - port_clz32((uint32_t)(x)))
+#endif
+
 /*
  * Number of pages between two pointers in a MISRA-compatible way.
  */
@@ -94,6 +137,222 @@ static memory_heap_t default_heap;
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Calculates the free list indexes of a block size.
+ *
+ * @param[in] size      block size, not greater than
+ *                      @p CH_HEAP_TLSF_MAX_SIZE
+ * @param[out] flp      first level index
+ * @param[out] slp      second level index
+ */
+static void tlsf_mapping(size_t size, unsigned *flp, unsigned *slp) {
+
+  if (size < H_SMALL_SIZE) {
+    *flp = 0U;
+    *slp = (unsigned)(size >> CH_HEAP_ALIGNMENT_LOG2);
+  }
+  else {
+    unsigned fl = H_FLS(size);
+
+    *slp = (unsigned)(size >> (fl - CH_HEAP_TLSF_SL_LOG2)) ^
+           CH_HEAP_TLSF_SL_COUNT;
+    *flp = (fl - CH_HEAP_TLSF_FL_SHIFT) + 1U;
+  }
+}
+
+/**
+ * @brief   Inserts a free block in its free list.
+ *
+ * @param[in] heapp     pointer to the heap
+ * @param[in] hp        pointer to the block
+ */
+static void tlsf_insert(memory_heap_t *heapp, heap_header_t *hp) {
+  unsigned fl, sl;
+
+  tlsf_mapping(H_BSIZE(hp), &fl, &sl);
+  H_PREV(hp) = NULL;
+  H_NEXT(hp) = heapp->lists[fl][sl];
+  if (H_NEXT(hp) != NULL) {
+    H_PREV(H_NEXT(hp)) = hp;
+  }
+  heapp->lists[fl][sl] = hp;
+  heapp->fl_map    |= 1U << fl;
+  heapp->sl_map[fl] |= 1U << sl;
+}
+
+/**
+ * @brief   Removes a free block from its free list.
+ *
+ * @param[in] heapp     pointer to the heap
+ * @param[in] hp        pointer to the block
+ */
+static void tlsf_remove(memory_heap_t *heapp, heap_header_t *hp) {
+  unsigned fl, sl;
+
+  tlsf_mapping(H_BSIZE(hp), &fl, &sl);
+  if (H_NEXT(hp) != NULL) {
+    H_PREV(H_NEXT(hp)) = H_PREV(hp);
+  }
+  if (H_PREV(hp) != NULL) {
+    H_NEXT(H_PREV(hp)) = H_NEXT(hp);
+  }
+  else {
+    heapp->lists[fl][sl] = H_NEXT(hp);
+    if (H_NEXT(hp) == NULL) {
+      heapp->sl_map[fl] &= ~(1U << sl);
+      if (heapp->sl_map[fl] == 0U) {
+        heapp->fl_map &= ~(1U << fl);
+      }
+    }
+  }
+}
+
+/**
+ * @brief   Finds a free block of at least the specified size.
+ * @details The size is rounded up to the next class so that any block in
+ *          the first non-empty class found is large enough. If no such
+ *          class exists then only the first block of the class containing
+ *          the size is checked, the list is never walked so this is a
+ *          constant time operation.
+ * @note    A request can fail even if a large enough block exists in the
+ *          class of the requested size, this is the usual TLSF trade-off
+ *          between determinism and fragmentation.
+ *
+ * @param[in] heapp     pointer to the heap
+ * @param[in] size      required size
+ * @return              The free block, still linked in its free list.
+ * @retval NULL         if a suitable block does not exist.
+ */
+static heap_header_t *tlsf_find(memory_heap_t *heapp, size_t size) {
+  heap_header_t *hp;
+  unsigned fl, sl;
+  size_t rsize;
+
+  /* Rounding up to the next class, small classes are exact.*/
+  rsize = size;
+  if (size >= H_SMALL_SIZE) {
+    rsize += ((size_t)1 << (H_FLS(size) - CH_HEAP_TLSF_SL_LOG2)) - (size_t)1;
+  }
+
+  if (rsize <= CH_HEAP_TLSF_MAX_SIZE) {
+    uint32_t map;
+
+    /* Searching for the first non-empty class starting from the one of
+       the rounded size, any block in it is large enough.*/
+    tlsf_mapping(rsize, &fl, &sl);
+    map = heapp->sl_map[fl] & (0xFFFFFFFFU << sl);
+    if (map == 0U) {
+      map = heapp->fl_map & (0xFFFFFFFFU << (fl + 1U));
+      if (map != 0U) {
+        fl  = H_FFS(map);
+        map = heapp->sl_map[fl];
+      }
+    }
+    if (map != 0U) {
+      return heapp->lists[fl][H_FFS(map)];
+    }
+  }
+
+  if (rsize == size) {
+    return NULL;
+  }
+
+  /* Last chance, the first block in the class of the requested size
+     itself, it could be large enough.*/
+  tlsf_mapping(size, &fl, &sl);
+  hp = heapp->lists[fl][sl];
+  if ((hp != NULL) && (H_BSIZE(hp) >= size)) {
+    return hp;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief   Splits a block.
+ * @details The block is shrunk to the specified size, the excess becomes a
+ *          new free block which is returned, it is not inserted in the free
+ *          lists.
+ *
+ * @param[in] hp        pointer to the block
+ * @param[in] size      new size of the block
+ * @return              The excess block.
+ */
+static heap_header_t *tlsf_split(heap_header_t *hp, size_t size) {
+  heap_header_t *rp, *np;
+
+  np = H_PHYS_NEXT(hp);
+  /*lint -save -e9087 [11.3] Safe cast.*/
+  rp = (heap_header_t *)(void *)((uint8_t *)H_BLOCK(hp) + size);
+  /*lint -restore*/
+  rp->free.bsize = ((H_BSIZE(hp) - size) - sizeof (heap_header_t)) | H_FREE;
+  if (H_IS_FREE(hp)) {
+    rp->free.bsize |= H_PREV_FREE;
+  }
+  H_PHYS(rp) = hp;
+  H_PHYS(np) = rp;
+  np->free.bsize |= H_PREV_FREE;
+  hp->free.bsize = size | (hp->free.bsize & H_FLAGS);
+
+  return rp;
+}
+
+/**
+ * @brief   Adds a memory area to an heap as free blocks.
+ * @details The area is terminated by an used sentinel block with zero
+ *          size, areas larger than @p CH_HEAP_TLSF_MAX_SIZE are split in
+ *          multiple blocks.
+ *
+ * @param[in] heapp     pointer to the heap
+ * @param[in] hp        pointer to the area, aligned to
+ *                      @p CH_HEAP_ALIGNMENT
+ * @param[in] size      size of the area, multiple of @p CH_HEAP_ALIGNMENT
+ */
+static void tlsf_add_area(memory_heap_t *heapp, heap_header_t *hp,
+                          size_t size) {
+  heap_header_t *pp = NULL;
+
+  while (size >= (sizeof (heap_header_t) + H_MIN_SPLIT)) {
+    size_t bsize = size - (sizeof (heap_header_t) * 2U);
+
+    if (bsize > CH_HEAP_TLSF_MAX_SIZE) {
+      bsize = CH_HEAP_TLSF_MAX_SIZE;
+    }
+    H_PHYS(hp) = pp;
+    hp->free.bsize = bsize | H_FREE | ((pp != NULL) ? H_PREV_FREE : (size_t)0);
+    tlsf_insert(heapp, hp);
+
+    size -= bsize + sizeof (heap_header_t);
+    pp = hp;
+    hp = H_PHYS_NEXT(hp);
+  }
+
+  /* Sentinel block.*/
+  if (pp != NULL) {
+    H_PHYS(hp) = pp;
+    hp->free.bsize = H_PREV_FREE;
+  }
+}
+
+/**
+ * @brief   Initializes the free lists of an heap, all lists empty.
+ *
+ * @param[in] heapp     pointer to the heap
+ */
+static void tlsf_init(memory_heap_t *heapp) {
+  unsigned fl, sl;
+
+  heapp->fl_map = 0U;
+  for (fl = 0U; fl < CH_HEAP_TLSF_FL_COUNT; fl++) {
+    heapp->sl_map[fl] = 0U;
+    for (sl = 0U; sl < CH_HEAP_TLSF_SL_COUNT; sl++) {
+      heapp->lists[fl][sl] = NULL;
+    }
+  }
+}
+#endif /* CH_CFG_USE_HEAP_TLSF == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -106,8 +365,12 @@ static memory_heap_t default_heap;
 void __heap_init(void) {
 
   default_heap.provider = chCoreAllocAlignedWithOffset;
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  tlsf_init(&default_heap);
+#else
   H_NEXT(&default_heap.header) = NULL;
   H_PAGES(&default_heap.header) = 0;
+#endif
 #if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
   chMtxObjectInit(&default_heap.mtx);
 #else
@@ -138,12 +401,18 @@ void chHeapObjectInit(memory_heap_t *heapp, void *buf, size_t size) {
   size -= (size_t)((uint8_t *)hp - (uint8_t *)buf);
   /*lint -restore*/
 
-  /* Initializing the heap header.*/
   heapp->provider = NULL;
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  /* Initializing the free lists then adding the whole area.*/
+  tlsf_init(heapp);
+  tlsf_add_area(heapp, hp, MEM_ALIGN_PREV(size, CH_HEAP_ALIGNMENT));
+#else
+  /* Initializing the heap header.*/
   H_NEXT(&heapp->header) = hp;
   H_PAGES(&heapp->header) = 0;
   H_NEXT(hp) = NULL;
   H_PAGES(hp) = (size - sizeof (heap_header_t)) / CH_HEAP_ALIGNMENT;
+#endif
 #if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
   chMtxObjectInit(&heapp->mtx);
 #else
@@ -152,8 +421,7 @@ void chHeapObjectInit(memory_heap_t *heapp, void *buf, size_t size) {
 }
 
 /**
- * @brief   Allocates a block of memory from the heap by using the first-fit
- *          algorithm.
+ * @brief   Allocates a block of memory from the heap.
  * @details The allocated block is guaranteed to be properly aligned to the
  *          specified alignment.
  *
@@ -169,6 +437,115 @@ void chHeapObjectInit(memory_heap_t *heapp, void *buf, size_t size) {
  * @api
  */
 void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align) {
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  heap_header_t *hp;
+  size_t asize, rsize;
+
+  chDbgCheck((size > 0U) && MEM_IS_VALID_ALIGNMENT(align));
+
+  /* If an heap is not specified then the default system header is used.*/
+  if (heapp == NULL) {
+    heapp = &default_heap;
+  }
+
+  /* Minimum alignment is constrained by the heap header structure size.*/
+  if (align < CH_HEAP_ALIGNMENT) {
+    align = CH_HEAP_ALIGNMENT;
+  }
+
+  /* Size is aligned to the allocation unit, checking for overflow in the
+     alignment rounding and for sizes not representable in the free
+     lists.*/
+  asize = MEM_ALIGN_NEXT(size, CH_HEAP_ALIGNMENT);
+  if ((asize < size) || (asize > CH_HEAP_TLSF_MAX_SIZE)) {
+    return NULL;
+  }
+
+  /* Stricter alignments require space for a leading free block.*/
+  rsize = asize;
+  if (align > CH_HEAP_ALIGNMENT) {
+    rsize += (size_t)align + H_MIN_SPLIT;
+  }
+
+  /* Taking heap mutex/semaphore.*/
+  H_LOCK(heapp);
+
+  hp = tlsf_find(heapp, rsize);
+  if (hp != NULL) {
+    tlsf_remove(heapp, hp);
+
+    if (align > CH_HEAP_ALIGNMENT) {
+      uint8_t *bp = (uint8_t *)H_BLOCK(hp);
+      size_t gap;
+
+      /* The gap before the aligned position must be able to contain
+         a free block.*/
+      gap = MEM_ALIGN_NEXT(bp, align) - (size_t)bp;
+      if ((gap > 0U) && (gap < H_MIN_SPLIT)) {
+        gap = MEM_ALIGN_NEXT(bp + H_MIN_SPLIT, align) - (size_t)bp;
+      }
+
+      /* The leading part goes back in the free lists.*/
+      if (gap > 0U) {
+        heap_header_t *ahp = tlsf_split(hp, gap - sizeof (heap_header_t));
+        tlsf_insert(heapp, hp);
+        hp = ahp;
+      }
+    }
+
+    /* Marking the block as used.*/
+    hp->free.bsize &= ~H_FREE;
+    H_PHYS_NEXT(hp)->free.bsize &= ~H_PREV_FREE;
+
+    /* The excess goes back in the free lists.*/
+    if ((H_BSIZE(hp) - asize) >= H_MIN_SPLIT) {
+      tlsf_insert(heapp, tlsf_split(hp, asize));
+    }
+
+    /* Setting in the block owner heap and size.*/
+    H_SIZE(hp) = size;
+    H_HEAP(hp) = heapp;
+
+    /* Releasing heap mutex/semaphore.*/
+    H_UNLOCK(heapp);
+
+    /*lint -save -e9087 [11.3] Safe cast.*/
+    return (void *)H_BLOCK(hp);
+    /*lint -restore*/
+  }
+
+  /* Releasing heap mutex/semaphore.*/
+  H_UNLOCK(heapp);
+
+  /* More memory is required, tries to get it from the associated provider
+     else fails. The block is obtained with its own sentinel so that it
+     can be returned to the free lists later.*/
+  if (heapp->provider != NULL) {
+    heap_header_t *ahp;
+
+    ahp = heapp->provider(asize + sizeof (heap_header_t),
+                          align,
+                          sizeof (heap_header_t));
+    if (ahp != NULL) {
+      heap_header_t *sp;
+
+      hp = ahp - 1U;
+      H_PHYS(hp) = NULL;
+      hp->free.bsize = asize;
+      sp = H_PHYS_NEXT(hp);
+      H_PHYS(sp) = hp;
+      sp->free.bsize = (size_t)0;
+      H_HEAP(hp) = heapp;
+      H_SIZE(hp) = size;
+
+      /*lint -save -e9087 [11.3] Safe cast.*/
+      return (void *)ahp;
+      /*lint -restore*/
+    }
+  }
+
+  return NULL;
+#else /* CH_CFG_USE_HEAP_TLSF == FALSE */
   heap_header_t *qp, *hp, *ahp;
   size_t pages;
 
@@ -287,6 +664,7 @@ void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align) {
   }
 
   return NULL;
+#endif /* CH_CFG_USE_HEAP_TLSF == FALSE */
 }
 
 /**
@@ -297,6 +675,56 @@ void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align) {
  * @api
  */
 void chHeapFree(void *p) {
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  heap_header_t *hp, *np;
+  memory_heap_t *heapp;
+
+  chDbgCheck((p != NULL) && MEM_IS_ALIGNED(p, CH_HEAP_ALIGNMENT));
+
+  /*lint -save -e9087 [11.3] Safe cast.*/
+  hp = (heap_header_t *)p - 1U;
+  /*lint -restore*/
+  heapp = H_HEAP(hp);
+
+  /* Taking heap mutex/semaphore.*/
+  H_LOCK(heapp);
+
+  chDbgAssert(!H_IS_FREE(hp), "not allocated");
+
+  hp->free.bsize |= H_FREE;
+
+  /* Merging with the previous physical block if free.*/
+  if (H_IS_PREV_FREE(hp)) {
+    heap_header_t *pp = H_PHYS(hp);
+    size_t msize = H_BSIZE(pp) + sizeof (heap_header_t) + H_BSIZE(hp);
+
+    if (msize <= CH_HEAP_TLSF_MAX_SIZE) {
+      tlsf_remove(heapp, pp);
+      pp->free.bsize = msize | (pp->free.bsize & H_FLAGS);
+      hp = pp;
+      H_PHYS(H_PHYS_NEXT(hp)) = hp;
+    }
+  }
+
+  /* Merging with the next physical block if free.*/
+  np = H_PHYS_NEXT(hp);
+  if (H_IS_FREE(np)) {
+    size_t msize = H_BSIZE(hp) + sizeof (heap_header_t) + H_BSIZE(np);
+
+    if (msize <= CH_HEAP_TLSF_MAX_SIZE) {
+      tlsf_remove(heapp, np);
+      hp->free.bsize = msize | (hp->free.bsize & H_FLAGS);
+      np = H_PHYS_NEXT(hp);
+      H_PHYS(np) = hp;
+    }
+  }
+  np->free.bsize |= H_PREV_FREE;
+
+  tlsf_insert(heapp, hp);
+
+  /* Releasing heap mutex/semaphore.*/
+  H_UNLOCK(heapp);
+#else /* CH_CFG_USE_HEAP_TLSF == FALSE */
   heap_header_t *qp, *hp;
   memory_heap_t *heapp;
 
@@ -341,6 +769,7 @@ void chHeapFree(void *p) {
 
   /* Releasing heap mutex/semaphore.*/
   H_UNLOCK(heapp);
+#endif /* CH_CFG_USE_HEAP_TLSF == FALSE */
 }
 
 /**
@@ -359,6 +788,57 @@ void chHeapFree(void *p) {
  * @api
  */
 size_t chHeapStatus(memory_heap_t *heapp, size_t *totalp, size_t *largestp) {
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  size_t n, tsize, lsize;
+  uint32_t flmap;
+
+  if (heapp == NULL) {
+    heapp = &default_heap;
+  }
+
+  H_LOCK(heapp);
+  tsize = 0U;
+  lsize = 0U;
+  n = 0U;
+  flmap = heapp->fl_map;
+  while (flmap != 0U) {
+    unsigned fl = H_FFS(flmap);
+    uint32_t slmap = heapp->sl_map[fl];
+
+    while (slmap != 0U) {
+      unsigned sl = H_FFS(slmap);
+      heap_header_t *hp = heapp->lists[fl][sl];
+
+      while (hp != NULL) {
+        size_t bsize = H_BSIZE(hp);
+
+        /* Updating counters.*/
+        n++;
+        tsize += bsize;
+        if (bsize > lsize) {
+          lsize = bsize;
+        }
+
+        hp = H_NEXT(hp);
+      }
+      slmap &= ~(1U << sl);
+    }
+    flmap &= ~(1U << fl);
+  }
+
+  /* Writing out fragmented free memory.*/
+  if (totalp != NULL) {
+    *totalp = tsize;
+  }
+
+  /* Writing out unfragmented free memory.*/
+  if (largestp != NULL) {
+    *largestp = lsize;
+  }
+  H_UNLOCK(heapp);
+
+  return n;
+#else /* CH_CFG_USE_HEAP_TLSF == FALSE */
   heap_header_t *qp;
   size_t n, tpages, lpages;
 
@@ -396,6 +876,7 @@ size_t chHeapStatus(memory_heap_t *heapp, size_t *totalp, size_t *largestp) {
   H_UNLOCK(heapp);
 
   return n;
+#endif /* CH_CFG_USE_HEAP_TLSF == FALSE */
 }
 
 #endif /* CH_CFG_USE_HEAP == TRUE */
@@ -28,7 +28,10 @@
  *          problems.<br>
  *          Memory Pools do not enforce any alignment constraint on the
  *          contained object however the objects must be properly aligned
- *          to contain a pointer to void.
+ *          to contain a pointer to void.<br>
+ *          Objects can also be allocated and released through magazines,
+ *          private caches that exchange objects with the pool in batches
+ *          thus reducing the accesses to the system lock.
  * @pre     In order to use the memory pools APIs the @p CH_CFG_USE_MEMPOOLS option
  *          must be enabled in @p chconf.h.
  * @note    Compatible with RT and NIL.
@@ -55,6 +58,23 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Links a list of objects to the pool of a magazine.
+ * @note    The list tail is known so the objects are linked in constant
+ *          time.
+ *
+ * @param[in] mgp       pointer to a @p memory_magazine_t structure
+ * @param[in] first     first object of the list
+ * @param[in] last      last object of the list
+ */
+static inline void magazine_spill(memory_magazine_t *mgp,
+                                  struct pool_header *first,
+                                  struct pool_header *last) {
+
+  last->next = mgp->pool->next;
+  mgp->pool->next = first;
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -210,6 +230,146 @@ void chPoolFree(memory_pool_t *mp, void *objp) {
   chSysUnlock();
 }
 
+/**
+ * @brief   Initializes an empty memory pool magazine.
+ *
+ * @param[out] mgp      pointer to a @p memory_magazine_t structure
+ * @param[in] mp        pointer to the associated @p memory_pool_t structure
+ * @param[in] batch     number of objects moved from or to the pool in a
+ *                      single transfer, the magazine caches up to twice
+ *                      this number of objects
+ *
+ * @init
+ */
+void chPoolMagazineObjectInit(memory_magazine_t *mgp,
+                              memory_pool_t *mp,
+                              size_t batch) {
+
+  chDbgCheck((mgp != NULL) && (mp != NULL) && (batch > 0U));
+
+  mgp->pool     = mp;
+  mgp->next     = NULL;
+  mgp->last     = NULL;
+  mgp->n        = 0U;
+  mgp->full     = NULL;
+  mgp->fulllast = NULL;
+  mgp->batch    = batch;
+}
+
+/**
+ * @brief   Allocates an object when the magazine loaded list is empty.
+ * @details The reserve batch becomes the loaded list, if there is no
+ *          reserve batch then up to @p batch objects are taken from the
+ *          pool in a single critical zone.
+ *
+ * @param[in] mgp       pointer to a @p memory_magazine_t structure
+ * @return              The pointer to the allocated object.
+ * @retval NULL         if both the magazine and the pool are empty.
+ *
+ * @notapi
+ */
+void *__pool_magazine_load(memory_magazine_t *mgp) {
+  struct pool_header *php;
+
+  chDbgCheck(mgp != NULL);
+  chDbgAssert(mgp->n == 0U, "loaded list not empty");
+
+  if (mgp->full != NULL) {
+    php = mgp->full;
+    mgp->last = mgp->fulllast;
+    mgp->n    = mgp->batch;
+    mgp->full = NULL;
+  }
+  else {
+    memory_pool_t *mp = mgp->pool;
+    size_t n = 0U;
+
+    chSysLock();
+    php = mp->next;
+    if (php != NULL) {
+      struct pool_header *last = php;
+
+      /* Detaching up to a batch of objects from the pool.*/
+      n = 1U;
+      while ((n < mgp->batch) && (last->next != NULL)) {
+        last = last->next;
+        n++;
+      }
+      mp->next   = last->next;
+      last->next = NULL;
+      mgp->last  = last;
+    }
+    else {
+      php = (struct pool_header *)chPoolAllocI(mp);
+    }
+    chSysUnlock();
+
+    if ((php == NULL) || (n == 0U)) {
+      return (void *)php;
+    }
+    mgp->n = n;
+  }
+
+  /* The first object is returned, the remaining ones are cached.*/
+  mgp->next = php->next;
+  mgp->n--;
+
+  return (void *)php;
+}
+
+/**
+ * @brief   Makes room in a magazine with a full loaded list.
+ * @details The loaded list becomes the reserve batch, the previous reserve
+ *          batch, if any, is returned to the pool in a single critical
+ *          zone.
+ *
+ * @param[in] mgp       pointer to a @p memory_magazine_t structure
+ *
+ * @notapi
+ */
+void __pool_magazine_unload(memory_magazine_t *mgp) {
+
+  chDbgCheck(mgp != NULL);
+  chDbgAssert(mgp->n == mgp->batch, "loaded list not full");
+
+  if (mgp->full != NULL) {
+    chSysLock();
+    magazine_spill(mgp, mgp->full, mgp->fulllast);
+    chSysUnlock();
+  }
+  mgp->full     = mgp->next;
+  mgp->fulllast = mgp->last;
+  mgp->next     = NULL;
+  mgp->n        = 0U;
+}
+
+/**
+ * @brief   Returns all the objects cached in a magazine to its pool.
+ * @note    This function must be called before disposing a magazine or
+ *          its owner thread, cached objects would be lost otherwise.
+ *
+ * @param[in] mgp       pointer to a @p memory_magazine_t structure
+ *
+ * @api
+ */
+void chPoolMagazineFlush(memory_magazine_t *mgp) {
+
+  chDbgCheck(mgp != NULL);
+
+  chSysLock();
+  if (mgp->n > 0U) {
+    magazine_spill(mgp, mgp->next, mgp->last);
+  }
+  if (mgp->full != NULL) {
+    magazine_spill(mgp, mgp->full, mgp->fulllast);
+  }
+  chSysUnlock();
+
+  mgp->next = NULL;
+  mgp->n    = 0U;
+  mgp->full = NULL;
+}
+
 #if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Initializes an empty guarded memory pool.
@@ -0,0 +1,537 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation version 3 of the License.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/src/chrings.c
+ * @brief   Lock-free rings code.
+ * @details Single producer single consumer byte rings.
+ *          <h2>Operation mode</h2>
+ *          A ring is a byte FIFO connecting exactly one producer with
+ *          exactly one consumer, each side can be a thread or an ISR.
+ *          Operations defined for rings:
+ *          - <b>Reserve</b>: Returns a contiguous free area of the buffer,
+ *            the producer fills it in place.
+ *          - <b>Commit</b>: Makes reserved data visible to the consumer.
+ *          - <b>Peek</b>: Returns a contiguous area of queued data, the
+ *            consumer processes it in place.
+ *          - <b>Consume</b>: Releases processed data to the producer.
+ *          .
+ *          Each side only writes its own counter so the data path only
+ *          requires atomic loads and stores, the kernel lock is taken
+ *          only when a side has to wait because the ring is empty or
+ *          full, or when the other side is waiting.
+ * @pre     In order to use the rings APIs the @p CH_CFG_USE_RINGS
+ *          option must be enabled in @p chconf.h.
+ * @note    The buffer size must be a power of two.
+ * @note    Compatible with RT and NIL.
+ *
+ * @addtogroup oslib_rings
+ * @{
+ */
+
+#include <string.h>
+
+#include "ch.h"
+
+#if (CH_CFG_USE_RINGS == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+#if !defined(port_memory_barrier)
+/**
+ * @brief   Compiler-neutral compiler barrier.
+ * @details An empty function is called through a volatile pointer, the
+ *          compiler cannot see the call target so memory accesses are not
+ *          moved across the call.
+ */
+#define __ring_compiler_barrier()           ring_barrier_fn()
+#endif
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+#if !defined(port_memory_barrier)
+static void ring_barrier_stub(void);
+
+/**
+ * @brief   Pointer to the compiler barrier function.
+ */
+static void (* volatile ring_barrier_fn)(void) = ring_barrier_stub;
+#endif
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+#if !defined(port_memory_barrier)
+/**
+ * @brief   Empty function used as compiler barrier.
+ */
+static void ring_barrier_stub(void) {
+}
+#endif
+
+/**
+ * @brief   Waits for the other side of the ring.
+ * @details The waiting flag is raised before checking the condition again
+ *          so that the other side, after updating its counter, either
+ *          sees the flag or the condition is satisfied here.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @param[in] flagp     pointer to the waiting flag of this side
+ * @param[in] trp       pointer to the thread reference of this side
+ * @param[in] availf    function returning the available contiguous space
+ * @param[out] bpp      pointer to the area pointer
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @return              The available contiguous space or zero if the
+ *                      operation timed out.
+ *
+ * @notapi
+ */
+static size_t ring_wait(ring_t *rp, volatile bool *flagp,
+                        thread_reference_t *trp,
+                        size_t (*availf)(ring_t *rp, uint8_t **bpp),
+                        uint8_t **bpp, sysinterval_t timeout) {
+  size_t n;
+
+  chSysLock();
+  *flagp = true;
+  CH_CFG_RING_BARRIER();
+  n = availf(rp, bpp);
+  if (n == (size_t)0) {
+    (void) chThdSuspendTimeoutS(trp, timeout);
+    n = availf(rp, bpp);
+  }
+  *flagp = false;
+  chSysUnlock();
+
+  return n;
+}
+
+/**
+ * @brief   Wakes up the other side of the ring, if waiting.
+ *
+ * @param[in] flagp     pointer to the waiting flag of the other side
+ * @param[in] trp       pointer to the thread reference of the other side
+ *
+ * @iclass
+ */
+static void ring_wakeup_i(volatile bool *flagp, thread_reference_t *trp) {
+
+  *flagp = false;
+  chThdResumeI(trp, MSG_OK);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p ring_t object.
+ *
+ * @param[out] rp       the pointer to the @p ring_t structure to be
+ *                      initialized
+ * @param[in] buf       pointer to the ring buffer as an array of @p uint8_t
+ * @param[in] n         number of elements in the buffer array, it must be
+ *                      a power of two
+ *
+ * @init
+ */
+void chRingObjectInit(ring_t *rp, uint8_t *buf, size_t n) {
+
+  chDbgCheck((rp != NULL) && (buf != NULL) && (n > (size_t)0) &&
+             ((n & (n - (size_t)1)) == (size_t)0));
+
+  rp->buffer = buf;
+  rp->mask   = n - (size_t)1;
+  rp->wrcnt  = (size_t)0;
+  rp->rdcnt  = (size_t)0;
+  rp->wwait  = false;
+  rp->rwait  = false;
+  rp->wtr    = NULL;
+  rp->rtr    = NULL;
+}
+
+/**
+ * @brief   Reserves a contiguous free area in the ring.
+ * @details The returned area is the largest contiguous free area starting
+ *          at the write position, it can be smaller than the total free
+ *          space when the buffer end is reached.
+ * @note    This function can only be invoked by the producer.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @param[out] bpp      pointer to a variable receiving the area pointer
+ * @return              The size of the reserved area, zero if the ring
+ *                      is full.
+ *
+ * @xclass
+ */
+size_t chRingWriteReserveX(ring_t *rp, uint8_t **bpp) {
+  size_t wr, n, s1;
+
+  chDbgCheck((rp != NULL) && (bpp != NULL));
+
+  wr = rp->wrcnt;
+  n  = chRingGetSizeX(rp) - (wr - rp->rdcnt);
+
+  /* The consumer must be done with the area before it is overwritten.*/
+  CH_CFG_RING_BARRIER();
+
+  wr &= rp->mask;
+  s1 = chRingGetSizeX(rp) - wr;
+  if (n > s1) {
+    n = s1;
+  }
+  *bpp = &rp->buffer[wr];
+
+  return n;
+}
+
+/**
+ * @brief   Reserves a contiguous free area in the ring with timeout.
+ * @details If the ring is full then the invoking thread waits until some
+ *          space is released by the consumer or the specified time runs
+ *          out.
+ * @note    This function can only be invoked by the producer.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @param[out] bpp      pointer to a variable receiving the area pointer
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The size of the reserved area, zero if the
+ *                      operation timed out.
+ *
+ * @api
+ */
+size_t chRingWriteReserveTimeout(ring_t *rp, uint8_t **bpp,
+                                 sysinterval_t timeout) {
+  size_t n;
+
+  n = chRingWriteReserveX(rp, bpp);
+  if ((n == (size_t)0) && (timeout != TIME_IMMEDIATE)) {
+    n = ring_wait(rp, &rp->wwait, &rp->wtr, chRingWriteReserveX,
+                  bpp, timeout);
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Commits data written in a reserved area.
+ * @details The data becomes visible to the consumer, the consumer is
+ *          woken up if waiting.
+ * @note    This function can only be invoked by the producer.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @param[in] n         number of bytes to be committed, it must not exceed
+ *                      the size of the reserved area
+ *
+ * @api
+ */
+void chRingWriteCommit(ring_t *rp, size_t n) {
+
+  chDbgCheck((rp != NULL) && (n <= chRingGetFreeCountX(rp)));
+
+  /* Nothing to make visible, the other side is not woken up.*/
+  if (n == (size_t)0) {
+    return;
+  }
+
+  CH_CFG_RING_BARRIER();
+  rp->wrcnt = rp->wrcnt + n;
+  CH_CFG_RING_BARRIER();
+
+  if (rp->rwait) {
+    chSysLock();
+    ring_wakeup_i(&rp->rwait, &rp->rtr);
+    chSchRescheduleS();
+    chSysUnlock();
+  }
+}
+
+/**
+ * @brief   Commits data written in a reserved area from an ISR.
+ * @details The data becomes visible to the consumer, the consumer is
+ *          woken up if waiting.
+ * @note    This function can only be invoked by the producer.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @param[in] n         number of bytes to be committed, it must not exceed
+ *                      the size of the reserved area
+ *
+ * @isr
+ */
+void chRingWriteCommitFromISR(ring_t *rp, size_t n) {
+
+  chDbgCheck((rp != NULL) && (n <= chRingGetFreeCountX(rp)));
+
+  /* Nothing to make visible, the other side is not woken up.*/
+  if (n == (size_t)0) {
+    return;
+  }
+
+  CH_CFG_RING_BARRIER();
+  rp->wrcnt = rp->wrcnt + n;
+  CH_CFG_RING_BARRIER();
+
+  if (rp->rwait) {
+    chSysLockFromISR();
+    ring_wakeup_i(&rp->rwait, &rp->rtr);
+    chSysUnlockFromISR();
+  }
+}
+
+/**
+ * @brief   Returns a contiguous area of queued data.
+ * @details The returned area is the largest contiguous area of data
+ *          starting at the read position, it can be smaller than the
+ *          total queued data when the buffer end is reached.
+ * @note    This function can only be invoked by the consumer.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @param[out] bpp      pointer to a variable receiving the area pointer
+ * @return              The size of the data area, zero if the ring is
+ *                      empty.
+ *
+ * @xclass
+ */
+size_t chRingReadPeekX(ring_t *rp, uint8_t **bpp) {
+  size_t rd, n, s1;
+
+  chDbgCheck((rp != NULL) && (bpp != NULL));
+
+  rd = rp->rdcnt;
+  n  = rp->wrcnt - rd;
+
+  /* The data must be read after the counter that published it.*/
+  CH_CFG_RING_BARRIER();
+
+  rd &= rp->mask;
+  s1 = chRingGetSizeX(rp) - rd;
+  if (n > s1) {
+    n = s1;
+  }
+  *bpp = &rp->buffer[rd];
+
+  return n;
+}
+
+/**
+ * @brief   Returns a contiguous area of queued data with timeout.
+ * @details If the ring is empty then the invoking thread waits until some
+ *          data is committed by the producer or the specified time runs
+ *          out.
+ * @note    This function can only be invoked by the consumer.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @param[out] bpp      pointer to a variable receiving the area pointer
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The size of the data area, zero if the operation
+ *                      timed out.
+ *
+ * @api
+ */
+size_t chRingReadPeekTimeout(ring_t *rp, uint8_t **bpp,
+                             sysinterval_t timeout) {
+  size_t n;
+
+  n = chRingReadPeekX(rp, bpp);
+  if ((n == (size_t)0) && (timeout != TIME_IMMEDIATE)) {
+    n = ring_wait(rp, &rp->rwait, &rp->rtr, chRingReadPeekX,
+                  bpp, timeout);
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Releases processed data.
+ * @details The space becomes available to the producer, the producer is
+ *          woken up if waiting.
+ * @note    This function can only be invoked by the consumer.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @param[in] n         number of bytes to be released, it must not exceed
+ *                      the size of the peeked area
+ *
+ * @api
+ */
+void chRingReadConsume(ring_t *rp, size_t n) {
+
+  chDbgCheck((rp != NULL) && (n <= chRingGetUsedCountX(rp)));
+
+  /* Nothing to make visible, the other side is not woken up.*/
+  if (n == (size_t)0) {
+    return;
+  }
+
+  CH_CFG_RING_BARRIER();
+  rp->rdcnt = rp->rdcnt + n;
+  CH_CFG_RING_BARRIER();
+
+  if (rp->wwait) {
+    chSysLock();
+    ring_wakeup_i(&rp->wwait, &rp->wtr);
+    chSchRescheduleS();
+    chSysUnlock();
+  }
+}
+
+/**
+ * @brief   Releases processed data from an ISR.
+ * @details The space becomes available to the producer, the producer is
+ *          woken up if waiting.
+ * @note    This function can only be invoked by the consumer.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @param[in] n         number of bytes to be released, it must not exceed
+ *                      the size of the peeked area
+ *
+ * @isr
+ */
+void chRingReadConsumeFromISR(ring_t *rp, size_t n) {
+
+  chDbgCheck((rp != NULL) && (n <= chRingGetUsedCountX(rp)));
+
+  /* Nothing to make visible, the other side is not woken up.*/
+  if (n == (size_t)0) {
+    return;
+  }
+
+  CH_CFG_RING_BARRIER();
+  rp->rdcnt = rp->rdcnt + n;
+  CH_CFG_RING_BARRIER();
+
+  if (rp->wwait) {
+    chSysLockFromISR();
+    ring_wakeup_i(&rp->wwait, &rp->wtr);
+    chSysUnlockFromISR();
+  }
+}
+
+/**
+ * @brief   Ring write with timeout.
+ * @details The function copies data from a buffer into the ring. The
+ *          operation completes when the specified amount of data has been
+ *          transferred or after the specified timeout.
+ * @note    This function can only be invoked by the producer.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @param[in] bp        pointer to the data buffer
+ * @param[in] n         the number of bytes to be written
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of bytes effectively transferred. A number
+ *                      lower than @p n means that a timeout occurred.
+ *
+ * @api
+ */
+size_t chRingWriteTimeout(ring_t *rp, const uint8_t *bp,
+                          size_t n, sysinterval_t timeout) {
+  size_t max = n;
+
+  while (n > (size_t)0) {
+    uint8_t *p;
+    size_t done;
+
+    done = chRingWriteReserveTimeout(rp, &p, timeout);
+    if (done == (size_t)0) {
+      break;
+    }
+    if (done > n) {
+      done = n;
+    }
+    memcpy((void *)p, (const void *)bp, done);
+    chRingWriteCommit(rp, done);
+
+    n  -= done;
+    bp += done;
+  }
+
+  return max - n;
+}
+
+/**
+ * @brief   Ring read with timeout.
+ * @details The function copies data from the ring into a buffer. The
+ *          operation completes when the specified amount of data has been
+ *          transferred or after the specified timeout.
+ * @note    This function can only be invoked by the consumer.
+ *
+ * @param[in] rp        the pointer to an initialized @p ring_t object
+ * @param[out] bp       pointer to the data buffer
+ * @param[in] n         the number of bytes to be read
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of bytes effectively transferred. A number
+ *                      lower than @p n means that a timeout occurred.
+ *
+ * @api
+ */
+size_t chRingReadTimeout(ring_t *rp, uint8_t *bp,
+                         size_t n, sysinterval_t timeout) {
+  size_t max = n;
+
+  while (n > (size_t)0) {
+    uint8_t *p;
+    size_t done;
+
+    done = chRingReadPeekTimeout(rp, &p, timeout);
+    if (done == (size_t)0) {
+      break;
+    }
+    if (done > n) {
+      done = n;
+    }
+    memcpy((void *)bp, (const void *)p, done);
+    chRingReadConsume(rp, done);
+
+    n  -= done;
+    bp += done;
+  }
+
+  return max - n;
+}
+
+#endif /* CH_CFG_USE_RINGS == TRUE */
+
+/** @} */
@@ -37,6 +37,15 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Thread Pools APIs.
+ * @details If enabled then the thread pools APIs are included in the
+ *          kernel.
+ */
+#if !defined(CH_CFG_USE_THREAD_POOLS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_THREAD_POOLS             FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -56,10 +65,91 @@
 #error "CH_CFG_USE_DYNAMIC requires CH_CFG_USE_HEAP and/or CH_CFG_USE_MEMPOOLS"
 #endif
 
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) && (CH_CFG_USE_MEMPOOLS == FALSE)
+#error "CH_CFG_USE_THREAD_POOLS requires CH_CFG_USE_MEMPOOLS"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Thread task function.
+ */
+typedef msg_t (*thread_task_function_t)(void *arg);
+
+/**
+ * @brief   Type of a thread pool task.
+ * @details A task is executed by one of the threads of a pool, the task
+ *          object is also the handle used for joining it.
+ * @note    Tasks are owned by the submitter, an object can be submitted
+ *          again only after its completion.
+ */
+typedef struct ch_thread_task {
+  /**
+   * @brief   Next task in the pool queue.
+   */
+  struct ch_thread_task     *next;
+  /**
+   * @brief   Task function.
+   */
+  thread_task_function_t    func;
+  /**
+   * @brief   Argument to be passed to the task function.
+   */
+  void                      *arg;
+  /**
+   * @brief   Value returned by the task function.
+   */
+  msg_t                     result;
+  /**
+   * @brief   Task completed.
+   */
+  bool                      done;
+  /**
+   * @brief   Thread joining the task.
+   */
+  thread_reference_t        tr;
+} thread_task_t;
+
+/**
+ * @brief   Type of a thread pool.
+ * @details A thread pool owns a set of threads created once, the threads
+ *          are parked while there are no tasks to execute.
+ */
+typedef struct ch_thread_pool {
+  /**
+   * @brief   Oldest queued task.
+   */
+  thread_task_t             *head;
+  /**
+   * @brief   Newest queued task.
+   */
+  thread_task_t             *tail;
+  /**
+   * @brief   Queue of the parked threads.
+   */
+  threads_queue_t           idleq;
+  /**
+   * @brief   Array of the pool threads.
+   */
+  thread_t                  **threads;
+  /**
+   * @brief   Size of the threads array.
+   */
+  unsigned                  size;
+  /**
+   * @brief   Number of started threads.
+   */
+  unsigned                  n;
+  /**
+   * @brief   Pool stopping.
+   */
+  bool                      stop;
+} thread_pool_t;
+#endif /* CH_CFG_USE_THREAD_POOLS == TRUE */
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -83,6 +173,16 @@ extern "C" {
   thread_t *chThdCreateFromMemoryPool(memory_pool_t *mp, const char *name,
                                       tprio_t prio, tfunc_t pf, void *arg);
 #endif
+#if CH_CFG_USE_THREAD_POOLS == TRUE
+  void chThdPoolObjectInit(thread_pool_t *tpp, thread_t **threads,
+                           unsigned size);
+  unsigned chThdPoolStart(thread_pool_t *tpp, memory_pool_t *mp,
+                          const char *name, tprio_t prio);
+  void chThdPoolStop(thread_pool_t *tpp);
+  void chThdPoolSubmitI(thread_pool_t *tpp, thread_task_t *ttp);
+  void chThdPoolSubmit(thread_pool_t *tpp, thread_task_t *ttp);
+  msg_t chThdTaskJoin(thread_task_t *ttp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -91,6 +191,57 @@ extern "C" {
 /* Module inline functions.                                                  */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a thread task object.
+ *
+ * @param[out] ttp      pointer to a @p thread_task_t structure
+ * @param[in] func      the task function
+ * @param[in] arg       argument to be passed to the task function
+ *
+ * @init
+ */
+static inline void chThdTaskObjectInit(thread_task_t *ttp,
+                                       thread_task_function_t func,
+                                       void *arg) {
+
+  chDbgCheck((ttp != NULL) && (func != NULL));
+
+  ttp->next   = NULL;
+  ttp->func   = func;
+  ttp->arg    = arg;
+  ttp->result = MSG_OK;
+  ttp->done   = false;
+  ttp->tr     = NULL;
+}
+
+/**
+ * @brief   Returns @p true if a submitted task has been completed.
+ *
+ * @param[in] ttp       pointer to a @p thread_task_t structure
+ * @return              The task state.
+ *
+ * @xclass
+ */
+static inline bool chThdTaskIsDoneX(const thread_task_t *ttp) {
+
+  return ttp->done;
+}
+
+/**
+ * @brief   Returns the number of started threads in a pool.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t structure
+ * @return              The number of threads.
+ *
+ * @xclass
+ */
+static inline unsigned chThdPoolGetSizeX(const thread_pool_t *tpp) {
+
+  return tpp->n;
+}
+#endif /* CH_CFG_USE_THREAD_POOLS == TRUE */
+
 #endif /* CH_CFG_USE_DYNAMIC == TRUE */
 
 #endif /* CHDYNAMIC_H */
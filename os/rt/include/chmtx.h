@@ -60,6 +60,11 @@ struct ch_mutex {
                                                 @p NULL.                    */
   mutex_t               *next;      /**< @brief Next @p mutex_t into an
                                                 owner-list or @p NULL.      */
+  tprio_t               wprio;      /**< @brief Highest priority among
+                                                the threads waiting on this
+                                                mutex and on the mutexes
+                                                below it in the owner-list,
+                                                zero if none.               */
 #if (CH_CFG_USE_MUTEXES_RECURSIVE == TRUE) || defined(__DOXYGEN__)
   cnt_t                 cnt;        /**< @brief Mutex recursion counter.    */
 #endif
@@ -77,9 +82,9 @@ struct ch_mutex {
  * @param[in] name      the name of the mutex variable
  */
 #if (CH_CFG_USE_MUTEXES_RECURSIVE == TRUE) || defined(__DOXYGEN__)
-#define __MUTEX_DATA(name) {__CH_QUEUE_DATA(name.queue), NULL, NULL, 0}
+#define __MUTEX_DATA(name) {__CH_QUEUE_DATA(name.queue), NULL, NULL, (tprio_t)0, 0}
 #else
-#define __MUTEX_DATA(name) {__CH_QUEUE_DATA(name.queue), NULL, NULL}
+#define __MUTEX_DATA(name) {__CH_QUEUE_DATA(name.queue), NULL, NULL, (tprio_t)0}
 #endif
 
 /**
@@ -31,14 +31,96 @@
 /* Module constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Number of priority levels tracked by the ready list bitmap.
+ */
+#define CH_RBMAP_LEVELS                     256U
+
+/**
+ * @brief   Number of 32 bits words in the ready list bitmap.
+ */
+#define CH_RBMAP_WORDS                      (CH_RBMAP_LEVELS / 32U)
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Bitmap-indexed ready list.
+ * @details If enabled then the ready list keeps track of the last thread of
+ *          each priority level and of the non-empty levels into a bitmap,
+ *          threads insertion becomes a constant time operation regardless
+ *          of the number of ready threads.
+ * @note    The default is @p FALSE.
+ * @note    Requires about 1kB of RAM for each OS instance on 32 bits
+ *          architectures.
+ */
+#if !defined(CH_CFG_USE_READY_BITMAP) || defined(__DOXYGEN__)
+#define CH_CFG_USE_READY_BITMAP             FALSE
+#endif
+
+/**
+ * @brief   Virtual timers wheel slots.
+ * @details If non-zero then virtual timers are kept in a hashed timing
+ *          wheel with the specified number of slots instead of the delta
+ *          list, arming and disarming a timer become constant time
+ *          operations regardless of the number of armed timers.
+ * @note    The value must be zero or a power of two.
+ * @note    The default is zero, the delta list is used.
+ */
+#if !defined(CH_CFG_VT_WHEEL_SLOTS) || defined(__DOXYGEN__)
+#define CH_CFG_VT_WHEEL_SLOTS               0
+#endif
+
+/**
+ * @brief   Size of the threads registry names hash index.
+ * @details If non-zero then each registry keeps an open addressing hash
+ *          index of the threads names, @p chRegFindThreadByName() becomes
+ *          a constant time operation regardless of the number of threads.
+ *          Threads exceeding the index capacity are still found by
+ *          scanning the registry.
+ * @note    The value must be zero or a power of two.
+ * @note    The names are hashed when assigned, the content of a name
+ *          string must not change while the thread is registered.
+ * @note    Requires a port supporting recursive locks, threads are
+ *          moved in the index by @p chRegSetThreadNameX().
+ * @note    The default is zero, lookups scan the registry.
+ */
+#if !defined(CH_CFG_REGISTRY_HASH_SIZE) || defined(__DOXYGEN__)
+#define CH_CFG_REGISTRY_HASH_SIZE           0
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (CH_CFG_VT_WHEEL_SLOTS < 0) ||                                          \
+    ((CH_CFG_VT_WHEEL_SLOTS & (CH_CFG_VT_WHEEL_SLOTS - 1)) != 0)
+#error "CH_CFG_VT_WHEEL_SLOTS must be zero or a power of two"
+#endif
+
+#if (CH_CFG_REGISTRY_HASH_SIZE < 0) ||                                      \
+    ((CH_CFG_REGISTRY_HASH_SIZE & (CH_CFG_REGISTRY_HASH_SIZE - 1)) != 0)
+#error "CH_CFG_REGISTRY_HASH_SIZE must be zero or a power of two"
+#endif
+
+#if (CH_CFG_REGISTRY_HASH_SIZE > 0) &&                                      \
+    (CH_PORT_SUPPORTS_RECURSIVE_LOCKS == FALSE)
+#error "CH_CFG_REGISTRY_HASH_SIZE requires a port supporting recursive locks"
+#endif
+
+#if (CH_CFG_VT_WHEEL_SLOTS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Mask of the timers wheel slot index.
+ */
+#define CH_VTW_MASK                         ((systime_t)CH_CFG_VT_WHEEL_SLOTS - (systime_t)1)
+
+/**
+ * @brief   Number of 32 bits words in the timers wheel slots bitmap.
+ */
+#define CH_VTW_WORDS                        ((CH_CFG_VT_WHEEL_SLOTS + 31U) / 32U)
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -86,6 +168,14 @@ struct ch_virtual_timer {
    * @brief   Current reload interval.
    */
   sysinterval_t                 reload;
+#if (CH_CFG_VT_WHEEL_SLOTS > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Delay still to wait after the deadline in the wheel.
+   * @note    Non-zero only for delays too long for a single wheel
+   *          deadline.
+   */
+  sysinterval_t                 remaining;
+#endif
 };
 
 /**
@@ -119,6 +209,37 @@ typedef struct ch_virtual_timers_list {
 #endif
 } virtual_timers_list_t;
 
+#if (CH_CFG_VT_WHEEL_SLOTS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a virtual timers wheel.
+ * @details Armed timers are hashed on the slot of their deadline, each slot
+ *          is an unordered double linked list. In this mode the @p delta
+ *          field of the timers holds the absolute deadline of the timer
+ *          and the delta list header of @p virtual_timers_list_t is
+ *          always empty.
+ */
+typedef struct ch_virtual_timers_wheel {
+  /**
+   * @brief   Number of armed timers.
+   */
+  ucnt_t                        armed;
+#if (CH_CFG_ST_TIMEDELTA > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Deadline of the currently programmed alarm.
+   */
+  systime_t                     alarm;
+#endif
+  /**
+   * @brief   Slots bitmap, one bit for each non-empty slot.
+   */
+  uint32_t                      map[CH_VTW_WORDS];
+  /**
+   * @brief   Wheel slots.
+   */
+  ch_delta_list_t               slots[CH_CFG_VT_WHEEL_SLOTS];
+} virtual_timers_wheel_t;
+#endif
+
 /**
  * @brief   Type of a registry structure.
  */
@@ -127,6 +248,20 @@ typedef struct ch_registry {
    * @brief   Registry queue header.
    */
   ch_queue_t                    queue;
+#if (CH_CFG_REGISTRY_HASH_SIZE > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Names hash index, open addressing with linear probing.
+   */
+  void                          *index[CH_CFG_REGISTRY_HASH_SIZE];
+  /**
+   * @brief   Number of threads in the index.
+   */
+  unsigned                      indexed;
+  /**
+   * @brief   Number of named threads not fitting the index.
+   */
+  unsigned                      unindexed;
+#endif
 } registry_t;
 
 /**
@@ -221,6 +356,7 @@ struct ch_thread {
   /**
    * @brief   Thread consumed time in ticks.
    * @note    This field can overflow.
+   * @note    In tickless mode the time is accounted on context switches.
    */
   volatile systime_t            time;
 #endif
@@ -339,11 +475,23 @@ struct ch_thread {
    */
   void                          *mpool;
 #endif
+#if (defined(CH_CFG_USE_JOB_POOLS) && (CH_CFG_USE_JOB_POOLS == TRUE)) ||   \
+    defined(__DOXYGEN__)
+  /**
+   * @brief   Job pool worker served by this thread or @p NULL.
+   */
+  struct ch_job_worker          *worker;
+#endif
 #if (CH_DBG_STATISTICS == TRUE) || defined(__DOXYGEN__)
   /**
    * @brief   Thread statistics.
    */
   time_measurement_t            stats;
+  /**
+   * @brief   Realtime counter cycles spent executing the thread.
+   * @note    The time spent in ISRs is not included.
+   */
+  rttime_t                      cycles;
 #endif
 #if defined(CH_CFG_THREAD_EXTRA_FIELDS)
   /* Extra fields defined in chconf.h.*/
@@ -366,6 +514,29 @@ typedef struct ch_ready_list {
   thread_t                      *current;
 } ready_list_t;
 
+#if (CH_CFG_USE_READY_BITMAP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a ready list bitmap index.
+ * @details The ready list is still a single priority-ordered list, each
+ *          priority level is a FIFO segment of that list delimited by
+ *          the last thread of the level.
+ */
+typedef struct ch_ready_bitmap {
+  /**
+   * @brief   Summary word, one bit for each non-zero word of @p map.
+   */
+  uint32_t                      summary;
+  /**
+   * @brief   Levels bitmap, one bit for each non-empty priority level.
+   */
+  uint32_t                      map[CH_RBMAP_WORDS];
+  /**
+   * @brief   Last element of each priority level or @p NULL if empty.
+   */
+  ch_priority_queue_t           *tails[CH_RBMAP_LEVELS];
+} ready_bitmap_t;
+#endif
+
 /**
  * @brief   Type of an system instance configuration.
  */
@@ -452,6 +623,30 @@ struct ch_os_instance {
    */
   kernel_stats_t                kernel_stats;
 #endif
+#if ((CH_DBG_THREADS_PROFILING == TRUE) && (CH_CFG_ST_TIMEDELTA > 0)) ||    \
+    defined(__DOXYGEN__)
+  /**
+   * @brief   System time of the last context switch.
+   * @note    Used for threads profiling in tickless mode.
+   */
+  systime_t                     profiling_time;
+#endif
+#if (CH_CFG_USE_READY_BITMAP == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Ready list bitmap index.
+   * @note    Placed after the fields whose offsets are exported to
+   *          debuggers.
+   */
+  ready_bitmap_t                rbmap;
+#endif
+#if (CH_CFG_VT_WHEEL_SLOTS > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Virtual timers wheel.
+   * @note    Placed after the fields whose offsets are exported to
+   *          debuggers.
+   */
+  virtual_timers_wheel_t        vtwheel;
+#endif
 #if defined(PORT_INSTANCE_EXTRA_FIELDS) || defined(__DOXYGEN__)
   /* Extra fields from port layer.*/
   PORT_INSTANCE_EXTRA_FIELDS
@@ -158,6 +158,78 @@
 /* Module inline functions.                                                  */
 /*===========================================================================*/
 
+#if !defined(port_ctz32) || defined(__DOXYGEN__)
+/**
+ * @brief   Count of trailing zeros of a non-zero 32 bits word.
+ * @note    Portable implementation used when the port layer does not
+ *          provide a @p port_ctz32() macro.
+ *
+ * @param[in] x         the word, it must not be zero
+ * @return              The number of trailing zero bits.
+ */
+static inline unsigned port_ctz32(uint32_t x) {
+  unsigned n = 0U;
+
+  if ((x & 0x0000FFFFU) == 0U) {
+    n += 16U;
+    x >>= 16;
+  }
+  if ((x & 0x000000FFU) == 0U) {
+    n += 8U;
+    x >>= 8;
+  }
+  if ((x & 0x0000000FU) == 0U) {
+    n += 4U;
+    x >>= 4;
+  }
+  if ((x & 0x00000003U) == 0U) {
+    n += 2U;
+    x >>= 2;
+  }
+  if ((x & 0x00000001U) == 0U) {
+    n += 1U;
+  }
+
+  return n;
+}
+#endif
+
+#if !defined(port_clz32) || defined(__DOXYGEN__)
+/**
+ * @brief   Count of leading zeros of a non-zero 32 bits word.
+ * @note    Portable implementation used when the port layer does not
+ *          provide a @p port_clz32() macro.
+ *
+ * @param[in] x         the word, it must not be zero
+ * @return              The number of leading zero bits.
+ */
+static inline unsigned port_clz32(uint32_t x) {
+  unsigned n = 0U;
+
+  if ((x & 0xFFFF0000U) == 0U) {
+    n += 16U;
+    x <<= 16;
+  }
+  if ((x & 0xFF000000U) == 0U) {
+    n += 8U;
+    x <<= 8;
+  }
+  if ((x & 0xF0000000U) == 0U) {
+    n += 4U;
+    x <<= 4;
+  }
+  if ((x & 0xC0000000U) == 0U) {
+    n += 2U;
+    x <<= 2;
+  }
+  if ((x & 0x80000000U) == 0U) {
+    n += 1U;
+  }
+
+  return n;
+}
+#endif
+
 #endif /* CHPORT_H */
 
 /** @} */
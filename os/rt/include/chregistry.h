@@ -99,6 +99,16 @@ typedef struct {
 #define REG_HEADER(oip) (&(oip)->reglist.queue)
 #endif
 
+/**
+ * @brief   Access to the registry structure of an OS instance.
+ */
+#if (CH_CFG_SMP_MODE == TRUE) || defined(__DOXYGEN__)
+#define REG_LIST(oip) (&ch_system.reglist)
+#else
+#define REG_LIST(oip) (&(oip)->reglist)
+#endif
+
+#if (CH_CFG_REGISTRY_HASH_SIZE == 0) || defined(__DOXYGEN__)
 /**
  * @brief   Removes a thread from the registry list.
  * @note    This macro is not meant for use in application code.
@@ -115,6 +125,10 @@ typedef struct {
  * @param[in] tp        thread to add to the registry
  */
 #define REG_INSERT(oip, tp) ch_queue_insert(REG_HEADER(oip), &(tp)->rqueue)
+#else
+#define REG_REMOVE(tp) __reg_remove(tp)
+#define REG_INSERT(oip, tp) __reg_insert(oip, tp)
+#endif
 
 /*===========================================================================*/
 /* External declarations.                                                    */
@@ -129,6 +143,11 @@ extern "C" {
   thread_t *chRegFindThreadByName(const char *name);
   thread_t *chRegFindThreadByPointer(thread_t *tp);
   thread_t *chRegFindThreadByWorkingArea(stkalign_t *wa);
+#if CH_CFG_REGISTRY_HASH_SIZE > 0
+  void __reg_insert(os_instance_t *oip, thread_t *tp);
+  void __reg_remove(thread_t *tp);
+  void __reg_rename(thread_t *tp, const char *name);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -148,8 +167,18 @@ extern "C" {
  * @init
  */
 static inline void __reg_object_init(registry_t *rp) {
+#if CH_CFG_REGISTRY_HASH_SIZE > 0
+  unsigned i;
+#endif
 
   ch_queue_init(&rp->queue);
+#if CH_CFG_REGISTRY_HASH_SIZE > 0
+  for (i = 0U; i < (unsigned)CH_CFG_REGISTRY_HASH_SIZE; i++) {
+    rp->index[i] = NULL;
+  }
+  rp->indexed   = 0U;
+  rp->unindexed = 0U;
+#endif
 }
 
 /**
@@ -163,7 +192,11 @@ static inline void __reg_object_init(registry_t *rp) {
  */
 static inline void chRegSetThreadName(const char *name) {
 
-#if CH_CFG_USE_REGISTRY == TRUE
+#if (CH_CFG_USE_REGISTRY == TRUE) && (CH_CFG_REGISTRY_HASH_SIZE > 0)
+  chSysLock();
+  __reg_rename(__sch_get_currthread(), name);
+  chSysUnlock();
+#elif CH_CFG_USE_REGISTRY == TRUE
   __sch_get_currthread()->name = name;
 #else
   (void)name;
@@ -195,6 +228,9 @@ static inline const char *chRegGetThreadNameX(thread_t *tp) {
  * @brief   Changes the name of the specified thread.
  * @pre     This function only stores the pointer to the name if the option
  *          @p CH_CFG_USE_REGISTRY is enabled else no action is performed.
+ * @note    If @p CH_CFG_REGISTRY_HASH_SIZE is non-zero then the thread
+ *          is moved in the names index under the new name, the function
+ *          enters a critical zone.
  *
  * @param[in] tp        pointer to the thread
  * @param[in] name      thread name as a zero terminated string
@@ -203,7 +239,38 @@ static inline const char *chRegGetThreadNameX(thread_t *tp) {
  */
 static inline void chRegSetThreadNameX(thread_t *tp, const char *name) {
 
-#if CH_CFG_USE_REGISTRY == TRUE
+#if (CH_CFG_USE_REGISTRY == TRUE) && (CH_CFG_REGISTRY_HASH_SIZE > 0)
+  syssts_t sts;
+
+  sts = chSysGetStatusAndLockX();
+  __reg_rename(tp, name);
+  chSysRestoreStatusX(sts);
+#elif CH_CFG_USE_REGISTRY == TRUE
+  tp->name = name;
+#else
+  (void)tp;
+  (void)name;
+#endif
+}
+
+/**
+ * @brief   Changes the name of the specified thread.
+ * @details The thread is moved in the names index under the new name.
+ * @pre     This function only stores the pointer to the name if the option
+ *          @p CH_CFG_USE_REGISTRY is enabled else no action is performed.
+ *
+ * @param[in] tp        pointer to the thread
+ * @param[in] name      thread name as a zero terminated string
+ *
+ * @iclass
+ */
+static inline void chRegSetThreadNameI(thread_t *tp, const char *name) {
+
+  chDbgCheckClassI();
+
+#if (CH_CFG_USE_REGISTRY == TRUE) && (CH_CFG_REGISTRY_HASH_SIZE > 0)
+  __reg_rename(tp, name);
+#elif CH_CFG_USE_REGISTRY == TRUE
   tp->name = name;
 #else
   (void)tp;
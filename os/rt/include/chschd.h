@@ -157,6 +157,7 @@ extern "C" {
   void chSchPreemption(void);
   void chSchDoYieldS(void);
   thread_t *chSchSelectFirst(void);
+  thread_t *ch_sch_ready_dequeue(thread_t *tp, tprio_t prio);
 #if CH_CFG_OPTIMIZE_SPEED == FALSE
   void ch_sch_prio_insert(ch_queue_t *qp, ch_queue_t *tp);
 #endif /* CH_CFG_OPTIMIZE_SPEED == FALSE */
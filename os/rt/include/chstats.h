@@ -59,6 +59,16 @@ typedef struct {
                                                 critical zones duration.    */
   time_measurement_t    m_crit_isr; /**< @brief Measurement of ISRs critical
                                                 zones duration.             */
+  rttime_t              c_isr;      /**< @brief Cycles spent in ISRs.       */
+  rtcnt_t               t_last;     /**< @brief Start of the current
+                                                accounting interval.        */
+  ucnt_t                isr_level;  /**< @brief ISRs nesting level.         */
+#if (CH_CFG_USE_TM_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+  tm_histogram_t        h_crit_thd; /**< @brief Distribution of threads
+                                                critical zones duration.    */
+  tm_histogram_t        h_crit_isr; /**< @brief Distribution of ISRs
+                                                critical zones duration.    */
+#endif
 } kernel_stats_t;
 
 /*===========================================================================*/
@@ -74,11 +84,13 @@ extern "C" {
 #endif
   void __stats_init(void);
   void __stats_increase_irq(void);
+  void __stats_leave_irq(void);
   void __stats_ctxswc(thread_t *ntp, thread_t *otp);
   void __stats_start_measure_crit_thd(void);
   void __stats_stop_measure_crit_thd(void);
   void __stats_start_measure_crit_isr(void);
   void __stats_stop_measure_crit_isr(void);
+  rttime_t chStatsGetIsrCyclesX(void);
 #ifdef __cplusplus
 }
 #endif
@@ -101,6 +113,15 @@ static inline void __stats_object_init(kernel_stats_t *ksp) {
   ksp->n_ctxswc = (ucnt_t)0;
   chTMObjectInit(&ksp->m_crit_thd);
   chTMObjectInit(&ksp->m_crit_isr);
+#if CH_CFG_USE_TM_HISTOGRAMS == TRUE
+  chTMHistogramObjectInit(&ksp->h_crit_thd);
+  chTMHistogramObjectInit(&ksp->h_crit_isr);
+  chTMSetHistogramX(&ksp->m_crit_thd, &ksp->h_crit_thd);
+  chTMSetHistogramX(&ksp->m_crit_isr, &ksp->h_crit_isr);
+#endif
+  ksp->c_isr     = (rttime_t)0;
+  ksp->t_last    = (rtcnt_t)0;
+  ksp->isr_level = (ucnt_t)0;
 
   /* The initialization code will stop the measurement on the final call
      to chSysUnlock().*/
@@ -111,6 +132,7 @@ static inline void __stats_object_init(kernel_stats_t *ksp) {
 
 /* Stub functions for when the statistics module is disabled. */
 #define __stats_increase_irq()
+#define __stats_leave_irq()
 #define __stats_ctxswc(old, new)
 #define __stats_start_measure_crit_thd()
 #define __stats_stop_measure_crit_thd()
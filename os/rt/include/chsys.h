@@ -161,6 +161,7 @@
 #define CH_IRQ_EPILOGUE()                                                   \
   __dbg_check_leave_isr();                                                  \
   __trace_isr_leave(__func__);                                              \
+  __stats_leave_irq();                                                      \
   CH_CFG_IRQ_EPILOGUE_HOOK();                                               \
   PORT_IRQ_EPILOGUE()
 
@@ -291,6 +292,11 @@
 #define chSysGetRealtimeCounterX() (rtcnt_t)port_rt_get_counter_value()
 #endif
 
+/* In tickless mode threads profiling is performed on context switches.*/
+#if (CH_DBG_THREADS_PROFILING == FALSE) || (CH_CFG_ST_TIMEDELTA == 0)
+#define __sys_profiling_switch(otp)
+#endif
+
 /**
  * @brief   Performs a context switch.
  * @note    Not a user function, it is meant to be invoked by the scheduler
@@ -305,6 +311,7 @@
                                                                             \
   __trace_switch(ntp, otp);                                                 \
   __stats_ctxswc(ntp, otp);                                                 \
+  __sys_profiling_switch(otp);                                              \
   CH_CFG_CONTEXT_SWITCH_HOOK(ntp, otp);                                     \
   port_switch(ntp, otp);                                                    \
 }
@@ -336,6 +343,9 @@ extern "C" {
   void chSysTimerHandlerI(void);
   syssts_t chSysGetStatusAndLockX(void);
   void chSysRestoreStatusX(syssts_t sts);
+#if (CH_DBG_THREADS_PROFILING == TRUE) && (CH_CFG_ST_TIMEDELTA > 0)
+  void __sys_profiling_switch(thread_t *otp);
+#endif
 #if PORT_SUPPORTS_RT == TRUE
   bool chSysIsCounterWithinX(rtcnt_t cnt, rtcnt_t start, rtcnt_t end);
   void chSysPolledDelayX(rtcnt_t cycles);
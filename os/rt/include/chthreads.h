@@ -368,10 +368,39 @@ static inline tprio_t chThdGetPriorityX(void) {
 #if (CH_DBG_THREADS_PROFILING == TRUE) || defined(__DOXYGEN__)
 static inline systime_t chThdGetTicksX(thread_t *tp) {
 
+#if CH_CFG_ST_TIMEDELTA > 0
+  /* In tickless mode the time of the running thread is only accounted
+     when it is switched out, the current interval is added here.*/
+  if (tp == chThdGetSelfX()) {
+    return tp->time + (systime_t)chTimeDiffX(currcore->profiling_time,
+                                             chVTGetSystemTimeX());
+  }
+#endif
+
   return tp->time;
 }
 #endif
 
+/**
+ * @brief   Returns the realtime counter cycles consumed by a thread.
+ * @note    This function is only available when the
+ *          @p CH_DBG_STATISTICS configuration option is enabled.
+ * @note    The time spent in ISRs is not included, the cycles of the
+ *          current thread are updated when it is switched out or
+ *          interrupted.
+ *
+ * @param[in] tp        pointer to the thread
+ * @return              The number of consumed realtime counter cycles.
+ *
+ * @xclass
+ */
+#if (CH_DBG_STATISTICS == TRUE) || defined(__DOXYGEN__)
+static inline rttime_t chThdGetCyclesX(thread_t *tp) {
+
+  return tp->cycles;
+}
+#endif
+
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE) ||  \
     defined(__DOXYGEN__)
 /**
@@ -44,6 +44,24 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Time measurement histograms.
+ * @details If enabled then histograms can be attached to time measurement
+ *          objects in order to collect the distribution of the measurements.
+ */
+#if !defined(CH_CFG_USE_TM_HISTOGRAMS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_TM_HISTOGRAMS            FALSE
+#endif
+
+/**
+ * @brief   Histograms resolution.
+ * @details Each power of two range is split in 2^N linear buckets, the
+ *          relative error of the reported values is below 2^-N.
+ */
+#if !defined(CH_CFG_TM_HISTOGRAM_SUB_BITS) || defined(__DOXYGEN__)
+#define CH_CFG_TM_HISTOGRAM_SUB_BITS        3
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -52,6 +70,25 @@
 #error "CH_CFG_USE_TM requires PORT_SUPPORTS_RT"
 #endif
 
+#if (CH_CFG_TM_HISTOGRAM_SUB_BITS < 1) || (CH_CFG_TM_HISTOGRAM_SUB_BITS > 8)
+#error "invalid CH_CFG_TM_HISTOGRAM_SUB_BITS value"
+#endif
+
+/**
+ * @brief   Number of linear buckets in each power of two range.
+ */
+#define TM_HISTOGRAM_SUB_BUCKETS        (1U << CH_CFG_TM_HISTOGRAM_SUB_BITS)
+
+/**
+ * @brief   Number of buckets in a histogram.
+ * @details Values below @p TM_HISTOGRAM_SUB_BUCKETS have a bucket each,
+ *          then each power of two range up to the realtime counter width
+ *          has @p TM_HISTOGRAM_SUB_BUCKETS buckets.
+ */
+#define TM_HISTOGRAM_BUCKETS                                                \
+  (((sizeof (rtcnt_t) * 8U) - CH_CFG_TM_HISTOGRAM_SUB_BITS + 1U) <<         \
+   CH_CFG_TM_HISTOGRAM_SUB_BITS)
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -66,6 +103,20 @@ typedef struct {
   rtcnt_t               offset;
 } tm_calibration_t;
 
+#if (CH_CFG_USE_TM_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a measurements histogram.
+ * @details Buckets are log-linear, the bucket width grows with the value
+ *          keeping the relative error constant.
+ * @note    Updates do not use critical zones, an histogram must be updated
+ *          by a single context at time, readers can run concurrently and
+ *          could see a partially updated histogram.
+ */
+typedef struct {
+  ucnt_t                buckets[TM_HISTOGRAM_BUCKETS];
+} tm_histogram_t;
+#endif
+
 /**
  * @brief   Type of a Time Measurement object.
  * @note    The maximum measurable time period depends on the implementation
@@ -81,6 +132,10 @@ typedef struct {
   rtcnt_t               last;           /**< @brief Last measurement.       */
   ucnt_t                n;              /**< @brief Number of measurements. */
   rttime_t              cumulative;     /**< @brief Cumulative measurement. */
+#if (CH_CFG_USE_TM_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+  tm_histogram_t        *histogram;     /**< @brief Attached histogram or
+                                                    @p NULL.                */
+#endif
 } time_measurement_t;
 
 /*===========================================================================*/
@@ -99,6 +154,14 @@ extern "C" {
   NOINLINE void chTMStopMeasurementX(time_measurement_t *tmp);
   NOINLINE void chTMChainMeasurementToX(time_measurement_t *tmp1,
                                         time_measurement_t *tmp2);
+#if (CH_CFG_USE_TM_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+  void chTMHistogramObjectInit(tm_histogram_t *hp);
+  void chTMHistogramRecordX(tm_histogram_t *hp, rtcnt_t value);
+  ucnt_t chTMHistogramGetCountX(const tm_histogram_t *hp);
+  rtcnt_t chTMHistogramGetPercentileX(const tm_histogram_t *hp,
+                                      unsigned pct100);
+  rtcnt_t chTMHistogramGetBucketBaseX(unsigned i);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -107,6 +170,44 @@ extern "C" {
 /* Module inline functions.                                                  */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_TM_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Attaches an histogram to a time measurement object.
+ * @details Each following measurement is also recorded in the histogram.
+ *
+ * @param[in,out] tmp   pointer to a @p time_measurement_t structure
+ * @param[in] hp        pointer to an initialized @p tm_histogram_t
+ *                      structure or @p NULL for detaching
+ *
+ * @xclass
+ */
+static inline void chTMSetHistogramX(time_measurement_t *tmp,
+                                     tm_histogram_t *hp) {
+
+  tmp->histogram = hp;
+}
+
+/**
+ * @brief   Returns a percentile of a time measurement.
+ * @details The percentile is taken from the attached histogram and is
+ *          limited to the worst measurement, the bucket upper limit
+ *          could exceed it.
+ * @pre     An histogram must be attached to the measurement object.
+ *
+ * @param[in] tmp       pointer to a @p time_measurement_t structure
+ * @param[in] pct100    the percentile in hundredths of percent
+ * @return              The percentile value in realtime counter cycles.
+ *
+ * @xclass
+ */
+static inline rtcnt_t chTMGetPercentileX(const time_measurement_t *tmp,
+                                         unsigned pct100) {
+  rtcnt_t v = chTMHistogramGetPercentileX(tmp->histogram, pct100);
+
+  return v > tmp->worst ? tmp->worst : v;
+}
+#endif
+
 /**
  * @brief   Time measurement initialization.
  * @note    Internal use only.
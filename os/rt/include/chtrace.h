@@ -201,6 +201,15 @@ typedef struct {
    * @brief   Pointer to the buffer front.
    */
   trace_event_t         *ptr;
+  /**
+   * @brief   Pointer to the oldest record not yet read.
+   * @note    The buffer is empty when this pointer is equal to @p ptr.
+   */
+  trace_event_t         *rdptr;
+  /**
+   * @brief   Number of records overwritten before being read.
+   */
+  uint32_t              lost;
   /**
    * @brief   Ring buffer.
    */
@@ -259,6 +268,9 @@ extern "C" {
   void chTraceSuspend(uint16_t mask);
   void chTraceResumeI(uint16_t mask);
   void chTraceResume(uint16_t mask);
+  size_t chTraceReadI(trace_event_t *tep, size_t n);
+  size_t chTraceRead(trace_event_t *tep, size_t n);
+  uint32_t chTraceGetLostX(void);
 #endif /* CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED */
 #ifdef __cplusplus
 }
@@ -48,10 +48,6 @@
 #error "CH_CFG_TIME_QUANTUM not supported in tickless mode"
 #endif
 
-#if (CH_CFG_ST_TIMEDELTA > 0) && (CH_DBG_THREADS_PROFILING == TRUE)
-#error "CH_DBG_THREADS_PROFILING not supported in tickless mode"
-#endif
-
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -77,6 +73,9 @@ extern "C" {
   void chVTDoResetI(virtual_timer_t *vtp);
   sysinterval_t chVTGetRemainingIntervalI(virtual_timer_t *vtp);
   void chVTDoTickI(void);
+#if CH_CFG_VT_WHEEL_SLOTS > 0
+  bool ch_vt_wheel_get_state(sysinterval_t *timep);
+#endif
 #if CH_CFG_USE_TIMESTAMP == TRUE
   systimestamp_t chVTGetTimeStampI(void);
   void chVTResetTimeStampI(void);
@@ -213,6 +212,12 @@ static inline bool chVTIsSystemTimeWithin(systime_t start, systime_t end) {
  * @iclass
  */
 static inline bool chVTGetTimersStateI(sysinterval_t *timep) {
+#if CH_CFG_VT_WHEEL_SLOTS > 0
+
+  chDbgCheckClassI();
+
+  return ch_vt_wheel_get_state(timep);
+#else
   virtual_timers_list_t *vtlp = &currcore->vtlist;
   ch_delta_list_t *dlp = &vtlp->dlist;
 
@@ -232,6 +237,7 @@ static inline bool chVTGetTimersStateI(sysinterval_t *timep) {
   }
 
   return true;
+#endif
 }
 
 /**
@@ -49,6 +49,50 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Thread pool worker.
+ * @details Tasks are taken from the pool queue in FIFO order, the thread is
+ *          parked in the idle queue when there are no queued tasks.
+ *
+ * @param[in] arg       pointer to the @p thread_pool_t structure
+ */
+static THD_FUNCTION(thdpool_worker, arg) {
+  thread_pool_t *tpp = (thread_pool_t *)arg;
+
+  chSysLock();
+  while (true) {
+    thread_task_t *ttp = tpp->head;
+
+    if (ttp != NULL) {
+      msg_t msg;
+
+      tpp->head = ttp->next;
+      if (tpp->head == NULL) {
+        tpp->tail = NULL;
+      }
+      chSysUnlock();
+
+      msg = ttp->func(ttp->arg);
+
+      chSysLock();
+      ttp->result = msg;
+      ttp->done   = true;
+      chThdResumeS(&ttp->tr, msg);
+      continue;
+    }
+
+    /* The queue is drained before terminating.*/
+    if (tpp->stop) {
+      break;
+    }
+
+    (void) chThdEnqueueTimeoutS(&tpp->idleq, TIME_INFINITE);
+  }
+  chThdExitS(MSG_OK);
+}
+#endif /* CH_CFG_USE_THREAD_POOLS == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -163,6 +207,172 @@ thread_t *chThdCreateFromMemoryPool(memory_pool_t *mp, const char *name,
 }
 #endif /* CH_CFG_USE_MEMPOOLS == TRUE */
 
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a thread pool object.
+ *
+ * @param[out] tpp      pointer to a @p thread_pool_t structure
+ * @param[in] threads   array of pointers to be used for the pool threads
+ * @param[in] size      number of elements in the threads array
+ *
+ * @init
+ */
+void chThdPoolObjectInit(thread_pool_t *tpp, thread_t **threads,
+                         unsigned size) {
+
+  chDbgCheck((tpp != NULL) && (threads != NULL) && (size > 0U));
+
+  tpp->head    = NULL;
+  tpp->tail    = NULL;
+  chThdQueueObjectInit(&tpp->idleq);
+  tpp->threads = threads;
+  tpp->size    = size;
+  tpp->n       = 0U;
+  tpp->stop    = false;
+}
+
+/**
+ * @brief   Starts the threads of a thread pool.
+ * @details One thread is created for each element of the threads array,
+ *          the working areas are allocated from the specified memory pool.
+ *          Thread initialization, stack filling and registry insertion
+ *          happen here once, tasks submitted later are just handed to the
+ *          parked threads.
+ * @pre     The pool must be initialized to contain only objects with
+ *          alignment @p PORT_WORKING_AREA_ALIGN.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t structure
+ * @param[in] mp        pointer to the memory pool of the working areas
+ * @param[in] name      name of the pool threads
+ * @param[in] prio      the priority level for the pool threads
+ * @return              The number of started threads, it can be less than
+ *                      the threads array size if the memory pool runs out
+ *                      of objects.
+ *
+ * @api
+ */
+unsigned chThdPoolStart(thread_pool_t *tpp, memory_pool_t *mp,
+                        const char *name, tprio_t prio) {
+
+  chDbgCheck((tpp != NULL) && (mp != NULL));
+  chDbgAssert(tpp->n == 0U, "already started");
+
+  while (tpp->n < tpp->size) {
+    thread_t *tp = chThdCreateFromMemoryPool(mp, name, prio,
+                                             thdpool_worker, (void *)tpp);
+    if (tp == NULL) {
+      break;
+    }
+    tpp->threads[tpp->n] = tp;
+    tpp->n++;
+  }
+
+  return tpp->n;
+}
+
+/**
+ * @brief   Stops a thread pool.
+ * @details The queued tasks are executed then the pool threads terminate,
+ *          the function waits for all of them and their working areas are
+ *          returned to the memory pool.
+ * @note    No tasks can be submitted after calling this function.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t structure
+ *
+ * @api
+ */
+void chThdPoolStop(thread_pool_t *tpp) {
+  unsigned i;
+
+  chDbgCheck(tpp != NULL);
+
+  chSysLock();
+  tpp->stop = true;
+  chThdDequeueAllI(&tpp->idleq, MSG_RESET);
+  chSchRescheduleS();
+  chSysUnlock();
+
+  for (i = 0U; i < tpp->n; i++) {
+    (void) chThdWait(tpp->threads[i]);
+  }
+  tpp->n = 0U;
+}
+
+/**
+ * @brief   Submits a task to a thread pool.
+ * @note    This function does not reschedule.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t structure
+ * @param[in] ttp       pointer to an initialized @p thread_task_t
+ *                      structure
+ *
+ * @iclass
+ */
+void chThdPoolSubmitI(thread_pool_t *tpp, thread_task_t *ttp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((tpp != NULL) && (ttp != NULL));
+  chDbgAssert(!tpp->stop, "pool stopped");
+  chDbgAssert(ttp->tr == NULL, "task being joined");
+
+  ttp->next = NULL;
+  ttp->done = false;
+  if (tpp->tail == NULL) {
+    tpp->head = ttp;
+  }
+  else {
+    tpp->tail->next = ttp;
+  }
+  tpp->tail = ttp;
+
+  /* Waking up a parked thread, if any.*/
+  chThdDequeueNextI(&tpp->idleq, MSG_OK);
+}
+
+/**
+ * @brief   Submits a task to a thread pool.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t structure
+ * @param[in] ttp       pointer to an initialized @p thread_task_t
+ *                      structure
+ *
+ * @api
+ */
+void chThdPoolSubmit(thread_pool_t *tpp, thread_task_t *ttp) {
+
+  chSysLock();
+  chThdPoolSubmitI(tpp, ttp);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Waits for the completion of a task.
+ * @note    Only one thread can join a task.
+ *
+ * @param[in] ttp       pointer to a submitted @p thread_task_t structure
+ * @return              The value returned by the task function.
+ *
+ * @api
+ */
+msg_t chThdTaskJoin(thread_task_t *ttp) {
+  msg_t msg;
+
+  chDbgCheck(ttp != NULL);
+
+  chSysLock();
+  if (ttp->done) {
+    msg = ttp->result;
+  }
+  else {
+    msg = chThdSuspendS(&ttp->tr);
+  }
+  chSysUnlock();
+
+  return msg;
+}
+#endif /* CH_CFG_USE_THREAD_POOLS == TRUE */
+
 #endif /* CH_CFG_USE_DYNAMIC == TRUE */
 
 /** @} */
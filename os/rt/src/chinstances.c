@@ -110,6 +110,21 @@ void chInstanceObjectInit(os_instance_t *oip,
   /* Ready list initialization.*/
   ch_pqueue_init(&oip->rlist.pqueue);
 
+#if CH_CFG_USE_READY_BITMAP == TRUE
+  /* Ready list bitmap initialization, all levels empty.*/
+  {
+    unsigned i;
+
+    oip->rbmap.summary = 0U;
+    for (i = 0U; i < CH_RBMAP_WORDS; i++) {
+      oip->rbmap.map[i] = 0U;
+    }
+    for (i = 0U; i < CH_RBMAP_LEVELS; i++) {
+      oip->rbmap.tails[i] = NULL;
+    }
+  }
+#endif
+
 #if (CH_CFG_USE_REGISTRY == TRUE) && (CH_CFG_SMP_MODE == FALSE)
   /* Registry initialization when SMP mode is disabled.*/
   __reg_object_init(&oip->reglist);
@@ -123,6 +138,24 @@ void chInstanceObjectInit(os_instance_t *oip,
   /* Virtual timers list initialization.*/
   __vt_object_init(&oip->vtlist);
 
+#if CH_CFG_VT_WHEEL_SLOTS > 0
+  /* Virtual timers wheel initialization, all slots empty.*/
+  {
+    unsigned i;
+
+    oip->vtwheel.armed = (ucnt_t)0;
+#if CH_CFG_ST_TIMEDELTA > 0
+    oip->vtwheel.alarm = (systime_t)0;
+#endif
+    for (i = 0U; i < CH_VTW_WORDS; i++) {
+      oip->vtwheel.map[i] = 0U;
+    }
+    for (i = 0U; i < (unsigned)CH_CFG_VT_WHEEL_SLOTS; i++) {
+      ch_dlist_init(&oip->vtwheel.slots[i]);
+    }
+  }
+#endif
+
   /* Debug support initialization.*/
   __dbg_object_init(&oip->dbg);
 
@@ -161,6 +194,12 @@ void chInstanceObjectInit(os_instance_t *oip,
 #if CH_DBG_STATISTICS == TRUE
   /* Starting measurement for this thread.*/
   chTMStartMeasurementX(&oip->rlist.current->stats);
+  oip->kernel_stats.t_last = chSysGetRealtimeCounterX();
+#endif
+
+#if (CH_DBG_THREADS_PROFILING == TRUE) && (CH_CFG_ST_TIMEDELTA > 0)
+  /* Profiling starts from the current thread.*/
+  oip->profiling_time = chVTGetSystemTimeX();
 #endif
 
   /* User instance initialization hook.*/
@@ -59,8 +59,13 @@
  *          indirectly, holding the mutex gains the same priority of the
  *          waiting thread (if their priority was not already equal or higher).
  *          The mechanism works with any number of nested mutexes and any
- *          number of involved threads. The algorithm complexity (worst case)
- *          is N with N equal to the number of nested mutexes.
+ *          number of involved threads. The lock complexity (worst case) is
+ *          N with N equal to the depth of the threads-mutexes chain, the
+ *          number of waiting threads does not matter.<br>
+ *          Each mutex caches the highest priority among the threads
+ *          waiting on it and on the mutexes locked before it by the same
+ *          owner, so the owner priority is restored in constant time on
+ *          unlock.
  * @pre     In order to use the mutex APIs the @p CH_CFG_USE_MUTEXES option
  *          must be enabled in @p chconf.h.
  * @post    Enabling mutexes requires 5-12 (depending on the architecture)
@@ -88,6 +93,123 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Pushes a mutex on the owned mutexes list of a thread.
+ * @details The cached waiters priority of the mutex is calculated from its
+ *          queue and from the mutex previously on top of the list.
+ *
+ * @param[in] tp        pointer to the new owner thread
+ * @param[in] mp        pointer to the @p mutex_t structure
+ */
+static inline void mtx_push(thread_t *tp, mutex_t *mp) {
+  tprio_t prio = (tprio_t)0;
+
+  if (ch_queue_notempty(&mp->queue)) {
+    prio = threadref(mp->queue.next)->hdr.pqueue.prio;
+  }
+  if ((tp->mtxlist != NULL) && (tp->mtxlist->wprio > prio)) {
+    prio = tp->mtxlist->wprio;
+  }
+  mp->wprio   = prio;
+  mp->owner   = tp;
+  mp->next    = tp->mtxlist;
+  tp->mtxlist = mp;
+}
+
+/**
+ * @brief   Priority a thread must have because of its owned mutexes.
+ *
+ * @param[in] tp        pointer to the thread
+ * @return              The higher between the thread base priority and
+ *                      the priority of the threads waiting on its mutexes.
+ */
+static inline tprio_t mtx_owner_prio(thread_t *tp) {
+
+  if ((tp->mtxlist != NULL) && (tp->mtxlist->wprio > tp->realprio)) {
+    return tp->mtxlist->wprio;
+  }
+  return tp->realprio;
+}
+
+/**
+ * @brief   Moves a thread forward in a priority ordered threads queue.
+ * @details Used after the thread priority has been raised, the thread is
+ *          moved only if its new priority is higher than the priority of
+ *          the thread in front of it. The queue is scanned backward from
+ *          the current position so only the overtaken threads are visited,
+ *          the threads with equal or higher priority are not scanned.
+ *
+ * @param[in] qp        pointer to the queue header
+ * @param[in] tp        pointer to the thread
+ */
+static inline void mtx_requeue(ch_queue_t *qp, thread_t *tp) {
+  ch_queue_t *cp = tp->hdr.queue.prev;
+  tprio_t prio = tp->hdr.pqueue.prio;
+
+  if ((cp != qp) && (threadref(cp)->hdr.pqueue.prio < prio)) {
+    (void) ch_queue_dequeue(&tp->hdr.queue);
+    do {
+      cp = cp->prev;
+    } while ((cp != qp) && (threadref(cp)->hdr.pqueue.prio < prio));
+
+    /* Behind its peers, as ch_sch_prio_insert() would do.*/
+    ch_queue_insert(cp->next, &tp->hdr.queue);
+  }
+}
+
+/**
+ * @brief   Updates the cached priorities after a thread enqueued on a mutex.
+ * @details The mutex and all the mutexes locked after it by the same owner
+ *          are updated, the walk is bounded by the mutexes nesting level
+ *          of the owner.
+ *
+ * @param[in] mp        pointer to the @p mutex_t structure
+ * @param[in] prio      priority of the enqueued thread
+ */
+static void mtx_raise(mutex_t *mp, tprio_t prio) {
+  mutex_t *lmp = mp->owner->mtxlist;
+
+  while (true) {
+    chDbgAssert(lmp != NULL, "not owned");
+
+    if (lmp->wprio < prio) {
+      lmp->wprio = prio;
+    }
+    if (lmp == mp) {
+      break;
+    }
+    lmp = lmp->next;
+  }
+}
+
+/**
+ * @brief   Rebuilds the owned mutexes list of a thread.
+ * @details Used when a mutex is removed out of order, the cached priorities
+ *          are recalculated starting from the bottom of the list.
+ *
+ * @param[in] tp        pointer to the thread
+ */
+static void mtx_rebuild(thread_t *tp) {
+  mutex_t *mp = tp->mtxlist;
+  mutex_t *rmp = NULL;
+
+  /* Reversing the list, the first mutex locked goes on top.*/
+  while (mp != NULL) {
+    mutex_t *next = mp->next;
+    mp->next = rmp;
+    rmp = mp;
+    mp = next;
+  }
+
+  /* Pushing them again in lock order.*/
+  tp->mtxlist = NULL;
+  while (rmp != NULL) {
+    mutex_t *next = rmp->next;
+    mtx_push(tp, rmp);
+    rmp = next;
+  }
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -105,6 +227,7 @@ void chMtxObjectInit(mutex_t *mp) {
 
   ch_queue_init(&mp->queue);
   mp->owner = NULL;
+  mp->wprio = (tprio_t)0;
 #if CH_CFG_USE_MUTEXES_RECURSIVE == TRUE
   mp->cnt = (cnt_t)0;
 #endif
@@ -159,18 +282,26 @@ void chMtxLockS(mutex_t *mp) {
          priority of the running thread requesting the mutex.*/
       thread_t *tp = mp->owner;
 
+      /* The running thread is going to wait on the mutex.*/
+      mtx_raise(mp, currtp->hdr.pqueue.prio);
+
       /* Does the running thread have higher priority than the mutex
          owning thread? */
       while (tp->hdr.pqueue.prio < currtp->hdr.pqueue.prio) {
+        /* Previous priority of thread tp, required to locate it in the
+           ready list.*/
+        tprio_t prio = tp->hdr.pqueue.prio;
+
         /* Make priority of thread tp match the running thread's priority.*/
         tp->hdr.pqueue.prio = currtp->hdr.pqueue.prio;
 
         /* The following states need priority queues reordering.*/
         switch (tp->state) {
         case CH_STATE_WTMTX:
-          /* Re-enqueues the mutex owner with its new priority.*/
-          ch_sch_prio_insert(&tp->u.wtmtxp->queue,
-                             ch_queue_dequeue(&tp->hdr.queue));
+          /* Moves the mutex owner forward in the queue, only the waiting
+             threads it overtakes are scanned.*/
+          mtx_requeue(&tp->u.wtmtxp->queue, tp);
+          mtx_raise(tp->u.wtmtxp, currtp->hdr.pqueue.prio);
           tp = tp->u.wtmtxp->owner;
           /*lint -e{9042} [16.1] Continues the while.*/
           continue;
@@ -184,26 +315,26 @@ void chMtxLockS(mutex_t *mp) {
     (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE)
         case CH_STATE_WTSEM:
 #endif
-          /* Re-enqueues tp with its new priority on the queue.*/
-          ch_sch_prio_insert(&tp->u.wtmtxp->queue,
-                             ch_queue_dequeue(&tp->hdr.queue));
+          /* Moves tp forward in the queue with its new priority.*/
+          mtx_requeue(&tp->u.wtmtxp->queue, tp);
           break;
 #endif
 #if (CH_CFG_USE_MESSAGES == TRUE) &&                                        \
     (CH_CFG_USE_MESSAGES_PRIORITY == TRUE)
         case CH_STATE_SNDMSGQ:
-          /* Re-enqueues tp using the receiver message queue back-pointer. */
-          ch_sch_prio_insert((ch_queue_t *)tp->u.wtobjp,
-                             ch_queue_dequeue(&tp->hdr.queue));
+          /* Moves tp forward using the receiver message queue back-pointer. */
+          mtx_requeue((ch_queue_t *)tp->u.wtobjp, tp);
           break;
 #endif
         case CH_STATE_READY:
+          /* Removing tp from the ready list.*/
+          (void) ch_sch_ready_dequeue(tp, prio);
 #if CH_DBG_ENABLE_ASSERTS == TRUE
           /* Prevents an assertion in chSchReadyI().*/
           tp->state = CH_STATE_CURRENT;
 #endif
           /* Re-enqueues tp with its new priority on the ready list.*/
-          (void) chSchReadyI(threadref(ch_queue_dequeue(&tp->hdr.queue)));
+          (void) chSchReadyI(tp);
           break;
         default:
           /* Nothing to do for other states.*/
@@ -233,9 +364,7 @@ void chMtxLockS(mutex_t *mp) {
     mp->cnt++;
 #endif
     /* It was not owned, inserted in the owned mutexes list.*/
-    mp->owner = currtp;
-    mp->next = currtp->mtxlist;
-    currtp->mtxlist = mp;
+    mtx_push(currtp, mp);
   }
 }
 
@@ -307,9 +436,7 @@ bool chMtxTryLockS(mutex_t *mp) {
 
   mp->cnt++;
 #endif
-  mp->owner = currtp;
-  mp->next = currtp->mtxlist;
-  currtp->mtxlist = mp;
+  mtx_push(currtp, mp);
   return true;
 }
 
@@ -327,7 +454,6 @@ bool chMtxTryLockS(mutex_t *mp) {
  */
 void chMtxUnlock(mutex_t *mp) {
   thread_t *currtp = chThdGetSelfX();
-  mutex_t *lmp;
 
   if (mp->owner != currtp) {
       /*
@@ -359,24 +485,10 @@ void chMtxUnlock(mutex_t *mp) {
     if (chMtxQueueNotEmptyS(mp)) {
       thread_t *tp;
 
-      /* Recalculates the optimal thread priority by scanning the owned
-         mutexes list.*/
-      tprio_t newprio = currtp->realprio;
-      lmp = currtp->mtxlist;
-      while (lmp != NULL) {
-        /* If the highest priority thread waiting in the mutexes list has a
-           greater priority than the current thread base priority then the
-           final priority will have at least that priority.*/
-        if (chMtxQueueNotEmptyS(lmp) &&
-            ((threadref(lmp->queue.next))->hdr.pqueue.prio > newprio)) {
-          newprio = (threadref(lmp->queue.next))->hdr.pqueue.prio;
-        }
-        lmp = lmp->next;
-      }
-
       /* Assigns to the current thread the highest priority among all the
-         waiting threads.*/
-      currtp->hdr.pqueue.prio = newprio;
+         threads waiting on the remaining owned mutexes, the mutex on top
+         of the list caches it.*/
+      currtp->hdr.pqueue.prio = mtx_owner_prio(currtp);
 
       /* Awakens the highest priority thread waiting for the unlocked mutex and
          assigns the mutex to it.*/
@@ -384,9 +496,7 @@ void chMtxUnlock(mutex_t *mp) {
       mp->cnt = (cnt_t)1;
 #endif
       tp = threadref(ch_queue_fifo_remove(&mp->queue));
-      mp->owner = tp;
-      mp->next = tp->mtxlist;
-      tp->mtxlist = mp;
+      mtx_push(tp, mp);
 
       /* Note, not using chSchWakeupS() because that function expects the
          current thread to have the higher or equal priority than the ones
@@ -421,7 +531,6 @@ void chMtxUnlock(mutex_t *mp) {
  */
 void chMtxUnlockS(mutex_t *mp) {
   thread_t *currtp = chThdGetSelfX();
-  mutex_t *lmp;
 
   if (mp->owner != currtp) {
       /*
@@ -452,24 +561,10 @@ void chMtxUnlockS(mutex_t *mp) {
     if (chMtxQueueNotEmptyS(mp)) {
       thread_t *tp;
 
-      /* Recalculates the optimal thread priority by scanning the owned
-         mutexes list.*/
-      tprio_t newprio = currtp->realprio;
-      lmp = currtp->mtxlist;
-      while (lmp != NULL) {
-        /* If the highest priority thread waiting in the mutexes list has a
-           greater priority than the current thread base priority then the
-           final priority will have at least that priority.*/
-        if (chMtxQueueNotEmptyS(lmp) &&
-            ((threadref(lmp->queue.next))->hdr.pqueue.prio > newprio)) {
-          newprio = threadref(lmp->queue.next)->hdr.pqueue.prio;
-        }
-        lmp = lmp->next;
-      }
-
       /* Assigns to the current thread the highest priority among all the
-         waiting threads.*/
-      currtp->hdr.pqueue.prio = newprio;
+         threads waiting on the remaining owned mutexes, the mutex on top
+         of the list caches it.*/
+      currtp->hdr.pqueue.prio = mtx_owner_prio(currtp);
 
       /* Awakens the highest priority thread waiting for the unlocked mutex and
          assigns the mutex to it.*/
@@ -477,9 +572,7 @@ void chMtxUnlockS(mutex_t *mp) {
       mp->cnt = (cnt_t)1;
 #endif
       tp = threadref(ch_queue_fifo_remove(&mp->queue));
-      mp->owner = tp;
-      mp->next = tp->mtxlist;
-      tp->mtxlist = mp;
+      mtx_push(tp, mp);
       (void) chSchReadyI(tp);
     }
     else {
@@ -516,9 +609,7 @@ void chMtxUnlockAllS(void) {
         mp->cnt = (cnt_t)1;
 #endif
         tp = threadref(ch_queue_fifo_remove(&mp->queue));
-        mp->owner   = tp;
-        mp->next    = tp->mtxlist;
-        tp->mtxlist = mp;
+        mtx_push(tp, mp);
         (void) chSchReadyI(tp);
       }
       else {
@@ -584,40 +675,40 @@ void chMtxForceReleaseS(mutex_t *mp)
 		m->next = mp->next;
 	  }
 	}
+	// the cached priorities above the removed mutex could be stale
+	mtx_rebuild(currtp);
   }
 
   /* If a thread is waiting on the mutex then the fun part begins.*/
   if (chMtxQueueNotEmptyS(mp)) {
 	thread_t *tp;
-
-	/* Recalculates the optimal thread priority by scanning the owned
-	   mutexes list.*/
-	tprio_t newprio = currtp->realprio;
-	mutex_t *lmp = currtp->mtxlist;
-	while (lmp != NULL) {
-	  /* If the highest priority thread waiting in the mutexes list has a
-		 greater priority than the current thread base priority then the
-		 final priority will have at least that priority.*/
-	  if (chMtxQueueNotEmptyS(lmp) &&
-		  ((threadref(lmp->queue.next))->hdr.pqueue.prio > newprio)) {
-		newprio = (threadref(lmp->queue.next))->hdr.pqueue.prio;
-	  }
-	  lmp = lmp->next;
+	tprio_t prio = currtp->hdr.pqueue.prio;
+
+	/* Assigns to the owner thread the highest priority among all the
+	   threads waiting on the remaining owned mutexes.*/
+	currtp->hdr.pqueue.prio = mtx_owner_prio(currtp);
+
+	/* The owner is not necessarily the running thread, if it is in the
+	   ready list then it must be moved to its new priority level.*/
+	if ((currtp->state == CH_STATE_READY) &&
+	    (currtp->hdr.pqueue.prio != prio)) {
+	  /* Removing the owner from the ready list using its old priority.*/
+	  (void) ch_sch_ready_dequeue(currtp, prio);
+#if CH_DBG_ENABLE_ASSERTS == TRUE
+	  /* Prevents an assertion in chSchReadyI().*/
+	  currtp->state = CH_STATE_CURRENT;
+#endif
+	  /* Re-enqueues the owner with its new priority on the ready list.*/
+	  (void) chSchReadyI(currtp);
 	}
 
-	/* Assigns to the current thread the highest priority among all the
-	   waiting threads.*/
-	currtp->hdr.pqueue.prio = newprio;
-
 	/* Awakens the highest priority thread waiting for the unlocked mutex and
 	   assigns the mutex to it.*/
 #if CH_CFG_USE_MUTEXES_RECURSIVE == TRUE
 	mp->cnt = (cnt_t)1;
 #endif
 	tp = threadref(ch_queue_fifo_remove(&mp->queue));
-	mp->owner = tp;
-	mp->next = tp->mtxlist;
-	tp->mtxlist = mp;
+	mtx_push(tp, mp);
 
 	/* Note, not using chSchWakeupS() because that function expects the
 	   current thread to have the higher or equal priority than the ones
@@ -50,6 +50,17 @@
 
 #if (CH_CFG_USE_REGISTRY == TRUE) || defined(__DOXYGEN__)
 
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+#if (CH_CFG_REGISTRY_HASH_SIZE > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Mask of the names index slots.
+ */
+#define REG_INDEX_MASK      ((unsigned)CH_CFG_REGISTRY_HASH_SIZE - 1U)
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -66,6 +77,50 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_REGISTRY_HASH_SIZE > 0) || defined(__DOXYGEN__)
+static unsigned reg_hash(const char *name) {
+
+  return ch_hash_name(name, CH_HASH_NAME_UNBOUNDED, REG_INDEX_MASK);
+}
+
+static unsigned reg_home(const void *p) {
+
+  return reg_hash(((const thread_t *)p)->name);
+}
+
+static void reg_index_insert(registry_t *rp, thread_t *tp) {
+
+  /* Unnamed threads cannot be looked up.*/
+  if (tp->name == NULL) {
+    return;
+  }
+
+  /* One slot is always left empty in order to terminate the probes.*/
+  if (rp->indexed >= REG_INDEX_MASK) {
+    rp->unindexed++;
+    return;
+  }
+
+  ch_hash_insert(rp->index, REG_INDEX_MASK, reg_hash(tp->name), (void *)tp);
+  rp->indexed++;
+}
+
+static void reg_index_remove(registry_t *rp, thread_t *tp) {
+
+  if (tp->name == NULL) {
+    return;
+  }
+
+  if (ch_hash_remove(rp->index, REG_INDEX_MASK, reg_hash(tp->name),
+                     (const void *)tp, reg_home)) {
+    rp->indexed--;
+  }
+  else {
+    rp->unindexed--;
+  }
+}
+#endif /* CH_CFG_REGISTRY_HASH_SIZE > 0 */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -229,10 +284,44 @@ thread_t *chRegNextThread(thread_t *tp) {
 thread_t *chRegFindThreadByName(const char *name) {
   thread_t *ctp;
 
+#if CH_CFG_REGISTRY_HASH_SIZE > 0
+  registry_t *rp;
+  unsigned i;
+  bool scan;
+
+  chDbgCheck(name != NULL);
+
+  chSysLock();
+  rp = REG_LIST(currcore);
+  i = reg_hash(name);
+  while ((ctp = (thread_t *)rp->index[i]) != NULL) {
+    if (strcmp(ctp->name, name) == 0) {
+#if CH_CFG_USE_DYNAMIC == TRUE
+      chDbgAssert(ctp->refs < (trefs_t)255, "too many references");
+
+      ctp->refs++;
+#endif
+      chSysUnlock();
+
+      return ctp;
+    }
+    i = (i + 1U) & REG_INDEX_MASK;
+  }
+
+  /* The registry is scanned only if some threads did not fit the index.*/
+  scan = rp->unindexed > 0U;
+  chSysUnlock();
+  if (!scan) {
+    return NULL;
+  }
+#endif
+
   /* Scanning registry.*/
   ctp = chRegFirstThread();
   do {
-    if (strcmp(chRegGetThreadNameX(ctp), name) == 0) {
+    const char *ctpname = chRegGetThreadNameX(ctp);
+
+    if ((ctpname != NULL) && (strcmp(ctpname, name) == 0)) {
       return ctp;
     }
     ctp = chRegNextThread(ctp);
@@ -241,6 +330,59 @@ thread_t *chRegFindThreadByName(const char *name) {
   return NULL;
 }
 
+#if (CH_CFG_REGISTRY_HASH_SIZE > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Adds a thread to the registry and to its names index.
+ * @note    This function is not meant for use in application code.
+ *
+ * @param[in] oip       pointer to the OS instance
+ * @param[in] tp        thread to add to the registry
+ *
+ * @notapi
+ */
+void __reg_insert(os_instance_t *oip, thread_t *tp) {
+  registry_t *rp = REG_LIST(oip);
+
+  ch_queue_insert(REG_HEADER(oip), &tp->rqueue);
+  reg_index_insert(rp, tp);
+}
+
+/**
+ * @brief   Removes a thread from the registry and from its names index.
+ * @note    This function is not meant for use in application code.
+ *
+ * @param[in] tp        thread to remove from the registry
+ *
+ * @notapi
+ */
+void __reg_remove(thread_t *tp) {
+  registry_t *rp = REG_LIST(tp->owner);
+
+  reg_index_remove(rp, tp);
+  (void) ch_queue_dequeue(&tp->rqueue);
+}
+
+/**
+ * @brief   Changes the name of a registered thread.
+ * @details The thread is moved in the names index under the new name.
+ * @note    This function is not meant for use in application code.
+ *
+ * @param[in] tp        pointer to the thread
+ * @param[in] name      thread name as a zero terminated string
+ *
+ * @notapi
+ */
+void __reg_rename(thread_t *tp, const char *name) {
+  registry_t *rp = REG_LIST(tp->owner);
+
+  chDbgAssert(tp->state != CH_STATE_FINAL, "terminated thread");
+
+  reg_index_remove(rp, tp);
+  tp->name = name;
+  reg_index_insert(rp, tp);
+}
+#endif /* CH_CFG_REGISTRY_HASH_SIZE > 0 */
+
 /**
  * @brief   Confirms that a pointer is a valid thread pointer.
  * @note    The reference counter of the found thread is increased by one so
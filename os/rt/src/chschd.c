@@ -47,6 +47,178 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_READY_BITMAP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Marks a priority level as non-empty.
+ *
+ * @param[in] rbp       pointer to the ready list bitmap
+ * @param[in] prio      the priority level
+ *
+ * @notapi
+ */
+static inline void __sch_rbmap_set(ready_bitmap_t *rbp, tprio_t prio) {
+  unsigned w = (unsigned)prio >> 5;
+
+  rbp->map[w] |= 1U << ((unsigned)prio & 31U);
+  rbp->summary |= 1U << w;
+}
+
+/**
+ * @brief   Marks a priority level as empty.
+ *
+ * @param[in] rbp       pointer to the ready list bitmap
+ * @param[in] prio      the priority level
+ *
+ * @notapi
+ */
+static inline void __sch_rbmap_clear(ready_bitmap_t *rbp, tprio_t prio) {
+  unsigned w = (unsigned)prio >> 5;
+
+  rbp->tails[prio] = NULL;
+  rbp->map[w] &= ~(1U << ((unsigned)prio & 31U));
+  if (rbp->map[w] == 0U) {
+    rbp->summary &= ~(1U << w);
+  }
+}
+
+/**
+ * @brief   Returns the insertion point for a new priority level.
+ * @details The insertion point is the last element of the nearest non-empty
+ *          priority level above the specified one, the search is performed
+ *          in constant time using the bitmap.
+ *
+ * @param[in] oip       pointer to the OS instance
+ * @param[in] prio      the priority level
+ * @return              The element after which the new level starts.
+ * @retval &oip->rlist.pqueue if there are no threads at higher priority.
+ *
+ * @notapi
+ */
+static inline ch_priority_queue_t *__sch_rbmap_above(os_instance_t *oip,
+                                                     tprio_t prio) {
+  ready_bitmap_t *rbp = &oip->rbmap;
+  unsigned level = (unsigned)prio + 1U;
+  unsigned w = level >> 5;
+  uint32_t m;
+
+  if (likely(w < CH_RBMAP_WORDS)) {
+
+    /* Higher levels in the same word.*/
+    m = rbp->map[w] & ~((1U << (level & 31U)) - 1U);
+    if (m != 0U) {
+      return rbp->tails[(w << 5) + port_ctz32(m)];
+    }
+
+    /* Nearest non-empty word above.*/
+    m = rbp->summary & ~((2U << w) - 1U);
+    if (m != 0U) {
+      w = port_ctz32(m);
+      return rbp->tails[(w << 5) + port_ctz32(rbp->map[w])];
+    }
+  }
+
+  return &oip->rlist.pqueue;
+}
+#endif /* CH_CFG_USE_READY_BITMAP == TRUE */
+
+/**
+ * @brief   Inserts an element in the ready list placing it behind its peers.
+ *
+ * @param[in] oip       pointer to the OS instance
+ * @param[in] p         the pointer to the element to be inserted
+ * @return              The inserted element pointer.
+ *
+ * @notapi
+ */
+static inline ch_priority_queue_t *__sch_rlist_insert_behind(os_instance_t *oip,
+                                                             ch_priority_queue_t *p) {
+#if CH_CFG_USE_READY_BITMAP == TRUE
+  ready_bitmap_t *rbp = &oip->rbmap;
+  ch_priority_queue_t *pqp = rbp->tails[p->prio];
+
+  chDbgAssert(p->prio < CH_RBMAP_LEVELS, "invalid priority");
+
+  /* Going after the last peer or, if there are no peers, after the last
+     element of the nearest higher priority level.*/
+  if (pqp == NULL) {
+    pqp = __sch_rbmap_above(oip, p->prio);
+    __sch_rbmap_set(rbp, p->prio);
+  }
+  rbp->tails[p->prio] = p;
+
+  /* Insertion on next.*/
+  p->prev       = pqp;
+  p->next       = pqp->next;
+  p->next->prev = p;
+  pqp->next     = p;
+
+  return p;
+#else
+  return ch_pqueue_insert_behind(&oip->rlist.pqueue, p);
+#endif
+}
+
+/**
+ * @brief   Inserts an element in the ready list placing it ahead of its
+ *          peers.
+ *
+ * @param[in] oip       pointer to the OS instance
+ * @param[in] p         the pointer to the element to be inserted
+ * @return              The inserted element pointer.
+ *
+ * @notapi
+ */
+static inline ch_priority_queue_t *__sch_rlist_insert_ahead(os_instance_t *oip,
+                                                            ch_priority_queue_t *p) {
+#if CH_CFG_USE_READY_BITMAP == TRUE
+  ready_bitmap_t *rbp = &oip->rbmap;
+  ch_priority_queue_t *pqp;
+
+  chDbgAssert(p->prio < CH_RBMAP_LEVELS, "invalid priority");
+
+  /* The first peer, if any, follows the last element of the nearest higher
+     priority level.*/
+  pqp = __sch_rbmap_above(oip, p->prio);
+  if (rbp->tails[p->prio] == NULL) {
+    rbp->tails[p->prio] = p;
+    __sch_rbmap_set(rbp, p->prio);
+  }
+
+  /* Insertion on next.*/
+  p->prev       = pqp;
+  p->next       = pqp->next;
+  p->next->prev = p;
+  pqp->next     = p;
+
+  return p;
+#else
+  return ch_pqueue_insert_ahead(&oip->rlist.pqueue, p);
+#endif
+}
+
+/**
+ * @brief   Removes the highest priority element from the ready list.
+ *
+ * @param[in] oip       pointer to the OS instance
+ * @return              The removed element pointer.
+ *
+ * @notapi
+ */
+static inline ch_priority_queue_t *__sch_rlist_remove_highest(os_instance_t *oip) {
+#if CH_CFG_USE_READY_BITMAP == TRUE
+  ch_priority_queue_t *p = ch_pqueue_remove_highest(&oip->rlist.pqueue);
+
+  /* If it was the last element of its level then the level is now empty.*/
+  if (oip->rbmap.tails[p->prio] == p) {
+    __sch_rbmap_clear(&oip->rbmap, p->prio);
+  }
+
+  return p;
+#else
+  return ch_pqueue_remove_highest(&oip->rlist.pqueue);
+#endif
+}
+
 /**
  * @brief   Inserts a thread in the Ready List placing it behind its peers.
  * @details The thread is positioned behind all threads with higher or equal
@@ -76,8 +248,7 @@ static thread_t *__sch_ready_behind(thread_t *tp) {
   tp->state = CH_STATE_READY;
 
   /* Insertion in the priority queue.*/
-  return threadref(ch_pqueue_insert_behind(&tp->owner->rlist.pqueue,
-                                           &tp->hdr.pqueue));
+  return threadref(__sch_rlist_insert_behind(tp->owner, &tp->hdr.pqueue));
 }
 
 /**
@@ -109,8 +280,7 @@ static thread_t *__sch_ready_ahead(thread_t *tp) {
   tp->state = CH_STATE_READY;
 
   /* Insertion in the priority queue.*/
-  return threadref(ch_pqueue_insert_ahead(&tp->owner->rlist.pqueue,
-                                          &tp->hdr.pqueue));
+  return threadref(__sch_rlist_insert_ahead(tp->owner, &tp->hdr.pqueue));
 }
 
 /**
@@ -129,7 +299,7 @@ static void __sch_reschedule_behind(void) {
   thread_t *ntp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  ntp = threadref(ch_pqueue_remove_highest(&oip->rlist.pqueue));
+  ntp = threadref(__sch_rlist_remove_highest(oip));
   ntp->state = CH_STATE_CURRENT;
   __instance_set_currthread(oip, ntp);
 
@@ -165,7 +335,7 @@ static void __sch_reschedule_ahead(void) {
   thread_t *ntp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  ntp = threadref(ch_pqueue_remove_highest(&oip->rlist.pqueue));
+  ntp = threadref(__sch_rlist_remove_highest(oip));
   ntp->state = CH_STATE_CURRENT;
   __instance_set_currthread(oip, ntp);
 
@@ -292,6 +462,47 @@ thread_t *chSchReadyI(thread_t *tp) {
   return __sch_ready_behind(tp);
 }
 
+/**
+ * @brief   Removes a thread from the Ready List.
+ * @details This function is meant to be used when the priority of a ready
+ *          thread has to be changed, the thread is removed from the ready
+ *          list and can be inserted again using @p chSchReadyI().
+ * @pre     The thread must be in the @p CH_STATE_READY state.
+ * @note    The thread state is not changed.
+ *
+ * @param[in] tp        the thread to be removed
+ * @param[in] prio      the priority of the thread when it was inserted in
+ *                      the ready list, it can differ from the current one
+ * @return              The thread pointer.
+ *
+ * @notapi
+ */
+thread_t *ch_sch_ready_dequeue(thread_t *tp, tprio_t prio) {
+#if CH_CFG_USE_READY_BITMAP == TRUE
+  ready_bitmap_t *rbp = &tp->owner->rbmap;
+  ch_priority_queue_t *pqp = &tp->hdr.pqueue;
+
+  chDbgAssert(tp->state == CH_STATE_READY, "not ready");
+
+  /* If it was the last element of its level then the previous element
+     becomes the last, if it belongs to the same level.*/
+  if (rbp->tails[prio] == pqp) {
+    if (pqp->prev->prio == prio) {
+      rbp->tails[prio] = pqp->prev;
+    }
+    else {
+      __sch_rbmap_clear(rbp, prio);
+    }
+  }
+#else
+  (void)prio;
+
+  chDbgAssert(tp->state == CH_STATE_READY, "not ready");
+#endif
+
+  return threadref(ch_queue_dequeue(&tp->hdr.queue));
+}
+
 /**
  * @brief   Puts the current thread to sleep into the specified state.
  * @details The thread goes into a sleeping state. The possible
@@ -321,7 +532,7 @@ void chSchGoSleepS(tstate_t newstate) {
 #endif
 
   /* Next thread in ready list becomes current.*/
-  ntp = threadref(ch_pqueue_remove_highest(&oip->rlist.pqueue));
+  ntp = threadref(__sch_rlist_remove_highest(oip));
   ntp->state = CH_STATE_CURRENT;
   __instance_set_currthread(oip, ntp);
 
@@ -519,7 +730,7 @@ void chSchDoPreemption(void) {
   thread_t *ntp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  ntp = threadref(ch_pqueue_remove_highest(&oip->rlist.pqueue));
+  ntp = threadref(__sch_rlist_remove_highest(oip));
   ntp->state = CH_STATE_CURRENT;
   __instance_set_currthread(oip, ntp);
 
@@ -629,7 +840,7 @@ thread_t *chSchSelectFirst(void) {
   thread_t *ntp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  ntp = threadref(ch_pqueue_remove_highest(&oip->rlist.pqueue));
+  ntp = threadref(__sch_rlist_remove_highest(oip));
   ntp->state = CH_STATE_CURRENT;
   __instance_set_currthread(oip, ntp);
 
@@ -55,24 +55,60 @@
 
 /**
  * @brief   Increases the IRQ counter.
+ * @details The cycles elapsed since the last accounting point are charged
+ *          to the interrupted thread when entering the outermost ISR.
  */
 void __stats_increase_irq(void) {
+  kernel_stats_t *ksp;
 
   port_lock_from_isr();
-  currcore->kernel_stats.n_irq++;
+  ksp = &currcore->kernel_stats;
+  ksp->n_irq++;
+  if (ksp->isr_level++ == (ucnt_t)0) {
+    rtcnt_t now = chSysGetRealtimeCounterX();
+
+    currcore->rlist.current->cycles += (rttime_t)(now - ksp->t_last);
+    ksp->t_last = now;
+  }
+  port_unlock_from_isr();
+}
+
+/**
+ * @brief   Accounts the time spent in ISRs.
+ * @details The cycles elapsed since the outermost ISR entry are charged
+ *          to the ISRs time when leaving it.
+ */
+void __stats_leave_irq(void) {
+  kernel_stats_t *ksp;
+
+  port_lock_from_isr();
+  ksp = &currcore->kernel_stats;
+  if (--ksp->isr_level == (ucnt_t)0) {
+    rtcnt_t now = chSysGetRealtimeCounterX();
+
+    ksp->c_isr += (rttime_t)(now - ksp->t_last);
+    ksp->t_last = now;
+  }
   port_unlock_from_isr();
 }
 
 /**
  * @brief   Updates context switch related statistics.
+ * @details The cycles elapsed since the last accounting point are charged
+ *          to the thread being switched out.
  *
  * @param[in] ntp       the thread to be switched in
  * @param[in] otp       the thread to be switched out
  */
 void __stats_ctxswc(thread_t *ntp, thread_t *otp) {
+  kernel_stats_t *ksp = &currcore->kernel_stats;
 
-  currcore->kernel_stats.n_ctxswc++;
+  ksp->n_ctxswc++;
   chTMChainMeasurementToX(&otp->stats, &ntp->stats);
+
+  /* The time stamp taken for the chained measurement is reused.*/
+  otp->cycles += (rttime_t)(ntp->stats.last - ksp->t_last);
+  ksp->t_last = ntp->stats.last;
 }
 
 /**
@@ -107,6 +143,21 @@ void __stats_stop_measure_crit_isr(void) {
   chTMStopMeasurementX(&currcore->kernel_stats.m_crit_isr);
 }
 
+/**
+ * @brief   Returns the cycles spent in ISRs.
+ * @note    The ISRs using @p CH_IRQ_PROLOGUE() and @p CH_IRQ_EPILOGUE()
+ *          are accounted, fast ISRs are charged to the interrupted thread.
+ *
+ * @return              The number of realtime counter cycles spent in ISRs
+ *                      on the current core.
+ *
+ * @xclass
+ */
+rttime_t chStatsGetIsrCyclesX(void) {
+
+  return currcore->kernel_stats.c_isr;
+}
+
 #endif /* CH_DBG_STATISTICS == TRUE */
 
 /** @} */
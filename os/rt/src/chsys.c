@@ -305,6 +305,25 @@ bool chSysIntegrityCheckI(unsigned testmask) {
     if (n != (cnt_t)0) {
       return true;
     }
+
+#if CH_CFG_USE_READY_BITMAP == TRUE
+    /* The last element of each priority level must be indexed by the
+       bitmap, other elements must not.*/
+    pqp = oip->rlist.pqueue.next;
+    while (pqp != &oip->rlist.pqueue) {
+      bool last = pqp->next->prio != pqp->prio;
+      bool mapped = (oip->rbmap.map[pqp->prio >> 5] &
+                     (1U << (pqp->prio & 31U))) != 0U;
+
+      if ((oip->rbmap.tails[pqp->prio] == pqp) != last) {
+        return true;
+      }
+      if (!mapped) {
+        return true;
+      }
+      pqp = pqp->next;
+    }
+#endif
   }
 
   /* Timers list integrity check.*/
@@ -330,6 +349,58 @@ bool chSysIntegrityCheckI(unsigned testmask) {
     if (n != (cnt_t)0) {
       return true;
     }
+
+#if CH_CFG_VT_WHEEL_SLOTS > 0
+    {
+      ucnt_t armed = (ucnt_t)0;
+      unsigned i;
+
+      /* In timers wheel mode the delta list is not used.*/
+      if (!ch_dlist_isempty(&oip->vtlist.dlist)) {
+        return true;
+      }
+
+      for (i = 0U; i < (unsigned)CH_CFG_VT_WHEEL_SLOTS; i++) {
+        ch_delta_list_t *slp = &oip->vtwheel.slots[i];
+        bool mapped = (oip->vtwheel.map[i >> 5] & (1U << (i & 31U))) != 0U;
+
+        /* Scanning the slot forward, timers must be in the slot of their
+           deadline.*/
+        n = (cnt_t)0;
+        dlp = slp->next;
+        while (dlp != slp) {
+          if (((systime_t)dlp->delta & CH_VTW_MASK) != (systime_t)i) {
+            return true;
+          }
+          n++;
+          armed++;
+          dlp = dlp->next;
+        }
+
+        /* The bitmap must reflect the slot state.*/
+        if ((n > (cnt_t)0) != mapped) {
+          return true;
+        }
+
+        /* Scanning the slot backward.*/
+        dlp = slp->prev;
+        while (dlp != slp) {
+          n--;
+          dlp = dlp->prev;
+        }
+
+        /* The number of elements must match.*/
+        if (n != (cnt_t)0) {
+          return true;
+        }
+      }
+
+      /* The number of armed timers must match.*/
+      if (armed != oip->vtwheel.armed) {
+        return true;
+      }
+    }
+#endif
   }
 
 #if CH_CFG_USE_REGISTRY == TRUE
@@ -383,7 +454,8 @@ bool chSysIntegrityCheckI(unsigned testmask) {
  * @iclass
  */
 void chSysTimerHandlerI(void) {
-#if (CH_CFG_TIME_QUANTUM > 0) || (CH_DBG_THREADS_PROFILING == TRUE)
+#if (CH_CFG_TIME_QUANTUM > 0) ||                                            \
+    ((CH_DBG_THREADS_PROFILING == TRUE) && (CH_CFG_ST_TIMEDELTA == 0))
   thread_t *currtp = chThdGetSelfX();
 #endif
 
@@ -396,13 +468,36 @@ void chSysTimerHandlerI(void) {
     currtp->ticks--;
   }
 #endif
-#if CH_DBG_THREADS_PROFILING == TRUE
+#if (CH_DBG_THREADS_PROFILING == TRUE) && (CH_CFG_ST_TIMEDELTA == 0)
   currtp->time++;
 #endif
   chVTDoTickI();
   CH_CFG_SYSTEM_TICK_HOOK();
 }
 
+#if ((CH_DBG_THREADS_PROFILING == TRUE) && (CH_CFG_ST_TIMEDELTA > 0)) ||    \
+    defined(__DOXYGEN__)
+/**
+ * @brief   Threads profiling on context switch.
+ * @details In tickless mode there is no periodic tick to sample the running
+ *          thread, the system time elapsed since the previous context switch
+ *          is charged to the thread being switched out instead.
+ * @note    Not a user function, it is meant to be invoked on context
+ *          switches.
+ *
+ * @param[in] otp       the thread to be switched out
+ *
+ * @notapi
+ */
+void __sys_profiling_switch(thread_t *otp) {
+  os_instance_t *oip = currcore;
+  systime_t now = chVTGetSystemTimeX();
+
+  otp->time += (systime_t)chTimeDiffX(oip->profiling_time, now);
+  oip->profiling_time = now;
+}
+#endif
+
 #if (CH_PORT_SUPPORTS_RECURSIVE_LOCKS == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Returns the execution status and enters a critical zone.
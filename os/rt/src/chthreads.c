@@ -104,6 +104,9 @@ thread_t *__thd_object_init(os_instance_t *oip,
 #if CH_CFG_USE_EVENTS == TRUE
   tp->epending          = (eventmask_t)0;
 #endif
+#if defined(CH_CFG_USE_JOB_POOLS) && (CH_CFG_USE_JOB_POOLS == TRUE)
+  tp->worker            = NULL;
+#endif
 #if CH_DBG_THREADS_PROFILING == TRUE
   tp->time              = (systime_t)0;
 #endif
@@ -122,6 +125,7 @@ thread_t *__thd_object_init(os_instance_t *oip,
 #endif
 #if CH_DBG_STATISTICS == TRUE
   chTMObjectInit(&tp->stats);
+  tp->cycles            = (rttime_t)0;
 #endif
   CH_CFG_THREAD_INIT_HOOK(tp);
   return tp;
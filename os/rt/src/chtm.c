@@ -33,6 +33,13 @@
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_TM_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Mask of the linear part of a bucket index.
+ */
+#define TM_HISTOGRAM_SUB_MASK       (TM_HISTOGRAM_SUB_BUCKETS - 1U)
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -49,6 +56,24 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_TM_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+static inline unsigned tm_histogram_index(rtcnt_t value) {
+  unsigned e;
+
+  if (value < (rtcnt_t)TM_HISTOGRAM_SUB_BUCKETS) {
+    return (unsigned)value;
+  }
+
+  /* Position of the most significant bit, the following bits select the
+     linear bucket within the power of two range.*/
+  e = 31U - port_clz32((uint32_t)value);
+  return ((e - CH_CFG_TM_HISTOGRAM_SUB_BITS + 1U) <<
+          CH_CFG_TM_HISTOGRAM_SUB_BITS) +
+         ((unsigned)(value >> (e - CH_CFG_TM_HISTOGRAM_SUB_BITS)) &
+          TM_HISTOGRAM_SUB_MASK);
+}
+#endif
+
 static inline void tm_stop(time_measurement_t *tmp,
                            rtcnt_t now,
                            rtcnt_t offset) {
@@ -62,6 +87,11 @@ static inline void tm_stop(time_measurement_t *tmp,
   if (tmp->last < tmp->best) {
     tmp->best = tmp->last;
   }
+#if CH_CFG_USE_TM_HISTOGRAMS == TRUE
+  if (tmp->histogram != NULL) {
+    tmp->histogram->buckets[tm_histogram_index(tmp->last)]++;
+  }
+#endif
 }
 
 /*===========================================================================*/
@@ -82,6 +112,9 @@ void chTMObjectInit(time_measurement_t *tmp) {
   tmp->last       = (rtcnt_t)0;
   tmp->n          = (ucnt_t)0;
   tmp->cumulative = (rttime_t)0;
+#if CH_CFG_USE_TM_HISTOGRAMS == TRUE
+  tmp->histogram  = NULL;
+#endif
 }
 
 /**
@@ -132,6 +165,124 @@ NOINLINE void chTMChainMeasurementToX(time_measurement_t *tmp1,
   tm_stop(tmp1, tmp2->last, (rtcnt_t)0);
 }
 
+#if (CH_CFG_USE_TM_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a @p tm_histogram_t object.
+ *
+ * @param[out] hp       pointer to a @p tm_histogram_t structure
+ *
+ * @init
+ */
+void chTMHistogramObjectInit(tm_histogram_t *hp) {
+  unsigned i;
+
+  for (i = 0U; i < TM_HISTOGRAM_BUCKETS; i++) {
+    hp->buckets[i] = (ucnt_t)0;
+  }
+}
+
+/**
+ * @brief   Records a value in an histogram.
+ * @details This function allows to record latencies not measured using a
+ *          @p time_measurement_t object, for example the time between an
+ *          ISR and the thread it wakes up.
+ *
+ * @param[in,out] hp    pointer to a @p tm_histogram_t structure
+ * @param[in] value     the value to be recorded, in realtime counter cycles
+ *
+ * @xclass
+ */
+void chTMHistogramRecordX(tm_histogram_t *hp, rtcnt_t value) {
+
+  hp->buckets[tm_histogram_index(value)]++;
+}
+
+/**
+ * @brief   Returns the number of values recorded in an histogram.
+ *
+ * @param[in] hp        pointer to a @p tm_histogram_t structure
+ * @return              The number of recorded values.
+ *
+ * @xclass
+ */
+ucnt_t chTMHistogramGetCountX(const tm_histogram_t *hp) {
+  ucnt_t n = (ucnt_t)0;
+  unsigned i;
+
+  for (i = 0U; i < TM_HISTOGRAM_BUCKETS; i++) {
+    n += hp->buckets[i];
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Returns a percentile of the recorded values.
+ * @details The returned value is the upper limit of the bucket containing
+ *          the percentile, it is never below the exact value.
+ *
+ * @param[in] hp        pointer to a @p tm_histogram_t structure
+ * @param[in] pct100    the percentile in hundredths of percent, for example
+ *                      9990 for the 99.9th percentile, 10000 for the
+ *                      maximum
+ * @return              The percentile value in realtime counter cycles.
+ * @retval 0            if the histogram is empty.
+ *
+ * @xclass
+ */
+rtcnt_t chTMHistogramGetPercentileX(const tm_histogram_t *hp,
+                                    unsigned pct100) {
+  ucnt_t n, rank, acc;
+  unsigned i;
+
+  n = chTMHistogramGetCountX(hp);
+  if (n == (ucnt_t)0) {
+    return (rtcnt_t)0;
+  }
+
+  /* Rank of the percentile value, rounded up.*/
+  rank = (ucnt_t)((((uint64_t)n * (uint64_t)pct100) + 9999U) / 10000U);
+  if (rank == (ucnt_t)0) {
+    rank = (ucnt_t)1;
+  }
+
+  acc = (ucnt_t)0;
+  for (i = 0U; i < TM_HISTOGRAM_BUCKETS - 1U; i++) {
+    acc += hp->buckets[i];
+    if (acc >= rank) {
+      break;
+    }
+  }
+
+  return i < TM_HISTOGRAM_BUCKETS - 1U ?
+         chTMHistogramGetBucketBaseX(i + 1U) - (rtcnt_t)1 : (rtcnt_t)-1;
+}
+
+/**
+ * @brief   Returns the lowest value recorded in a bucket.
+ * @details Bucket @p i contains the values from the base of bucket @p i
+ *          to the base of bucket @p i+1 excluded.
+ *
+ * @param[in] i         the bucket index
+ * @return              The bucket base value.
+ *
+ * @xclass
+ */
+rtcnt_t chTMHistogramGetBucketBaseX(unsigned i) {
+  unsigned g;
+
+  chDbgCheck(i < TM_HISTOGRAM_BUCKETS);
+
+  if (i < TM_HISTOGRAM_SUB_BUCKETS) {
+    return (rtcnt_t)i;
+  }
+
+  g = i >> CH_CFG_TM_HISTOGRAM_SUB_BITS;
+  return (rtcnt_t)(TM_HISTOGRAM_SUB_BUCKETS + (i & TM_HISTOGRAM_SUB_MASK)) <<
+         (g - 1U);
+}
+#endif /* CH_CFG_USE_TM_HISTOGRAMS == TRUE */
+
 #endif /* CH_CFG_USE_TM == TRUE */
 
 /** @} */
@@ -68,6 +68,14 @@ NOINLINE static void trace_next(os_instance_t *oip) {
   if (++oip->trace_buffer.ptr >= &oip->trace_buffer.buffer[CH_DBG_TRACE_BUFFER_SIZE]) {
     oip->trace_buffer.ptr = &oip->trace_buffer.buffer[0];
   }
+
+  /* If the buffer became full then the oldest unread record is dropped.*/
+  if (oip->trace_buffer.ptr == oip->trace_buffer.rdptr) {
+    if (++oip->trace_buffer.rdptr >= &oip->trace_buffer.buffer[CH_DBG_TRACE_BUFFER_SIZE]) {
+      oip->trace_buffer.rdptr = &oip->trace_buffer.buffer[0];
+    }
+    oip->trace_buffer.lost++;
+  }
 }
 #endif
 
@@ -90,6 +98,8 @@ void __trace_object_init(trace_buffer_t *tbp) {
   tbp->suspended = (uint16_t)~CH_DBG_TRACE_MASK;
   tbp->size      = CH_DBG_TRACE_BUFFER_SIZE;
   tbp->ptr       = &tbp->buffer[0];
+  tbp->rdptr     = &tbp->buffer[0];
+  tbp->lost      = 0U;
   for (i = 0U; i < (unsigned)CH_DBG_TRACE_BUFFER_SIZE; i++) {
     tbp->buffer[i].type = CH_TRACE_TYPE_UNUSED;
   }
@@ -285,6 +295,77 @@ void chTraceResume(uint16_t mask) {
   chTraceResumeI(mask);
   chSysUnlock();
 }
+
+/**
+ * @brief   Reads records from the trace buffer.
+ * @details The oldest records not yet read are copied in the specified
+ *          array and removed from the buffer, this allows to continuously
+ *          drain the buffer. Records overwritten before being read are
+ *          counted, see @p chTraceGetLostX().
+ * @note    The buffer has a single reader, draining it from more than one
+ *          thread would split the events sequence.
+ *
+ * @param[out] tep      pointer to an array of @p trace_event_t
+ * @param[in] n         number of elements in the array
+ * @return              The number of records copied.
+ *
+ * @iclass
+ */
+size_t chTraceReadI(trace_event_t *tep, size_t n) {
+  trace_buffer_t *tbp = &currcore->trace_buffer;
+  size_t i = (size_t)0;
+
+  chDbgCheckClassI();
+  chDbgCheck(tep != NULL);
+
+  while ((i < n) && (tbp->rdptr != tbp->ptr)) {
+    tep[i++] = *tbp->rdptr;
+    if (++tbp->rdptr >= &tbp->buffer[CH_DBG_TRACE_BUFFER_SIZE]) {
+      tbp->rdptr = &tbp->buffer[0];
+    }
+  }
+
+  return i;
+}
+
+/**
+ * @brief   Reads records from the trace buffer.
+ * @details The oldest records not yet read are copied in the specified
+ *          array and removed from the buffer, this allows to continuously
+ *          drain the buffer. Records overwritten before being read are
+ *          counted, see @p chTraceGetLostX().
+ * @note    The buffer has a single reader, draining it from more than one
+ *          thread would split the events sequence.
+ *
+ * @param[out] tep      pointer to an array of @p trace_event_t
+ * @param[in] n         number of elements in the array
+ * @return              The number of records copied.
+ *
+ * @api
+ */
+size_t chTraceRead(trace_event_t *tep, size_t n) {
+  size_t i;
+
+  chSysLock();
+  i = chTraceReadI(tep, n);
+  chSysUnlock();
+
+  return i;
+}
+
+/**
+ * @brief   Returns the number of records lost.
+ * @details Records are lost when they are overwritten before being read,
+ *          the counter is never reset and wraps around.
+ *
+ * @return              The number of lost records.
+ *
+ * @xclass
+ */
+uint32_t chTraceGetLostX(void) {
+
+  return currcore->trace_buffer.lost;
+}
 #endif /* CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED */
 
 /** @} */
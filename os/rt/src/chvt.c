@@ -39,6 +39,17 @@
    ~(sysinterval_t)(((sysinterval_t)1 << (CH_CFG_ST_RESOLUTION / 2)) - (sysinterval_t)1))
 #endif
 
+#if (CH_CFG_VT_WHEEL_SLOTS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Maximum delay of a timer in the timers wheel.
+ * @note    Deadlines are compared as distances from the last processed
+ *          time so they must stay within half of the system time range,
+ *          longer delays are split, the timer is linked again with the
+ *          remaining delay each time its deadline is reached.
+ */
+#define VTW_MAX_DELAY           ((sysinterval_t)(TIME_MAX_SYSTIME / (systime_t)2))
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -124,20 +135,15 @@ static void vt_set_alarm(systime_t now, sysinterval_t delay) {
 }
 
 /**
- * @brief   Inserts a timer as first element in a delta list.
- * @note    This is the special case when the delta list is initially empty.
+ * @brief   Alarm start.
+ * @note    This is the special case when the alarm is initially stopped.
+ *
+ * @param[in] now       last known system time
+ * @param[in] delay     delay over @p now
  */
-static void vt_insert_first(virtual_timers_list_t *vtlp,
-                            virtual_timer_t *vtp,
-                            systime_t now,
-                            sysinterval_t delay) {
+static void vt_start_alarm(systime_t now, sysinterval_t delay) {
   sysinterval_t currdelta;
 
-  /* The delta list is empty, the current time becomes the new
-     delta list base time, the timer is inserted.*/
-  vtlp->lasttime = now;
-  ch_dlist_insert_after(&vtlp->dlist, &vtp->dlist, delay);
-
   /* Initial delta is what is configured statically.*/
   currdelta = (sysinterval_t)CH_CFG_ST_TIMEDELTA;
 
@@ -156,9 +162,8 @@ static void vt_insert_first(virtual_timers_list_t *vtlp,
   }
 #endif
 
-  /* Being the first element inserted in the list the alarm timer
-     is started.*/
-  port_timer_start_alarm(chTimeAddX(vtlp->lasttime, delay));
+  /* Being the first timer armed the alarm timer is started.*/
+  port_timer_start_alarm(chTimeAddX(now, delay));
 
   /* Deadline skip detection and correction loop.*/
   while (true) {
@@ -196,14 +201,332 @@ static void vt_insert_first(virtual_timers_list_t *vtlp,
   chDbgAssert(currdelta <= CH_CFG_ST_TIMEDELTA, "insufficient delta");
 #endif
 }
+
+#if (CH_CFG_VT_WHEEL_SLOTS == 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Inserts a timer as first element in a delta list.
+ * @note    This is the special case when the delta list is initially empty.
+ */
+static void vt_insert_first(virtual_timers_list_t *vtlp,
+                            virtual_timer_t *vtp,
+                            systime_t now,
+                            sysinterval_t delay) {
+
+  /* The delta list is empty, the current time becomes the new
+     delta list base time, the timer is inserted.*/
+  vtlp->lasttime = now;
+  ch_dlist_insert_after(&vtlp->dlist, &vtp->dlist, delay);
+
+  /* Being the first element inserted in the list the alarm timer
+     is started.*/
+  vt_start_alarm(now, delay);
+}
+#endif /* CH_CFG_VT_WHEEL_SLOTS == 0 */
 #endif /* CH_CFG_ST_TIMEDELTA > 0 */
 
+#if (CH_CFG_VT_WHEEL_SLOTS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Links a timer in the wheel slot of its deadline.
+ *
+ * @param[in] vtwp      pointer to the timers wheel
+ * @param[in] vtp       pointer to the @p virtual_timer_t structure
+ * @param[in] deadline  absolute deadline of the timer
+ */
+static inline void vt_wheel_link(virtual_timers_wheel_t *vtwp,
+                                 virtual_timer_t *vtp,
+                                 systime_t deadline) {
+  unsigned i = (unsigned)(deadline & CH_VTW_MASK);
+
+  ch_dlist_insert_before(&vtwp->slots[i], &vtp->dlist,
+                         (sysinterval_t)deadline);
+  vtwp->map[i >> 5] |= 1U << (i & 31U);
+  vtwp->armed++;
+}
+
+/**
+ * @brief   Unlinks a timer from the wheel, marking it as not armed.
+ * @note    The timer could be also linked in a list of expired timers,
+ *          the slot is identified by the deadline anyway.
+ *
+ * @param[in] vtwp      pointer to the timers wheel
+ * @param[in] vtp       pointer to the @p virtual_timer_t structure
+ */
+static inline void vt_wheel_unlink(virtual_timers_wheel_t *vtwp,
+                                   virtual_timer_t *vtp) {
+  unsigned i = (unsigned)((systime_t)vtp->dlist.delta & CH_VTW_MASK);
+
+  (void) ch_dlist_dequeue(&vtp->dlist);
+  vtp->dlist.next = NULL;
+  if (ch_dlist_isempty(&vtwp->slots[i])) {
+    vtwp->map[i >> 5] &= ~(1U << (i & 31U));
+  }
+  vtwp->armed--;
+}
+
+/**
+ * @brief   Distance of the nearest deadline in the wheel.
+ * @details Non-empty slots are visited in time order starting from the
+ *          slot following @p base, the scan stops on the first timer
+ *          expiring within the current wheel round. Only when all timers
+ *          belong to following rounds the whole wheel is visited.
+ * @pre     The wheel must not be empty and all deadlines must follow
+ *          @p base.
+ *
+ * @param[in] vtwp      pointer to the timers wheel
+ * @param[in] base      time of the last processed slot
+ * @return              The distance in ticks from @p base.
+ */
+static sysinterval_t vt_wheel_next(virtual_timers_wheel_t *vtwp,
+                                   systime_t base) {
+  sysinterval_t mindelta = (sysinterval_t)TIME_MAX_SYSTIME;
+  unsigned i, j, scanned;
+
+  i = (unsigned)((base + (systime_t)1) & CH_VTW_MASK);
+  scanned = 0U;
+  while (scanned < (unsigned)CH_CFG_VT_WHEEL_SLOTS) {
+    uint32_t bits = vtwp->map[i >> 5] & (0xFFFFFFFFU << (i & 31U));
+    ch_delta_list_t *slp, *dlp;
+
+    if (bits == 0U) {
+      /* Skipping to the next bitmap word or wrapping.*/
+      unsigned next = (i | 31U) + 1U;
+      if (next > (unsigned)CH_CFG_VT_WHEEL_SLOTS) {
+        next = (unsigned)CH_CFG_VT_WHEEL_SLOTS;
+      }
+      scanned += next - i;
+      i = next & (unsigned)CH_VTW_MASK;
+      continue;
+    }
+
+    /* Next non-empty slot within the current word.*/
+    j = (i & ~31U) + port_ctz32(bits);
+    scanned += j - i;
+    if (scanned >= (unsigned)CH_CFG_VT_WHEEL_SLOTS) {
+      break;
+    }
+
+    /* Nearest deadline in the slot.*/
+    slp = &vtwp->slots[j];
+    for (dlp = slp->next; dlp != slp; dlp = dlp->next) {
+      sysinterval_t delta = chTimeDiffX(base, (systime_t)dlp->delta);
+      if (delta < mindelta) {
+        mindelta = delta;
+      }
+    }
+
+    /* A timer expiring within this round is the nearest one, slots
+       already visited only contain timers of following rounds.*/
+    if (mindelta <= (sysinterval_t)scanned + (sysinterval_t)1) {
+      break;
+    }
+
+    i = (j + 1U) & (unsigned)CH_VTW_MASK;
+    scanned++;
+  }
+
+  chDbgAssert(mindelta != (sysinterval_t)TIME_MAX_SYSTIME, "empty wheel");
+
+  return mindelta;
+}
+
+/**
+ * @brief   Moves the expired timers of a slot in a list.
+ * @details Timers whose deadline is within <tt>(base, base + elapsed]</tt>
+ *          are moved, timers belonging to following wheel rounds are left
+ *          in place.
+ *
+ * @param[in] vtwp      pointer to the timers wheel
+ * @param[in] i         slot index
+ * @param[in] elp       list of the expired timers
+ * @param[in] base      time of the last processed slot
+ * @param[in] elapsed   ticks elapsed since @p base
+ */
+static void vt_wheel_collect(virtual_timers_wheel_t *vtwp,
+                             unsigned i,
+                             ch_delta_list_t *elp,
+                             systime_t base,
+                             sysinterval_t elapsed) {
+  ch_delta_list_t *slp = &vtwp->slots[i];
+  ch_delta_list_t *dlp = slp->next;
+
+  while (dlp != slp) {
+    ch_delta_list_t *next = dlp->next;
+
+    if (chTimeDiffX(base, (systime_t)dlp->delta) <= elapsed) {
+      (void) ch_dlist_dequeue(dlp);
+      ch_dlist_insert_before(elp, dlp, dlp->delta);
+    }
+    dlp = next;
+  }
+
+  if (ch_dlist_isempty(slp)) {
+    vtwp->map[i >> 5] &= ~(1U << (i & 31U));
+  }
+}
+
+/**
+ * @brief   Enqueues a virtual timer in the timers wheel.
+ *
+ * @param[in] vtlp      pointer to the virtual timers list
+ * @param[in] vtwp      pointer to the timers wheel
+ * @param[in] vtp       pointer to the @p virtual_timer_t structure
+ * @param[in] now       last known system time
+ * @param[in] delay     delay over @p now, must be greater than zero
+ */
+static void vt_wheel_enqueue(virtual_timers_list_t *vtlp,
+                             virtual_timers_wheel_t *vtwp,
+                             virtual_timer_t *vtp,
+                             systime_t now,
+                             sysinterval_t delay) {
+  systime_t deadline;
+
+  /* Delays too long for a single deadline are split, the part exceeding
+     the limit is waited after the first deadline is reached.*/
+  if (delay > VTW_MAX_DELAY) {
+    vtp->remaining = delay - VTW_MAX_DELAY;
+    delay = VTW_MAX_DELAY;
+  }
+  else {
+    vtp->remaining = (sysinterval_t)0;
+  }
+  deadline = chTimeAddX(now, delay);
+
+#if CH_CFG_ST_TIMEDELTA > 0
+  /* Special case where the wheel is empty, the current time becomes the
+     new base time and the alarm is started.*/
+  if (vtwp->armed == 0U) {
+    vtlp->lasttime = now;
+    vtwp->alarm    = deadline;
+    vt_wheel_link(vtwp, vtp, deadline);
+    vt_start_alarm(now, delay);
+
+    return;
+  }
+
+  /* If the timer expires before the programmed alarm then the alarm is
+     moved earlier.*/
+  if (chTimeDiffX(vtlp->lasttime, deadline) <
+      chTimeDiffX(vtlp->lasttime, vtwp->alarm)) {
+    vtwp->alarm = deadline;
+    vt_set_alarm(now, delay);
+  }
+#else
+  (void)vtlp;
+#endif
+
+  vt_wheel_link(vtwp, vtp, deadline);
+}
+
+/**
+ * @brief   Invokes the callbacks of a list of expired timers.
+ *
+ * @param[in] vtlp      pointer to the virtual timers list
+ * @param[in] vtwp      pointer to the timers wheel
+ * @param[in] elp       list of the expired timers
+ */
+static void vt_wheel_fire(virtual_timers_list_t *vtlp,
+                          virtual_timers_wheel_t *vtwp,
+                          ch_delta_list_t *elp) {
+
+  while (ch_dlist_notempty(elp)) {
+    virtual_timer_t *vtp = (virtual_timer_t *)elp->next;
+    systime_t deadline = (systime_t)vtp->dlist.delta;
+
+    /* Removing the timer, marking it as not armed.*/
+    vt_wheel_unlink(vtwp, vtp);
+
+#if CH_CFG_ST_TIMEDELTA > 0
+    /* If the wheel becomes empty then the alarm is disabled.*/
+    if (vtwp->armed == 0U) {
+      port_timer_stop_alarm();
+    }
+#endif
+
+    /* If part of a long delay is still to be waited then the timer is
+       linked again instead of being triggered.*/
+    if (unlikely(vtp->remaining > (sysinterval_t)0)) {
+#if CH_CFG_ST_TIMEDELTA == 0
+      vt_wheel_enqueue(vtlp, vtwp, vtp, deadline, vtp->remaining);
+      continue;
+#else
+      systime_t now = chVTGetSystemTimeX();
+      sysinterval_t nowdelta = chTimeDiffX(deadline, now);
+
+      if (vtp->remaining > nowdelta) {
+        vt_wheel_enqueue(vtlp, vtwp, vtp, now, vtp->remaining - nowdelta);
+        continue;
+      }
+
+      /* The whole delay already elapsed, the timer is triggered.*/
+      deadline = chTimeAddX(deadline, vtp->remaining);
+#endif
+    }
+
+    /* The callback is invoked outside the kernel critical section, it
+       is re-entered on the callback return.*/
+    chSysUnlockFromISR();
+
+    vtp->func(vtp, vtp->par);
+
+    chSysLockFromISR();
+
+    /* If a reload is defined the timer needs to be restarted.*/
+    if (unlikely(vtp->reload > (sysinterval_t)0)) {
+#if CH_CFG_ST_TIMEDELTA == 0
+      vt_wheel_enqueue(vtlp, vtwp, vtp, deadline, vtp->reload);
+#else
+      sysinterval_t nowdelta, delay;
+      systime_t now;
+
+      /* Refreshing the now delta after spending time in the callback for
+         a more accurate detection of too fast reloads.*/
+      now = chVTGetSystemTimeX();
+      nowdelta = chTimeDiffX(deadline, now);
+
+#if !defined(CH_VT_RFCU_DISABLED)
+      /* Checking if the required reload is feasible.*/
+      if (nowdelta > vtp->reload) {
+        /* System time is already past the deadline, logging the fault and
+           proceeding with a minimum delay.*/
+
+        chDbgAssert(false, "skipped deadline");
+        chRFCUCollectFaultsI(CH_RFCU_VT_SKIPPED_DEADLINE);
+
+        delay = (sysinterval_t)0;
+      }
+      else {
+        delay = vtp->reload - nowdelta;
+      }
+#else
+      /* Assertions as fallback.*/
+      chDbgAssert(nowdelta <= vtp->reload, "skipped deadline");
+
+      delay = vtp->reload - nowdelta;
+#endif
+
+      /* The deadline must follow the last processed time.*/
+      if (delay == (sysinterval_t)0) {
+        delay = (sysinterval_t)1;
+      }
+
+      vt_wheel_enqueue(vtlp, vtwp, vtp, now, delay);
+#endif
+    }
+  }
+}
+#endif /* CH_CFG_VT_WHEEL_SLOTS > 0 */
+
 /**
  * @brief   Enqueues a virtual timer in a virtual timers list.
  */
 static void vt_enqueue(virtual_timers_list_t *vtlp,
                        virtual_timer_t *vtp,
                        sysinterval_t delay) {
+#if CH_CFG_VT_WHEEL_SLOTS > 0
+
+  vt_wheel_enqueue(vtlp, &currcore->vtwheel, vtp,
+                   chVTGetSystemTimeX(), delay);
+#else /* CH_CFG_VT_WHEEL_SLOTS == 0 */
   sysinterval_t delta;
 
 #if CH_CFG_ST_TIMEDELTA > 0
@@ -245,6 +568,7 @@ static void vt_enqueue(virtual_timers_list_t *vtlp,
 #endif /* CH_CFG_ST_TIMEDELTA == 0 */
 
   ch_dlist_insert(&vtlp->dlist, &vtp->dlist, delta);
+#endif /* CH_CFG_VT_WHEEL_SLOTS == 0 */
 }
 
 /*===========================================================================*/
@@ -341,7 +665,20 @@ void chVTDoResetI(virtual_timer_t *vtp) {
   chDbgCheck(vtp != NULL);
   chDbgAssert(chVTIsArmedI(vtp), "timer not armed");
 
-#if CH_CFG_ST_TIMEDELTA == 0
+#if CH_CFG_VT_WHEEL_SLOTS > 0
+  (void)vtlp;
+
+  /* Removing the timer from its slot, marking it as not armed.*/
+  vt_wheel_unlink(&currcore->vtwheel, vtp);
+
+#if CH_CFG_ST_TIMEDELTA > 0
+  /* If the wheel becomes empty then the alarm timer is stopped, else the
+     alarm is left in place, a spurious tick event is harmless.*/
+  if (currcore->vtwheel.armed == 0U) {
+    port_timer_stop_alarm();
+  }
+#endif
+#elif CH_CFG_ST_TIMEDELTA == 0
 
   /* The delta of the timer is added to the next timer.*/
   vtp->dlist.next->delta += vtp->dlist.delta;
@@ -422,6 +759,33 @@ void chVTDoResetI(virtual_timer_t *vtp) {
  */
 sysinterval_t chVTGetRemainingIntervalI(virtual_timer_t *vtp) {
   virtual_timers_list_t *vtlp = &currcore->vtlist;
+#if CH_CFG_VT_WHEEL_SLOTS > 0
+  systime_t deadline;
+
+  chDbgCheckClassI();
+
+  /* In the timers wheel the timer holds its absolute deadline.*/
+  deadline = (systime_t)vtp->dlist.delta;
+#if CH_CFG_ST_TIMEDELTA > 0
+  {
+    systime_t now = chVTGetSystemTimeX();
+    sysinterval_t nowdelta = chTimeDiffX(vtlp->lasttime, now);
+    sysinterval_t delta = chTimeDiffX(vtlp->lasttime, deadline);
+    if (nowdelta > delta) {
+      /* Deadline passed but not yet processed, the remaining part of a
+         long delay could be still pending.*/
+      nowdelta -= delta;
+      if (nowdelta > vtp->remaining) {
+        return (sysinterval_t)0;
+      }
+      return vtp->remaining - nowdelta;
+    }
+    return (delta - nowdelta) + vtp->remaining;
+  }
+#else
+  return chTimeDiffX(vtlp->systime, deadline) + vtp->remaining;
+#endif
+#else /* CH_CFG_VT_WHEEL_SLOTS == 0 */
   sysinterval_t delta;
   ch_delta_list_t *dlp;
 
@@ -449,7 +813,44 @@ sysinterval_t chVTGetRemainingIntervalI(virtual_timer_t *vtp) {
   chDbgAssert(false, "timer not in list");
 
   return (sysinterval_t)-1;
+#endif /* CH_CFG_VT_WHEEL_SLOTS == 0 */
+}
+
+#if (CH_CFG_VT_WHEEL_SLOTS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the time interval until the next timer event.
+ * @note    This is the timers wheel implementation of
+ *          @p chVTGetTimersStateI().
+ *
+ * @param[out] timep    pointer to a variable that will contain the time
+ *                      interval until the next timer elapses. This pointer
+ *                      can be @p NULL if the information is not required.
+ * @return              The time, in ticks, until next time event.
+ * @retval false        if the timers wheel is empty.
+ * @retval true         if the timers wheel contains at least one timer.
+ *
+ * @notapi
+ */
+bool ch_vt_wheel_get_state(sysinterval_t *timep) {
+  os_instance_t *oip = currcore;
+
+  if (oip->vtwheel.armed == 0U) {
+    return false;
+  }
+
+  if (timep != NULL) {
+#if CH_CFG_ST_TIMEDELTA == 0
+    *timep = vt_wheel_next(&oip->vtwheel, oip->vtlist.systime);
+#else
+    *timep = (vt_wheel_next(&oip->vtwheel, oip->vtlist.lasttime) +
+              (sysinterval_t)CH_CFG_ST_TIMEDELTA) -
+             chTimeDiffX(oip->vtlist.lasttime, chVTGetSystemTimeX());
+#endif
+  }
+
+  return true;
 }
+#endif /* CH_CFG_VT_WHEEL_SLOTS > 0 */
 
 /**
  * @brief   Virtual timers ticker.
@@ -465,7 +866,76 @@ void chVTDoTickI(void) {
 
   chDbgCheckClassI();
 
+#if CH_CFG_VT_WHEEL_SLOTS > 0
+  virtual_timers_wheel_t *vtwp = &currcore->vtwheel;
+  ch_delta_list_t expired;
+
+  ch_dlist_init(&expired);
+
 #if CH_CFG_ST_TIMEDELTA == 0
+  {
+    systime_t now = ++vtlp->systime;
+    unsigned i = (unsigned)(now & CH_VTW_MASK);
+
+    /* Only the slot of the current time is checked, timers in the slot
+       belonging to following wheel rounds are left in place.*/
+    if ((vtwp->map[i >> 5] & (1U << (i & 31U))) != 0U) {
+      vt_wheel_collect(vtwp, i, &expired, now - (systime_t)1,
+                       (sysinterval_t)1);
+      vt_wheel_fire(vtlp, vtwp, &expired);
+    }
+  }
+#else /* CH_CFG_ST_TIMEDELTA > 0 */
+  sysinterval_t delay;
+  systime_t now;
+
+  /* Looping until no more timers are found expired between "lasttime" and
+     current time, callbacks could take time or arm more timers.*/
+  while (true) {
+    sysinterval_t nowdelta, n, j;
+
+    /* Delta between current time and last execution time.*/
+    now = chVTGetSystemTimeX();
+    nowdelta = chTimeDiffX(vtlp->lasttime, now);
+
+    /* Slots to be scanned, all of them if a whole wheel round elapsed.*/
+    n = nowdelta;
+    if (n > (sysinterval_t)CH_CFG_VT_WHEEL_SLOTS) {
+      n = (sysinterval_t)CH_CFG_VT_WHEEL_SLOTS;
+    }
+    for (j = (sysinterval_t)1; j <= n; j++) {
+      unsigned i = (unsigned)((vtlp->lasttime + (systime_t)j) & CH_VTW_MASK);
+
+      if ((vtwp->map[i >> 5] & (1U << (i & 31U))) != 0U) {
+        vt_wheel_collect(vtwp, i, &expired, vtlp->lasttime, nowdelta);
+      }
+    }
+
+    /* The processed time slice becomes the new base time.*/
+    vtlp->lasttime = now;
+
+    /* Loop break condition.*/
+    if (ch_dlist_isempty(&expired)) {
+      break;
+    }
+
+    /* Note that "lasttime" can be modified within the callbacks if some
+       timer function is called.*/
+    vt_wheel_fire(vtlp, vtwp, &expired);
+  }
+
+  /* If the wheel is empty, nothing else to do, the alarm has already been
+     stopped.*/
+  if (vtwp->armed == 0U) {
+    return;
+  }
+
+  /* Update alarm time to the nearest deadline.*/
+  delay = vt_wheel_next(vtwp, now);
+  vtwp->alarm = chTimeAddX(now, delay);
+  vt_set_alarm(now, delay);
+#endif /* CH_CFG_ST_TIMEDELTA > 0 */
+#elif CH_CFG_ST_TIMEDELTA == 0
   vtlp->systime++;
   if (ch_dlist_notempty(&vtlp->dlist)) {
     /* The list is not empty, processing elements on top.*/
@@ -18,7 +18,14 @@
 #endif
 #endif
 
-#if HAL_USE_MMC_SPI
+#if defined(FATFS_HAL_DEVICE_TYPE)
+/* Any block device, for example a RamDisk, the header declaring the type
+   is specified using FATFS_HAL_DEVICE_HEADER.*/
+#if defined(FATFS_HAL_DEVICE_HEADER)
+#include FATFS_HAL_DEVICE_HEADER
+#endif
+extern FATFS_HAL_DEVICE_TYPE FATFS_HAL_DEVICE;
+#elif HAL_USE_MMC_SPI
 extern MMCDriver FATFS_HAL_DEVICE;
 #elif HAL_USE_SDC
 extern SDCDriver FATFS_HAL_DEVICE;
@@ -43,6 +50,357 @@ extern RTCDriver RTCD1;
 #define FATFS_NUM_RETRIES 5
 #define FATFS_RETRY(x) do { uint8_t ii; for (ii=0; ii<FATFS_NUM_RETRIES; ii++) {if ((x)==0) break; else if (ii==FATFS_NUM_RETRIES-1) return RES_ERROR;}} while(0)
 
+/*
+  Write-back sector cache between FatFS and the block device, it is
+  built on the OSLIB objects cache (CH_CFG_USE_OBJ_CACHES).
+  - Single sector reads and writes, FAT, directory and partial file
+    sectors, are served from the cache, writes are deferred until the
+    sector is evicted or FatFS requests a CTRL_SYNC.
+  - A single sector miss following the previously read sector triggers
+    a multi-sector read of FATFS_CACHE_READAHEAD sectors.
+  - CTRL_SYNC writes dirty sectors in ascending order, runs of consecutive
+    sectors are merged in multi-sector writes of up to
+    FATFS_CACHE_READAHEAD sectors.
+  - Multi-sector transfers go straight to the device, cached copies are
+    kept coherent.
+  - A dirty sector is written back before its buffer is reused for another
+    sector, a failure is reported by the operation requiring the buffer
+    and the sector is kept dirty.
+  Dirty sectors are discarded by disk_initialize() because the medium could
+  have been replaced, f_sync() or f_close() must be used before unmounting.
+ */
+#if !defined(FATFS_USE_SECTOR_CACHE)
+#define FATFS_USE_SECTOR_CACHE FALSE
+#endif
+
+/* Number of cached sectors.*/
+#if !defined(FATFS_CACHE_SECTORS)
+#define FATFS_CACHE_SECTORS 16
+#endif
+
+/* Size of the cache hash table, must be a power of two not lower than
+   FATFS_CACHE_SECTORS.*/
+#if !defined(FATFS_CACHE_HASH_SIZE)
+#define FATFS_CACHE_HASH_SIZE 32
+#endif
+
+/* Sectors read ahead on sequential access, it is also the maximum length
+   of a coalesced write.*/
+#if !defined(FATFS_CACHE_READAHEAD)
+#define FATFS_CACHE_READAHEAD 4
+#endif
+
+#if FATFS_USE_SECTOR_CACHE
+#if CH_CFG_USE_OBJ_CACHES == FALSE
+#error "FATFS_USE_SECTOR_CACHE requires CH_CFG_USE_OBJ_CACHES"
+#endif
+#if FF_MAX_SS != FF_MIN_SS
+#error "FATFS_USE_SECTOR_CACHE requires a fixed sector size"
+#endif
+#if FATFS_CACHE_READAHEAD < 1
+#error "invalid FATFS_CACHE_READAHEAD value"
+#endif
+#if FATFS_CACHE_SECTORS <= FATFS_CACHE_READAHEAD
+#error "FATFS_CACHE_SECTORS must be greater than FATFS_CACHE_READAHEAD"
+#endif
+#if (FATFS_CACHE_HASH_SIZE < FATFS_CACHE_SECTORS) ||                        \
+    ((FATFS_CACHE_HASH_SIZE & (FATFS_CACHE_HASH_SIZE - 1)) != 0)
+#error "invalid FATFS_CACHE_HASH_SIZE value"
+#endif
+
+#include <string.h>
+
+typedef struct {
+  oc_object_t   header;
+  BYTE          data[FF_MAX_SS];
+} fatfs_sector_t;
+
+static objects_cache_t fatfs_cache;
+static oc_hash_header_t fatfs_cache_hash[FATFS_CACHE_HASH_SIZE];
+static fatfs_sector_t fatfs_cache_sectors[FATFS_CACHE_SECTORS];
+static BYTE fatfs_cache_buffer[FATFS_CACHE_READAHEAD * FF_MAX_SS];
+static bool fatfs_cache_ready;
+static bool fatfs_cache_error;
+static DWORD fatfs_cache_next;
+
+static bool fatfs_blk_read(DWORD sector, BYTE *buff, UINT count) {
+  uint8_t ii;
+
+  for (ii = 0; ii < FATFS_NUM_RETRIES; ii++) {
+    if (!blkRead(&FATFS_HAL_DEVICE, sector, buff, count))
+      return false;
+  }
+  return true;
+}
+
+#if !FF_FS_READONLY
+static bool fatfs_blk_write(DWORD sector, const BYTE *buff, UINT count) {
+  uint8_t ii;
+
+  for (ii = 0; ii < FATFS_NUM_RETRIES; ii++) {
+    if (!blkWrite(&FATFS_HAL_DEVICE, sector, buff, count))
+      return false;
+  }
+  return true;
+}
+#endif
+
+static bool fatfs_cache_readf(objects_cache_t *ocp,
+                              oc_object_t *objp,
+                              bool async) {
+  bool err;
+
+  err = fatfs_blk_read(objp->obj_key, ((fatfs_sector_t *)objp)->data, 1);
+  if (!err)
+    objp->obj_flags &= ~OC_FLAG_NOTSYNC;
+  if (async)
+    chCacheReleaseObject(ocp, objp);
+  return err;
+}
+
+static bool fatfs_cache_writef(objects_cache_t *ocp,
+                               oc_object_t *objp,
+                               bool async) {
+  bool err;
+
+#if !FF_FS_READONLY
+  err = fatfs_blk_write(objp->obj_key, ((fatfs_sector_t *)objp)->data, 1);
+#else
+  err = true;
+#endif
+  if (async) {
+    /* Asynchronous writes come from evictions not preceded by a write-back
+       in fatfs_cache_get(), it cannot happen unless the cache is accessed
+       concurrently. On failure the sector is dropped and the error is
+       reported by the next CTRL_SYNC.*/
+    if (err) {
+      fatfs_cache_error = true;
+      objp->obj_flags |= OC_FLAG_NOTSYNC;
+    }
+    chCacheReleaseObject(ocp, objp);
+  }
+  return err;
+}
+
+static void fatfs_cache_init(void) {
+
+  chCacheObjectInit(&fatfs_cache,
+                    FATFS_CACHE_HASH_SIZE, fatfs_cache_hash,
+                    FATFS_CACHE_SECTORS, sizeof (fatfs_sector_t),
+                    fatfs_cache_sectors,
+                    fatfs_cache_readf, fatfs_cache_writef);
+  fatfs_cache_ready = true;
+  fatfs_cache_error = false;
+  fatfs_cache_next  = 0;
+}
+
+/* Returns the cached object of a sector having all the specified flags,
+   the object is not acquired.*/
+static oc_object_t *fatfs_cache_find(DWORD sector, oc_flags_t flags) {
+  unsigned i;
+
+  flags |= OC_FLAG_INHASH;
+  for (i = 0; i < FATFS_CACHE_SECTORS; i++) {
+    oc_object_t *objp = &fatfs_cache_sectors[i].header;
+
+    if (((objp->obj_flags & flags) == flags) && (objp->obj_key == sector))
+      return objp;
+  }
+  return NULL;
+}
+
+/* Retrieves the object of a sector. On a cache miss the least recently
+   used sector is reused, if it is dirty then it is written back here so
+   that a failure can be reported to the caller and the sector kept.*/
+static bool fatfs_cache_get(DWORD sector, oc_object_t **objpp) {
+  oc_object_t *objp;
+  uint32_t key = 0U;
+  bool dirty = false;
+
+  if (fatfs_cache_find(sector, 0U) == NULL) {
+    chSysLock();
+    objp = fatfs_cache.lru.lru_prev;
+    if ((objp != (oc_object_t *)&fatfs_cache.lru) &&
+        ((objp->obj_flags & OC_FLAG_LAZYWRITE) != 0U)) {
+      key   = objp->obj_key;
+      dirty = true;
+    }
+    chSysUnlock();
+
+    if (dirty) {
+      bool err;
+
+      objp = chCacheGetObject(&fatfs_cache, 0U, key);
+#if !FF_FS_READONLY
+      err = fatfs_blk_write(key, ((fatfs_sector_t *)objp)->data, 1);
+#else
+      err = true;
+#endif
+      /* On success the sector is queued for reuse, on failure it is moved
+         to the LRU head and the next miss will try another sector.*/
+      if (!err) {
+        objp->obj_flags &= ~OC_FLAG_LAZYWRITE;
+        objp->obj_flags |= OC_FLAG_FORGET;
+      }
+      chCacheReleaseObject(&fatfs_cache, objp);
+      if (err)
+        return true;
+    }
+  }
+  *objpp = chCacheGetObject(&fatfs_cache, 0U, (uint32_t)sector);
+  return false;
+}
+
+static DRESULT fatfs_cache_read(DWORD sector, BYTE *buff, UINT count) {
+  oc_object_t *objp;
+  bool err = false;
+  unsigned i;
+
+  if (count > 1) {
+    /* Multi-sector reads go straight to the device, dirty cached sectors
+       are more recent than the medium and replace the data read.*/
+    if (fatfs_blk_read(sector, buff, count))
+      return RES_ERROR;
+    for (i = 0; i < FATFS_CACHE_SECTORS; i++) {
+      objp = &fatfs_cache_sectors[i].header;
+      if (((objp->obj_flags & (OC_FLAG_INHASH | OC_FLAG_LAZYWRITE)) ==
+           (OC_FLAG_INHASH | OC_FLAG_LAZYWRITE)) &&
+          (objp->obj_key >= sector) && (objp->obj_key - sector < count)) {
+        memcpy(buff + (objp->obj_key - sector) * FF_MAX_SS,
+               ((fatfs_sector_t *)objp)->data, FF_MAX_SS);
+      }
+    }
+    fatfs_cache_next = sector + count;
+    return RES_OK;
+  }
+
+  if (fatfs_cache_get(sector, &objp))
+    return RES_ERROR;
+  if ((objp->obj_flags & OC_FLAG_NOTSYNC) != 0U) {
+    if ((FATFS_CACHE_READAHEAD > 1) && (sector == fatfs_cache_next)) {
+      BlockDeviceInfo bdi;
+      UINT n = FATFS_CACHE_READAHEAD;
+
+      /* Sequential access, reading the following sectors too, the read
+         is clipped to the device size.*/
+      if (!blkGetInfo(&FATFS_HAL_DEVICE, &bdi) && (bdi.blk_num > sector) &&
+          (bdi.blk_num - sector < n))
+        n = bdi.blk_num - sector;
+      err = fatfs_blk_read(sector, fatfs_cache_buffer, n);
+      if (!err) {
+        memcpy(((fatfs_sector_t *)objp)->data, fatfs_cache_buffer, FF_MAX_SS);
+        objp->obj_flags &= ~OC_FLAG_NOTSYNC;
+        for (i = 1; i < n; i++) {
+          oc_object_t *rap;
+
+          /* A failed write-back ends the read-ahead, the dirty sector is
+             retried later.*/
+          if (fatfs_cache_get(sector + i, &rap))
+            break;
+
+          /* Sectors already in cache are left untouched.*/
+          if ((rap->obj_flags & OC_FLAG_NOTSYNC) != 0U) {
+            memcpy(((fatfs_sector_t *)rap)->data,
+                   fatfs_cache_buffer + i * FF_MAX_SS, FF_MAX_SS);
+            rap->obj_flags &= ~OC_FLAG_NOTSYNC;
+          }
+          chCacheReleaseObject(&fatfs_cache, rap);
+        }
+      }
+    }
+    else {
+      err = chCacheReadObject(&fatfs_cache, objp, false);
+    }
+  }
+  if (!err)
+    memcpy(buff, ((fatfs_sector_t *)objp)->data, FF_MAX_SS);
+  chCacheReleaseObject(&fatfs_cache, objp);
+  fatfs_cache_next = sector + 1;
+  return err ? RES_ERROR : RES_OK;
+}
+
+#if !FF_FS_READONLY
+static DRESULT fatfs_cache_write(DWORD sector, const BYTE *buff, UINT count) {
+  oc_object_t *objp;
+  unsigned i;
+
+  if (count > 1) {
+    /* Multi-sector writes go straight to the device, cached copies are
+       updated and no more dirty.*/
+    if (fatfs_blk_write(sector, buff, count))
+      return RES_ERROR;
+    for (i = 0; i < count; i++) {
+      if (fatfs_cache_find(sector + i, 0U) != NULL) {
+        objp = chCacheGetObject(&fatfs_cache, 0U, (uint32_t)(sector + i));
+        memcpy(((fatfs_sector_t *)objp)->data, buff + i * FF_MAX_SS,
+               FF_MAX_SS);
+        objp->obj_flags &= ~(OC_FLAG_NOTSYNC | OC_FLAG_LAZYWRITE);
+        chCacheReleaseObject(&fatfs_cache, objp);
+      }
+    }
+    return RES_OK;
+  }
+
+  /* Single sector writes are deferred.*/
+  if (fatfs_cache_get(sector, &objp))
+    return RES_ERROR;
+  memcpy(((fatfs_sector_t *)objp)->data, buff, FF_MAX_SS);
+  objp->obj_flags &= ~OC_FLAG_NOTSYNC;
+  objp->obj_flags |= OC_FLAG_LAZYWRITE;
+  chCacheReleaseObject(&fatfs_cache, objp);
+  return RES_OK;
+}
+
+static DRESULT fatfs_cache_sync(void) {
+  oc_object_t *run[FATFS_CACHE_READAHEAD];
+  bool err = fatfs_cache_error;
+  unsigned i, n;
+
+  fatfs_cache_error = false;
+  while (true) {
+    DWORD first = 0;
+    bool found = false, failed;
+
+    /* Lowest dirty sector.*/
+    for (i = 0; i < FATFS_CACHE_SECTORS; i++) {
+      oc_object_t *objp = &fatfs_cache_sectors[i].header;
+
+      if (((objp->obj_flags & (OC_FLAG_INHASH | OC_FLAG_LAZYWRITE)) ==
+           (OC_FLAG_INHASH | OC_FLAG_LAZYWRITE)) &&
+          (!found || (objp->obj_key < first))) {
+        first = objp->obj_key;
+        found = true;
+      }
+    }
+    if (!found)
+      break;
+
+    /* Gathering the run of consecutive dirty sectors starting from it.*/
+    for (n = 0; n < FATFS_CACHE_READAHEAD; n++) {
+      if (fatfs_cache_find(first + n, OC_FLAG_LAZYWRITE) == NULL)
+        break;
+      run[n] = chCacheGetObject(&fatfs_cache, 0U, (uint32_t)(first + n));
+      memcpy(fatfs_cache_buffer + n * FF_MAX_SS,
+             ((fatfs_sector_t *)run[n])->data, FF_MAX_SS);
+    }
+
+    /* On failure the sectors are left dirty for a later attempt.*/
+    failed = fatfs_blk_write(first, fatfs_cache_buffer, n);
+    for (i = 0; i < n; i++) {
+      if (!failed)
+        run[i]->obj_flags &= ~OC_FLAG_LAZYWRITE;
+      chCacheReleaseObject(&fatfs_cache, run[i]);
+    }
+    if (failed) {
+      err = true;
+      break;
+    }
+  }
+  return err ? RES_ERROR : RES_OK;
+}
+#endif /* !FF_FS_READONLY */
+#endif /* FATFS_USE_SECTOR_CACHE */
+
 /*-----------------------------------------------------------------------*/
 /* Inidialize a Drive                                                    */
 
@@ -60,6 +418,10 @@ DSTATUS disk_initialize (
       stat |= STA_NOINIT;
     if (blkIsWriteProtected(&FATFS_HAL_DEVICE))
       stat |= STA_PROTECT;
+#if FATFS_USE_SECTOR_CACHE
+    /* The medium could have been replaced, starting with an empty cache.*/
+    fatfs_cache_init();
+#endif
     return stat;
   }
   return STA_NOINIT;
@@ -105,6 +467,10 @@ DRESULT disk_read (
   case 0:
     if (blkGetDriverState(&FATFS_HAL_DEVICE) != BLK_READY)
       return RES_NOTRDY;
+#if FATFS_USE_SECTOR_CACHE
+    if (fatfs_cache_ready)
+      return fatfs_cache_read(sector, buff, count);
+#endif
     FATFS_RETRY(blkRead(&FATFS_HAL_DEVICE, sector, buff, count));
 	return RES_OK;
   }
@@ -128,6 +494,10 @@ DRESULT disk_write (
   case 0:
     if (blkGetDriverState(&FATFS_HAL_DEVICE) != BLK_READY)
       return RES_NOTRDY;
+#if FATFS_USE_SECTOR_CACHE
+    if (fatfs_cache_ready)
+      return fatfs_cache_write(sector, buff, count);
+#endif
     FATFS_RETRY(blkWrite(&FATFS_HAL_DEVICE, sector, buff, count));
     return RES_OK;
   }
@@ -154,6 +524,10 @@ DRESULT disk_ioctl (
   case 0:
     switch (cmd) {
     case CTRL_SYNC:
+#if FATFS_USE_SECTOR_CACHE && !FF_FS_READONLY
+      if (fatfs_cache_ready)
+        return fatfs_cache_sync();
+#endif
       return RES_OK;
     case GET_SECTOR_COUNT:
       if (blkGetInfo(&FATFS_HAL_DEVICE, &bdi)) {
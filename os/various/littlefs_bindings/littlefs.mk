@@ -3,8 +3,14 @@ LITTLEFSSRC = $(CHIBIOS)/os/various/littlefs_bindings/lfs_hal.c \
               $(CHIBIOS)/ext/littlefs/lfs.c \
               $(CHIBIOS)/ext/littlefs/lfs_util.c
 
+# CRC engine, it could be already included by other subsystems.
+ifeq ($(findstring os/common/utils/src/crc.c,$(ALLCSRC)),)
+LITTLEFSSRC += $(CHIBIOS)/os/common/utils/src/crc.c
+endif
+
 LITTLEFSINC = $(CHIBIOS)/os/various/littlefs_bindings \
-              $(CHIBIOS)/ext/littlefs
+              $(CHIBIOS)/ext/littlefs \
+              $(CHIBIOS)/os/common/utils/include
 
 DDEFS      += -DLFS_THREADSAFE=1 -DLFS_NO_DEBUG=0 -DLFS_CONFIG=lfs_config.h
 
@@ -35,6 +35,10 @@
 #include "vfs.h"
 #endif
 
+#if (SHELL_CMD_TOP_ENABLED == TRUE) || defined(__DOXYGEN__)
+#include <stdlib.h>
+#endif
+
 #if (SHELL_CMD_TEST_ENABLED == TRUE) || defined(__DOXYGEN__)
 #include "rt_test_root.h"
 #include "oslib_test_root.h"
@@ -188,6 +192,185 @@ static void cmd_threads(BaseSequentialStream *chp, int argc, char *argv[]) {
 }
 #endif
 
+#if (SHELL_CMD_TOP_ENABLED == TRUE) || defined(__DOXYGEN__)
+typedef struct {
+  thread_t      *tp;
+  rttime_t      cycles;
+  bool          valid;
+} top_sample_t;
+
+static top_sample_t *top_find(top_sample_t *sp, unsigned n, thread_t *tp) {
+  unsigned i;
+
+  for (i = 0U; i < n; i++) {
+    if (sp[i].tp == tp) {
+      return &sp[i];
+    }
+  }
+  return NULL;
+}
+
+static rttime_t top_cycles(thread_t *tp) {
+  rttime_t cycles;
+
+  /* Counters are not necessarily read atomically.*/
+  chSysLock();
+  cycles = tp == NULL ? chStatsGetIsrCyclesX() : chThdGetCyclesX(tp);
+  chSysUnlock();
+
+  return cycles;
+}
+
+static uint32_t top_permille(rttime_t cycles, rttime_t total) {
+
+  return total == 0U ? 0U : (uint32_t)((cycles * 1000U) / total);
+}
+
+static rtcnt_t top_elapsed(rttime_t *elapsedp, rtcnt_t last) {
+  rtcnt_t now = chSysGetRealtimeCounterX();
+
+  *elapsedp += (rttime_t)(rtcnt_t)(now - last);
+
+  return now;
+}
+
+static void cmd_top(BaseSequentialStream *chp, int argc, char *argv[]) {
+  static const char *states[] = {CH_STATE_NAMES};
+  top_sample_t samples[SHELL_CMD_TOP_MAX_THREADS];
+  top_sample_t *sp;
+  unsigned n = 0U, skipped = 0U;
+  rttime_t isr, total, elapsed = 0U;
+  rtcnt_t last;
+  thread_t *tp;
+  uint32_t pm;
+  int window = 1000;
+
+  if (argc == 1) {
+    window = atoi(argv[0]);
+  }
+  if ((argc > 1) || (window <= 0)) {
+    shellUsage(chp, "top [milliseconds]");
+    return;
+  }
+
+  /* The load is the fraction of the cycles consumed by all threads and
+     ISRs during the time window.*/
+  last = chSysGetRealtimeCounterX();
+  tp = chRegFirstThread();
+  do {
+    if (n < (unsigned)SHELL_CMD_TOP_MAX_THREADS) {
+      samples[n].tp     = tp;
+      samples[n].cycles = top_cycles(tp);
+      samples[n].valid  = false;
+      n++;
+    }
+    else {
+      skipped++;
+    }
+    tp = chRegNextThread(tp);
+  } while (tp != NULL);
+  isr = top_cycles(NULL);
+
+  /* The window length in counter cycles is accumulated in steps short
+     enough to not overflow the realtime counter.*/
+  while (window > 0) {
+    int step = window > 100 ? 100 : window;
+
+    chThdSleepMilliseconds(step);
+    last = top_elapsed(&elapsed, last);
+    window -= step;
+  }
+
+  total = 0U;
+  tp = chRegFirstThread();
+  do {
+    sp = top_find(samples, n, tp);
+    if (sp != NULL) {
+      sp->cycles = top_cycles(tp) - sp->cycles;
+      sp->valid  = true;
+    }
+    tp = chRegNextThread(tp);
+  } while (tp != NULL);
+  isr = top_cycles(NULL) - isr;
+  (void) top_elapsed(&elapsed, last);
+
+  /* Samples are matched by address, a thread terminated during the window
+     and replaced by a new one at the same address gives a meaningless
+     delta, possibly wrapped, those longer than the window are discarded.*/
+  for (sp = &samples[0]; sp < &samples[n]; sp++) {
+    if (sp->valid && (sp->cycles > elapsed)) {
+      sp->valid = false;
+    }
+    if (sp->valid) {
+      total += sp->cycles;
+    }
+  }
+  total += isr;
+
+  chprintf(chp, "    addr prio     state   load         name" SHELL_NEWLINE_STR);
+  tp = chRegFirstThread();
+  do {
+    sp = top_find(samples, n, tp);
+    if ((sp != NULL) && sp->valid) {
+      pm = top_permille(sp->cycles, total);
+      chprintf(chp, "%08lx %4lu %9s %4lu.%lu%% %12s" SHELL_NEWLINE_STR,
+               (unsigned long)(uintptr_t)tp,
+               (uint32_t)tp->hdr.pqueue.prio,
+               states[tp->state],
+               pm / 10U, pm % 10U,
+               tp->name == NULL ? "" : tp->name);
+    }
+    tp = chRegNextThread(tp);
+  } while (tp != NULL);
+  pm = top_permille(isr, total);
+  chprintf(chp, "                   ISRs %4lu.%lu%%" SHELL_NEWLINE_STR,
+           pm / 10U, pm % 10U);
+  if (skipped > 0U) {
+    chprintf(chp, "%u threads not sampled and not in the total, "
+             "SHELL_CMD_TOP_MAX_THREADS is %u" SHELL_NEWLINE_STR,
+             skipped, (unsigned)SHELL_CMD_TOP_MAX_THREADS);
+  }
+}
+#endif
+
+#if (SHELL_CMD_STATS_ENABLED == TRUE) || defined(__DOXYGEN__)
+static void stats_print_tm(BaseSequentialStream *chp, const char *name,
+                           const time_measurement_t *tmp) {
+  time_measurement_t tm;
+
+  chSysLock();
+  tm = *tmp;
+  chSysUnlock();
+
+  chprintf(chp, "%s: best %lu worst %lu avg %lu cycles" SHELL_NEWLINE_STR,
+           name, (uint32_t)tm.best, (uint32_t)tm.worst,
+           tm.n == (ucnt_t)0 ? 0U : (uint32_t)(tm.cumulative / tm.n));
+#if CH_CFG_USE_TM_HISTOGRAMS == TRUE
+  if (tm.histogram != NULL) {
+    chprintf(chp, "%s: p50 %lu p99 %lu p99.9 %lu cycles" SHELL_NEWLINE_STR,
+             name,
+             (uint32_t)chTMGetPercentileX(&tm, 5000U),
+             (uint32_t)chTMGetPercentileX(&tm, 9900U),
+             (uint32_t)chTMGetPercentileX(&tm, 9990U));
+  }
+#endif
+}
+
+static void cmd_stats(BaseSequentialStream *chp, int argc, char *argv[]) {
+  kernel_stats_t *ksp = &currcore->kernel_stats;
+
+  (void)argv;
+  if (argc > 0) {
+    shellUsage(chp, "stats");
+    return;
+  }
+  chprintf(chp, "irq     : %lu" SHELL_NEWLINE_STR, (uint32_t)ksp->n_irq);
+  chprintf(chp, "ctxswc  : %lu" SHELL_NEWLINE_STR, (uint32_t)ksp->n_ctxswc);
+  stats_print_tm(chp, "crit thd", &ksp->m_crit_thd);
+  stats_print_tm(chp, "crit isr", &ksp->m_crit_isr);
+}
+#endif
+
 #if (SHELL_CMD_TEST_ENABLED == TRUE) || defined(__DOXYGEN__)
 static THD_FUNCTION(test_rt, arg) {
   BaseSequentialStream *chp = (BaseSequentialStream *)arg;
@@ -526,6 +709,12 @@ const ShellCommand shell_local_commands[] = {
 #if SHELL_CMD_THREADS_ENABLED == TRUE
   {"threads",   cmd_threads},
 #endif
+#if SHELL_CMD_TOP_ENABLED == TRUE
+  {"top",       cmd_top},
+#endif
+#if SHELL_CMD_STATS_ENABLED == TRUE
+  {"stats",     cmd_stats},
+#endif
 #if SHELL_CMD_FILES_ENABLED == TRUE
   {"cat",       cmd_cat},
   {"cd",        cmd_cd},
@@ -57,6 +57,14 @@
 #define SHELL_CMD_THREADS_ENABLED           TRUE
 #endif
 
+#if !defined(SHELL_CMD_TOP_ENABLED) || defined(__DOXYGEN__)
+#define SHELL_CMD_TOP_ENABLED               FALSE
+#endif
+
+#if !defined(SHELL_CMD_STATS_ENABLED) || defined(__DOXYGEN__)
+#define SHELL_CMD_STATS_ENABLED             FALSE
+#endif
+
 #if !defined(SHELL_CMD_TEST_ENABLED) || defined(__DOXYGEN__)
 #define SHELL_CMD_TEST_ENABLED              TRUE
 #endif
@@ -69,6 +77,10 @@
 #define SHELL_CMD_TEST_WA_SIZE              THD_WORKING_AREA_SIZE(512)
 #endif
 
+#if !defined(SHELL_CMD_TOP_MAX_THREADS) || defined(__DOXYGEN__)
+#define SHELL_CMD_TOP_MAX_THREADS           16
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -85,6 +97,18 @@
 #error "SHELL_CMD_THREADS_ENABLED requires CH_CFG_USE_REGISTRY"
 #endif
 
+#if (SHELL_CMD_TOP_ENABLED == TRUE) && (CH_CFG_USE_REGISTRY == FALSE)
+#error "SHELL_CMD_TOP_ENABLED requires CH_CFG_USE_REGISTRY"
+#endif
+
+#if (SHELL_CMD_TOP_ENABLED == TRUE) && (CH_DBG_STATISTICS == FALSE)
+#error "SHELL_CMD_TOP_ENABLED requires CH_DBG_STATISTICS"
+#endif
+
+#if (SHELL_CMD_STATS_ENABLED == TRUE) && (CH_DBG_STATISTICS == FALSE)
+#error "SHELL_CMD_STATS_ENABLED requires CH_DBG_STATISTICS"
+#endif
+
 #if (SHELL_CMD_FILES_ENABLED == TRUE) && (CH_CFG_USE_HEAP == FALSE)
 #error "SHELL_CMD_FILES_ENABLED requires CH_CFG_USE_HEAP"
 #endif
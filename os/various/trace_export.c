@@ -0,0 +1,288 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    trace_export.c
+ * @brief   Trace buffer exporter code.
+ * @details The exporter drains the kernel trace buffer and writes the
+ *          records on a stream in a compact binary format, the buffer is
+ *          used as a single producer single consumer queue so tracing can
+ *          run continuously as long as the exporter keeps up. Records
+ *          overwritten before being exported are reported in the stream.
+ *          The script @p tools/trace/trace2json.py converts the stream in
+ *          the Chrome/Perfetto JSON trace format.
+ *
+ * @addtogroup trace_export
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "trace_export.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static uintptr_t trexp_id(const void *p) {
+
+  return (uintptr_t)p;
+}
+
+static void trexp_put(uint8_t *p, uintptr_t w, size_t n) {
+
+  while (n-- > (size_t)0) {
+    *p++ = (uint8_t)w;
+    w >>= 8;
+  }
+}
+
+static void trexp_write_record(trace_exporter_t *tep, unsigned type,
+                               unsigned state, uint32_t rtstamp,
+                               uint32_t time, uintptr_t p1, uintptr_t p2) {
+  uint8_t buf[TREXP_RECORD_SIZE];
+
+  trexp_put(&buf[0], (uint32_t)type | ((uint32_t)state << 3) |
+                     (rtstamp << 8), 4U);
+  trexp_put(&buf[4], time, 4U);
+  trexp_put(&buf[8], p1, TREXP_PARAM_SIZE);
+  trexp_put(&buf[8U + TREXP_PARAM_SIZE], p2, TREXP_PARAM_SIZE);
+  (void) streamWrite(tep->stream, buf, sizeof buf);
+}
+
+static void trexp_write_name(trace_exporter_t *tep, unsigned kind,
+                             const void *p, const char *name) {
+  size_t n = strlen(name);
+
+  trexp_write_record(tep, CH_TRACE_TYPE_UNUSED, kind, 0U, 0U,
+                     trexp_id(p), (uintptr_t)n);
+  (void) streamWrite(tep->stream, (const uint8_t *)name, n);
+}
+
+static bool trexp_is_known(trace_exporter_t *tep, const void *p) {
+  unsigned i;
+
+  for (i = 0U; i < TREXP_NAMES_SIZE; i++) {
+    if (tep->ids[i] == p) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void trexp_set_known(trace_exporter_t *tep, const void *p) {
+
+  tep->ids[tep->nextid] = p;
+  if (++tep->nextid >= TREXP_NAMES_SIZE) {
+    tep->nextid = 0U;
+  }
+}
+
+static void trexp_announce_string(trace_exporter_t *tep, const char *s) {
+
+  if ((s != NULL) && !trexp_is_known(tep, s)) {
+    trexp_write_name(tep, TREXP_EXT_STRING, s, s);
+    trexp_set_known(tep, s);
+  }
+}
+
+static void trexp_announce_thread(trace_exporter_t *tep, thread_t *tp) {
+
+  if (!trexp_is_known(tep, tp)) {
+#if CH_CFG_USE_REGISTRY == TRUE
+    const char *name;
+
+    /* The thread could have been terminated since the event has been
+       recorded, the registry is checked before accessing it.*/
+    if (chRegFindThreadByPointer(tp) == NULL) {
+      return;
+    }
+    name = chRegGetThreadNameX(tp);
+    if (name != NULL) {
+      trexp_write_name(tep, TREXP_EXT_THREAD, tp, name);
+    }
+#if CH_CFG_USE_DYNAMIC == TRUE
+    chThdRelease(tp);
+#endif
+#endif
+    trexp_set_known(tep, tp);
+  }
+}
+
+static void trexp_write_event(trace_exporter_t *tep, trace_event_t *ep) {
+  uintptr_t p1, p2;
+
+  switch (ep->type) {
+  case CH_TRACE_TYPE_READY:
+    trexp_announce_thread(tep, ep->u.rdy.tp);
+    p1 = trexp_id(ep->u.rdy.tp);
+    p2 = (uintptr_t)ep->u.rdy.msg;
+    break;
+  case CH_TRACE_TYPE_SWITCH:
+    trexp_announce_thread(tep, ep->u.sw.ntp);
+    p1 = trexp_id(ep->u.sw.ntp);
+    p2 = trexp_id(ep->u.sw.wtobjp);
+    break;
+  case CH_TRACE_TYPE_ISR_ENTER:
+  case CH_TRACE_TYPE_ISR_LEAVE:
+    trexp_announce_string(tep, ep->u.isr.name);
+    p1 = trexp_id(ep->u.isr.name);
+    p2 = 0U;
+    break;
+  case CH_TRACE_TYPE_HALT:
+    trexp_announce_string(tep, ep->u.halt.reason);
+    p1 = trexp_id(ep->u.halt.reason);
+    p2 = 0U;
+    break;
+  case CH_TRACE_TYPE_USER:
+    p1 = trexp_id(ep->u.user.up1);
+    p2 = trexp_id(ep->u.user.up2);
+    break;
+  default:
+    return;
+  }
+
+  trexp_write_record(tep, ep->type, ep->state, ep->rtstamp,
+                     (uint32_t)ep->time, p1, p2);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a trace exporter.
+ *
+ * @param[out] tep      pointer to a @p trace_exporter_t structure
+ * @param[in] stream    pointer to the output stream
+ * @param[in] rtfreq    frequency of the real time counter used for the
+ *                      records time stamps, zero if not available
+ *
+ * @init
+ */
+void trexpObjectInit(trace_exporter_t *tep, BaseSequentialStream *stream,
+                     uint32_t rtfreq) {
+  unsigned i;
+
+  tep->stream = stream;
+  tep->rtfreq = rtfreq;
+  tep->lost   = 0U;
+  tep->nextid = 0U;
+  for (i = 0U; i < TREXP_NAMES_SIZE; i++) {
+    tep->ids[i] = NULL;
+  }
+}
+
+/**
+ * @brief   Starts the exported stream.
+ * @details Records already in the trace buffer are discarded, then the
+ *          stream header and the names of the existing threads are
+ *          written.
+ *
+ * @param[in] tep       pointer to a @p trace_exporter_t structure
+ *
+ * @api
+ */
+void trexpStart(trace_exporter_t *tep) {
+
+  chSysLock();
+  while (chTraceReadI(tep->events, TREXP_CHUNK_SIZE) > (size_t)0) {
+  }
+  tep->lost = chTraceGetLostX();
+  chSysUnlock();
+
+  trexp_write_record(tep, CH_TRACE_TYPE_UNUSED, TREXP_EXT_HEADER,
+                     (uint32_t)TREXP_PARAM_SIZE,
+                     (uint32_t)CH_CFG_ST_FREQUENCY, tep->rtfreq,
+                     TREXP_MAGIC);
+
+#if CH_CFG_USE_REGISTRY == TRUE
+  {
+    thread_t *tp = chRegFirstThread();
+    do {
+      trexp_announce_thread(tep, tp);
+      tp = chRegNextThread(tp);
+    } while (tp != NULL);
+  }
+#endif
+}
+
+/**
+ * @brief   Exports the records in the trace buffer.
+ * @details All the records accumulated in the trace buffer are written on
+ *          the stream, the function is meant to be invoked periodically by
+ *          a low priority thread. Names are written the first time a
+ *          thread or string is referenced.
+ * @note    At most @p CH_DBG_TRACE_BUFFER_SIZE records are exported by a
+ *          single call.
+ * @note    The stream is written outside the critical zone, writing can
+ *          generate further trace events.
+ *
+ * @param[in] tep       pointer to a @p trace_exporter_t structure
+ * @return              The number of exported trace records.
+ *
+ * @api
+ */
+size_t trexpDrain(trace_exporter_t *tep) {
+  size_t total = (size_t)0;
+
+  /* The amount of records exported in a single call is limited because
+     writing on the stream can generate new records.*/
+  while (true) {
+    size_t i, n;
+    uint32_t lost;
+
+    chSysLock();
+    n = chTraceReadI(tep->events, TREXP_CHUNK_SIZE);
+    lost = chTraceGetLostX();
+    chSysUnlock();
+
+    /* Records lost before the ones just fetched.*/
+    if (lost != tep->lost) {
+      trexp_write_record(tep, CH_TRACE_TYPE_UNUSED, TREXP_EXT_LOST, 0U,
+                         0U, (uintptr_t)(lost - tep->lost), 0U);
+      tep->lost = lost;
+    }
+
+    for (i = (size_t)0; i < n; i++) {
+      trexp_write_event(tep, &tep->events[i]);
+    }
+    total += n;
+
+    if ((n == (size_t)0) || (total >= (size_t)CH_DBG_TRACE_BUFFER_SIZE)) {
+      return total;
+    }
+  }
+}
+
+/** @} */
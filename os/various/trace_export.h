@@ -0,0 +1,182 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    trace_export.h
+ * @brief   Trace buffer exporter macros and structures.
+ *
+ * @addtogroup trace_export
+ * @{
+ */
+
+#ifndef TRACE_EXPORT_H
+#define TRACE_EXPORT_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the record parameters.
+ * @details Parameters are pointer-sized so that thread and object
+ *          identifiers are exported without truncation.
+ */
+#define TREXP_PARAM_SIZE                sizeof (uintptr_t)
+
+/**
+ * @brief   Size of an exported record.
+ * @details Records are composed of two little endian 32 bits words
+ *          followed by two little endian parameters of
+ *          @p TREXP_PARAM_SIZE bytes:
+ *          - Word 0, record type in bits 0..2, state in bits 3..7 and
+ *            real time stamp in bits 8..31.
+ *          - Word 1, system time stamp.
+ *          - First parameter.
+ *          - Second parameter.
+ *          .
+ */
+#define TREXP_RECORD_SIZE               (8U + (2U * TREXP_PARAM_SIZE))
+
+/**
+ * @brief   Magic number in the header record, "CHTR".
+ */
+#define TREXP_MAGIC                     0x52544843U
+
+/**
+ * @name    Extension records
+ * @details Extension records have type zero, the state field specifies
+ *          the record kind.
+ * @{
+ */
+/**
+ * @brief   String record.
+ * @details Parameter 1 is the string identifier, parameter 2 is the string
+ *          length, the string characters follow the record.
+ */
+#define TREXP_EXT_STRING                1U
+/**
+ * @brief   Thread name record.
+ * @details Parameter 1 is the thread identifier, parameter 2 is the name
+ *          length, the name characters follow the record.
+ */
+#define TREXP_EXT_THREAD                2U
+/**
+ * @brief   Lost records.
+ * @details Parameter 1 is the number of records lost since the previous
+ *          lost record.
+ */
+#define TREXP_EXT_LOST                  3U
+/**
+ * @brief   Stream header.
+ * @details The real time stamp field is @p TREXP_PARAM_SIZE, the time
+ *          stamp field is the system time frequency, parameter 1 is the
+ *          real time counter frequency, parameter 2 is the magic number.
+ */
+#define TREXP_EXT_HEADER                4U
+/** @} */
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of identifiers remembered by the exporter.
+ * @details Names are sent once for each thread or string identifier, when
+ *          the table is full the oldest entries are replaced and names can
+ *          be sent again.
+ */
+#if !defined(TREXP_NAMES_SIZE) || defined(__DOXYGEN__)
+#define TREXP_NAMES_SIZE                32U
+#endif
+
+/**
+ * @brief   Number of trace records fetched from the kernel at once.
+ */
+#if !defined(TREXP_CHUNK_SIZE) || defined(__DOXYGEN__)
+#define TREXP_CHUNK_SIZE                16U
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*
+ * Module dependencies check.
+ */
+#if CH_DBG_TRACE_MASK == CH_DBG_TRACE_MASK_DISABLED
+#error "Trace export requires CH_DBG_TRACE_MASK"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a trace exporter.
+ */
+typedef struct {
+  /**
+   * @brief   Output stream.
+   */
+  BaseSequentialStream  *stream;
+  /**
+   * @brief   Frequency of the real time counter.
+   */
+  uint32_t              rtfreq;
+  /**
+   * @brief   Lost records counter at the last check.
+   */
+  uint32_t              lost;
+  /**
+   * @brief   Next entry to be replaced in the identifiers table.
+   */
+  unsigned              nextid;
+  /**
+   * @brief   Identifiers already announced on the stream.
+   */
+  const void            *ids[TREXP_NAMES_SIZE];
+  /**
+   * @brief   Records fetched from the trace buffer.
+   */
+  trace_event_t         events[TREXP_CHUNK_SIZE];
+} trace_exporter_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void trexpObjectInit(trace_exporter_t *tep, BaseSequentialStream *stream,
+                       uint32_t rtfreq);
+  void trexpStart(trace_exporter_t *tep);
+  size_t trexpDrain(trace_exporter_t *tep);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* TRACE_EXPORT_H */
+
+/** @} */
@@ -164,6 +164,10 @@ struct vfs_chfs_file_node {
    * @brief       Node mode information.
    */
   vfs_mode_t                mode;
+  /**
+   * @brief       File buffer or @p NULL if the node is not buffered.
+   */
+  vfs_file_buffer_t         *buffer;
   /**
    * @brief       Implemented interface @p sequential_stream_i.
    */
@@ -214,6 +214,10 @@ struct vfs_streams_file_node {
    * @brief       Node mode information.
    */
   vfs_mode_t                mode;
+  /**
+   * @brief       File buffer or @p NULL if the node is not buffered.
+   */
+  vfs_file_buffer_t         *buffer;
   /**
    * @brief       Stream interface for this file.
    */
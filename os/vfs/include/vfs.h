@@ -88,6 +88,7 @@
 #include "vfsbuffers.h"
 #include "vfsnodes.h"
 #include "vfsdrivers.h"
+#include "vfsasync.h"
 
 /* File System drivers.*/
 #if VFS_CFG_ENABLE_DRV_OVERLAY == TRUE
@@ -149,6 +150,9 @@ extern "C" {
                            vfs_seekmode_t whence);
   vfs_offset_t vfsGetFilePosition(vfs_file_node_c *vfnp);
   sequential_stream_i *vfsGetFileStream(vfs_file_node_c *vfnp);
+  msg_t vfsSetFileBuffer(vfs_file_node_c *vfnp, vfs_file_buffer_t *fbp,
+                         uint8_t *buf, size_t size);
+  msg_t vfsSyncFile(vfs_file_node_c *vfnp);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,215 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation version 3 of the License.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    vfs/include/vfsasync.h
+ * @brief   VFS asynchronous I/O header file.
+ *
+ * @addtogroup VFS_ASYNC
+ * @{
+ */
+
+#ifndef VFSASYNC_H
+#define VFSASYNC_H
+
+#if (VFS_CFG_ENABLE_ASYNC == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Asynchronous operations
+ * @{
+ */
+#define VFS_ASYNC_OP_READ       0U
+#define VFS_ASYNC_OP_WRITE      1U
+#define VFS_ASYNC_OP_SYNC       2U
+/** @} */
+
+/**
+ * @name    Request states
+ * @{
+ */
+#define VFS_ASYNC_IDLE          0U
+#define VFS_ASYNC_QUEUED        1U
+#define VFS_ASYNC_ACTIVE        2U
+#define VFS_ASYNC_DONE          3U
+/** @} */
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of an asynchronous request.
+ */
+typedef struct vfs_async_request vfs_async_request_t;
+
+/**
+ * @brief   Type of a completion callback.
+ * @note    Callbacks are invoked from the worker thread context.
+ *
+ * @param[in] arp       Pointer to the completed request.
+ */
+typedef void (*vfs_async_callback_t)(vfs_async_request_t *arp);
+
+/**
+ * @brief   Type of an asynchronous I/O worker.
+ */
+typedef struct vfs_async_worker {
+  /**
+   * @brief   Queue of pending requests.
+   */
+  ch_queue_t                queue;
+  /**
+   * @brief   Worker thread.
+   */
+  thread_t                  *thread;
+  /**
+   * @brief   Reference to the worker thread while waiting for requests.
+   */
+  thread_reference_t        wait;
+  /**
+   * @brief   Stop request flag.
+   */
+  bool                      stop;
+} vfs_async_worker_t;
+
+/**
+ * @brief   Structure representing an asynchronous request.
+ */
+struct vfs_async_request {
+  /**
+   * @brief   Queue link, must be the first field.
+   */
+  ch_queue_t                queue;
+  /**
+   * @brief   Request state.
+   */
+  volatile unsigned         state;
+  /**
+   * @brief   Requested operation.
+   */
+  unsigned                  op;
+  /**
+   * @brief   Target file node.
+   */
+  vfs_file_node_c           *vfnp;
+  /**
+   * @brief   Data buffer.
+   */
+  uint8_t                   *buf;
+  /**
+   * @brief   Number of bytes to be transferred.
+   */
+  size_t                    n;
+  /**
+   * @brief   Operation result.
+   * @details Number of transferred bytes or an error code.
+   */
+  ssize_t                   result;
+  /**
+   * @brief   Completion callback or @p NULL.
+   */
+  vfs_async_callback_t      callback;
+  /**
+   * @brief   Callback argument.
+   */
+  void                      *arg;
+  /**
+   * @brief   Reference to a thread waiting for completion.
+   */
+  thread_reference_t        waiter;
+};
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void vfsAsyncStart(vfs_async_worker_t *awp, void *wsp, size_t size,
+                     tprio_t prio);
+#if (CH_CFG_USE_WAITEXIT == TRUE) || defined(__DOXYGEN__)
+  void vfsAsyncStop(vfs_async_worker_t *awp);
+#endif
+  void vfsAsyncObjectInit(vfs_async_request_t *arp,
+                          vfs_async_callback_t callback, void *arg);
+  msg_t vfsAsyncReadFile(vfs_async_worker_t *awp, vfs_async_request_t *arp,
+                         vfs_file_node_c *vfnp, uint8_t *buf, size_t n);
+  msg_t vfsAsyncWriteFile(vfs_async_worker_t *awp, vfs_async_request_t *arp,
+                          vfs_file_node_c *vfnp, const uint8_t *buf,
+                          size_t n);
+  msg_t vfsAsyncSyncFile(vfs_async_worker_t *awp, vfs_async_request_t *arp,
+                         vfs_file_node_c *vfnp);
+  msg_t vfsAsyncWait(vfs_async_request_t *arp, sysinterval_t timeout);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Checks if a request has been completed.
+ *
+ * @param[in] arp       Pointer to a @p vfs_async_request_t object.
+ * @return              The completion state.
+ *
+ * @xclass
+ */
+static inline bool vfsAsyncIsDone(vfs_async_request_t *arp) {
+
+  return (bool)(arp->state == VFS_ASYNC_DONE);
+}
+
+/**
+ * @brief   Returns the result of a completed request.
+ *
+ * @param[in] arp       Pointer to a @p vfs_async_request_t object.
+ * @return              The number of transferred bytes or an error code.
+ *
+ * @xclass
+ */
+static inline ssize_t vfsAsyncGetResult(vfs_async_request_t *arp) {
+
+  chDbgAssert(arp->state == VFS_ASYNC_DONE, "not completed");
+
+  return arp->result;
+}
+
+#endif /* VFS_CFG_ENABLE_ASYNC == TRUE */
+
+#endif /* VFSASYNC_H */
+
+/** @} */
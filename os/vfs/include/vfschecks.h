@@ -72,6 +72,10 @@
 #error "invalid value for VFS_CFG_PATHBUFS_NUM"
 #endif
 
+#if !defined(VFS_CFG_ENABLE_ASYNC)
+#error "VFS_CFG_ENABLE_ASYNC not defined in vfsconf.h"
+#endif
+
 #if !defined(VFS_CFG_ENABLE_DRV_OVERLAY)
 #error "VFS_CFG_ENABLE_DRV_OVERLAY not defined in vfsconf.h"
 #endif
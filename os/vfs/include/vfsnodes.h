@@ -119,6 +119,11 @@ typedef struct vfs_direntry_info vfs_direntry_info_t;
  */
 typedef struct vfs_stat vfs_stat_t;
 
+/**
+ * @brief       Type of a file buffer structure.
+ */
+typedef struct vfs_file_buffer vfs_file_buffer_t;
+
 /**
  * @brief       Structure representing a directory entry.
  */
@@ -151,6 +156,36 @@ struct vfs_stat {
   vfs_offset_t              size;
 };
 
+/**
+ * @brief       Structure representing a file buffer.
+ */
+struct vfs_file_buffer {
+  /**
+   * @brief       Buffer area.
+   */
+  uint8_t                   *data;
+  /**
+   * @brief       Size of the buffer area.
+   */
+  size_t                    size;
+  /**
+   * @brief       File offset of the first buffered byte.
+   */
+  vfs_offset_t              offset;
+  /**
+   * @brief       Number of buffered bytes.
+   */
+  size_t                    valid;
+  /**
+   * @brief       Current position within the buffered bytes.
+   */
+  size_t                    pos;
+  /**
+   * @brief       Buffered bytes not yet written to the file.
+   */
+  bool                      dirty;
+};
+
 /**
  * @class       vfs_node_c
  * @extends     referenced_object_c
@@ -310,6 +345,10 @@ struct vfs_file_node {
    * @brief       Node mode information.
    */
   vfs_mode_t                mode;
+  /**
+   * @brief       File buffer or @p NULL if the node is not buffered.
+   */
+  vfs_file_buffer_t         *buffer;
 };
 /** @} */
 
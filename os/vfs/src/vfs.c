@@ -46,6 +46,225 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Writes the buffered data to the file.
+ *
+ * @param[in] vfnp      Pointer to the @p vfs_file_node_c object.
+ * @return              The operation result.
+ *
+ * @notapi
+ */
+static msg_t vfs_buffer_flush(vfs_file_node_c *vfnp) {
+  vfs_file_buffer_t *fbp = vfnp->buffer;
+  ssize_t n;
+
+  if (!fbp->dirty) {
+    return CH_RET_SUCCESS;
+  }
+
+  /* The file position is at the start of the buffered data, on failure the
+     data is kept for a later attempt.*/
+  n = vfsFileWrite((void *)vfnp, fbp->data, fbp->valid);
+  CH_RETURN_ON_ERROR(n);
+  if ((size_t)n != fbp->valid) {
+    /* Short write, the file position moved past the written part, only
+       the unwritten tail is kept.*/
+    memmove(fbp->data, fbp->data + (size_t)n, fbp->valid - (size_t)n);
+    fbp->offset += (vfs_offset_t)n;
+    fbp->valid  -= (size_t)n;
+    fbp->pos     = fbp->valid;
+    return CH_RET_EIO;
+  }
+
+  fbp->offset += (vfs_offset_t)n;
+  fbp->valid   = 0U;
+  fbp->pos     = 0U;
+  fbp->dirty   = false;
+
+  return CH_RET_SUCCESS;
+}
+
+/**
+ * @brief   Discards read buffered data.
+ * @details The file position is moved back to the current buffer position.
+ *
+ * @param[in] vfnp      Pointer to the @p vfs_file_node_c object.
+ * @return              The operation result.
+ *
+ * @notapi
+ */
+static msg_t vfs_buffer_discard(vfs_file_node_c *vfnp) {
+  vfs_file_buffer_t *fbp = vfnp->buffer;
+  msg_t ret;
+
+  if (fbp->pos < fbp->valid) {
+    ret = vfsFileSetPosition((void *)vfnp,
+                             fbp->offset + (vfs_offset_t)fbp->pos,
+                             VFS_SEEK_SET);
+    CH_RETURN_ON_ERROR(ret);
+  }
+
+  fbp->offset += (vfs_offset_t)fbp->pos;
+  fbp->valid   = 0U;
+  fbp->pos     = 0U;
+
+  return CH_RET_SUCCESS;
+}
+
+/**
+ * @brief   Buffered file read.
+ * @details Data is read in whole buffer-aligned blocks, this results in
+ *          read-ahead on sequential access. Transfers spanning whole
+ *          blocks go straight into the caller buffer.
+ *
+ * @param[in] vfnp      Pointer to the @p vfs_file_node_c object.
+ * @param[in] buf       Pointer to the data buffer.
+ * @param[in] n         Maximum amount of data to be transferred.
+ * @return              The transferred number of bytes or an error.
+ *
+ * @notapi
+ */
+static ssize_t vfs_buffer_read(vfs_file_node_c *vfnp, uint8_t *buf, size_t n) {
+  vfs_file_buffer_t *fbp = vfnp->buffer;
+  size_t total = 0U;
+  msg_t ret;
+
+  ret = vfs_buffer_flush(vfnp);
+  CH_RETURN_ON_ERROR(ret);
+
+  while (n > 0U) {
+    size_t lim, chunk;
+    ssize_t nr;
+
+    /* Serving from the buffer first.*/
+    if (fbp->pos < fbp->valid) {
+      chunk = fbp->valid - fbp->pos;
+      if (chunk > n) {
+        chunk = n;
+      }
+      memcpy(buf, fbp->data + fbp->pos, chunk);
+      fbp->pos += chunk;
+      buf      += chunk;
+      n        -= chunk;
+      total    += chunk;
+      continue;
+    }
+
+    /* Buffer exhausted, the file position is at its end.*/
+    fbp->offset += (vfs_offset_t)fbp->valid;
+    fbp->valid   = 0U;
+    fbp->pos     = 0U;
+    lim = fbp->size - ((size_t)fbp->offset % fbp->size);
+    if (n >= lim) {
+      /* Whole blocks are read directly.*/
+      chunk = lim + (((n - lim) / fbp->size) * fbp->size);
+      nr = vfsFileRead((void *)vfnp, buf, chunk);
+      if (CH_RET_IS_ERROR(nr)) {
+        return total > 0U ? (ssize_t)total : nr;
+      }
+      fbp->offset += (vfs_offset_t)nr;
+      buf         += (size_t)nr;
+      n           -= (size_t)nr;
+      total       += (size_t)nr;
+      if ((size_t)nr < chunk) {
+        break;
+      }
+    }
+    else {
+      /* Refilling the buffer up to the next block boundary.*/
+      nr = vfsFileRead((void *)vfnp, fbp->data, lim);
+      if (CH_RET_IS_ERROR(nr)) {
+        return total > 0U ? (ssize_t)total : nr;
+      }
+      if (nr == 0) {
+        break;
+      }
+      fbp->valid = (size_t)nr;
+    }
+  }
+
+  return (ssize_t)total;
+}
+
+/**
+ * @brief   Buffered file write.
+ * @details Data is accumulated up to the next buffer-aligned boundary then
+ *          written in a single operation. Transfers spanning whole blocks
+ *          go straight to the file.
+ *
+ * @param[in] vfnp      Pointer to the @p vfs_file_node_c object.
+ * @param[in] buf       Pointer to the data buffer.
+ * @param[in] n         Maximum amount of data to be transferred.
+ * @return              The transferred number of bytes or an error.
+ *
+ * @notapi
+ */
+static ssize_t vfs_buffer_write(vfs_file_node_c *vfnp,
+                                const uint8_t *buf, size_t n) {
+  vfs_file_buffer_t *fbp = vfnp->buffer;
+  size_t total = 0U;
+  msg_t ret;
+
+  /* Read data in the buffer is discarded.*/
+  if (!fbp->dirty) {
+    ret = vfs_buffer_discard(vfnp);
+    CH_RETURN_ON_ERROR(ret);
+  }
+
+  while (n > 0U) {
+    size_t lim, chunk;
+    ssize_t nw;
+
+    lim = fbp->size - ((size_t)fbp->offset % fbp->size);
+    if ((fbp->valid == 0U) && (n >= lim)) {
+      /* Whole blocks are written directly.*/
+      chunk = lim + (((n - lim) / fbp->size) * fbp->size);
+      nw = vfsFileWrite((void *)vfnp, buf, chunk);
+      if (CH_RET_IS_ERROR(nw)) {
+        return total > 0U ? (ssize_t)total : nw;
+      }
+      fbp->offset += (vfs_offset_t)nw;
+      buf         += (size_t)nw;
+      n           -= (size_t)nw;
+      total       += (size_t)nw;
+      if ((size_t)nw < chunk) {
+        break;
+      }
+    }
+    else {
+      chunk = lim - fbp->valid;
+      if (chunk > n) {
+        chunk = n;
+      }
+      memcpy(fbp->data + fbp->valid, buf, chunk);
+      fbp->valid += chunk;
+      fbp->pos    = fbp->valid;
+      fbp->dirty  = true;
+      buf        += chunk;
+      n          -= chunk;
+      total      += chunk;
+
+      /* Flushing on block boundary, on failure the part of the data just
+         added still in the buffer is removed and not accounted.*/
+      if (fbp->valid == lim) {
+        ret = vfs_buffer_flush(vfnp);
+        if (CH_RET_IS_ERROR(ret)) {
+          if (chunk > fbp->valid) {
+            chunk = fbp->valid;
+          }
+          fbp->valid -= chunk;
+          fbp->pos    = fbp->valid;
+          fbp->dirty  = fbp->valid > 0U;
+          total      -= chunk;
+          return total > 0U ? (ssize_t)total : ret;
+        }
+      }
+    }
+  }
+
+  return (ssize_t)total;
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -241,6 +460,9 @@ msg_t vfsGetNodeStat(vfs_node_c *np, vfs_stat_t *sp) {
 
 /**
  * @brief   Releases a @p vfs_node_c or descendant object.
+ * @note    Buffered data of a file node is written before releasing but
+ *          write errors cannot be reported, call @p vfsSyncFile() before
+ *          closing in order to check the outcome.
  *
  * @param[in] vnp       Pointer to the @p vfs_node_c object to be released.
  *
@@ -250,6 +472,13 @@ void vfsClose(vfs_node_c *vnp) {
 
   chDbgAssert(vnp->references > 0U, "zero count");
 
+  /* Buffered data is written before releasing, file buffers can only be
+     associated to regular files.*/
+  if (VFS_MODE_S_ISREG(vnp->mode) &&
+      (((vfs_file_node_c *)vnp)->buffer != NULL)) {
+    (void) vfs_buffer_flush((vfs_file_node_c *)vnp);
+  }
+
   roRelease((void *)vnp);
 }
 
@@ -306,6 +535,10 @@ ssize_t vfsReadFile(vfs_file_node_c *vfnp, uint8_t *buf, size_t n) {
 
   chDbgAssert(vfnp->references > 0U, "zero count");
 
+  if (vfnp->buffer != NULL) {
+    return vfs_buffer_read(vfnp, buf, n);
+  }
+
   return vfsFileRead((void *)vfnp, buf, n);
 }
 
@@ -324,6 +557,10 @@ ssize_t vfsWriteFile(vfs_file_node_c *vfnp, const uint8_t *buf, size_t n) {
 
   chDbgAssert(vfnp->references > 0U, "zero count");
 
+  if (vfnp->buffer != NULL) {
+    return vfs_buffer_write(vfnp, buf, n);
+  }
+
   return vfsFileWrite((void *)vfnp, buf, n);
 }
 
@@ -343,6 +580,38 @@ msg_t vfsSetFilePosition(vfs_file_node_c *vfnp,
 
   chDbgAssert(vfnp->references > 0U, "zero count");
 
+  if (vfnp->buffer != NULL) {
+    vfs_file_buffer_t *fbp = vfnp->buffer;
+    msg_t ret;
+
+    ret = vfs_buffer_flush(vfnp);
+    CH_RETURN_ON_ERROR(ret);
+
+    /* Relative positioning is resolved here because the file position
+       does not match the logical position while buffering.*/
+    if (whence == VFS_SEEK_CUR) {
+      offset += fbp->offset + (vfs_offset_t)fbp->pos;
+      whence  = VFS_SEEK_SET;
+    }
+
+    /* Positioning within the buffered data does not involve the file.*/
+    if ((whence == VFS_SEEK_SET) && (fbp->valid > 0U) &&
+        (offset >= fbp->offset) &&
+        (offset <= fbp->offset + (vfs_offset_t)fbp->valid)) {
+      fbp->pos = (size_t)(offset - fbp->offset);
+      return CH_RET_SUCCESS;
+    }
+
+    ret = vfsFileSetPosition((void *)vfnp, offset, whence);
+    CH_RETURN_ON_ERROR(ret);
+
+    fbp->offset = vfsFileGetPosition((void *)vfnp);
+    fbp->valid  = 0U;
+    fbp->pos    = 0U;
+
+    return CH_RET_SUCCESS;
+  }
+
   return vfsFileSetPosition((void *)vfnp, offset, whence);
 }
 
@@ -358,6 +627,10 @@ vfs_offset_t vfsGetFilePosition(vfs_file_node_c *vfnp) {
 
   chDbgAssert(vfnp->references > 0U, "zero count");
 
+  if (vfnp->buffer != NULL) {
+    return vfnp->buffer->offset + (vfs_offset_t)vfnp->buffer->pos;
+  }
+
   return vfsFileGetPosition((void *)vfnp);
 }
 
@@ -376,4 +649,78 @@ sequential_stream_i *vfsGetFileStream(vfs_file_node_c *vfnp) {
   return vfsFileGetStream((void *)vfnp);
 }
 
+/**
+ * @brief   Associates a buffer to a file node.
+ * @details Reads are performed in buffer-aligned blocks, small writes are
+ *          accumulated and written in buffer-aligned blocks. Buffered data
+ *          is written on @p vfsSyncFile(), @p vfsClose() or when the
+ *          buffer is detached, write errors are not reported by
+ *          @p vfsClose().
+ * @note    The buffer size should be a multiple of the media sector size.
+ * @note    Only regular files can be buffered.
+ * @note    The inner stream returned by @p vfsGetFileStream() bypasses the
+ *          buffer.
+ *
+ * @param[in] vfnp      Pointer to the @p vfs_file_node_c object.
+ * @param[in] fbp       Pointer to a @p vfs_file_buffer_t structure or
+ *                      @p NULL for detaching the current buffer.
+ * @param[in] buf       Pointer to the buffer area.
+ * @param[in] size      Size of the buffer area.
+ * @return              The operation result.
+ *
+ * @api
+ */
+msg_t vfsSetFileBuffer(vfs_file_node_c *vfnp, vfs_file_buffer_t *fbp,
+                       uint8_t *buf, size_t size) {
+  msg_t ret;
+
+  chDbgCheck((fbp == NULL) || ((buf != NULL) && (size > 0U)));
+  chDbgAssert(vfnp->references > 0U, "zero count");
+
+  if (!VFS_MODE_S_ISREG(vfnp->mode)) {
+    return CH_RET_EINVAL;
+  }
+
+  /* Removing the current buffer, the file position is moved to the
+     logical position.*/
+  if (vfnp->buffer != NULL) {
+    ret = vfs_buffer_flush(vfnp);
+    CH_RETURN_ON_ERROR(ret);
+    ret = vfs_buffer_discard(vfnp);
+    CH_RETURN_ON_ERROR(ret);
+    vfnp->buffer = NULL;
+  }
+
+  if (fbp != NULL) {
+    fbp->data   = buf;
+    fbp->size   = size;
+    fbp->offset = vfsFileGetPosition((void *)vfnp);
+    fbp->valid  = 0U;
+    fbp->pos    = 0U;
+    fbp->dirty  = false;
+    vfnp->buffer = fbp;
+  }
+
+  return CH_RET_SUCCESS;
+}
+
+/**
+ * @brief   Writes the buffered data of a file node.
+ *
+ * @param[in] vfnp      Pointer to the @p vfs_file_node_c object.
+ * @return              The operation result.
+ *
+ * @api
+ */
+msg_t vfsSyncFile(vfs_file_node_c *vfnp) {
+
+  chDbgAssert(vfnp->references > 0U, "zero count");
+
+  if (vfnp->buffer != NULL) {
+    return vfs_buffer_flush(vfnp);
+  }
+
+  return CH_RET_SUCCESS;
+}
+
 /** @} */
@@ -0,0 +1,331 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation version 3 of the License.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    vfs/src/vfsasync.c
+ * @brief   VFS asynchronous I/O code.
+ * @details Requests are queued to a worker object and executed, in order, by
+ *          the worker thread using the synchronous file API, this makes the
+ *          mechanism independent from the underlying file system driver.
+ *          A worker is meant to serve the files of a single driver so that
+ *          slow devices do not delay the I/O on other devices.
+ *
+ * @addtogroup VFS_ASYNC
+ * @{
+ */
+
+#include "vfs.h"
+
+#if (VFS_CFG_ENABLE_ASYNC == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static ssize_t vfs_async_execute(vfs_async_request_t *arp) {
+
+  switch (arp->op) {
+  case VFS_ASYNC_OP_READ:
+    return vfsReadFile(arp->vfnp, arp->buf, arp->n);
+  case VFS_ASYNC_OP_WRITE:
+    return vfsWriteFile(arp->vfnp, arp->buf, arp->n);
+  case VFS_ASYNC_OP_SYNC:
+    return (ssize_t)vfsSyncFile(arp->vfnp);
+  default:
+    return (ssize_t)CH_RET_EINVAL;
+  }
+}
+
+static THD_FUNCTION(vfs_async_thread, p) {
+  vfs_async_worker_t *awp = (vfs_async_worker_t *)p;
+
+  chRegSetThreadName("vfsasync");
+
+  while (true) {
+    vfs_async_request_t *arp;
+
+    /* Waiting for a request, pending requests are served before
+       stopping.*/
+    chSysLock();
+    while (ch_queue_isempty(&awp->queue)) {
+      if (awp->stop) {
+        chSysUnlock();
+        return;
+      }
+      (void) chThdSuspendS(&awp->wait);
+    }
+    arp = (vfs_async_request_t *)ch_queue_fifo_remove(&awp->queue);
+    arp->state = VFS_ASYNC_ACTIVE;
+    chSysUnlock();
+
+    /* Executing the operation.*/
+    arp->result = vfs_async_execute(arp);
+
+    /* The callback is invoked before marking the request as done because
+       the request can be reused after that.*/
+    if (arp->callback != NULL) {
+      arp->callback(arp);
+    }
+
+    chSysLock();
+    arp->state = VFS_ASYNC_DONE;
+    chThdResumeS(&arp->waiter, MSG_OK);
+    chSchRescheduleS();
+    chSysUnlock();
+  }
+}
+
+static msg_t vfs_async_submit(vfs_async_worker_t *awp,
+                              vfs_async_request_t *arp,
+                              unsigned op,
+                              vfs_file_node_c *vfnp,
+                              uint8_t *buf,
+                              size_t n) {
+
+  chDbgCheck((awp != NULL) && (arp != NULL) && (vfnp != NULL));
+  chDbgAssert(vfnp->references > 0U, "zero count");
+
+  chSysLock();
+
+  if ((arp->state == VFS_ASYNC_QUEUED) || (arp->state == VFS_ASYNC_ACTIVE)) {
+    chSysUnlock();
+    return CH_RET_EBUSY;
+  }
+
+  arp->state  = VFS_ASYNC_QUEUED;
+  arp->op     = op;
+  arp->vfnp   = vfnp;
+  arp->buf    = buf;
+  arp->n      = n;
+  arp->result = (ssize_t)0;
+  ch_queue_insert(&awp->queue, &arp->queue);
+
+  /* Waking up the worker if idle.*/
+  chThdResumeS(&awp->wait, MSG_OK);
+  chSchRescheduleS();
+
+  chSysUnlock();
+
+  return CH_RET_SUCCESS;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Starts an asynchronous I/O worker.
+ *
+ * @param[out] awp      Pointer to a @p vfs_async_worker_t object.
+ * @param[out] wsp      Pointer to a working area for the worker thread.
+ * @param[in] size      Size of the working area.
+ * @param[in] prio      Priority of the worker thread.
+ *
+ * @api
+ */
+void vfsAsyncStart(vfs_async_worker_t *awp, void *wsp, size_t size,
+                   tprio_t prio) {
+
+  chDbgCheck((awp != NULL) && (wsp != NULL));
+
+  ch_queue_init(&awp->queue);
+  awp->wait   = NULL;
+  awp->stop   = false;
+  awp->thread = chThdCreateStatic(wsp, size, prio, vfs_async_thread,
+                                  (void *)awp);
+}
+
+#if (CH_CFG_USE_WAITEXIT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Stops an asynchronous I/O worker.
+ * @note    Pending requests are completed before the worker terminates.
+ *
+ * @param[in] awp       Pointer to a @p vfs_async_worker_t object.
+ *
+ * @api
+ */
+void vfsAsyncStop(vfs_async_worker_t *awp) {
+
+  chDbgCheck(awp != NULL);
+
+  chSysLock();
+  awp->stop = true;
+  chThdResumeS(&awp->wait, MSG_OK);
+  chSchRescheduleS();
+  chSysUnlock();
+
+  (void) chThdWait(awp->thread);
+  awp->thread = NULL;
+}
+#endif
+
+/**
+ * @brief   Initializes an asynchronous request.
+ *
+ * @param[out] arp      Pointer to a @p vfs_async_request_t object.
+ * @param[in] callback  Completion callback or @p NULL.
+ * @param[in] arg       Argument for the callback, stored in the request.
+ *
+ * @init
+ */
+void vfsAsyncObjectInit(vfs_async_request_t *arp,
+                        vfs_async_callback_t callback, void *arg) {
+
+  chDbgCheck(arp != NULL);
+
+  arp->state    = VFS_ASYNC_IDLE;
+  arp->op       = VFS_ASYNC_OP_READ;
+  arp->vfnp     = NULL;
+  arp->buf      = NULL;
+  arp->n        = (size_t)0;
+  arp->result   = (ssize_t)0;
+  arp->callback = callback;
+  arp->arg      = arg;
+  arp->waiter   = NULL;
+}
+
+/**
+ * @brief   Submits an asynchronous read.
+ * @details Data is read from the current file position when the request
+ *          is executed, requests are executed in submission order.
+ * @note    While requests are pending on a file the synchronous API must
+ *          not be used on the same file.
+ *
+ * @param[in] awp       Pointer to a @p vfs_async_worker_t object.
+ * @param[in] arp       Pointer to a @p vfs_async_request_t object.
+ * @param[in] vfnp      Pointer to the @p vfs_file_node_c object.
+ * @param[out] buf      Pointer to the data buffer, it must stay valid until
+ *                      the request is completed.
+ * @param[in] n         Maximum amount of data to be transferred.
+ * @return              The operation result.
+ * @retval CH_RET_EBUSY If the request is still pending.
+ *
+ * @api
+ */
+msg_t vfsAsyncReadFile(vfs_async_worker_t *awp, vfs_async_request_t *arp,
+                       vfs_file_node_c *vfnp, uint8_t *buf, size_t n) {
+
+  return vfs_async_submit(awp, arp, VFS_ASYNC_OP_READ, vfnp, buf, n);
+}
+
+/**
+ * @brief   Submits an asynchronous write.
+ * @details Data is written at the current file position when the request
+ *          is executed, requests are executed in submission order.
+ * @note    While requests are pending on a file the synchronous API must
+ *          not be used on the same file.
+ *
+ * @param[in] awp       Pointer to a @p vfs_async_worker_t object.
+ * @param[in] arp       Pointer to a @p vfs_async_request_t object.
+ * @param[in] vfnp      Pointer to the @p vfs_file_node_c object.
+ * @param[in] buf       Pointer to the data buffer, it must stay valid until
+ *                      the request is completed.
+ * @param[in] n         Amount of data to be transferred.
+ * @return              The operation result.
+ * @retval CH_RET_EBUSY If the request is still pending.
+ *
+ * @api
+ */
+msg_t vfsAsyncWriteFile(vfs_async_worker_t *awp, vfs_async_request_t *arp,
+                        vfs_file_node_c *vfnp, const uint8_t *buf,
+                        size_t n) {
+
+  return vfs_async_submit(awp, arp, VFS_ASYNC_OP_WRITE, vfnp,
+                          (uint8_t *)buf, n);
+}
+
+/**
+ * @brief   Submits an asynchronous file synchronization.
+ * @details Buffered data is written to the file and the file system
+ *          structures are updated, see @p vfsSyncFile().
+ *
+ * @param[in] awp       Pointer to a @p vfs_async_worker_t object.
+ * @param[in] arp       Pointer to a @p vfs_async_request_t object.
+ * @param[in] vfnp      Pointer to the @p vfs_file_node_c object.
+ * @return              The operation result.
+ * @retval CH_RET_EBUSY If the request is still pending.
+ *
+ * @api
+ */
+msg_t vfsAsyncSyncFile(vfs_async_worker_t *awp, vfs_async_request_t *arp,
+                       vfs_file_node_c *vfnp) {
+
+  return vfs_async_submit(awp, arp, VFS_ASYNC_OP_SYNC, vfnp,
+                          NULL, (size_t)0);
+}
+
+/**
+ * @brief   Waits for the completion of a request.
+ * @note    Only one thread can wait on a request.
+ *
+ * @param[in] arp       Pointer to a @p vfs_async_request_t object.
+ * @param[in] timeout   The number of ticks before the operation times out,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The wait result.
+ * @retval CH_RET_SUCCESS If the request is completed, the operation result
+ *                      can be retrieved using @p vfsAsyncGetResult().
+ * @retval CH_RET_TIMEOUT If the request did not complete in time.
+ * @retval CH_RET_EINVAL If the request has never been submitted.
+ *
+ * @api
+ */
+msg_t vfsAsyncWait(vfs_async_request_t *arp, sysinterval_t timeout) {
+  msg_t ret;
+
+  chDbgCheck(arp != NULL);
+
+  chSysLock();
+
+  if (arp->state == VFS_ASYNC_DONE) {
+    ret = CH_RET_SUCCESS;
+  }
+  else if (arp->state == VFS_ASYNC_IDLE) {
+    ret = CH_RET_EINVAL;
+  }
+  else {
+    ret = chThdSuspendTimeoutS(&arp->waiter, timeout) == MSG_OK ?
+          CH_RET_SUCCESS : CH_RET_TIMEOUT;
+  }
+
+  chSysUnlock();
+
+  return ret;
+}
+
+#endif /* VFS_CFG_ENABLE_ASYNC == TRUE */
+
+/** @} */
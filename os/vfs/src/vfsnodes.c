@@ -227,6 +227,8 @@ void *__vfsfile_objinit_impl(void *ip, const void *vmt, vfs_driver_c *driver,
   /* Initialization code.*/
   self = __vfsnode_objinit_impl(ip, vmt, driver, mode);
 
+  self->buffer = NULL;
+
   return self;
 }
 
@@ -3,5 +3,17 @@ TESTSRC += ${CHIBIOS}/test/corebmk/source/test/ffbench_mod.c \
            ${CHIBIOS}/test/corebmk/source/test/corebmk_test_root.c \
            ${CHIBIOS}/test/corebmk/source/test/corebmk_test_sequence_001.c
 
+# CRC engine, it could be already included by other subsystems. It goes in
+# ALLCSRC so that the other subsystems can see it.
+ifeq ($(findstring os/common/utils/src/crc.c,$(ALLCSRC)),)
+ALLCSRC += ${CHIBIOS}/os/common/utils/src/crc.c
+endif
+
+# Streams and chprintf(), they could be already included by other subsystems.
+ifeq ($(findstring os/hal/lib/streams/chprintf.c,$(ALLCSRC)),)
+include $(CHIBIOS)/os/hal/lib/streams/streams.mk
+endif
+
 # Required include directories
-TESTINC += ${CHIBIOS}/test/corebmk/source/test
+TESTINC += ${CHIBIOS}/test/corebmk/source/test \
+           ${CHIBIOS}/os/common/utils/include
@@ -45,6 +45,8 @@
  * <h2>Test Cases</h2>
  * - @subpage corebmk_test_001_001
  * - @subpage corebmk_test_001_002
+ * - @subpage corebmk_test_001_003
+ * - @subpage corebmk_test_001_004
  * .
  */
 
@@ -70,6 +72,57 @@
 float *fdatas;
 double *fdatad;
 
+#include "crc.h"
+
+#define CRC_BUFFER_SIZE 1024U       /* CRC benchmark buffer size.           */
+
+static uint8_t crc_buffer[CRC_BUFFER_SIZE];
+
+#include "chprintf.h"
+
+static char fmt_buffer[64];
+static uint32_t fmt_calls;
+
+static size_t fmt_write(void *ip, const uint8_t *bp, size_t n) {
+
+  (void)ip;
+  (void)bp;
+  fmt_calls++;
+
+  return n;
+}
+
+static size_t fmt_read(void *ip, uint8_t *bp, size_t n) {
+
+  (void)ip;
+  (void)bp;
+  (void)n;
+
+  return 0;
+}
+
+static msg_t fmt_put(void *ip, uint8_t b) {
+
+  (void)ip;
+  (void)b;
+  fmt_calls++;
+
+  return MSG_OK;
+}
+
+static msg_t fmt_get(void *ip) {
+
+  (void)ip;
+
+  return MSG_RESET;
+}
+
+static const struct BaseSequentialStreamVMT fmt_vmt = {
+  (size_t)0, fmt_write, fmt_read, fmt_put, fmt_get
+};
+
+static BaseSequentialStream fmt_stream = {&fmt_vmt};
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -250,6 +303,215 @@ static const testcase_t corebmk_test_001_002 = {
   corebmk_test_001_002_execute
 };
 
+/**
+ * @page corebmk_test_001_003 [1.3] CRC throughput
+ *
+ * <h2>Description</h2>
+ * CRC16-CCITT and CRC32-IEEE software kernels benchmark, the kernels
+ * are checked against the standard check values then the throughput is
+ * reported.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.3.1] Printing setup.
+ * - [1.3.2] Checking the kernels against the standard check values.
+ * - [1.3.3] Running CRC16-CCITT over the buffer for one second.
+ * - [1.3.4] Running CRC32-IEEE over the buffer for one second.
+ * .
+ */
+
+static void corebmk_test_001_003_execute(void) {
+  systime_t start, end;
+  uint32_t n;
+  unsigned i;
+
+  /* [1.3.1] Printing setup.*/
+  test_set_step(1);
+  {
+    test_print("--- Slices: ");
+    test_printn(CRC_CFG_SLICES);
+    test_println("");
+    test_print("--- Buffer: ");
+    test_printn(CRC_BUFFER_SIZE);
+    test_println(" bytes");
+  }
+  test_end_step(1);
+
+  /* [1.3.2] Checking the kernels against the standard check values.*/
+  test_set_step(2);
+  {
+    static const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    test_assert(crc16_ccitt(0xFFFFU, check, sizeof (check)) == 0x29B1U,
+                "CRC16 mismatch");
+    test_assert(~crc32_ieee(0xFFFFFFFFU, check, sizeof (check)) == 0xCBF43926U,
+                "CRC32 mismatch");
+  }
+  test_end_step(2);
+
+  /* [1.3.3] Running CRC16-CCITT over the buffer for one second.*/
+  test_set_step(3);
+  {
+    uint16_t crc = 0xFFFFU;
+
+    for (i = 0U; i < CRC_BUFFER_SIZE; i++) {
+      crc_buffer[i] = (uint8_t)(i * 7U);
+    }
+
+    n = 0U;
+    chThdSleep(1);
+    start = chVTGetSystemTimeX();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      for (i = 0U; i < 16U; i++) {
+        crc = crc16_ccitt(crc, crc_buffer, CRC_BUFFER_SIZE);
+      }
+      n += 16U;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+    (void)crc;
+    test_print("--- CRC16 : ");
+    test_printn(n * (CRC_BUFFER_SIZE / 1024U));
+    test_println(" kB/S");
+  }
+  test_end_step(3);
+
+  /* [1.3.4] Running CRC32-IEEE over the buffer for one second.*/
+  test_set_step(4);
+  {
+    uint32_t crc = 0xFFFFFFFFU;
+
+    n = 0U;
+    chThdSleep(1);
+    start = chVTGetSystemTimeX();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      for (i = 0U; i < 16U; i++) {
+        crc = crc32_ieee(crc, crc_buffer, CRC_BUFFER_SIZE);
+      }
+      n += 16U;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+    (void)crc;
+    test_print("--- CRC32 : ");
+    test_printn(n * (CRC_BUFFER_SIZE / 1024U));
+    test_println(" kB/S");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t corebmk_test_001_003 = {
+  "CRC throughput",
+  NULL,
+  NULL,
+  corebmk_test_001_003_execute
+};
+
+/**
+ * @page corebmk_test_001_004 [1.4] Formatting throughput
+ *
+ * <h2>Description</h2>
+ * chprintf() and chsnprintf() benchmark, the output of a few
+ * conversions is checked then CSV-like records are formatted for one
+ * second, the number of formatted records per second and the number of
+ * stream calls per record are reported.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.4.1] Printing setup
+ * - [1.4.2] Checking the conversions against the expected output
+ * - [1.4.3] Formatting records on a call-counting stream for one second
+ * - [1.4.4] Formatting records in memory for one second
+ * .
+ */
+
+static void corebmk_test_001_004_execute(void) {
+  systime_t start, end;
+  uint32_t n;
+
+  /* [1.4.1] Printing setup*/
+  test_set_step(1);
+  {
+    test_print("--- Buffer: ");
+    test_printn(CHPRINTF_BUFFER_SIZE);
+    test_println(" bytes");
+  }
+  test_end_step(1);
+
+  /* [1.4.2] Checking the conversions against the expected output*/
+  test_set_step(2);
+  {
+    int len;
+
+    len = chsnprintf(fmt_buffer, sizeof (fmt_buffer), "%d|%5u|%-4x|%08x|%o|%s",
+                     -1234, 99U, 0xABU, 0xDEADBEEFU, 8U, "end");
+    test_assert(len == 32, "wrong length");
+    test_assert(strcmp(fmt_buffer, "-1234|   99|AB  |DEADBEEF|10|end") == 0,
+                "wrong conversion");
+    len = chsnprintf(fmt_buffer, sizeof (fmt_buffer), "%ld|%lu|%+05d|%U",
+                     -2147483647L, 4294967295UL, 42, 1000000UL);
+    test_assert(len == 36, "wrong length");
+    test_assert(strcmp(fmt_buffer, "-2147483647|4294967295|+0042|1000000") == 0,
+                "wrong conversion");
+  }
+  test_end_step(2);
+
+  /* [1.4.3] Formatting records on a call-counting stream for one second*/
+  test_set_step(3);
+  {
+    fmt_calls = 0U;
+    n = 0U;
+    chThdSleep(1);
+    start = chVTGetSystemTimeX();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      (void) chprintf(&fmt_stream, "%u,%d,%08x,%s\r\n",
+                      n, -(int)n, n * 2654435761U, "sample");
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+    test_print("--- Stream: ");
+    test_printn(n);
+    test_println(" records/S");
+    test_print("--- Calls : ");
+    test_printn(fmt_calls / n);
+    test_println(" per record");
+  }
+  test_end_step(3);
+
+  /* [1.4.4] Formatting records in memory for one second*/
+  test_set_step(4);
+  {
+    n = 0U;
+    chThdSleep(1);
+    start = chVTGetSystemTimeX();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      (void) chsnprintf(fmt_buffer, sizeof (fmt_buffer), "%u,%d,%08x,%s\r\n",
+                        n, -(int)n, n * 2654435761U, "sample");
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+    test_print("--- Memory: ");
+    test_printn(n);
+    test_println(" records/S");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t corebmk_test_001_004 = {
+  "Formatting throughput",
+  NULL,
+  NULL,
+  corebmk_test_001_004_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -260,6 +522,8 @@ static const testcase_t corebmk_test_001_002 = {
 const testcase_t * const corebmk_test_sequence_001_array[] = {
   &corebmk_test_001_001,
   &corebmk_test_001_002,
+  &corebmk_test_001_003,
+  &corebmk_test_001_004,
   NULL
 };
 
@@ -0,0 +1,7 @@
+# List of all the crypto fall-back test files.
+TESTSRC += ${CHIBIOS}/test/cryfb/source/test/cryfb_test_root.c \
+           ${CHIBIOS}/test/cryfb/source/test/cryfb_test_sequence_001.c \
+           ${CHIBIOS}/test/cryfb/source/test/cryfb_test_sequence_002.c
+
+# Required include directories
+TESTINC += ${CHIBIOS}/test/cryfb/source/test
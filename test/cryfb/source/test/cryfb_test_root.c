@@ -0,0 +1,74 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @mainpage Test Suite Specification
+ * Test suite for the software fall-back of the HAL cryptographic
+ * driver. The HAL must be configured with HAL_USE_CRY and
+ * HAL_CRY_ENFORCE_FALLBACK enabled so that all the algorithms are
+ * served by the fall-back code. The known answer vectors are taken from
+ * FIPS-197, SP800-38A, the GCM specification, FIPS 180-4 and RFC 4231.
+ *
+ * <h2>Test Sequences</h2>
+ * - @subpage cryfb_test_sequence_001
+ * - @subpage cryfb_test_sequence_002
+ * .
+ */
+
+/**
+ * @file    cryfb_test_root.c
+ * @brief   Test Suite root structures code.
+ */
+
+#include "hal.h"
+#include "cryfb_test_root.h"
+
+#if !defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Array of test sequences.
+ */
+const testsequence_t * const cryfb_test_suite_array[] = {
+#if (HAL_CRY_ENFORCE_FALLBACK == TRUE) || defined(__DOXYGEN__)
+  &cryfb_test_sequence_001,
+#endif
+#if (HAL_CRY_ENFORCE_FALLBACK == TRUE) || defined(__DOXYGEN__)
+  &cryfb_test_sequence_002,
+#endif
+  NULL
+};
+
+/**
+ * @brief   Test suite root structure.
+ */
+const testsuite_t cryfb_test_suite = {
+  "Crypto Fall-back Test Suite",
+  cryfb_test_suite_array
+};
+
+/*===========================================================================*/
+/* Shared code.                                                              */
+/*===========================================================================*/
+
+CRYDriver CRYFBD1;
+uint8_t cryfb_test_buffer[CRYFB_TEST_BUFFER_SIZE];
+uint8_t cryfb_test_output[CRYFB_TEST_BUFFER_SIZE];
+
+#endif /* !defined(__DOXYGEN__) */
@@ -0,0 +1,59 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    cryfb_test_root.h
+ * @brief   Test Suite root structures header.
+ */
+
+#ifndef CRYFB_TEST_ROOT_H
+#define CRYFB_TEST_ROOT_H
+
+#include "ch_test.h"
+
+#include "cryfb_test_sequence_001.h"
+#include "cryfb_test_sequence_002.h"
+
+#if !defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+extern const testsuite_t cryfb_test_suite;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Shared definitions.                                                       */
+/*===========================================================================*/
+
+#define TEST_SUITE_NAME "Crypto Fall-back Test Suite"
+
+#define CRYFB_TEST_BUFFER_SIZE 1024U
+
+extern CRYDriver CRYFBD1;
+extern uint8_t cryfb_test_buffer[CRYFB_TEST_BUFFER_SIZE];
+extern uint8_t cryfb_test_output[CRYFB_TEST_BUFFER_SIZE];
+
+#endif /* !defined(__DOXYGEN__) */
+
+#endif /* CRYFB_TEST_ROOT_H */
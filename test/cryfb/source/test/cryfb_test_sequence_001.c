@@ -0,0 +1,1041 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "cryfb_test_root.h"
+
+/**
+ * @file    cryfb_test_sequence_001.c
+ * @brief   Test Sequence 001 code.
+ *
+ * @page cryfb_test_sequence_001 [1] Known Answer Tests
+ *
+ * File: @ref cryfb_test_sequence_001.c
+ *
+ * <h2>Description</h2>
+ * The fall-back algorithms are verified against the published test
+ * vectors.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - HAL_CRY_ENFORCE_FALLBACK == TRUE
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage cryfb_test_001_001
+ * - @subpage cryfb_test_001_002
+ * - @subpage cryfb_test_001_003
+ * - @subpage cryfb_test_001_004
+ * - @subpage cryfb_test_001_005
+ * - @subpage cryfb_test_001_006
+ * - @subpage cryfb_test_001_007
+ * .
+ */
+
+#if (HAL_CRY_ENFORCE_FALLBACK == TRUE) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+
+static CRYDriver CRYFBD2;
+
+/* FIPS-197 appendix C examples.*/
+static const uint8_t aes_fips197_key[32] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+  0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+  0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
+};
+
+static const uint8_t aes_fips197_pt[16] = {
+  0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+  0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF
+};
+
+static const uint8_t aes_fips197_ct128[16] = {
+  0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30,
+  0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A
+};
+
+static const uint8_t aes_fips197_ct192[16] = {
+  0xDD, 0xA9, 0x7C, 0xA4, 0x86, 0x4C, 0xDF, 0xE0,
+  0x6E, 0xAF, 0x70, 0xA0, 0xEC, 0x0D, 0x71, 0x91
+};
+
+static const uint8_t aes_fips197_ct256[16] = {
+  0x8E, 0xA2, 0xB7, 0xCA, 0x51, 0x67, 0x45, 0xBF,
+  0xEA, 0xFC, 0x49, 0x90, 0x4B, 0x49, 0x60, 0x89
+};
+
+/* SP800-38A appendix F, AES-128 examples.*/
+static const uint8_t aes_sp800_key[16] = {
+  0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6,
+  0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C
+};
+
+static const uint8_t aes_sp800_iv[16] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+  0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+
+static const uint8_t aes_sp800_ctr[16] = {
+  0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7,
+  0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF
+};
+
+static const uint8_t aes_sp800_pt[64] = {
+  0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96,
+  0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A,
+  0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C,
+  0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51,
+  0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11,
+  0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF,
+  0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17,
+  0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10
+};
+
+static const uint8_t aes_sp800_ecb[64] = {
+  0x3A, 0xD7, 0x7B, 0xB4, 0x0D, 0x7A, 0x36, 0x60,
+  0xA8, 0x9E, 0xCA, 0xF3, 0x24, 0x66, 0xEF, 0x97,
+  0xF5, 0xD3, 0xD5, 0x85, 0x03, 0xB9, 0x69, 0x9D,
+  0xE7, 0x85, 0x89, 0x5A, 0x96, 0xFD, 0xBA, 0xAF,
+  0x43, 0xB1, 0xCD, 0x7F, 0x59, 0x8E, 0xCE, 0x23,
+  0x88, 0x1B, 0x00, 0xE3, 0xED, 0x03, 0x06, 0x88,
+  0x7B, 0x0C, 0x78, 0x5E, 0x27, 0xE8, 0xAD, 0x3F,
+  0x82, 0x23, 0x20, 0x71, 0x04, 0x72, 0x5D, 0xD4
+};
+
+static const uint8_t aes_sp800_cbc[64] = {
+  0x76, 0x49, 0xAB, 0xAC, 0x81, 0x19, 0xB2, 0x46,
+  0xCE, 0xE9, 0x8E, 0x9B, 0x12, 0xE9, 0x19, 0x7D,
+  0x50, 0x86, 0xCB, 0x9B, 0x50, 0x72, 0x19, 0xEE,
+  0x95, 0xDB, 0x11, 0x3A, 0x91, 0x76, 0x78, 0xB2,
+  0x73, 0xBE, 0xD6, 0xB8, 0xE3, 0xC1, 0x74, 0x3B,
+  0x71, 0x16, 0xE6, 0x9E, 0x22, 0x22, 0x95, 0x16,
+  0x3F, 0xF1, 0xCA, 0xA1, 0x68, 0x1F, 0xAC, 0x09,
+  0x12, 0x0E, 0xCA, 0x30, 0x75, 0x86, 0xE1, 0xA7
+};
+
+static const uint8_t aes_sp800_cfb[64] = {
+  0x3B, 0x3F, 0xD9, 0x2E, 0xB7, 0x2D, 0xAD, 0x20,
+  0x33, 0x34, 0x49, 0xF8, 0xE8, 0x3C, 0xFB, 0x4A,
+  0xC8, 0xA6, 0x45, 0x37, 0xA0, 0xB3, 0xA9, 0x3F,
+  0xCD, 0xE3, 0xCD, 0xAD, 0x9F, 0x1C, 0xE5, 0x8B,
+  0x26, 0x75, 0x1F, 0x67, 0xA3, 0xCB, 0xB1, 0x40,
+  0xB1, 0x80, 0x8C, 0xF1, 0x87, 0xA4, 0xF4, 0xDF,
+  0xC0, 0x4B, 0x05, 0x35, 0x7C, 0x5D, 0x1C, 0x0E,
+  0xEA, 0xC4, 0xC6, 0x6F, 0x9F, 0xF7, 0xF2, 0xE6
+};
+
+static const uint8_t aes_sp800_ctr_ct[64] = {
+  0x87, 0x4D, 0x61, 0x91, 0xB6, 0x20, 0xE3, 0x26,
+  0x1B, 0xEF, 0x68, 0x64, 0x99, 0x0D, 0xB6, 0xCE,
+  0x98, 0x06, 0xF6, 0x6B, 0x79, 0x70, 0xFD, 0xFF,
+  0x86, 0x17, 0x18, 0x7B, 0xB9, 0xFF, 0xFD, 0xFF,
+  0x5A, 0xE4, 0xDF, 0x3E, 0xDB, 0xD5, 0xD3, 0x5E,
+  0x5B, 0x4F, 0x09, 0x02, 0x0D, 0xB0, 0x3E, 0xAB,
+  0x1E, 0x03, 0x1D, 0xDA, 0x2F, 0xBE, 0x03, 0xD1,
+  0x79, 0x21, 0x70, 0xA0, 0xF3, 0x00, 0x9C, 0xEE
+};
+
+/* GCM specification, test cases 2 and 4.*/
+static const uint8_t gcm_tc2_ct[16] = {
+  0x03, 0x88, 0xDA, 0xCE, 0x60, 0xB6, 0xA3, 0x92,
+  0xF3, 0x28, 0xC2, 0xB9, 0x71, 0xB2, 0xFE, 0x78
+};
+
+static const uint8_t gcm_tc2_tag[16] = {
+  0xAB, 0x6E, 0x47, 0xD4, 0x2C, 0xEC, 0x13, 0xBD,
+  0xF5, 0x3A, 0x67, 0xB2, 0x12, 0x57, 0xBD, 0xDF
+};
+
+static const uint8_t gcm_tc4_key[16] = {
+  0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C,
+  0x6D, 0x6A, 0x8F, 0x94, 0x67, 0x30, 0x83, 0x08
+};
+
+static const uint8_t gcm_tc4_iv[16] = {
+  0xCA, 0xFE, 0xBA, 0xBE, 0xFA, 0xCE, 0xDB, 0xAD,
+  0xDE, 0xCA, 0xF8, 0x88, 0x00, 0x00, 0x00, 0x01
+};
+
+static const uint8_t gcm_tc4_aad[20] = {
+  0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF,
+  0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF,
+  0xAB, 0xAD, 0xDA, 0xD2
+};
+
+static const uint8_t gcm_tc4_pt[60] = {
+  0xD9, 0x31, 0x32, 0x25, 0xF8, 0x84, 0x06, 0xE5,
+  0xA5, 0x59, 0x09, 0xC5, 0xAF, 0xF5, 0x26, 0x9A,
+  0x86, 0xA7, 0xA9, 0x53, 0x15, 0x34, 0xF7, 0xDA,
+  0x2E, 0x4C, 0x30, 0x3D, 0x8A, 0x31, 0x8A, 0x72,
+  0x1C, 0x3C, 0x0C, 0x95, 0x95, 0x68, 0x09, 0x53,
+  0x2F, 0xCF, 0x0E, 0x24, 0x49, 0xA6, 0xB5, 0x25,
+  0xB1, 0x6A, 0xED, 0xF5, 0xAA, 0x0D, 0xE6, 0x57,
+  0xBA, 0x63, 0x7B, 0x39
+};
+
+static const uint8_t gcm_tc4_ct[60] = {
+  0x42, 0x83, 0x1E, 0xC2, 0x21, 0x77, 0x74, 0x24,
+  0x4B, 0x72, 0x21, 0xB7, 0x84, 0xD0, 0xD4, 0x9C,
+  0xE3, 0xAA, 0x21, 0x2F, 0x2C, 0x02, 0xA4, 0xE0,
+  0x35, 0xC1, 0x7E, 0x23, 0x29, 0xAC, 0xA1, 0x2E,
+  0x21, 0xD5, 0x14, 0xB2, 0x54, 0x66, 0x93, 0x1C,
+  0x7D, 0x8F, 0x6A, 0x5A, 0xAC, 0x84, 0xAA, 0x05,
+  0x1B, 0xA3, 0x0B, 0x39, 0x6A, 0x0A, 0xAC, 0x97,
+  0x3D, 0x58, 0xE0, 0x91
+};
+
+static const uint8_t gcm_tc4_tag[16] = {
+  0x5B, 0xC9, 0x4F, 0xBC, 0x32, 0x21, 0xA5, 0xDB,
+  0x94, 0xFA, 0xE9, 0x5A, 0xE7, 0x12, 0x1A, 0x47
+};
+
+/* FIPS 180-4 examples, one and two blocks messages.*/
+static const char sha_msg1[] = "abc";
+static const char sha_msg2[] =
+  "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+static const char sha_msg3[] =
+  "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+  "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+
+static const uint8_t sha1_digest1[20] = {
+  0xA9, 0x99, 0x3E, 0x36, 0x47, 0x06, 0x81, 0x6A,
+  0xBA, 0x3E, 0x25, 0x71, 0x78, 0x50, 0xC2, 0x6C,
+  0x9C, 0xD0, 0xD8, 0x9D
+};
+
+static const uint8_t sha1_digest2[20] = {
+  0x84, 0x98, 0x3E, 0x44, 0x1C, 0x3B, 0xD2, 0x6E,
+  0xBA, 0xAE, 0x4A, 0xA1, 0xF9, 0x51, 0x29, 0xE5,
+  0xE5, 0x46, 0x70, 0xF1
+};
+
+static const uint8_t sha256_digest1[32] = {
+  0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA,
+  0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+  0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C,
+  0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD
+};
+
+static const uint8_t sha256_digest2[32] = {
+  0x24, 0x8D, 0x6A, 0x61, 0xD2, 0x06, 0x38, 0xB8,
+  0xE5, 0xC0, 0x26, 0x93, 0x0C, 0x3E, 0x60, 0x39,
+  0xA3, 0x3C, 0xE4, 0x59, 0x64, 0xFF, 0x21, 0x67,
+  0xF6, 0xEC, 0xED, 0xD4, 0x19, 0xDB, 0x06, 0xC1
+};
+
+static const uint8_t sha512_digest1[64] = {
+  0xDD, 0xAF, 0x35, 0xA1, 0x93, 0x61, 0x7A, 0xBA,
+  0xCC, 0x41, 0x73, 0x49, 0xAE, 0x20, 0x41, 0x31,
+  0x12, 0xE6, 0xFA, 0x4E, 0x89, 0xA9, 0x7E, 0xA2,
+  0x0A, 0x9E, 0xEE, 0xE6, 0x4B, 0x55, 0xD3, 0x9A,
+  0x21, 0x92, 0x99, 0x2A, 0x27, 0x4F, 0xC1, 0xA8,
+  0x36, 0xBA, 0x3C, 0x23, 0xA3, 0xFE, 0xEB, 0xBD,
+  0x45, 0x4D, 0x44, 0x23, 0x64, 0x3C, 0xE8, 0x0E,
+  0x2A, 0x9A, 0xC9, 0x4F, 0xA5, 0x4C, 0xA4, 0x9F
+};
+
+static const uint8_t sha512_digest3[64] = {
+  0x8E, 0x95, 0x9B, 0x75, 0xDA, 0xE3, 0x13, 0xDA,
+  0x8C, 0xF4, 0xF7, 0x28, 0x14, 0xFC, 0x14, 0x3F,
+  0x8F, 0x77, 0x79, 0xC6, 0xEB, 0x9F, 0x7F, 0xA1,
+  0x72, 0x99, 0xAE, 0xAD, 0xB6, 0x88, 0x90, 0x18,
+  0x50, 0x1D, 0x28, 0x9E, 0x49, 0x00, 0xF7, 0xE4,
+  0x33, 0x1B, 0x99, 0xDE, 0xC4, 0xB5, 0x43, 0x3A,
+  0xC7, 0xD3, 0x29, 0xEE, 0xB6, 0xDD, 0x26, 0x54,
+  0x5E, 0x96, 0xE5, 0x5B, 0x87, 0x4B, 0xE9, 0x09
+};
+
+/* RFC 4231 test cases 2 and 4.*/
+static const char hmac_key2[] = "Jefe";
+static const char hmac_msg2[] = "what do ya want for nothing?";
+
+static const uint8_t hmac_key4[25] = {
+  0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+  0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10,
+  0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+  0x19
+};
+
+static const uint8_t hmac256_mac2[32] = {
+  0x5B, 0xDC, 0xC1, 0x46, 0xBF, 0x60, 0x75, 0x4E,
+  0x6A, 0x04, 0x24, 0x26, 0x08, 0x95, 0x75, 0xC7,
+  0x5A, 0x00, 0x3F, 0x08, 0x9D, 0x27, 0x39, 0x83,
+  0x9D, 0xEC, 0x58, 0xB9, 0x64, 0xEC, 0x38, 0x43
+};
+
+static const uint8_t hmac512_mac2[64] = {
+  0x16, 0x4B, 0x7A, 0x7B, 0xFC, 0xF8, 0x19, 0xE2,
+  0xE3, 0x95, 0xFB, 0xE7, 0x3B, 0x56, 0xE0, 0xA3,
+  0x87, 0xBD, 0x64, 0x22, 0x2E, 0x83, 0x1F, 0xD6,
+  0x10, 0x27, 0x0C, 0xD7, 0xEA, 0x25, 0x05, 0x54,
+  0x97, 0x58, 0xBF, 0x75, 0xC0, 0x5A, 0x99, 0x4A,
+  0x6D, 0x03, 0x4F, 0x65, 0xF8, 0xF0, 0xE6, 0xFD,
+  0xCA, 0xEA, 0xB1, 0xA3, 0x4D, 0x4A, 0x6B, 0x4B,
+  0x63, 0x6E, 0x07, 0x0A, 0x38, 0xBC, 0xE7, 0x37
+};
+
+static const uint8_t hmac256_mac4[32] = {
+  0x82, 0x55, 0x8A, 0x38, 0x9A, 0x44, 0x3C, 0x0E,
+  0xA4, 0xCC, 0x81, 0x98, 0x99, 0xF2, 0x08, 0x3A,
+  0x85, 0xF0, 0xFA, 0xA3, 0xE5, 0x78, 0xF8, 0x07,
+  0x7A, 0x2E, 0x3F, 0xF4, 0x67, 0x29, 0x66, 0x5B
+};
+
+static const uint8_t hmac512_mac4[64] = {
+  0xB0, 0xBA, 0x46, 0x56, 0x37, 0x45, 0x8C, 0x69,
+  0x90, 0xE5, 0xA8, 0xC5, 0xF6, 0x1D, 0x4A, 0xF7,
+  0xE5, 0x76, 0xD9, 0x7F, 0xF9, 0x4B, 0x87, 0x2D,
+  0xE7, 0x6F, 0x80, 0x50, 0x36, 0x1E, 0xE3, 0xDB,
+  0xA9, 0x1C, 0xA5, 0xC1, 0x1A, 0xA2, 0x5E, 0xB4,
+  0xD6, 0x79, 0x27, 0x5C, 0xC5, 0x78, 0x80, 0x63,
+  0xA5, 0xF1, 0x97, 0x41, 0x12, 0x0C, 0x4F, 0x2D,
+  0xE2, 0xAD, 0xEB, 0xEB, 0x10, 0xA2, 0x98, 0xDD
+};
+
+/* RFC 4231 test case 6 message with a 100 bytes key, it exercises the
+   hashing of keys longer than the SHA256 block size.*/
+static const char hmac_msg6[] =
+  "Test Using Larger Than Block-Size Key - Hash Key First";
+
+static const uint8_t hmac256_mac6[32] = {
+  0xAE, 0x77, 0x84, 0xE2, 0x45, 0x97, 0x7B, 0x78,
+  0xCD, 0x7A, 0x94, 0x14, 0xF4, 0x96, 0xDD, 0xBB,
+  0xA3, 0x1E, 0xA4, 0x48, 0xBD, 0xD6, 0x1E, 0x91,
+  0xC3, 0x7F, 0x00, 0x2C, 0x72, 0xF5, 0x24, 0x42
+};
+
+static const uint8_t hmac512_mac6[64] = {
+  0xFA, 0x77, 0xAA, 0xC2, 0x2C, 0x81, 0xF5, 0xD7,
+  0x53, 0x1D, 0xC1, 0x1D, 0xFE, 0xE9, 0x0F, 0x6A,
+  0xB0, 0xF9, 0x0C, 0x49, 0x51, 0xB2, 0x0C, 0x58,
+  0x2E, 0xCE, 0x4E, 0x0D, 0x3D, 0x7B, 0xC0, 0x60,
+  0xAC, 0x67, 0x60, 0x25, 0x14, 0xE3, 0x4C, 0xC9,
+  0x02, 0xB4, 0x85, 0xC0, 0x58, 0xA3, 0x91, 0x5E,
+  0x2E, 0x00, 0x17, 0xD3, 0x51, 0x59, 0x64, 0x71,
+  0x47, 0x1C, 0x84, 0x23, 0x7A, 0x8C, 0x67, 0x4A
+};
+
+static bool aes_block_kat(size_t size, const uint8_t *ct) {
+
+  if (cryLoadAESTransientKey(&CRYFBD1, size,
+                             aes_fips197_key) != CRY_NOERROR) {
+    return false;
+  }
+  if (cryEncryptAES(&CRYFBD1, 0, aes_fips197_pt,
+                    cryfb_test_output) != CRY_NOERROR) {
+    return false;
+  }
+  if (memcmp(cryfb_test_output, ct, 16U) != 0) {
+    return false;
+  }
+  if (cryDecryptAES(&CRYFBD1, 0, cryfb_test_output,
+                    cryfb_test_buffer) != CRY_NOERROR) {
+    return false;
+  }
+
+  return memcmp(cryfb_test_buffer, aes_fips197_pt, 16U) == 0;
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page cryfb_test_001_001 [1.1] AES block cipher
+ *
+ * <h2>Description</h2>
+ * The AES single block functions are verified against the FIPS-197
+ * appendix C examples for the three key sizes, the key identifiers and
+ * key sizes checks are also verified.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.1.1] Encrypting without a loaded key, the operation must fail.
+ * - [1.1.2] Loading a key with an invalid size, the operation must
+ *   fail.
+ * - [1.1.3] AES-128 encryption and decryption of the FIPS-197 C.1
+ *   example.
+ * - [1.1.4] AES-192 encryption and decryption of the FIPS-197 C.2
+ *   example.
+ * - [1.1.5] AES-256 encryption and decryption of the FIPS-197 C.3
+ *   example.
+ * - [1.1.6] Using a key identifier other than the transient key, the
+ *   operation must fail.
+ * .
+ */
+
+static void cryfb_test_001_001_setup(void) {
+  cryObjectInit(&CRYFBD1);
+  (void) cryStart(&CRYFBD1, NULL);
+}
+
+static void cryfb_test_001_001_teardown(void) {
+  cryStop(&CRYFBD1);
+}
+
+static void cryfb_test_001_001_execute(void) {
+  cryerror_t err;
+
+  /* [1.1.1] Encrypting without a loaded key, the operation must fail.*/
+  test_set_step(1);
+  {
+    err = cryEncryptAES(&CRYFBD1, 0, aes_fips197_pt, cryfb_test_output);
+    test_assert(err == CRY_ERR_INV_KEY_ID, "unexpected result");
+  }
+  test_end_step(1);
+
+  /* [1.1.2] Loading a key with an invalid size, the operation must
+     fail.*/
+  test_set_step(2);
+  {
+    err = cryLoadAESTransientKey(&CRYFBD1, 20, aes_fips197_key);
+    test_assert(err == CRY_ERR_INV_KEY_SIZE, "unexpected result");
+  }
+  test_end_step(2);
+
+  /* [1.1.3] AES-128 encryption and decryption of the FIPS-197 C.1
+     example.*/
+  test_set_step(3);
+  {
+    test_assert(aes_block_kat(16, aes_fips197_ct128), "AES-128 mismatch");
+  }
+  test_end_step(3);
+
+  /* [1.1.4] AES-192 encryption and decryption of the FIPS-197 C.2
+     example.*/
+  test_set_step(4);
+  {
+    test_assert(aes_block_kat(24, aes_fips197_ct192), "AES-192 mismatch");
+  }
+  test_end_step(4);
+
+  /* [1.1.5] AES-256 encryption and decryption of the FIPS-197 C.3
+     example.*/
+  test_set_step(5);
+  {
+    test_assert(aes_block_kat(32, aes_fips197_ct256), "AES-256 mismatch");
+  }
+  test_end_step(5);
+
+  /* [1.1.6] Using a key identifier other than the transient key, the
+     operation must fail.*/
+  test_set_step(6);
+  {
+    err = cryEncryptAES(&CRYFBD1, 1, aes_fips197_pt, cryfb_test_output);
+    test_assert(err == CRY_ERR_INV_KEY_ID, "unexpected result");
+  }
+  test_end_step(6);
+}
+
+static const testcase_t cryfb_test_001_001 = {
+  "AES block cipher",
+  cryfb_test_001_001_setup,
+  cryfb_test_001_001_teardown,
+  cryfb_test_001_001_execute
+};
+
+/**
+ * @page cryfb_test_001_002 [1.2] AES ECB and CBC modes
+ *
+ * <h2>Description</h2>
+ * The ECB and CBC modes are verified against the SP800-38A F.1.1,
+ * F.1.2, F.2.1 and F.2.2 examples.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.2.1] Loading the AES-128 key.
+ * - [1.2.2] ECB encryption and decryption of four blocks.
+ * - [1.2.3] CBC encryption and decryption of four blocks.
+ * .
+ */
+
+static void cryfb_test_001_002_setup(void) {
+  cryObjectInit(&CRYFBD1);
+  (void) cryStart(&CRYFBD1, NULL);
+}
+
+static void cryfb_test_001_002_teardown(void) {
+  cryStop(&CRYFBD1);
+}
+
+static void cryfb_test_001_002_execute(void) {
+  cryerror_t err;
+
+  /* [1.2.1] Loading the AES-128 key.*/
+  test_set_step(1);
+  {
+    err = cryLoadAESTransientKey(&CRYFBD1, 16, aes_sp800_key);
+    test_assert(err == CRY_NOERROR, "key not loaded");
+  }
+  test_end_step(1);
+
+  /* [1.2.2] ECB encryption and decryption of four blocks.*/
+  test_set_step(2);
+  {
+    err = cryEncryptAES_ECB(&CRYFBD1, 0, 64, aes_sp800_pt, cryfb_test_output);
+    test_assert(err == CRY_NOERROR, "encryption failed");
+    test_assert(memcmp(cryfb_test_output, aes_sp800_ecb, 64) == 0,
+                "ciphertext mismatch");
+    err = cryDecryptAES_ECB(&CRYFBD1, 0, 64, aes_sp800_ecb, cryfb_test_output);
+    test_assert(err == CRY_NOERROR, "decryption failed");
+    test_assert(memcmp(cryfb_test_output, aes_sp800_pt, 64) == 0,
+                "plaintext mismatch");
+  }
+  test_end_step(2);
+
+  /* [1.2.3] CBC encryption and decryption of four blocks.*/
+  test_set_step(3);
+  {
+    err = cryEncryptAES_CBC(&CRYFBD1, 0, 64, aes_sp800_pt, cryfb_test_output,
+                            aes_sp800_iv);
+    test_assert(err == CRY_NOERROR, "encryption failed");
+    test_assert(memcmp(cryfb_test_output, aes_sp800_cbc, 64) == 0,
+                "ciphertext mismatch");
+    err = cryDecryptAES_CBC(&CRYFBD1, 0, 64, aes_sp800_cbc, cryfb_test_output,
+                            aes_sp800_iv);
+    test_assert(err == CRY_NOERROR, "decryption failed");
+    test_assert(memcmp(cryfb_test_output, aes_sp800_pt, 64) == 0,
+                "plaintext mismatch");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t cryfb_test_001_002 = {
+  "AES ECB and CBC modes",
+  cryfb_test_001_002_setup,
+  cryfb_test_001_002_teardown,
+  cryfb_test_001_002_execute
+};
+
+/**
+ * @page cryfb_test_001_003 [1.3] AES CFB and CTR modes
+ *
+ * <h2>Description</h2>
+ * The CFB-128 and CTR modes are verified against the SP800-38A F.3.13,
+ * F.3.14, F.5.1 and F.5.2 examples, a message not multiple of the block
+ * size is also processed.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.3.1] Loading the AES-128 key.
+ * - [1.3.2] CFB encryption and decryption of four blocks.
+ * - [1.3.3] CTR encryption and decryption of four blocks.
+ * - [1.3.4] CFB and CTR encryption of the first 23 bytes, the result
+ *   must be the head of the full message result.
+ * .
+ */
+
+static void cryfb_test_001_003_setup(void) {
+  cryObjectInit(&CRYFBD1);
+  (void) cryStart(&CRYFBD1, NULL);
+}
+
+static void cryfb_test_001_003_teardown(void) {
+  cryStop(&CRYFBD1);
+}
+
+static void cryfb_test_001_003_execute(void) {
+  cryerror_t err;
+
+  /* [1.3.1] Loading the AES-128 key.*/
+  test_set_step(1);
+  {
+    err = cryLoadAESTransientKey(&CRYFBD1, 16, aes_sp800_key);
+    test_assert(err == CRY_NOERROR, "key not loaded");
+  }
+  test_end_step(1);
+
+  /* [1.3.2] CFB encryption and decryption of four blocks.*/
+  test_set_step(2);
+  {
+    err = cryEncryptAES_CFB(&CRYFBD1, 0, 64, aes_sp800_pt, cryfb_test_output,
+                            aes_sp800_iv);
+    test_assert(err == CRY_NOERROR, "encryption failed");
+    test_assert(memcmp(cryfb_test_output, aes_sp800_cfb, 64) == 0,
+                "ciphertext mismatch");
+    err = cryDecryptAES_CFB(&CRYFBD1, 0, 64, aes_sp800_cfb, cryfb_test_output,
+                            aes_sp800_iv);
+    test_assert(err == CRY_NOERROR, "decryption failed");
+    test_assert(memcmp(cryfb_test_output, aes_sp800_pt, 64) == 0,
+                "plaintext mismatch");
+  }
+  test_end_step(2);
+
+  /* [1.3.3] CTR encryption and decryption of four blocks.*/
+  test_set_step(3);
+  {
+    err = cryEncryptAES_CTR(&CRYFBD1, 0, 64, aes_sp800_pt, cryfb_test_output,
+                            aes_sp800_ctr);
+    test_assert(err == CRY_NOERROR, "encryption failed");
+    test_assert(memcmp(cryfb_test_output, aes_sp800_ctr_ct, 64) == 0,
+                "ciphertext mismatch");
+    err = cryDecryptAES_CTR(&CRYFBD1, 0, 64, aes_sp800_ctr_ct,
+                            cryfb_test_output, aes_sp800_ctr);
+    test_assert(err == CRY_NOERROR, "decryption failed");
+    test_assert(memcmp(cryfb_test_output, aes_sp800_pt, 64) == 0,
+                "plaintext mismatch");
+  }
+  test_end_step(3);
+
+  /* [1.3.4] CFB and CTR encryption of the first 23 bytes, the result
+     must be the head of the full message result.*/
+  test_set_step(4);
+  {
+    err = cryEncryptAES_CFB(&CRYFBD1, 0, 23, aes_sp800_pt, cryfb_test_output,
+                            aes_sp800_iv);
+    test_assert(err == CRY_NOERROR, "encryption failed");
+    test_assert(memcmp(cryfb_test_output, aes_sp800_cfb, 23) == 0,
+                "CFB ciphertext mismatch");
+    err = cryEncryptAES_CTR(&CRYFBD1, 0, 23, aes_sp800_pt, cryfb_test_output,
+                            aes_sp800_ctr);
+    test_assert(err == CRY_NOERROR, "encryption failed");
+    test_assert(memcmp(cryfb_test_output, aes_sp800_ctr_ct, 23) == 0,
+                "CTR ciphertext mismatch");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t cryfb_test_001_003 = {
+  "AES CFB and CTR modes",
+  cryfb_test_001_003_setup,
+  cryfb_test_001_003_teardown,
+  cryfb_test_001_003_execute
+};
+
+/**
+ * @page cryfb_test_001_004 [1.4] AES GCM mode
+ *
+ * <h2>Description</h2>
+ * The GCM mode is verified against the test cases 2 and 4 of the GCM
+ * specification, a message with a corrupted tag must be rejected
+ * without producing any plaintext.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.4.1] Test case 2, zero key and IV, one block of zeros.
+ * - [1.4.2] Test case 4, encryption with additional authenticated data
+ *   and a message not multiple of the block size.
+ * - [1.4.3] Test case 4, decryption.
+ * - [1.4.4] Test case 4, decryption with a corrupted tag, the operation
+ *   must fail and the output buffer must not be written.
+ * .
+ */
+
+static void cryfb_test_001_004_setup(void) {
+  cryObjectInit(&CRYFBD1);
+  (void) cryStart(&CRYFBD1, NULL);
+}
+
+static void cryfb_test_001_004_teardown(void) {
+  cryStop(&CRYFBD1);
+}
+
+static void cryfb_test_001_004_execute(void) {
+  uint8_t tag[16];
+  cryerror_t err;
+
+  /* [1.4.1] Test case 2, zero key and IV, one block of zeros.*/
+  test_set_step(1);
+  {
+    memset(cryfb_test_buffer, 0, 16);
+    err = cryLoadAESTransientKey(&CRYFBD1, 16, cryfb_test_buffer);
+    test_assert(err == CRY_NOERROR, "key not loaded");
+    err = cryEncryptAES_GCM(&CRYFBD1, 0, 0, cryfb_test_buffer,
+                            16, cryfb_test_buffer, cryfb_test_output,
+                            cryfb_test_buffer, 16, tag);
+    test_assert(err == CRY_NOERROR, "encryption failed");
+    test_assert(memcmp(cryfb_test_output, gcm_tc2_ct, 16) == 0,
+                "ciphertext mismatch");
+    test_assert(memcmp(tag, gcm_tc2_tag, 16) == 0, "tag mismatch");
+  }
+  test_end_step(1);
+
+  /* [1.4.2] Test case 4, encryption with additional authenticated data
+     and a message not multiple of the block size.*/
+  test_set_step(2);
+  {
+    err = cryLoadAESTransientKey(&CRYFBD1, 16, gcm_tc4_key);
+    test_assert(err == CRY_NOERROR, "key not loaded");
+    err = cryEncryptAES_GCM(&CRYFBD1, 0,
+                            sizeof gcm_tc4_aad, gcm_tc4_aad,
+                            sizeof gcm_tc4_pt, gcm_tc4_pt, cryfb_test_output,
+                            gcm_tc4_iv, 16, tag);
+    test_assert(err == CRY_NOERROR, "encryption failed");
+    test_assert(memcmp(cryfb_test_output, gcm_tc4_ct, sizeof gcm_tc4_ct) == 0,
+                "ciphertext mismatch");
+    test_assert(memcmp(tag, gcm_tc4_tag, 16) == 0, "tag mismatch");
+  }
+  test_end_step(2);
+
+  /* [1.4.3] Test case 4, decryption.*/
+  test_set_step(3);
+  {
+    err = cryDecryptAES_GCM(&CRYFBD1, 0,
+                            sizeof gcm_tc4_aad, gcm_tc4_aad,
+                            sizeof gcm_tc4_ct, gcm_tc4_ct, cryfb_test_output,
+                            gcm_tc4_iv, 16, gcm_tc4_tag);
+    test_assert(err == CRY_NOERROR, "decryption failed");
+    test_assert(memcmp(cryfb_test_output, gcm_tc4_pt, sizeof gcm_tc4_pt) == 0,
+                "plaintext mismatch");
+  }
+  test_end_step(3);
+
+  /* [1.4.4] Test case 4, decryption with a corrupted tag, the operation
+     must fail and the output buffer must not be written.*/
+  test_set_step(4);
+  {
+    memcpy(tag, gcm_tc4_tag, 16);
+    tag[15] ^= 0x01U;
+    memset(cryfb_test_output, 0x55, sizeof gcm_tc4_ct);
+    err = cryDecryptAES_GCM(&CRYFBD1, 0,
+                            sizeof gcm_tc4_aad, gcm_tc4_aad,
+                            sizeof gcm_tc4_ct, gcm_tc4_ct, cryfb_test_output,
+                            gcm_tc4_iv, 16, tag);
+    test_assert(err == CRY_ERR_AUTH_FAILED, "corrupted tag accepted");
+    test_assert(cryfb_test_output[0] == 0x55U, "output written");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t cryfb_test_001_004 = {
+  "AES GCM mode",
+  cryfb_test_001_004_setup,
+  cryfb_test_001_004_teardown,
+  cryfb_test_001_004_execute
+};
+
+/**
+ * @page cryfb_test_001_005 [1.5] SHA1, SHA256 and SHA512
+ *
+ * <h2>Description</h2>
+ * The hash functions are verified against the FIPS 180-4 one block and
+ * two blocks examples, the two blocks messages are also hashed in
+ * chunks of 7 bytes.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.5.1] SHA1 of the one block and two blocks messages.
+ * - [1.5.2] SHA256 of the one block and two blocks messages, the second
+ *   message is hashed in chunks of 7 bytes.
+ * - [1.5.3] SHA512 of the one block and two blocks messages, the second
+ *   message is hashed in chunks of 7 bytes.
+ * .
+ */
+
+static void cryfb_test_001_005_setup(void) {
+  cryObjectInit(&CRYFBD1);
+  (void) cryStart(&CRYFBD1, NULL);
+}
+
+static void cryfb_test_001_005_teardown(void) {
+  cryStop(&CRYFBD1);
+}
+
+static void cryfb_test_001_005_execute(void) {
+  SHA1Context sha1ctx;
+  SHA256Context sha256ctx;
+  SHA512Context sha512ctx;
+  size_t i;
+
+  /* [1.5.1] SHA1 of the one block and two blocks messages.*/
+  test_set_step(1);
+  {
+    (void) crySHA1Init(&CRYFBD1, &sha1ctx);
+    (void) crySHA1Update(&CRYFBD1, &sha1ctx, 3, (const uint8_t *)sha_msg1);
+    (void) crySHA1Final(&CRYFBD1, &sha1ctx, cryfb_test_output);
+    test_assert(memcmp(cryfb_test_output, sha1_digest1, 20) == 0,
+                "digest mismatch");
+    (void) crySHA1Init(&CRYFBD1, &sha1ctx);
+    (void) crySHA1Update(&CRYFBD1, &sha1ctx, 56, (const uint8_t *)sha_msg2);
+    (void) crySHA1Final(&CRYFBD1, &sha1ctx, cryfb_test_output);
+    test_assert(memcmp(cryfb_test_output, sha1_digest2, 20) == 0,
+                "digest mismatch");
+  }
+  test_end_step(1);
+
+  /* [1.5.2] SHA256 of the one block and two blocks messages, the second
+     message is hashed in chunks of 7 bytes.*/
+  test_set_step(2);
+  {
+    (void) crySHA256Init(&CRYFBD1, &sha256ctx);
+    (void) crySHA256Update(&CRYFBD1, &sha256ctx, 3, (const uint8_t *)sha_msg1);
+    (void) crySHA256Final(&CRYFBD1, &sha256ctx, cryfb_test_output);
+    test_assert(memcmp(cryfb_test_output, sha256_digest1, 32) == 0,
+                "digest mismatch");
+    (void) crySHA256Init(&CRYFBD1, &sha256ctx);
+    for (i = 0U; i < 56U; i += 7U) {
+      (void) crySHA256Update(&CRYFBD1, &sha256ctx, 7,
+                             (const uint8_t *)&sha_msg2[i]);
+    }
+    (void) crySHA256Final(&CRYFBD1, &sha256ctx, cryfb_test_output);
+    test_assert(memcmp(cryfb_test_output, sha256_digest2, 32) == 0,
+                "digest mismatch");
+  }
+  test_end_step(2);
+
+  /* [1.5.3] SHA512 of the one block and two blocks messages, the second
+     message is hashed in chunks of 7 bytes.*/
+  test_set_step(3);
+  {
+    (void) crySHA512Init(&CRYFBD1, &sha512ctx);
+    (void) crySHA512Update(&CRYFBD1, &sha512ctx, 3, (const uint8_t *)sha_msg1);
+    (void) crySHA512Final(&CRYFBD1, &sha512ctx, cryfb_test_output);
+    test_assert(memcmp(cryfb_test_output, sha512_digest1, 64) == 0,
+                "digest mismatch");
+    (void) crySHA512Init(&CRYFBD1, &sha512ctx);
+    for (i = 0U; i < 112U; i += 7U) {
+      (void) crySHA512Update(&CRYFBD1, &sha512ctx, 7,
+                             (const uint8_t *)&sha_msg3[i]);
+    }
+    (void) crySHA512Final(&CRYFBD1, &sha512ctx, cryfb_test_output);
+    test_assert(memcmp(cryfb_test_output, sha512_digest3, 64) == 0,
+                "digest mismatch");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t cryfb_test_001_005 = {
+  "SHA1, SHA256 and SHA512",
+  cryfb_test_001_005_setup,
+  cryfb_test_001_005_teardown,
+  cryfb_test_001_005_execute
+};
+
+/**
+ * @page cryfb_test_001_006 [1.6] HMAC-SHA256 and HMAC-SHA512
+ *
+ * <h2>Description</h2>
+ * The HMAC functions are verified against the RFC 4231 test cases 2 and
+ * 4, a key longer than the SHA256 block size is also used, keys larger
+ * than the fall-back limit must be rejected.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.6.1] RFC 4231 test case 2.
+ * - [1.6.2] RFC 4231 test case 4.
+ * - [1.6.3] RFC 4231 test case 6 message with a 100 bytes key, the key
+ *   is hashed for HMAC-SHA256 and used as is for HMAC-SHA512.
+ * - [1.6.4] Loading a key larger than CRY_FALLBACK_HMAC_MAX_KEY_SIZE,
+ *   the operation must fail.
+ * .
+ */
+
+static void cryfb_test_001_006_setup(void) {
+  cryObjectInit(&CRYFBD1);
+  (void) cryStart(&CRYFBD1, NULL);
+}
+
+static void cryfb_test_001_006_teardown(void) {
+  cryStop(&CRYFBD1);
+}
+
+static void cryfb_test_001_006_execute(void) {
+  HMACSHA256Context hmac256ctx;
+  HMACSHA512Context hmac512ctx;
+  cryerror_t err;
+
+  /* [1.6.1] RFC 4231 test case 2.*/
+  test_set_step(1);
+  {
+    err = cryLoadHMACTransientKey(&CRYFBD1, 4, (const uint8_t *)hmac_key2);
+    test_assert(err == CRY_NOERROR, "key not loaded");
+    (void) cryHMACSHA256Init(&CRYFBD1, &hmac256ctx);
+    (void) cryHMACSHA256Update(&CRYFBD1, &hmac256ctx, 28,
+                               (const uint8_t *)hmac_msg2);
+    (void) cryHMACSHA256Final(&CRYFBD1, &hmac256ctx, cryfb_test_output);
+    test_assert(memcmp(cryfb_test_output, hmac256_mac2, 32) == 0,
+                "MAC mismatch");
+    (void) cryHMACSHA512Init(&CRYFBD1, &hmac512ctx);
+    (void) cryHMACSHA512Update(&CRYFBD1, &hmac512ctx, 28,
+                               (const uint8_t *)hmac_msg2);
+    (void) cryHMACSHA512Final(&CRYFBD1, &hmac512ctx, cryfb_test_output);
+    test_assert(memcmp(cryfb_test_output, hmac512_mac2, 64) == 0,
+                "MAC mismatch");
+  }
+  test_end_step(1);
+
+  /* [1.6.2] RFC 4231 test case 4.*/
+  test_set_step(2);
+  {
+    memset(cryfb_test_buffer, 0xCD, 50);
+    err = cryLoadHMACTransientKey(&CRYFBD1, sizeof hmac_key4, hmac_key4);
+    test_assert(err == CRY_NOERROR, "key not loaded");
+    (void) cryHMACSHA256Init(&CRYFBD1, &hmac256ctx);
+    (void) cryHMACSHA256Update(&CRYFBD1, &hmac256ctx, 50,
+                               cryfb_test_buffer);
+    (void) cryHMACSHA256Final(&CRYFBD1, &hmac256ctx, cryfb_test_output);
+    test_assert(memcmp(cryfb_test_output, hmac256_mac4, 32) == 0,
+                "MAC mismatch");
+    (void) cryHMACSHA512Init(&CRYFBD1, &hmac512ctx);
+    (void) cryHMACSHA512Update(&CRYFBD1, &hmac512ctx, 50,
+                               cryfb_test_buffer);
+    (void) cryHMACSHA512Final(&CRYFBD1, &hmac512ctx, cryfb_test_output);
+    test_assert(memcmp(cryfb_test_output, hmac512_mac4, 64) == 0,
+                "MAC mismatch");
+  }
+  test_end_step(2);
+
+  /* [1.6.3] RFC 4231 test case 6 message with a 100 bytes key, the key
+     is hashed for HMAC-SHA256 and used as is for HMAC-SHA512.*/
+  test_set_step(3);
+  {
+    memset(cryfb_test_buffer, 0xAA, 100);
+    err = cryLoadHMACTransientKey(&CRYFBD1, 100, cryfb_test_buffer);
+    test_assert(err == CRY_NOERROR, "key not loaded");
+    (void) cryHMACSHA256Init(&CRYFBD1, &hmac256ctx);
+    (void) cryHMACSHA256Update(&CRYFBD1, &hmac256ctx, 54,
+                               (const uint8_t *)hmac_msg6);
+    (void) cryHMACSHA256Final(&CRYFBD1, &hmac256ctx, cryfb_test_output);
+    test_assert(memcmp(cryfb_test_output, hmac256_mac6, 32) == 0,
+                "MAC mismatch");
+    (void) cryHMACSHA512Init(&CRYFBD1, &hmac512ctx);
+    (void) cryHMACSHA512Update(&CRYFBD1, &hmac512ctx, 54,
+                               (const uint8_t *)hmac_msg6);
+    (void) cryHMACSHA512Final(&CRYFBD1, &hmac512ctx, cryfb_test_output);
+    test_assert(memcmp(cryfb_test_output, hmac512_mac6, 64) == 0,
+                "MAC mismatch");
+  }
+  test_end_step(3);
+
+  /* [1.6.4] Loading a key larger than CRY_FALLBACK_HMAC_MAX_KEY_SIZE,
+     the operation must fail.*/
+  test_set_step(4);
+  {
+    err = cryLoadHMACTransientKey(&CRYFBD1, CRY_FALLBACK_HMAC_MAX_KEY_SIZE + 1U,
+                                  cryfb_test_buffer);
+    test_assert(err == CRY_ERR_INV_KEY_SIZE, "unexpected result");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t cryfb_test_001_006 = {
+  "HMAC-SHA256 and HMAC-SHA512",
+  cryfb_test_001_006_setup,
+  cryfb_test_001_006_teardown,
+  cryfb_test_001_006_execute
+};
+
+/**
+ * @page cryfb_test_001_007 [1.7] Transient keys isolation
+ *
+ * <h2>Description</h2>
+ * Two driver instances are loaded with different keys, each instance
+ * must keep using its own keys.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.7.1] Loading the FIPS-197 AES-128 key in the first driver and
+ *   the SP800-38A key in the second driver.
+ * - [1.7.2] Encrypting with both drivers, each result must match its
+ *   own key.
+ * - [1.7.3] Loading a HMAC key only in the second driver, the first
+ *   driver must still report no HMAC key.
+ * .
+ */
+
+static void cryfb_test_001_007_setup(void) {
+  cryObjectInit(&CRYFBD1);
+  cryObjectInit(&CRYFBD2);
+  (void) cryStart(&CRYFBD1, NULL);
+  (void) cryStart(&CRYFBD2, NULL);
+}
+
+static void cryfb_test_001_007_teardown(void) {
+  cryStop(&CRYFBD2);
+  cryStop(&CRYFBD1);
+}
+
+static void cryfb_test_001_007_execute(void) {
+  HMACSHA256Context hmac256ctx;
+  cryerror_t err;
+
+  /* [1.7.1] Loading the FIPS-197 AES-128 key in the first driver and
+     the SP800-38A key in the second driver.*/
+  test_set_step(1);
+  {
+    err = cryLoadAESTransientKey(&CRYFBD1, 16, aes_fips197_key);
+    test_assert(err == CRY_NOERROR, "key not loaded");
+    err = cryLoadAESTransientKey(&CRYFBD2, 16, aes_sp800_key);
+    test_assert(err == CRY_NOERROR, "key not loaded");
+  }
+  test_end_step(1);
+
+  /* [1.7.2] Encrypting with both drivers, each result must match its
+     own key.*/
+  test_set_step(2);
+  {
+    err = cryEncryptAES(&CRYFBD1, 0, aes_fips197_pt,
+                        cryfb_test_output);
+    test_assert(err == CRY_NOERROR, "encryption failed");
+    test_assert(memcmp(cryfb_test_output, aes_fips197_ct128, 16) == 0,
+                "wrong key used");
+    err = cryEncryptAES_ECB(&CRYFBD2, 0, 16, aes_sp800_pt,
+                            cryfb_test_output);
+    test_assert(err == CRY_NOERROR, "encryption failed");
+    test_assert(memcmp(cryfb_test_output, aes_sp800_ecb, 16) == 0,
+                "wrong key used");
+  }
+  test_end_step(2);
+
+  /* [1.7.3] Loading a HMAC key only in the second driver, the first
+     driver must still report no HMAC key.*/
+  test_set_step(3);
+  {
+    err = cryLoadHMACTransientKey(&CRYFBD2, 4,
+                                  (const uint8_t *)hmac_key2);
+    test_assert(err == CRY_NOERROR, "key not loaded");
+    err = cryHMACSHA256Init(&CRYFBD1, &hmac256ctx);
+    test_assert(err == CRY_ERR_INV_KEY_ID, "unexpected key");
+    err = cryHMACSHA256Init(&CRYFBD2, &hmac256ctx);
+    test_assert(err == CRY_NOERROR, "key not found");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t cryfb_test_001_007 = {
+  "Transient keys isolation",
+  cryfb_test_001_007_setup,
+  cryfb_test_001_007_teardown,
+  cryfb_test_001_007_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const cryfb_test_sequence_001_array[] = {
+  &cryfb_test_001_001,
+  &cryfb_test_001_002,
+  &cryfb_test_001_003,
+  &cryfb_test_001_004,
+  &cryfb_test_001_005,
+  &cryfb_test_001_006,
+  &cryfb_test_001_007,
+  NULL
+};
+
+/**
+ * @brief   Known Answer Tests.
+ */
+const testsequence_t cryfb_test_sequence_001 = {
+  "Known Answer Tests",
+  cryfb_test_sequence_001_array
+};
+
+#endif /* HAL_CRY_ENFORCE_FALLBACK == TRUE */
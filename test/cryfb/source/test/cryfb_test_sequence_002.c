@@ -0,0 +1,273 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "cryfb_test_root.h"
+
+/**
+ * @file    cryfb_test_sequence_002.c
+ * @brief   Test Sequence 002 code.
+ *
+ * @page cryfb_test_sequence_002 [2] Benchmarks
+ *
+ * File: @ref cryfb_test_sequence_002.c
+ *
+ * <h2>Description</h2>
+ * Throughput measurements of the fall-back algorithms, results are
+ * printed on the output log.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - HAL_CRY_ENFORCE_FALLBACK == TRUE
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage cryfb_test_002_001
+ * - @subpage cryfb_test_002_002
+ * .
+ */
+
+#if (HAL_CRY_ENFORCE_FALLBACK == TRUE) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+
+typedef cryerror_t (*cryfb_test_op_t)(void);
+
+static SHA256Context sha256ctx;
+static SHA512Context sha512ctx;
+static uint8_t iv[16];
+
+static cryerror_t op_aes_cbc(void) {
+
+  return cryEncryptAES_CBC(&CRYFBD1, 0, CRYFB_TEST_BUFFER_SIZE,
+                           cryfb_test_buffer, cryfb_test_output, iv);
+}
+
+static cryerror_t op_aes_ctr(void) {
+
+  return cryEncryptAES_CTR(&CRYFBD1, 0, CRYFB_TEST_BUFFER_SIZE,
+                           cryfb_test_buffer, cryfb_test_output, iv);
+}
+
+static cryerror_t op_aes_gcm(void) {
+  uint8_t tag[16];
+
+  return cryEncryptAES_GCM(&CRYFBD1, 0, 0, cryfb_test_buffer,
+                           CRYFB_TEST_BUFFER_SIZE, cryfb_test_buffer,
+                           cryfb_test_output, iv, 16, tag);
+}
+
+static cryerror_t op_sha256(void) {
+
+  return crySHA256Update(&CRYFBD1, &sha256ctx,
+                         CRYFB_TEST_BUFFER_SIZE, cryfb_test_buffer);
+}
+
+static cryerror_t op_sha512(void) {
+
+  return crySHA512Update(&CRYFBD1, &sha512ctx,
+                         CRYFB_TEST_BUFFER_SIZE, cryfb_test_buffer);
+}
+
+static uint32_t cryfb_test_loop(cryfb_test_op_t op) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  chThdSleep(1);
+  start = chVTGetSystemTimeX();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    if (op() != CRY_NOERROR) {
+      return 0U;
+    }
+    n++;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  return n;
+}
+
+static void cryfb_test_print(const char *msgp, uint32_t n) {
+
+  test_print(msgp);
+  test_printn((n * CRYFB_TEST_BUFFER_SIZE) / 1024U);
+  test_println(" kB/S");
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page cryfb_test_002_001 [2.1] AES-128 throughput
+ *
+ * <h2>Description</h2>
+ * A 1kB buffer is encrypted repeatedly for one second using the CBC,
+ * CTR and GCM modes, the throughput is printed on the output log.
+ *
+ * <h2>Test Steps</h2>
+ * - [2.1.1] Loading the AES-128 key.
+ * - [2.1.2] CBC encryption for one second.
+ * - [2.1.3] CTR encryption for one second.
+ * - [2.1.4] GCM encryption for one second.
+ * .
+ */
+
+static void cryfb_test_002_001_setup(void) {
+  cryObjectInit(&CRYFBD1);
+  (void) cryStart(&CRYFBD1, NULL);
+  memset(cryfb_test_buffer, 0x5A, CRYFB_TEST_BUFFER_SIZE);
+  memset(iv, 0, sizeof iv);
+}
+
+static void cryfb_test_002_001_teardown(void) {
+  cryStop(&CRYFBD1);
+}
+
+static void cryfb_test_002_001_execute(void) {
+  cryerror_t err;
+
+  /* [2.1.1] Loading the AES-128 key.*/
+  test_set_step(1);
+  {
+    err = cryLoadAESTransientKey(&CRYFBD1, 16,
+                                 cryfb_test_buffer);
+    test_assert(err == CRY_NOERROR, "key not loaded");
+  }
+  test_end_step(1);
+
+  /* [2.1.2] CBC encryption for one second.*/
+  test_set_step(2);
+  {
+    uint32_t n = cryfb_test_loop(op_aes_cbc);
+    test_assert(n > 0U, "encryption failed");
+    cryfb_test_print("--- CBC : ", n);
+  }
+  test_end_step(2);
+
+  /* [2.1.3] CTR encryption for one second.*/
+  test_set_step(3);
+  {
+    uint32_t n = cryfb_test_loop(op_aes_ctr);
+    test_assert(n > 0U, "encryption failed");
+    cryfb_test_print("--- CTR : ", n);
+  }
+  test_end_step(3);
+
+  /* [2.1.4] GCM encryption for one second.*/
+  test_set_step(4);
+  {
+    uint32_t n = cryfb_test_loop(op_aes_gcm);
+    test_assert(n > 0U, "encryption failed");
+    cryfb_test_print("--- GCM : ", n);
+  }
+  test_end_step(4);
+}
+
+static const testcase_t cryfb_test_002_001 = {
+  "AES-128 throughput",
+  cryfb_test_002_001_setup,
+  cryfb_test_002_001_teardown,
+  cryfb_test_002_001_execute
+};
+
+/**
+ * @page cryfb_test_002_002 [2.2] SHA256 and SHA512 throughput
+ *
+ * <h2>Description</h2>
+ * A 1kB buffer is hashed repeatedly for one second using SHA256 and
+ * SHA512, the throughput is printed on the output log.
+ *
+ * <h2>Test Steps</h2>
+ * - [2.2.1] SHA256 for one second.
+ * - [2.2.2] SHA512 for one second.
+ * .
+ */
+
+static void cryfb_test_002_002_setup(void) {
+  cryObjectInit(&CRYFBD1);
+  (void) cryStart(&CRYFBD1, NULL);
+  memset(cryfb_test_buffer, 0x5A, CRYFB_TEST_BUFFER_SIZE);
+}
+
+static void cryfb_test_002_002_teardown(void) {
+  cryStop(&CRYFBD1);
+}
+
+static void cryfb_test_002_002_execute(void) {
+  /* [2.2.1] SHA256 for one second.*/
+  test_set_step(1);
+  {
+    uint32_t n;
+
+    (void) crySHA256Init(&CRYFBD1, &sha256ctx);
+    n = cryfb_test_loop(op_sha256);
+    test_assert(n > 0U, "hash failed");
+    (void) crySHA256Final(&CRYFBD1, &sha256ctx, cryfb_test_output);
+    cryfb_test_print("--- SHA256 : ", n);
+  }
+  test_end_step(1);
+
+  /* [2.2.2] SHA512 for one second.*/
+  test_set_step(2);
+  {
+    uint32_t n;
+
+    (void) crySHA512Init(&CRYFBD1, &sha512ctx);
+    n = cryfb_test_loop(op_sha512);
+    test_assert(n > 0U, "hash failed");
+    (void) crySHA512Final(&CRYFBD1, &sha512ctx, cryfb_test_output);
+    cryfb_test_print("--- SHA512 : ", n);
+  }
+  test_end_step(2);
+}
+
+static const testcase_t cryfb_test_002_002 = {
+  "SHA256 and SHA512 throughput",
+  cryfb_test_002_002_setup,
+  cryfb_test_002_002_teardown,
+  cryfb_test_002_002_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const cryfb_test_sequence_002_array[] = {
+  &cryfb_test_002_001,
+  &cryfb_test_002_002,
+  NULL
+};
+
+/**
+ * @brief   Benchmarks.
+ */
+const testsequence_t cryfb_test_sequence_002 = {
+  "Benchmarks",
+  cryfb_test_sequence_002_array
+};
+
+#endif /* HAL_CRY_ENFORCE_FALLBACK == TRUE */
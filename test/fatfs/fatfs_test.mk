@@ -0,0 +1,6 @@
+# List of all the FatFS bindings test files.
+TESTSRC += ${CHIBIOS}/test/fatfs/source/test/fatfs_test_root.c \
+           ${CHIBIOS}/test/fatfs/source/test/fatfs_test_sequence_001.c
+
+# Required include directories
+TESTINC += ${CHIBIOS}/test/fatfs/source/test
@@ -0,0 +1,144 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @mainpage Test Suite Specification
+ * Test suite for the FatFS disk I/O bindings sector cache. The project
+ * must define FATFS_USE_SECTOR_CACHE, FATFS_CACHE_SECTORS and
+ * FATFS_CACHE_READAHEAD, the block device is a RamDisk provided by the
+ * test suite with FATFS_HAL_DEVICE defined as fatfs_test_disk,
+ * FATFS_HAL_DEVICE_TYPE as fatfs_test_disk_t and
+ * FATFS_HAL_DEVICE_HEADER as "fatfs_test_root.h".
+ *
+ * <h2>Test Sequences</h2>
+ * - @subpage fatfs_test_sequence_001
+ * .
+ */
+
+/**
+ * @file    fatfs_test_root.c
+ * @brief   Test Suite root structures code.
+ */
+
+#include "hal.h"
+#include "fatfs_test_root.h"
+
+#if !defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Array of test sequences.
+ */
+const testsequence_t * const fatfs_test_suite_array[] = {
+#if (FATFS_USE_SECTOR_CACHE == TRUE) || defined(__DOXYGEN__)
+  &fatfs_test_sequence_001,
+#endif
+  NULL
+};
+
+/**
+ * @brief   Test suite root structure.
+ */
+const testsuite_t fatfs_test_suite = {
+  "FatFS Bindings Test Suite",
+  fatfs_test_suite_array
+};
+
+/*===========================================================================*/
+/* Shared code.                                                              */
+/*===========================================================================*/
+
+fatfs_test_disk_t fatfs_test_disk;
+uint8_t fatfs_test_storage[FATFS_TEST_DISK_SECTORS * FF_MAX_SS];
+uint8_t fatfs_test_buffer[FATFS_TEST_BUFFER_SECTORS * FF_MAX_SS];
+
+static const struct BaseBlockDeviceVMT *ramdisk_vmt;
+static struct BaseBlockDeviceVMT fatfs_test_vmt;
+
+static bool fatfs_test_blk_read(void *instance, uint32_t startblk,
+                                uint8_t *buffer, uint32_t n) {
+  fatfs_test_disk_t *tdp = (fatfs_test_disk_t *)instance;
+
+  tdp->reads++;
+  return ramdisk_vmt->read(instance, startblk, buffer, n);
+}
+
+static bool fatfs_test_blk_write(void *instance, uint32_t startblk,
+                                 const uint8_t *buffer, uint32_t n) {
+  fatfs_test_disk_t *tdp = (fatfs_test_disk_t *)instance;
+
+  if (tdp->fail_writes) {
+    return HAL_FAILED;
+  }
+  tdp->writes++;
+  tdp->written += n;
+  return ramdisk_vmt->write(instance, startblk, buffer, n);
+}
+
+void fatfs_test_start(void) {
+  DWORD sector;
+
+  for (sector = 0; sector < FATFS_TEST_DISK_SECTORS; sector++) {
+    fatfs_test_fill(fatfs_test_sector(sector), sector, 0U);
+  }
+
+  /* The RamDisk methods are wrapped by the counting ones.*/
+  ramdiskObjectInit((RamDisk *)&fatfs_test_disk);
+  ramdisk_vmt = fatfs_test_disk.vmt;
+  fatfs_test_vmt = *ramdisk_vmt;
+  fatfs_test_vmt.read  = fatfs_test_blk_read;
+  fatfs_test_vmt.write = fatfs_test_blk_write;
+  fatfs_test_disk.vmt  = &fatfs_test_vmt;
+  ramdiskStart((RamDisk *)&fatfs_test_disk, fatfs_test_storage,
+               FF_MAX_SS, FATFS_TEST_DISK_SECTORS, false);
+  fatfs_test_disk.fail_writes = false;
+  fatfs_test_disk.reads       = 0U;
+  fatfs_test_disk.writes      = 0U;
+  fatfs_test_disk.written     = 0U;
+
+  /* Starting with an empty cache.*/
+  (void) disk_initialize(0);
+}
+
+void fatfs_test_fill(uint8_t *p, DWORD sector, uint8_t seed) {
+  unsigned i;
+
+  for (i = 0U; i < FF_MAX_SS; i++) {
+    p[i] = (uint8_t)((sector * 13U) + (seed * 101U) + i);
+  }
+}
+
+bool fatfs_test_check(const uint8_t *p, DWORD sector, uint8_t seed) {
+  unsigned i;
+
+  for (i = 0U; i < FF_MAX_SS; i++) {
+    if (p[i] != (uint8_t)((sector * 13U) + (seed * 101U) + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+DRESULT fatfs_test_write(DWORD sector, uint8_t seed) {
+
+  fatfs_test_fill(fatfs_test_buffer, sector, seed);
+  return disk_write(0, fatfs_test_buffer, sector, 1);
+}
+
+#endif /* !defined(__DOXYGEN__) */
@@ -0,0 +1,85 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fatfs_test_root.h
+ * @brief   Test Suite root structures header.
+ */
+
+#ifndef FATFS_TEST_ROOT_H
+#define FATFS_TEST_ROOT_H
+
+#include "ch_test.h"
+
+#include "fatfs_test_sequence_001.h"
+
+#if !defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+extern const testsuite_t fatfs_test_suite;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Shared definitions.                                                       */
+/*===========================================================================*/
+
+#include "ramdisk.h"
+#include "ff.h"
+#include "diskio.h"
+
+#define TEST_SUITE_NAME "FatFS Bindings Test Suite"
+
+#if (FATFS_USE_SECTOR_CACHE == TRUE) &&                                     \
+    (!defined(FATFS_CACHE_SECTORS) || !defined(FATFS_CACHE_READAHEAD))
+#error "FATFS_CACHE_SECTORS and FATFS_CACHE_READAHEAD must be defined"
+#endif
+
+#define FATFS_TEST_DISK_SECTORS ((FATFS_CACHE_SECTORS * 2U) + 48U)
+#define FATFS_TEST_BUFFER_SECTORS 8U
+
+/* RamDisk counting the device accesses, writes can be made to fail.*/
+typedef struct {
+  const struct BaseBlockDeviceVMT *vmt;
+  _ramdisk_device_data
+  bool                  fail_writes;
+  unsigned              reads;
+  unsigned              writes;
+  unsigned              written;
+} fatfs_test_disk_t;
+
+extern fatfs_test_disk_t fatfs_test_disk;
+extern uint8_t fatfs_test_storage[FATFS_TEST_DISK_SECTORS * FF_MAX_SS];
+extern uint8_t fatfs_test_buffer[FATFS_TEST_BUFFER_SECTORS * FF_MAX_SS];
+
+#define fatfs_test_sector(sector) (&fatfs_test_storage[(sector) * FF_MAX_SS])
+
+void fatfs_test_start(void);
+void fatfs_test_fill(uint8_t *p, DWORD sector, uint8_t seed);
+bool fatfs_test_check(const uint8_t *p, DWORD sector, uint8_t seed);
+DRESULT fatfs_test_write(DWORD sector, uint8_t seed);
+
+#endif /* !defined(__DOXYGEN__) */
+
+#endif /* FATFS_TEST_ROOT_H */
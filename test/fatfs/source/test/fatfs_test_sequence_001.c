@@ -0,0 +1,543 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "fatfs_test_root.h"
+
+/**
+ * @file    fatfs_test_sequence_001.c
+ * @brief   Test Sequence 001 code.
+ *
+ * @page fatfs_test_sequence_001 [1] Sector cache
+ *
+ * File: @ref fatfs_test_sequence_001.c
+ *
+ * <h2>Description</h2>
+ * The FatFS sector cache is exercised through the disk I/O functions,
+ * device accesses are counted by the test RamDisk.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - FATFS_USE_SECTOR_CACHE == TRUE
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage fatfs_test_001_001
+ * - @subpage fatfs_test_001_002
+ * - @subpage fatfs_test_001_003
+ * - @subpage fatfs_test_001_004
+ * - @subpage fatfs_test_001_005
+ * .
+ */
+
+#if (FATFS_USE_SECTOR_CACHE == TRUE) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page fatfs_test_001_001 [1.1] Read caching and read-ahead
+ *
+ * <h2>Description</h2>
+ * Single sector reads are served from the cache, a read following the
+ * previously read sector triggers a multi-sector read.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.1.1] Reading sector 10, it is read from the device.
+ * - [1.1.2] Reading sector 11, FATFS_CACHE_READAHEAD sectors are read
+ *   with a single device access.
+ * - [1.1.3] Reading again sector 10 and the sectors read ahead, no
+ *   device access is expected.
+ * .
+ */
+
+static void fatfs_test_001_001_setup(void) {
+  fatfs_test_start();
+}
+
+static void fatfs_test_001_001_teardown(void) {
+  ramdiskStop((RamDisk *)&fatfs_test_disk);
+}
+
+static void fatfs_test_001_001_execute(void) {
+  DWORD sector;
+
+  /* [1.1.1] Reading sector 10, it is read from the device.*/
+  test_set_step(1);
+  {
+    test_assert(disk_read(0, fatfs_test_buffer, 10, 1) == RES_OK,
+                "read failed");
+    test_assert(fatfs_test_check(fatfs_test_buffer, 10, 0U), "wrong data");
+    test_assert(fatfs_test_disk.reads == 1U, "unexpected device reads");
+  }
+  test_end_step(1);
+
+  /* [1.1.2] Reading sector 11, FATFS_CACHE_READAHEAD sectors are read
+     with a single device access.*/
+  test_set_step(2);
+  {
+    test_assert(disk_read(0, fatfs_test_buffer, 11, 1) == RES_OK,
+                "read failed");
+    test_assert(fatfs_test_check(fatfs_test_buffer, 11, 0U), "wrong data");
+    test_assert(fatfs_test_disk.reads == 2U, "unexpected device reads");
+  }
+  test_end_step(2);
+
+  /* [1.1.3] Reading again sector 10 and the sectors read ahead, no
+     device access is expected.*/
+  test_set_step(3);
+  {
+    for (sector = 10; sector < 11 + FATFS_CACHE_READAHEAD; sector++) {
+      test_assert(disk_read(0, fatfs_test_buffer, sector, 1) == RES_OK,
+                  "read failed");
+      test_assert(fatfs_test_check(fatfs_test_buffer, sector, 0U),
+                  "wrong data");
+    }
+    test_assert(fatfs_test_disk.reads == 2U, "unexpected device reads");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t fatfs_test_001_001 = {
+  "Read caching and read-ahead",
+  fatfs_test_001_001_setup,
+  fatfs_test_001_001_teardown,
+  fatfs_test_001_001_execute
+};
+
+/**
+ * @page fatfs_test_001_002 [1.2] Deferred writes and sync coalescing
+ *
+ * <h2>Description</h2>
+ * Single sector writes are deferred until CTRL_SYNC, runs of
+ * consecutive dirty sectors are written with multi-sector writes of up
+ * to FATFS_CACHE_READAHEAD sectors.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.2.1] Writing sectors 22, 20, 30 and 21, nothing is written on
+ *   the device.
+ * - [1.2.2] Reading back sector 21, the written data is returned
+ *   without device accesses.
+ * - [1.2.3] Synchronizing, sectors 20 to 22 are written with
+ *   multi-sector writes and sector 30 with another one.
+ * - [1.2.4] Synchronizing again, nothing is written.
+ * - [1.2.5] Writing a run of FATFS_CACHE_READAHEAD + 1 consecutive
+ *   sectors, the sync splits it in two device accesses.
+ * .
+ */
+
+static void fatfs_test_001_002_setup(void) {
+  fatfs_test_start();
+}
+
+static void fatfs_test_001_002_teardown(void) {
+  ramdiskStop((RamDisk *)&fatfs_test_disk);
+}
+
+static void fatfs_test_001_002_execute(void) {
+  DWORD sector;
+  unsigned writes;
+
+  /* [1.2.1] Writing sectors 22, 20, 30 and 21, nothing is written on
+     the device.*/
+  test_set_step(1);
+  {
+    test_assert(fatfs_test_write(22, 1U) == RES_OK, "write failed");
+    test_assert(fatfs_test_write(20, 1U) == RES_OK, "write failed");
+    test_assert(fatfs_test_write(30, 1U) == RES_OK, "write failed");
+    test_assert(fatfs_test_write(21, 1U) == RES_OK, "write failed");
+    test_assert(fatfs_test_disk.writes == 0U, "unexpected device writes");
+    test_assert(fatfs_test_check(fatfs_test_sector(20), 20, 0U),
+                "medium modified");
+  }
+  test_end_step(1);
+
+  /* [1.2.2] Reading back sector 21, the written data is returned
+     without device accesses.*/
+  test_set_step(2);
+  {
+    test_assert(disk_read(0, fatfs_test_buffer, 21, 1) == RES_OK,
+                "read failed");
+    test_assert(fatfs_test_check(fatfs_test_buffer, 21, 1U), "wrong data");
+    test_assert(fatfs_test_disk.reads == 0U, "unexpected device reads");
+  }
+  test_end_step(2);
+
+  /* [1.2.3] Synchronizing, sectors 20 to 22 are written with
+     multi-sector writes and sector 30 with another one.*/
+  test_set_step(3);
+  {
+    writes = ((3U + FATFS_CACHE_READAHEAD - 1U) / FATFS_CACHE_READAHEAD) + 1U;
+    test_assert(disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK, "sync failed");
+    test_assert(fatfs_test_disk.writes == writes, "unexpected device writes");
+    test_assert(fatfs_test_disk.written == 4U, "unexpected sectors count");
+    test_assert(fatfs_test_check(fatfs_test_sector(20), 20, 1U), "not written");
+    test_assert(fatfs_test_check(fatfs_test_sector(21), 21, 1U), "not written");
+    test_assert(fatfs_test_check(fatfs_test_sector(22), 22, 1U), "not written");
+    test_assert(fatfs_test_check(fatfs_test_sector(30), 30, 1U), "not written");
+  }
+  test_end_step(3);
+
+  /* [1.2.4] Synchronizing again, nothing is written.*/
+  test_set_step(4);
+  {
+    test_assert(disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK, "sync failed");
+    test_assert(fatfs_test_disk.writes == writes, "unexpected device writes");
+  }
+  test_end_step(4);
+
+  /* [1.2.5] Writing a run of FATFS_CACHE_READAHEAD + 1 consecutive
+     sectors, the sync splits it in two device accesses.*/
+  test_set_step(5);
+  {
+    for (sector = 40; sector <= 40 + FATFS_CACHE_READAHEAD; sector++) {
+      test_assert(fatfs_test_write(sector, 2U) == RES_OK, "write failed");
+    }
+    test_assert(disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK, "sync failed");
+    test_assert(fatfs_test_disk.writes == writes + 2U,
+                "unexpected device writes");
+    test_assert(fatfs_test_disk.written == 5U + FATFS_CACHE_READAHEAD,
+                "unexpected sectors count");
+    for (sector = 40; sector <= 40 + FATFS_CACHE_READAHEAD; sector++) {
+      test_assert(fatfs_test_check(fatfs_test_sector(sector), sector, 2U),
+                  "not written");
+    }
+  }
+  test_end_step(5);
+}
+
+static const testcase_t fatfs_test_001_002 = {
+  "Deferred writes and sync coalescing",
+  fatfs_test_001_002_setup,
+  fatfs_test_001_002_teardown,
+  fatfs_test_001_002_execute
+};
+
+/**
+ * @page fatfs_test_001_003 [1.3] Eviction of dirty sectors
+ *
+ * <h2>Description</h2>
+ * The cache is filled with dirty sectors, accessing a further sector
+ * requires the write-back of the least recently used one.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.3.1] Writing FATFS_CACHE_SECTORS non consecutive sectors.
+ * - [1.3.2] Reading a sector not in cache, the least recently used
+ *   sector is written back and the read succeeds.
+ * - [1.3.3] Writing a sector not in cache, the next least recently used
+ *   sector is written back.
+ * - [1.3.4] Synchronizing, each dirty sector is written exactly once.
+ * .
+ */
+
+static void fatfs_test_001_003_setup(void) {
+  fatfs_test_start();
+}
+
+static void fatfs_test_001_003_teardown(void) {
+  ramdiskStop((RamDisk *)&fatfs_test_disk);
+}
+
+static void fatfs_test_001_003_execute(void) {
+  DWORD i;
+
+  /* [1.3.1] Writing FATFS_CACHE_SECTORS non consecutive sectors.*/
+  test_set_step(1);
+  {
+    for (i = 0; i < FATFS_CACHE_SECTORS; i++) {
+      test_assert(fatfs_test_write(i * 2U, 1U) == RES_OK, "write failed");
+    }
+    test_assert(fatfs_test_disk.writes == 0U, "unexpected device writes");
+  }
+  test_end_step(1);
+
+  /* [1.3.2] Reading a sector not in cache, the least recently used
+     sector is written back and the read succeeds.*/
+  test_set_step(2);
+  {
+    test_assert(disk_read(0, fatfs_test_buffer, 1, 1) == RES_OK,
+                "read failed");
+    test_assert(fatfs_test_check(fatfs_test_buffer, 1, 0U), "wrong data");
+    test_assert(fatfs_test_disk.writes == 1U, "unexpected device writes");
+    test_assert(fatfs_test_check(fatfs_test_sector(0), 0, 1U), "not written");
+  }
+  test_end_step(2);
+
+  /* [1.3.3] Writing a sector not in cache, the next least recently used
+     sector is written back.*/
+  test_set_step(3);
+  {
+    test_assert(fatfs_test_write(3, 1U) == RES_OK, "write failed");
+    test_assert(fatfs_test_disk.writes == 2U, "unexpected device writes");
+    test_assert(fatfs_test_check(fatfs_test_sector(2), 2, 1U), "not written");
+  }
+  test_end_step(3);
+
+  /* [1.3.4] Synchronizing, each dirty sector is written exactly once.*/
+  test_set_step(4);
+  {
+    test_assert(disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK, "sync failed");
+    test_assert(fatfs_test_disk.written == FATFS_CACHE_SECTORS + 1U,
+                "unexpected sectors count");
+    for (i = 0; i < FATFS_CACHE_SECTORS; i++) {
+      test_assert(fatfs_test_check(fatfs_test_sector(i * 2U), i * 2U, 1U),
+                  "not written");
+    }
+    test_assert(fatfs_test_check(fatfs_test_sector(3), 3, 1U), "not written");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t fatfs_test_001_003 = {
+  "Eviction of dirty sectors",
+  fatfs_test_001_003_setup,
+  fatfs_test_001_003_teardown,
+  fatfs_test_001_003_execute
+};
+
+/**
+ * @page fatfs_test_001_004 [1.4] Failed write-back
+ *
+ * <h2>Description</h2>
+ * A failed write-back is reported by the operation requiring it, dirty
+ * sectors are retained until they are successfully written.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.4.1] Writing FATFS_CACHE_SECTORS non consecutive sectors.
+ * - [1.4.2] Making the device fail writes and reading a sector not in
+ *   cache, the write-back fails and the error is reported.
+ * - [1.4.3] Writing a sector not in cache, the error is reported.
+ * - [1.4.4] Restoring the device, all the written sectors are read back
+ *   from the cache.
+ * - [1.4.5] Making the device fail writes again, synchronization fails.
+ * - [1.4.6] Restoring the device, synchronization succeeds and all the
+ *   sectors are written.
+ * .
+ */
+
+static void fatfs_test_001_004_setup(void) {
+  fatfs_test_start();
+}
+
+static void fatfs_test_001_004_teardown(void) {
+  ramdiskStop((RamDisk *)&fatfs_test_disk);
+}
+
+static void fatfs_test_001_004_execute(void) {
+  DWORD i;
+  unsigned reads;
+
+  /* [1.4.1] Writing FATFS_CACHE_SECTORS non consecutive sectors.*/
+  test_set_step(1);
+  {
+    for (i = 0; i < FATFS_CACHE_SECTORS; i++) {
+      test_assert(fatfs_test_write(i * 2U, 1U) == RES_OK, "write failed");
+    }
+    test_assert(fatfs_test_disk.writes == 0U, "unexpected device writes");
+  }
+  test_end_step(1);
+
+  /* [1.4.2] Making the device fail writes and reading a sector not in
+     cache, the write-back fails and the error is reported.*/
+  test_set_step(2);
+  {
+    fatfs_test_disk.fail_writes = true;
+    test_assert(disk_read(0, fatfs_test_buffer, 1, 1) == RES_ERROR,
+                "error not reported");
+    test_assert(fatfs_test_check(fatfs_test_sector(0), 0, 0U),
+                "medium modified");
+  }
+  test_end_step(2);
+
+  /* [1.4.3] Writing a sector not in cache, the error is reported.*/
+  test_set_step(3);
+  {
+    test_assert(fatfs_test_write(1, 2U) == RES_ERROR,
+                "error not reported");
+  }
+  test_end_step(3);
+
+  /* [1.4.4] Restoring the device, all the written sectors are read back
+     from the cache.*/
+  test_set_step(4);
+  {
+    fatfs_test_disk.fail_writes = false;
+    reads = fatfs_test_disk.reads;
+    for (i = 0; i < FATFS_CACHE_SECTORS; i++) {
+      test_assert(disk_read(0, fatfs_test_buffer, i * 2U, 1) == RES_OK,
+                  "read failed");
+      test_assert(fatfs_test_check(fatfs_test_buffer, i * 2U, 1U),
+                  "sector lost");
+    }
+    test_assert(fatfs_test_disk.reads == reads, "unexpected device reads");
+  }
+  test_end_step(4);
+
+  /* [1.4.5] Making the device fail writes again, synchronization
+     fails.*/
+  test_set_step(5);
+  {
+    fatfs_test_disk.fail_writes = true;
+    test_assert(disk_ioctl(0, CTRL_SYNC, NULL) == RES_ERROR,
+                "error not reported");
+    test_assert(fatfs_test_check(fatfs_test_sector(0), 0, 0U),
+                "medium modified");
+  }
+  test_end_step(5);
+
+  /* [1.4.6] Restoring the device, synchronization succeeds and all the
+     sectors are written.*/
+  test_set_step(6);
+  {
+    fatfs_test_disk.fail_writes = false;
+    test_assert(disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK, "sync failed");
+    test_assert(fatfs_test_disk.written == FATFS_CACHE_SECTORS,
+                "unexpected sectors count");
+    for (i = 0; i < FATFS_CACHE_SECTORS; i++) {
+      test_assert(fatfs_test_check(fatfs_test_sector(i * 2U), i * 2U, 1U),
+                  "not written");
+    }
+  }
+  test_end_step(6);
+}
+
+static const testcase_t fatfs_test_001_004 = {
+  "Failed write-back",
+  fatfs_test_001_004_setup,
+  fatfs_test_001_004_teardown,
+  fatfs_test_001_004_execute
+};
+
+/**
+ * @page fatfs_test_001_005 [1.5] Multi-sector transfers coherence
+ *
+ * <h2>Description</h2>
+ * Multi-sector transfers bypass the cache, the data read includes dirty
+ * cached sectors and cached copies of written sectors are updated.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.5.1] Reading sector 5 and writing sector 6, sector 5 is cached
+ *   and sector 6 is cached and dirty.
+ * - [1.5.2] Reading sectors 4 to 9 with a multi-sector read, the dirty
+ *   cached sector replaces the medium content.
+ * - [1.5.3] Writing sectors 4 to 9 with a multi-sector write, the
+ *   cached copies are updated.
+ * - [1.5.4] Synchronizing, the cached copies are no more dirty and
+ *   nothing is written.
+ * .
+ */
+
+static void fatfs_test_001_005_setup(void) {
+  fatfs_test_start();
+}
+
+static void fatfs_test_001_005_teardown(void) {
+  ramdiskStop((RamDisk *)&fatfs_test_disk);
+}
+
+static void fatfs_test_001_005_execute(void) {
+  DWORD sector;
+  unsigned reads;
+
+  /* [1.5.1] Reading sector 5 and writing sector 6, sector 5 is cached
+     and sector 6 is cached and dirty.*/
+  test_set_step(1);
+  {
+    test_assert(disk_read(0, fatfs_test_buffer, 5, 1) == RES_OK,
+                "read failed");
+    test_assert(fatfs_test_write(6, 1U) == RES_OK, "write failed");
+  }
+  test_end_step(1);
+
+  /* [1.5.2] Reading sectors 4 to 9 with a multi-sector read, the dirty
+     cached sector replaces the medium content.*/
+  test_set_step(2);
+  {
+    test_assert(disk_read(0, fatfs_test_buffer, 4, 6) == RES_OK,
+                "read failed");
+    for (sector = 4; sector < 10; sector++) {
+      test_assert(fatfs_test_check(&fatfs_test_buffer[(sector - 4) * FF_MAX_SS],
+                                   sector, sector == 6 ? 1U : 0U),
+                  "wrong data");
+    }
+  }
+  test_end_step(2);
+
+  /* [1.5.3] Writing sectors 4 to 9 with a multi-sector write, the
+     cached copies are updated.*/
+  test_set_step(3);
+  {
+    for (sector = 4; sector < 10; sector++) {
+      fatfs_test_fill(&fatfs_test_buffer[(sector - 4) * FF_MAX_SS], sector, 2U);
+    }
+    test_assert(disk_write(0, fatfs_test_buffer, 4, 6) == RES_OK,
+                "write failed");
+    test_assert(fatfs_test_disk.writes == 1U, "unexpected device writes");
+    reads = fatfs_test_disk.reads;
+    for (sector = 5; sector < 7; sector++) {
+      test_assert(disk_read(0, fatfs_test_buffer, sector, 1) == RES_OK,
+                  "read failed");
+      test_assert(fatfs_test_check(fatfs_test_buffer, sector, 2U),
+                  "stale data");
+    }
+    test_assert(fatfs_test_disk.reads == reads, "unexpected device reads");
+  }
+  test_end_step(3);
+
+  /* [1.5.4] Synchronizing, the cached copies are no more dirty and
+     nothing is written.*/
+  test_set_step(4);
+  {
+    test_assert(disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK, "sync failed");
+    test_assert(fatfs_test_disk.writes == 1U, "unexpected device writes");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t fatfs_test_001_005 = {
+  "Multi-sector transfers coherence",
+  fatfs_test_001_005_setup,
+  fatfs_test_001_005_teardown,
+  fatfs_test_001_005_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const fatfs_test_sequence_001_array[] = {
+  &fatfs_test_001_001,
+  &fatfs_test_001_002,
+  &fatfs_test_001_003,
+  &fatfs_test_001_004,
+  &fatfs_test_001_005,
+  NULL
+};
+
+/**
+ * @brief   Sector cache.
+ */
+const testsequence_t fatfs_test_sequence_001 = {
+  "Sector cache",
+  fatfs_test_sequence_001_array
+};
+
+#endif /* FATFS_USE_SECTOR_CACHE == TRUE */
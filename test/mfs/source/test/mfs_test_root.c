@@ -24,6 +24,7 @@
  * - @subpage mfs_test_sequence_001
  * - @subpage mfs_test_sequence_002
  * - @subpage mfs_test_sequence_003
+ * - @subpage mfs_test_sequence_004
  * .
  */
 
@@ -48,6 +49,7 @@ const testsequence_t * const mfs_test_suite_array[] = {
   &mfs_test_sequence_001,
   &mfs_test_sequence_002,
   &mfs_test_sequence_003,
+  &mfs_test_sequence_004,
   NULL
 };
 
@@ -150,6 +152,12 @@ flash_error_t bank_erase(mfs_bank_t bank) {
 flash_error_t bank_verify_erased(mfs_bank_t bank) {
   flash_sector_t sector, n;
 
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  /* Completing a deferred bank erase, if any.*/
+  while (mfsPerformGarbageCollectionStep(&mfs1) == MFS_WARN_GC) {
+  }
+#endif
+
   if (bank == MFS_BANK_0) {
     sector = mfscfg1.bank0_start;
     n      = mfscfg1.bank0_sectors;
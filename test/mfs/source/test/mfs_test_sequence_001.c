@@ -37,6 +37,7 @@
  * - @subpage mfs_test_001_005
  * - @subpage mfs_test_001_006
  * - @subpage mfs_test_001_007
+ * - @subpage mfs_test_001_008
  * .
  */
 
@@ -411,7 +412,7 @@ static void mfs_test_001_005_execute(void) {
   test_set_step(1);
   {
     mfs_id_t id;
-    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) +
+    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) + MFS_INDEX_SPACE +
                                             sizeof (mfs_data_header_t))) /
                       (sizeof (mfs_data_header_t) + sizeof mfs_pattern512);
 
@@ -438,7 +439,7 @@ static void mfs_test_001_005_execute(void) {
   test_set_step(2);
   {
     mfs_error_t err;
-    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) +
+    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) + MFS_INDEX_SPACE +
                                             sizeof (mfs_data_header_t))) /
                       (sizeof (mfs_data_header_t) + sizeof mfs_pattern512);
 
@@ -534,7 +535,7 @@ static void mfs_test_001_006_execute(void) {
   test_set_step(1);
   {
     mfs_id_t id;
-    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) +
+    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) + MFS_INDEX_SPACE +
                                             sizeof (mfs_data_header_t))) /
                       (sizeof (mfs_data_header_t) + sizeof mfs_pattern512);
 
@@ -598,7 +599,7 @@ static void mfs_test_001_006_execute(void) {
   test_set_step(4);
   {
     mfs_id_t id;
-    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) +
+    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) + MFS_INDEX_SPACE +
                                             sizeof (mfs_data_header_t))) /
                       (sizeof (mfs_data_header_t) + sizeof mfs_pattern512);
 
@@ -665,7 +666,7 @@ static void mfs_test_001_006_execute(void) {
   test_set_step(7);
   {
     mfs_id_t id;
-    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) +
+    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) + MFS_INDEX_SPACE +
                                             sizeof (mfs_data_header_t))) /
                       (sizeof (mfs_data_header_t) + sizeof mfs_pattern512);
 
@@ -731,7 +732,7 @@ static void mfs_test_001_007_execute(void) {
   test_set_step(1);
   {
     mfs_id_t id;
-    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) +
+    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) + MFS_INDEX_SPACE +
                                             sizeof (mfs_data_header_t))) /
                       (sizeof (mfs_data_header_t) + (sizeof mfs_pattern512 / 4));
 
@@ -757,10 +758,10 @@ static void mfs_test_001_007_execute(void) {
     mfs_error_t err;
     size_t size;
     mfs_id_t id;
-    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) +
+    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) + MFS_INDEX_SPACE +
                                             sizeof (mfs_data_header_t))) /
                       (sizeof (mfs_data_header_t) + (sizeof mfs_pattern512 / 4));
-    mfs_id_t n = ((mfscfg1.bank_size - sizeof (mfs_bank_header_t)) -
+    mfs_id_t n = ((mfscfg1.bank_size - (sizeof (mfs_bank_header_t) + MFS_INDEX_SPACE)) -
                   (id_max * (sizeof (mfs_data_header_t) + (sizeof mfs_pattern512 / 4)))) /
                  sizeof (mfs_data_header_t);
 
@@ -781,7 +782,7 @@ static void mfs_test_001_007_execute(void) {
   {
     mfs_error_t err;
     size_t size;
-    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) +
+    mfs_id_t id_max = (mfscfg1.bank_size - (sizeof (mfs_bank_header_t) + MFS_INDEX_SPACE +
                                             sizeof (mfs_data_header_t))) /
                       (sizeof (mfs_data_header_t) + (sizeof mfs_pattern512 / 4));
 
@@ -805,6 +806,167 @@ static const testcase_t mfs_test_001_007 = {
   mfs_test_001_007_execute
 };
 
+#if (MFS_CFG_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page mfs_test_001_008 [1.8] Testing incremental garbage collection
+ *
+ * <h2>Description</h2>
+ * The garbage collection is performed in steps, records modified while
+ * the collection is copying data and a mount while the old bank erase
+ * is pending are tested.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - MFS_CFG_INCREMENTAL_GC == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [1.8.1] Writing all records with a small size, MFS_NO_ERROR is
+ *   expected.
+ * - [1.8.2] Rewriting the first record and performing a step after each
+ *   write, the step starts a collection only when the obsolete data
+ *   exceeds the free space, MFS_WARN_GC is then expected.
+ * - [1.8.3] Writing a record already copied, the copy is completed,
+ *   MFS_WARN_GC is expected and the old bank erase is left pending.
+ * - [1.8.4] Mounting again with the erase pending, MFS_NO_ERROR is
+ *   expected and the erase is still pending.
+ * - [1.8.5] Performing steps until the collection is complete, one step
+ *   for each sector of the old bank is expected.
+ * - [1.8.6] Checking all records content, MFS_NO_ERROR is expected for
+ *   each record.
+ * .
+ */
+
+static void mfs_test_001_008_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_001_008_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_001_008_execute(void) {
+
+  /* [1.8.1] Writing all records with a small size, MFS_NO_ERROR is
+     expected.*/
+  test_set_step(1);
+  {
+    mfs_id_t id;
+
+    for (id = 1; id <= MFS_CFG_MAX_RECORDS; id++) {
+      mfs_error_t err;
+
+      err = mfsWriteRecord(&mfs1, id, sizeof mfs_pattern16, mfs_pattern16);
+      test_assert(err == MFS_NO_ERROR, "error creating the record");
+    }
+  }
+  test_end_step(1);
+
+  /* [1.8.2] Rewriting the first record and performing a step after each
+     write, the step starts a collection only when the obsolete data
+     exceeds the free space, MFS_WARN_GC is then expected.*/
+  test_set_step(2);
+  {
+    mfs_error_t err;
+    unsigned n = 0;
+
+    do {
+      err = mfsWriteRecord(&mfs1, 1, sizeof mfs_pattern512, mfs_pattern512);
+      test_assert(err == MFS_NO_ERROR, "error creating the record");
+      err = mfsPerformGarbageCollectionStep(&mfs1);
+      test_assert(!MFS_IS_ERROR(err), "step failed");
+      n++;
+    } while (err == MFS_NO_ERROR);
+    test_assert(n > 1, "collection started too early");
+    test_assert(mfs1.gc_state == MFS_GC_COPY, "not copying");
+    test_assert(mfs1.current_counter == 1, "not first instance");
+  }
+  test_end_step(2);
+
+  /* [1.8.3] Writing a record already copied, the copy is completed,
+     MFS_WARN_GC is expected and the old bank erase is left pending.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+
+    err = mfsWriteRecord(&mfs1, 1, sizeof mfs_pattern32, mfs_pattern32);
+    test_assert(err == MFS_WARN_GC, "copy not completed");
+    test_assert(mfs1.current_counter == 2, "not second instance");
+    test_assert(mfs1.current_bank == MFS_BANK_1, "unexpected bank");
+    test_assert(mfs1.gc_state == MFS_GC_ERASE, "not erasing");
+  }
+  test_end_step(3);
+
+  /* [1.8.4] Mounting again with the erase pending, MFS_NO_ERROR is
+     expected and the erase is still pending.*/
+  test_set_step(4);
+  {
+    mfs_error_t err;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "initialization error");
+    test_assert(mfs1.current_bank == MFS_BANK_1, "unexpected bank");
+    test_assert(mfs1.gc_state == MFS_GC_ERASE, "not erasing");
+  }
+  test_end_step(4);
+
+  /* [1.8.5] Performing steps until the collection is complete, one step
+     for each sector of the old bank is expected.*/
+  test_set_step(5);
+  {
+    mfs_error_t err;
+    flash_sector_t n = 0;
+
+    do {
+      err = mfsPerformGarbageCollectionStep(&mfs1);
+      test_assert(!MFS_IS_ERROR(err), "step failed");
+      n++;
+    } while (err == MFS_WARN_GC);
+    test_assert(n == mfscfg1.bank0_sectors, "unexpected number of steps");
+    test_assert(mfs1.gc_state == MFS_GC_IDLE, "not idle");
+    test_assert(bank_verify_erased(MFS_BANK_0) == FLASH_NO_ERROR, "bank 0 not erased");
+  }
+  test_end_step(5);
+
+  /* [1.8.6] Checking all records content, MFS_NO_ERROR is expected for
+     each record.*/
+  test_set_step(6);
+  {
+    mfs_id_t id;
+
+    for (id = 1; id <= MFS_CFG_MAX_RECORDS; id++) {
+      mfs_error_t err;
+      size_t size;
+
+      size = sizeof __nocache_mfs_buffer;
+      err = mfsReadRecord(&mfs1, id, &size, __nocache_mfs_buffer);
+      test_assert(err == MFS_NO_ERROR, "record not found");
+      if (id == 1) {
+        test_assert(size == sizeof mfs_pattern32, "unexpected record length");
+        test_assert(memcmp(mfs_pattern32, __nocache_mfs_buffer, size) == 0,
+                    "wrong record content");
+      }
+      else {
+        test_assert(size == sizeof mfs_pattern16, "unexpected record length");
+        test_assert(memcmp(mfs_pattern16, __nocache_mfs_buffer, size) == 0,
+                    "wrong record content");
+      }
+    }
+  }
+  test_end_step(6);
+}
+
+static const testcase_t mfs_test_001_008 = {
+  "Testing incremental garbage collection",
+  mfs_test_001_008_setup,
+  mfs_test_001_008_teardown,
+  mfs_test_001_008_execute
+};
+#endif /* MFS_CFG_INCREMENTAL_GC == TRUE */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -820,6 +982,9 @@ const testcase_t * const mfs_test_sequence_001_array[] = {
   &mfs_test_001_005,
   &mfs_test_001_006,
   &mfs_test_001_007,
+#if (MFS_CFG_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+  &mfs_test_001_008,
+#endif
   NULL
 };
 
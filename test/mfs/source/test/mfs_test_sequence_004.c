@@ -0,0 +1,189 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "mfs_test_root.h"
+
+/**
+ * @file    mfs_test_sequence_004.c
+ * @brief   Test Sequence 004 code.
+ *
+ * @page mfs_test_sequence_004 [4] Benchmarks.
+ *
+ * File: @ref mfs_test_sequence_004.c
+ *
+ * <h2>Description</h2>
+ * Performance measurements of the MFS operations on the target flash,
+ * results are printed on the output log.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage mfs_test_004_001
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include "hal_mfs.h"
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page mfs_test_004_001 [4.1] MFS throughput
+ *
+ * <h2>Description</h2>
+ * Records are written, read and compacted for one second each, the
+ * throughput of each operation is printed on the output log.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.1.1] Writing a 512 bytes record for one second, garbage
+ *   collection is triggered when required, the write throughput is
+ *   printed.
+ * - [4.1.2] Reading the 512 bytes record for one second, the read
+ *   throughput is printed.
+ * - [4.1.3] Writing three more records then performing garbage
+ *   collection for one second, the amount of copied data per second is
+ *   printed.
+ * .
+ */
+
+static void mfs_test_004_001_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_004_001_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_004_001_execute(void) {
+  systime_t start, end;
+  uint32_t n;
+
+  /* [4.1.1] Writing a 512 bytes record for one second, garbage
+     collection is triggered when required, the write throughput is
+     printed.*/
+  test_set_step(1);
+  {
+    n = 0U;
+    osalThreadSleep(1);
+    start = osalOsGetSystemTimeX();
+    end = osalTimeAddX(start, OSAL_MS2I(1000));
+    do {
+      mfs_error_t err;
+
+      err = mfsWriteRecord(&mfs1, 1, sizeof mfs_pattern512, mfs_pattern512);
+      test_assert(!MFS_IS_ERROR(err), "error writing the record");
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    test_print("--- Write : ");
+    test_printn((n * sizeof mfs_pattern512) / 1024U);
+    test_println(" kB/S");
+  }
+  test_end_step(1);
+
+  /* [4.1.2] Reading the 512 bytes record for one second, the read
+     throughput is printed.*/
+  test_set_step(2);
+  {
+    n = 0U;
+    osalThreadSleep(1);
+    start = osalOsGetSystemTimeX();
+    end = osalTimeAddX(start, OSAL_MS2I(1000));
+    do {
+      mfs_error_t err;
+      size_t size = sizeof __nocache_mfs_buffer;
+
+      err = mfsReadRecord(&mfs1, 1, &size, __nocache_mfs_buffer);
+      test_assert(err == MFS_NO_ERROR, "error reading the record");
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    test_print("--- Read  : ");
+    test_printn((n * sizeof mfs_pattern512) / 1024U);
+    test_println(" kB/S");
+  }
+  test_end_step(2);
+
+  /* [4.1.3] Writing three more records then performing garbage
+     collection for one second, the amount of copied data per second is
+     printed.*/
+  test_set_step(3);
+  {
+    mfs_id_t id;
+
+    for (id = 2; id <= 4; id++) {
+      mfs_error_t err;
+
+      err = mfsWriteRecord(&mfs1, id, sizeof mfs_pattern512, mfs_pattern512);
+      test_assert(!MFS_IS_ERROR(err), "error writing the record");
+    }
+
+    n = 0U;
+    osalThreadSleep(1);
+    start = osalOsGetSystemTimeX();
+    end = osalTimeAddX(start, OSAL_MS2I(1000));
+    do {
+      mfs_error_t err;
+
+      err = mfsPerformGarbageCollection(&mfs1);
+      test_assert(err == MFS_NO_ERROR, "garbage collection failed");
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+    test_print("--- GC    : ");
+    test_printn((n * 4U * sizeof mfs_pattern512) / 1024U);
+    test_println(" kB/S");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t mfs_test_004_001 = {
+  "MFS throughput",
+  mfs_test_004_001_setup,
+  mfs_test_004_001_teardown,
+  mfs_test_004_001_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const mfs_test_sequence_004_array[] = {
+  &mfs_test_004_001,
+  NULL
+};
+
+/**
+ * @brief   Benchmarks.
+ */
+const testsequence_t mfs_test_sequence_004 = {
+  "Benchmarks.",
+  mfs_test_sequence_004_array
+};
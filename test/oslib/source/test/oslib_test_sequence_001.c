@@ -180,6 +180,9 @@ static void oslib_test_001_003_execute(void) {
     test_print("--- CH_CFG_USE_PIPES:                   ");
     test_printn(CH_CFG_USE_PIPES);
     test_println("");
+    test_print("--- CH_CFG_USE_RINGS:                   ");
+    test_printn(CH_CFG_USE_RINGS);
+    test_println("");
     test_print("--- CH_CFG_USE_OBJ_CACHES:              ");
     test_printn(CH_CFG_USE_OBJ_CACHES);
     test_println("");
@@ -210,6 +213,9 @@ static void oslib_test_001_003_execute(void) {
     test_print("--- CH_CFG_FACTORY_PIPES:               ");
     test_printn(CH_CFG_FACTORY_PIPES);
     test_println("");
+    test_print("--- CH_CFG_FACTORY_HASH_SIZE:           ");
+    test_printn(CH_CFG_FACTORY_HASH_SIZE);
+    test_println("");
   }
   test_end_step(1);
 }
@@ -39,6 +39,9 @@
  * - @subpage oslib_test_002_001
  * - @subpage oslib_test_002_002
  * - @subpage oslib_test_002_003
+ * - @subpage oslib_test_002_004
+ * - @subpage oslib_test_002_005
+ * - @subpage oslib_test_002_006
  * .
  */
 
@@ -53,6 +56,87 @@
 static msg_t mb_buffer[MB_SIZE];
 static MAILBOX_DECL(mb1, mb_buffer, MB_SIZE);
 
+#define MB_BENCH_SIZE 32
+#define MB_BENCH_BATCH 16
+
+static msg_t mb_bench_buffer[MB_BENCH_SIZE];
+static msg_t mb_bench_msgs[MB_BENCH_BATCH];
+static MAILBOX_DECL(mb2, mb_bench_buffer, MB_BENCH_SIZE);
+
+static THD_WORKING_AREA(waMBThread, 256);
+static THD_FUNCTION(MBSingleThread, arg) {
+  msg_t msg;
+
+  (void)arg;
+
+  while (chMBFetchTimeout(&mb2, &msg, TIME_INFINITE) == MSG_OK) {
+  }
+}
+
+static THD_FUNCTION(MBBatchThread, arg) {
+  msg_t msgs[MB_BENCH_BATCH];
+  size_t n;
+
+  (void)arg;
+
+  while (chMBFetchBatchTimeout(&mb2, msgs, MB_BENCH_BATCH,
+                               &n, TIME_INFINITE) == MSG_OK) {
+  }
+}
+
+static uint32_t mb_loop(tfunc_t funcp) {
+  systime_t start, end;
+  thread_t *tp;
+  uint32_t n = 0U;
+  size_t i, posted;
+
+  thread_descriptor_t td = {
+    .name  = "consumer",
+    .wbase = waMBThread,
+    .wend  = THD_WORKING_AREA_END(waMBThread),
+    .prio  = chThdGetPriorityX() - 1,
+    .funcp = funcp,
+    .arg   = NULL
+  };
+
+  chMBObjectInit(&mb2, mb_bench_buffer, MB_BENCH_SIZE);
+  tp = chThdCreate(&td);
+
+  chThdSleep((sysinterval_t)1);
+  start = chVTGetSystemTimeX();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    if (funcp == MBSingleThread) {
+      for (i = 0U; i < MB_BENCH_BATCH; i++) {
+        (void)chMBPostTimeout(&mb2, mb_bench_msgs[i], TIME_INFINITE);
+      }
+    }
+    else {
+      for (i = 0U; i < MB_BENCH_BATCH; i += posted) {
+        (void)chMBPostBatchTimeout(&mb2, &mb_bench_msgs[i],
+                                   MB_BENCH_BATCH - i, &posted,
+                                   TIME_INFINITE);
+      }
+    }
+    n += MB_BENCH_BATCH;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  /* The consumer exits on reset.*/
+  chMBReset(&mb2);
+  (void)chThdWait(tp);
+
+  return n;
+}
+
+#if CH_CFG_USE_OBJ_FIFOS == TRUE
+static void *fifo_objects[MB_SIZE];
+static msg_t fifo_msgs[MB_SIZE];
+static objects_fifo_t fifo1;
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -410,6 +494,275 @@ static const testcase_t oslib_test_002_003 = {
   oslib_test_002_003_execute
 };
 
+/**
+ * @page oslib_test_002_004 [2.4] Mailbox batch API
+ *
+ * <h2>Description</h2>
+ * The mailbox batch API is tested, messages are posted and fetched in
+ * groups without triggering blocking conditions.
+ *
+ * <h2>Test Steps</h2>
+ * - [2.4.1] Posting more messages than the free slots, the mailbox must
+ *   be filled and the number of posted messages returned.
+ * - [2.4.2] Posting into a full mailbox, a timeout is expected.
+ * - [2.4.3] Fetching part of the messages then posting again, the
+ *   buffer pointers wrap around.
+ * - [2.4.4] Fetching all messages in a single operation, the order must
+ *   be preserved.
+ * - [2.4.5] Fetching from an empty mailbox, a timeout is expected.
+ * - [2.4.6] Testing the behavior of the batch API when the mailbox is
+ *   in reset state then return in active state.
+ * .
+ */
+
+static void oslib_test_002_004_setup(void) {
+  chMBObjectInit(&mb1, mb_buffer, MB_SIZE);
+}
+
+static void oslib_test_002_004_execute(void) {
+  msg_t msg1;
+  size_t n;
+  unsigned i;
+  msg_t msgs[MB_SIZE * 2];
+  msg_t out[MB_SIZE * 2];
+
+  /* [2.4.1] Posting more messages than the free slots, the mailbox must
+     be filled and the number of posted messages returned.*/
+  test_set_step(1);
+  {
+    for (i = 0U; i < MB_SIZE * 2U; i++) {
+      msgs[i] = (msg_t)('A' + i);
+    }
+    msg1 = chMBPostBatchTimeout(&mb1, msgs, MB_SIZE * 2U, &n, TIME_INFINITE);
+    test_assert(msg1 == MSG_OK, "wrong wake-up message");
+    test_assert(n == MB_SIZE, "wrong number of posted messages");
+
+    chSysLock();
+    test_assert(chMBGetFreeCountI(&mb1) == 0U, "still empty");
+    chSysUnlock();
+  }
+  test_end_step(1);
+
+  /* [2.4.2] Posting into a full mailbox, a timeout is expected.*/
+  test_set_step(2);
+  {
+    msg1 = chMBPostBatchTimeout(&mb1, msgs, 1U, &n, TIME_IMMEDIATE);
+    test_assert(msg1 == MSG_TIMEOUT, "wrong wake-up message");
+    test_assert(n == 0U, "messages posted");
+
+    chSysLock();
+    msg1 = chMBPostBatchI(&mb1, msgs, 1U, &n);
+    chSysUnlock();
+    test_assert(msg1 == MSG_TIMEOUT, "wrong wake-up message");
+    test_assert(n == 0U, "messages posted");
+  }
+  test_end_step(2);
+
+  /* [2.4.3] Fetching part of the messages then posting again, the
+     buffer pointers wrap around.*/
+  test_set_step(3);
+  {
+    msg1 = chMBFetchBatchTimeout(&mb1, out, 2U, &n, TIME_INFINITE);
+    test_assert(msg1 == MSG_OK, "wrong wake-up message");
+    test_assert(n == 2U, "wrong number of fetched messages");
+    test_assert((out[0] == 'A') && (out[1] == 'B'), "wrong messages");
+
+    chSysLock();
+    msg1 = chMBPostBatchI(&mb1, &msgs[MB_SIZE], MB_SIZE, &n);
+    chSysUnlock();
+    test_assert(msg1 == MSG_OK, "wrong wake-up message");
+    test_assert(n == 2U, "wrong number of posted messages");
+  }
+  test_end_step(3);
+
+  /* [2.4.4] Fetching all messages in a single operation, the order must
+     be preserved.*/
+  test_set_step(4);
+  {
+    chSysLock();
+    msg1 = chMBFetchBatchI(&mb1, out, MB_SIZE * 2U, &n);
+    chSysUnlock();
+    test_assert(msg1 == MSG_OK, "wrong wake-up message");
+    test_assert(n == MB_SIZE, "wrong number of fetched messages");
+    for (i = 0U; i < n; i++) {
+      test_emit_token((char)out[i]);
+    }
+    test_assert_sequence("CDEF", "wrong get sequence");
+  }
+  test_end_step(4);
+
+  /* [2.4.5] Fetching from an empty mailbox, a timeout is expected.*/
+  test_set_step(5);
+  {
+    msg1 = chMBFetchBatchTimeout(&mb1, out, MB_SIZE, &n, TIME_IMMEDIATE);
+    test_assert(msg1 == MSG_TIMEOUT, "wrong wake-up message");
+    test_assert(n == 0U, "messages fetched");
+
+    chSysLock();
+    msg1 = chMBFetchBatchI(&mb1, out, MB_SIZE, &n);
+    chSysUnlock();
+    test_assert(msg1 == MSG_TIMEOUT, "wrong wake-up message");
+    test_assert(n == 0U, "messages fetched");
+  }
+  test_end_step(5);
+
+  /* [2.4.6] Testing the behavior of the batch API when the mailbox is
+     in reset state then return in active state.*/
+  test_set_step(6);
+  {
+    chMBReset(&mb1);
+    msg1 = chMBPostBatchTimeout(&mb1, msgs, MB_SIZE, &n, TIME_INFINITE);
+    test_assert(msg1 == MSG_RESET, "not in reset state");
+    msg1 = chMBFetchBatchTimeout(&mb1, out, MB_SIZE, &n, TIME_INFINITE);
+    test_assert(msg1 == MSG_RESET, "not in reset state");
+    chMBResumeX(&mb1);
+    msg1 = chMBPostBatchTimeout(&mb1, msgs, MB_SIZE, &n, TIME_INFINITE);
+    test_assert((msg1 == MSG_OK) && (n == MB_SIZE), "post failed");
+    chMBReset(&mb1);
+    chMBResumeX(&mb1);
+  }
+  test_end_step(6);
+}
+
+static const testcase_t oslib_test_002_004 = {
+  "Mailbox batch API",
+  oslib_test_002_004_setup,
+  NULL,
+  oslib_test_002_004_execute
+};
+
+#if (CH_CFG_USE_OBJ_FIFOS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_002_005 [2.5] Objects FIFO batch API
+ *
+ * <h2>Description</h2>
+ * The objects FIFO batch API is tested, objects are sent and received
+ * in groups.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_OBJ_FIFOS == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [2.5.1] Taking all the objects then sending them in a single
+ *   operation.
+ * - [2.5.2] Receiving all the objects in a single operation, the order
+ *   must be preserved.
+ * - [2.5.3] Receiving from an empty FIFO, a timeout is expected.
+ * .
+ */
+
+static void oslib_test_002_005_setup(void) {
+  chFifoObjectInit(&fifo1, sizeof (void *), MB_SIZE, fifo_objects,
+                   fifo_msgs);
+}
+
+static void oslib_test_002_005_execute(void) {
+  msg_t msg1;
+  size_t n;
+  unsigned i;
+  void *objs[MB_SIZE];
+  void *rcv[MB_SIZE];
+
+  /* [2.5.1] Taking all the objects then sending them in a single
+     operation.*/
+  test_set_step(1);
+  {
+    for (i = 0U; i < MB_SIZE; i++) {
+      objs[i] = chFifoTakeObjectTimeout(&fifo1, TIME_IMMEDIATE);
+      test_assert(objs[i] != NULL, "object not available");
+    }
+    chFifoSendObjectBatch(&fifo1, objs, MB_SIZE);
+  }
+  test_end_step(1);
+
+  /* [2.5.2] Receiving all the objects in a single operation, the order
+     must be preserved.*/
+  test_set_step(2);
+  {
+    msg1 = chFifoReceiveObjectBatchTimeout(&fifo1, rcv, MB_SIZE, &n,
+                                           TIME_IMMEDIATE);
+    test_assert(msg1 == MSG_OK, "wrong wake-up message");
+    test_assert(n == MB_SIZE, "wrong number of received objects");
+    for (i = 0U; i < MB_SIZE; i++) {
+      test_assert(rcv[i] == objs[i], "wrong object");
+      chFifoReturnObject(&fifo1, rcv[i]);
+    }
+  }
+  test_end_step(2);
+
+  /* [2.5.3] Receiving from an empty FIFO, a timeout is expected.*/
+  test_set_step(3);
+  {
+    msg1 = chFifoReceiveObjectBatchTimeout(&fifo1, rcv, MB_SIZE, &n,
+                                           TIME_IMMEDIATE);
+    test_assert(msg1 == MSG_TIMEOUT, "wrong wake-up message");
+    test_assert(n == 0U, "objects received");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t oslib_test_002_005 = {
+  "Objects FIFO batch API",
+  oslib_test_002_005_setup,
+  NULL,
+  oslib_test_002_005_execute
+};
+#endif /* CH_CFG_USE_OBJ_FIFOS == TRUE */
+
+/**
+ * @page oslib_test_002_006 [2.6] Mailbox throughput
+ *
+ * <h2>Description</h2>
+ * A consumer thread is created with a lower priority than the producer,
+ * messages are posted in groups then fetched, first one at time then
+ * using the batch API. The number of messages transferred in a one
+ * second time window is measured and the results printed on the output
+ * log.
+ *
+ * <h2>Test Steps</h2>
+ * - [2.6.1] Messages are transferred using chMBPostTimeout() and
+ *   chMBFetchTimeout(), the score is printed.
+ * - [2.6.2] Messages are transferred using chMBPostBatchTimeout() and
+ *   chMBFetchBatchTimeout(), the score is printed.
+ * .
+ */
+
+static void oslib_test_002_006_execute(void) {
+  uint32_t n;
+
+  /* [2.6.1] Messages are transferred using chMBPostTimeout() and
+     chMBFetchTimeout(), the score is printed.*/
+  test_set_step(1);
+  {
+    n = mb_loop(MBSingleThread);
+    test_print("--- Single post : ");
+    test_printn(n);
+    test_println(" msgs/S");
+  }
+  test_end_step(1);
+
+  /* [2.6.2] Messages are transferred using chMBPostBatchTimeout() and
+     chMBFetchBatchTimeout(), the score is printed.*/
+  test_set_step(2);
+  {
+    n = mb_loop(MBBatchThread);
+    test_print("--- Batch post  : ");
+    test_printn(n);
+    test_println(" msgs/S");
+  }
+  test_end_step(2);
+}
+
+static const testcase_t oslib_test_002_006 = {
+  "Mailbox throughput",
+  NULL,
+  NULL,
+  oslib_test_002_006_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -421,6 +774,11 @@ const testcase_t * const oslib_test_sequence_002_array[] = {
   &oslib_test_002_001,
   &oslib_test_002_002,
   &oslib_test_002_003,
+  &oslib_test_002_004,
+#if (CH_CFG_USE_OBJ_FIFOS == TRUE) || defined(__DOXYGEN__)
+  &oslib_test_002_005,
+#endif
+  &oslib_test_002_006,
   NULL
 };
 
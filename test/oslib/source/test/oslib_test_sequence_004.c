@@ -37,6 +37,8 @@
  *
  * <h2>Test Cases</h2>
  * - @subpage oslib_test_004_001
+ * - @subpage oslib_test_004_002
+ * - @subpage oslib_test_004_003
  * .
  */
 
@@ -54,7 +56,7 @@ static msg_t msg_queue[JOBS_QUEUE_SIZE];
 
 static void job_slow(void *arg) {
 
-  test_emit_token((int)arg);
+  test_emit_token((int)(uintptr_t)arg);
   chThdSleepMilliseconds(10);
 }
 
@@ -70,6 +72,171 @@ static THD_FUNCTION(Thread1, arg) {
   } while (msg == MSG_OK);
 }
 
+
+#if CH_CFG_USE_JOB_POOLS == TRUE
+#define JOB_POOL_WORKERS 2
+#define JOBS_BENCH_SIZE 16
+
+static job_pool_t jp;
+static job_worker_t workers[JOB_POOL_WORKERS];
+static pooled_job_t pjobs[JOBS_BENCH_SIZE];
+static job_group_t jg;
+static jobs_queue_t jqb;
+static job_descriptor_t jobs_bench[JOBS_BENCH_SIZE];
+static msg_t msg_bench[JOBS_BENCH_SIZE];
+
+static void job_fast(void *arg) {
+
+  (void)arg;
+}
+
+static void job_token(void *arg) {
+
+  test_emit_token((char)(uintptr_t)arg);
+}
+
+static void job_sleep(void *arg) {
+
+  (void)arg;
+  chThdSleepMilliseconds(50);
+}
+
+static void job_spawn(void *arg) {
+  unsigned i;
+
+  (void)arg;
+
+  for (i = 1U; i < 3U; i++) {
+    chPooledJobObjectInit(&pjobs[i], job_token, (void *)(uintptr_t)('a' + i - 1U));
+    chJobPoolSubmit(&jp, &pjobs[i], &jg);
+  }
+}
+
+static void job_spawn_sleep(void *arg) {
+  unsigned i;
+
+  (void)arg;
+
+  for (i = 1U; i < 3U; i++) {
+    chPooledJobObjectInit(&pjobs[i], job_token, (void *)(uintptr_t)('a' + i - 1U));
+  }
+  chJobPoolSubmitBatch(&jp, &pjobs[1], 2U, NULL);
+  chThdSleepMilliseconds(50);
+}
+
+static THD_FUNCTION(Thread2, arg) {
+  job_worker_t *wp = (job_worker_t *)arg;
+
+  while (chJobPoolDispatch(&jp, wp) == MSG_OK) {
+  }
+}
+
+static THD_FUNCTION(Thread3, arg) {
+  jobs_queue_t *jqp = (jobs_queue_t *)arg;
+
+  while (chJobDispatch(jqp) == MSG_OK) {
+  }
+}
+
+static thread_t *jobs_start(stkalign_t *wbase, stkalign_t *wend,
+                            tfunc_t funcp, void *arg) {
+
+  thread_descriptor_t td = {
+    .name  = "worker",
+    .wbase = wbase,
+    .wend  = wend,
+    .prio  = chThdGetPriorityX() - 1,
+    .funcp = funcp,
+    .arg   = arg
+  };
+
+  return chThdCreate(&td);
+}
+
+static uint32_t jobs_queue_loop(void) {
+  systime_t start, end;
+  thread_t *tp1, *tp2;
+  job_descriptor_t *jdp;
+  uint32_t n = 0U;
+  unsigned i;
+
+  chJobObjectInit(&jqb, JOBS_BENCH_SIZE, jobs_bench, msg_bench);
+  tp1 = jobs_start(wa1Thread1, THD_WORKING_AREA_END(wa1Thread1),
+                   Thread3, &jqb);
+  tp2 = jobs_start(wa2Thread1, THD_WORKING_AREA_END(wa2Thread1),
+                   Thread3, &jqb);
+
+  chThdSleep((sysinterval_t)1);
+  start = chVTGetSystemTimeX();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    for (i = 0U; i < JOBS_BENCH_SIZE; i++) {
+      jdp = chJobGet(&jqb);
+      jdp->jobfunc = job_fast;
+      jdp->jobarg  = NULL;
+      chJobPost(&jqb, jdp);
+    }
+    n += JOBS_BENCH_SIZE;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  for (i = 0U; i < 2U; i++) {
+    jdp = chJobGet(&jqb);
+    jdp->jobfunc = NULL;
+    jdp->jobarg  = NULL;
+    chJobPost(&jqb, jdp);
+  }
+  (void) chThdWait(tp1);
+  (void) chThdWait(tp2);
+
+  return n;
+}
+
+static uint32_t job_pool_loop(bool batch) {
+  systime_t start, end;
+  thread_t *tp1, *tp2;
+  uint32_t n = 0U;
+  unsigned i;
+
+  chJobPoolObjectInit(&jp, workers, JOB_POOL_WORKERS);
+  chJobGroupObjectInit(&jg);
+  for (i = 0U; i < JOBS_BENCH_SIZE; i++) {
+    chPooledJobObjectInit(&pjobs[i], job_fast, NULL);
+  }
+  tp1 = jobs_start(wa1Thread1, THD_WORKING_AREA_END(wa1Thread1),
+                   Thread2, &workers[0]);
+  tp2 = jobs_start(wa2Thread1, THD_WORKING_AREA_END(wa2Thread1),
+                   Thread2, &workers[1]);
+
+  chThdSleep((sysinterval_t)1);
+  start = chVTGetSystemTimeX();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    if (batch) {
+      chJobPoolSubmitBatch(&jp, pjobs, JOBS_BENCH_SIZE, &jg);
+    }
+    else {
+      for (i = 0U; i < JOBS_BENCH_SIZE; i++) {
+        chJobPoolSubmit(&jp, &pjobs[i], &jg);
+      }
+    }
+    (void) chJobGroupJoin(&jg);
+    n += JOBS_BENCH_SIZE;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  chJobPoolStop(&jp);
+  (void) chThdWait(tp1);
+  (void) chThdWait(tp2);
+
+  return n;
+}
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -133,7 +300,7 @@ static void oslib_test_004_001_execute(void) {
     for (i = 0; i < 8; i++) {
       jdp = chJobGet(&jq);
       jdp->jobfunc = job_slow;
-      jdp->jobarg  = (void *)('a' + i);
+      jdp->jobarg  = (void *)(uintptr_t)('a' + i);
       chJobPost(&jq, jdp);
     }
   }
@@ -182,6 +349,204 @@ static const testcase_t oslib_test_004_001 = {
   oslib_test_004_001_execute
 };
 
+#if (CH_CFG_USE_JOB_POOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_004_002 [4.2] Job pool test
+ *
+ * <h2>Description</h2>
+ * The job pool API is tested for functionality, jobs submitted from
+ * outside the pool are executed in order, jobs submitted by a worker
+ * are executed newest first by the worker itself or stolen oldest first
+ * by the other worker.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_JOB_POOLS == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [4.2.1] Initializing the pool and starting the thread serving the
+ *   first worker.
+ * - [4.2.2] Submitting four jobs as a batch from outside the pool, the
+ *   jobs must be executed in submission order.
+ * - [4.2.3] Submitting a job which submits two jobs from the worker,
+ *   the jobs in the worker own deque must be executed newest first.
+ * - [4.2.4] Starting the thread serving the second worker then
+ *   submitting a job which submits two jobs and sleeps, the jobs must
+ *   be stolen oldest first.
+ * - [4.2.5] Submitting a slow job, joining with a short timeout must
+ *   fail then joining without timeout must succeed.
+ * - [4.2.6] Stopping the pool, the worker threads must exit.
+ * .
+ */
+
+static void oslib_test_004_002_execute(void) {
+  thread_t *tp1, *tp2;
+  unsigned i;
+  msg_t msg;
+
+  /* [4.2.1] Initializing the pool and starting the thread serving the
+     first worker.*/
+  test_set_step(1);
+  {
+    chJobPoolObjectInit(&jp, workers, JOB_POOL_WORKERS);
+    chJobGroupObjectInit(&jg);
+    tp1 = jobs_start(wa1Thread1, THD_WORKING_AREA_END(wa1Thread1),
+                     Thread2, &workers[0]);
+  }
+  test_end_step(1);
+
+  /* [4.2.2] Submitting four jobs as a batch from outside the pool, the
+     jobs must be executed in submission order.*/
+  test_set_step(2);
+  {
+    for (i = 0U; i < 4U; i++) {
+      chPooledJobObjectInit(&pjobs[i], job_token, (void *)(uintptr_t)('a' + i));
+    }
+    chJobPoolSubmitBatch(&jp, pjobs, 4U, &jg);
+    test_assert(chJobGroupGetPendingX(&jg) == (cnt_t)4, "wrong pending count");
+    msg = chJobGroupJoin(&jg);
+    test_assert(msg == MSG_OK, "join failed");
+    test_assert(chJobGroupGetPendingX(&jg) == (cnt_t)0, "jobs pending");
+    test_assert_sequence("abcd", "unexpected tokens");
+  }
+  test_end_step(2);
+
+  /* [4.2.3] Submitting a job which submits two jobs from the worker,
+     the jobs in the worker own deque must be executed newest first.*/
+  test_set_step(3);
+  {
+    chPooledJobObjectInit(&pjobs[0], job_spawn, NULL);
+    chJobPoolSubmit(&jp, &pjobs[0], &jg);
+    msg = chJobGroupJoin(&jg);
+    test_assert(msg == MSG_OK, "join failed");
+    test_assert(chJobGroupGetPendingX(&jg) == (cnt_t)0, "jobs pending");
+    test_assert_sequence("ba", "unexpected tokens");
+    test_assert(workers[0].stolen == 0U, "wrong stolen count");
+  }
+  test_end_step(3);
+
+  /* [4.2.4] Starting the thread serving the second worker then
+     submitting a job which submits two jobs and sleeps, the jobs must
+     be stolen oldest first.*/
+  test_set_step(4);
+  {
+    tp2 = jobs_start(wa2Thread1, THD_WORKING_AREA_END(wa2Thread1),
+                     Thread2, &workers[1]);
+    chPooledJobObjectInit(&pjobs[0], job_spawn_sleep, NULL);
+    chJobPoolSubmit(&jp, &pjobs[0], &jg);
+    msg = chJobGroupJoin(&jg);
+    test_assert(msg == MSG_OK, "join failed");
+    test_assert_sequence("ab", "unexpected tokens");
+    test_assert(workers[0].stolen + workers[1].stolen == 2U,
+                "wrong stolen count");
+  }
+  test_end_step(4);
+
+  /* [4.2.5] Submitting a slow job, joining with a short timeout must
+     fail then joining without timeout must succeed.*/
+  test_set_step(5);
+  {
+    chPooledJobObjectInit(&pjobs[0], job_sleep, NULL);
+    chJobPoolSubmit(&jp, &pjobs[0], &jg);
+    msg = chJobGroupJoinTimeout(&jg, TIME_MS2I(10));
+    test_assert(msg == MSG_TIMEOUT, "not timed out");
+    msg = chJobGroupJoin(&jg);
+    test_assert(msg == MSG_OK, "join failed");
+  }
+  test_end_step(5);
+
+  /* [4.2.6] Stopping the pool, the worker threads must exit.*/
+  test_set_step(6);
+  {
+    chJobPoolStop(&jp);
+    (void) chThdWait(tp1);
+    (void) chThdWait(tp2);
+  }
+  test_end_step(6);
+}
+
+static const testcase_t oslib_test_004_002 = {
+  "Job pool test",
+  NULL,
+  NULL,
+  oslib_test_004_002_execute
+};
+#endif /* CH_CFG_USE_JOB_POOLS == TRUE */
+
+#if (CH_CFG_USE_JOB_POOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_004_003 [4.3] Jobs throughput
+ *
+ * <h2>Description</h2>
+ * Two lower priority threads execute empty jobs, first using a jobs
+ * queue then using a job pool. Jobs are submitted one at time to both,
+ * then in batches to the job pool. The number of jobs executed in a one
+ * second time window is measured and the results printed on the output
+ * log.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_JOB_POOLS == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [4.3.1] Jobs are posted one at time to a jobs queue, the score is
+ *   printed.
+ * - [4.3.2] Jobs are submitted one at time to a job pool then joined,
+ *   the score is printed.
+ * - [4.3.3] Jobs are submitted in batches to a job pool then joined,
+ *   the score is printed.
+ * .
+ */
+
+static void oslib_test_004_003_execute(void) {
+  uint32_t n;
+
+  /* [4.3.1] Jobs are posted one at time to a jobs queue, the score is
+     printed.*/
+  test_set_step(1);
+  {
+    n = jobs_queue_loop();
+    test_print("--- Queue      : ");
+    test_printn(n);
+    test_println(" jobs/S");
+  }
+  test_end_step(1);
+
+  /* [4.3.2] Jobs are submitted one at time to a job pool then joined,
+     the score is printed.*/
+  test_set_step(2);
+  {
+    n = job_pool_loop(false);
+    test_print("--- Pool       : ");
+    test_printn(n);
+    test_println(" jobs/S");
+  }
+  test_end_step(2);
+
+  /* [4.3.3] Jobs are submitted in batches to a job pool then joined,
+     the score is printed.*/
+  test_set_step(3);
+  {
+    n = job_pool_loop(true);
+    test_print("--- Pool batch : ");
+    test_printn(n);
+    test_println(" jobs/S");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t oslib_test_004_003 = {
+  "Jobs throughput",
+  NULL,
+  NULL,
+  oslib_test_004_003_execute
+};
+#endif /* CH_CFG_USE_JOB_POOLS == TRUE */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -191,6 +556,12 @@ static const testcase_t oslib_test_004_001 = {
  */
 const testcase_t * const oslib_test_sequence_004_array[] = {
   &oslib_test_004_001,
+#if (CH_CFG_USE_JOB_POOLS == TRUE) || defined(__DOXYGEN__)
+  &oslib_test_004_002,
+#endif
+#if (CH_CFG_USE_JOB_POOLS == TRUE) || defined(__DOXYGEN__)
+  &oslib_test_004_003,
+#endif
   NULL
 };
 
@@ -39,6 +39,8 @@
  * - @subpage oslib_test_007_001
  * - @subpage oslib_test_007_002
  * - @subpage oslib_test_007_003
+ * - @subpage oslib_test_007_004
+ * - @subpage oslib_test_007_005
  * .
  */
 
@@ -50,11 +52,11 @@
 
 #define MEMORY_POOL_SIZE 4
 
-static uint32_t objects[MEMORY_POOL_SIZE];
-static MEMORYPOOL_DECL(mp1, sizeof (uint32_t), PORT_NATURAL_ALIGN, NULL);
+static void *objects[MEMORY_POOL_SIZE];
+static MEMORYPOOL_DECL(mp1, sizeof (void *), PORT_NATURAL_ALIGN, NULL);
 
 #if CH_CFG_USE_SEMAPHORES
-static GUARDEDMEMORYPOOL_DECL(gmp1, sizeof (uint32_t), PORT_NATURAL_ALIGN);
+static GUARDEDMEMORYPOOL_DECL(gmp1, sizeof (void *), PORT_NATURAL_ALIGN);
 #endif
 
 static void *null_provider(size_t size, unsigned align) {
@@ -65,6 +67,54 @@ static void *null_provider(size_t size, unsigned align) {
   return NULL;
 }
 
+#define MAGAZINE_POOL_SIZE 32U
+#define MAGAZINE_BATCH 8U
+#define MAGAZINE_BURST 16U
+#define MAGAZINE_ROUNDS 16U
+
+static void *mag_objects[MAGAZINE_POOL_SIZE];
+static void *mag_ptrs[MAGAZINE_POOL_SIZE];
+static MEMORYPOOL_DECL(mp2, sizeof (void *), PORT_NATURAL_ALIGN, NULL);
+static memory_magazine_t mag1;
+
+static uint32_t pool_loop(memory_magazine_t *mgp) {
+  systime_t start, end;
+  uint32_t n = 0U;
+  unsigned i, j;
+
+  chThdSleep((sysinterval_t)1);
+  start = chVTGetSystemTimeX();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    /* Several bursts for each time check, the loop overhead would hide
+       the cost of the operations otherwise.*/
+    for (j = 0U; j < MAGAZINE_ROUNDS; j++) {
+      if (mgp == NULL) {
+        for (i = 0U; i < MAGAZINE_BURST; i++) {
+          mag_ptrs[i] = chPoolAlloc(&mp2);
+        }
+        for (i = 0U; i < MAGAZINE_BURST; i++) {
+          chPoolFree(&mp2, mag_ptrs[i]);
+        }
+      }
+      else {
+        for (i = 0U; i < MAGAZINE_BURST; i++) {
+          mag_ptrs[i] = chPoolMagazineAlloc(mgp);
+        }
+        for (i = 0U; i < MAGAZINE_BURST; i++) {
+          chPoolMagazineFree(mgp, mag_ptrs[i]);
+        }
+      }
+    }
+    n += MAGAZINE_BURST * MAGAZINE_ROUNDS;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  return n;
+}
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -89,7 +139,7 @@ static void *null_provider(size_t size, unsigned align) {
  */
 
 static void oslib_test_007_001_setup(void) {
-  chPoolObjectInit(&mp1, sizeof (uint32_t), NULL);
+  chPoolObjectInit(&mp1, sizeof (void *), NULL);
 }
 
 static void oslib_test_007_001_execute(void) {
@@ -144,7 +194,7 @@ static void oslib_test_007_001_execute(void) {
      more memory.*/
   test_set_step(7);
   {
-    chPoolObjectInit(&mp1, sizeof (uint32_t), null_provider);
+    chPoolObjectInit(&mp1, sizeof (void *), null_provider);
     test_assert(chPoolAlloc(&mp1) == NULL, "provider returned memory");
   }
   test_end_step(7);
@@ -183,7 +233,7 @@ static const testcase_t oslib_test_007_001 = {
  */
 
 static void oslib_test_007_002_setup(void) {
-  chGuardedPoolObjectInit(&gmp1, sizeof (uint32_t));
+  chGuardedPoolObjectInit(&gmp1, sizeof (void *));
 }
 
 static void oslib_test_007_002_execute(void) {
@@ -266,7 +316,7 @@ static const testcase_t oslib_test_007_002 = {
  */
 
 static void oslib_test_007_003_setup(void) {
-  chGuardedPoolObjectInit(&gmp1, sizeof (uint32_t));
+  chGuardedPoolObjectInit(&gmp1, sizeof (void *));
 }
 
 static void oslib_test_007_003_execute(void) {
@@ -288,6 +338,169 @@ static const testcase_t oslib_test_007_003 = {
 };
 #endif /* CH_CFG_USE_SEMAPHORES == TRUE */
 
+/**
+ * @page oslib_test_007_004 [7.4] Memory pool magazines
+ *
+ * <h2>Description</h2>
+ * The magazine functionality is tested by allocating and releasing all
+ * the pool objects through a magazine, the objects are expected to be
+ * moved between the pool and the magazine in batches.
+ *
+ * <h2>Test Steps</h2>
+ * - [7.4.1] Allocating and releasing an object, the magazine is
+ *   refilled with a whole batch.
+ * - [7.4.2] Emptying the pool through the magazine.
+ * - [7.4.3] Releasing all objects through the magazine, no more than
+ *   twice the batch size must remain cached.
+ * - [7.4.4] Flushing the magazine, all objects must be back into the
+ *   pool.
+ * .
+ */
+
+static void oslib_test_007_004_setup(void) {
+  chPoolObjectInit(&mp2, sizeof (void *), NULL);
+  chPoolLoadArray(&mp2, mag_objects, MAGAZINE_POOL_SIZE);
+  chPoolMagazineObjectInit(&mag1, &mp2, MAGAZINE_BATCH);
+}
+
+static void oslib_test_007_004_execute(void) {
+  unsigned i;
+
+  /* [7.4.1] Allocating and releasing an object, the magazine is
+     refilled with a whole batch.*/
+  test_set_step(1);
+  {
+    void *p;
+
+    p = chPoolMagazineAlloc(&mag1);
+    test_assert(p != NULL, "allocation failed");
+    test_assert(chPoolMagazineGetCountX(&mag1) == MAGAZINE_BATCH - 1U,
+                "batch not transferred");
+    chPoolMagazineFree(&mag1, p);
+    test_assert(chPoolMagazineGetCountX(&mag1) == MAGAZINE_BATCH,
+                "object not cached");
+  }
+  test_end_step(1);
+
+  /* [7.4.2] Emptying the pool through the magazine.*/
+  test_set_step(2);
+  {
+    for (i = 0U; i < MAGAZINE_POOL_SIZE; i++) {
+      mag_ptrs[i] = chPoolMagazineAlloc(&mag1);
+      test_assert(mag_ptrs[i] != NULL, "list empty");
+    }
+    test_assert(chPoolMagazineAlloc(&mag1) == NULL, "list not empty");
+    test_assert(chPoolMagazineGetCountX(&mag1) == 0U, "magazine not empty");
+  }
+  test_end_step(2);
+
+  /* [7.4.3] Releasing all objects through the magazine, no more than
+     twice the batch size must remain cached.*/
+  test_set_step(3);
+  {
+    for (i = 0U; i < MAGAZINE_POOL_SIZE; i++) {
+      chPoolMagazineFree(&mag1, mag_ptrs[i]);
+      test_assert(chPoolMagazineGetCountX(&mag1) <= MAGAZINE_BATCH * 2U,
+                  "magazine overflow");
+    }
+  }
+  test_end_step(3);
+
+  /* [7.4.4] Flushing the magazine, all objects must be back into the
+     pool.*/
+  test_set_step(4);
+  {
+    chPoolMagazineFlush(&mag1);
+    test_assert(chPoolMagazineGetCountX(&mag1) == 0U, "magazine not empty");
+    for (i = 0U; i < MAGAZINE_POOL_SIZE; i++) {
+      test_assert(chPoolAlloc(&mp2) != NULL, "list empty");
+    }
+    test_assert(chPoolAlloc(&mp2) == NULL, "list not empty");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t oslib_test_007_004 = {
+  "Memory pool magazines",
+  oslib_test_007_004_setup,
+  NULL,
+  oslib_test_007_004_execute
+};
+
+/**
+ * @page oslib_test_007_005 [7.5] Memory pool throughput
+ *
+ * <h2>Description</h2>
+ * Objects are allocated and released in bursts, first directly from the
+ * pool then through a magazine, the number of objects processed in a
+ * one second time window is measured and the results printed on the
+ * output log.
+ *
+ * <h2>Test Steps</h2>
+ * - [7.5.1] Objects are allocated and released using chPoolAlloc() and
+ *   chPoolFree(), the score is printed.
+ * - [7.5.2] Objects are allocated and released using
+ *   chPoolMagazineAlloc() and chPoolMagazineFree(), the score is
+ *   printed.
+ * - [7.5.3] Flushing the magazine, all objects must be back into the
+ *   pool.
+ * .
+ */
+
+static void oslib_test_007_005_setup(void) {
+  chPoolObjectInit(&mp2, sizeof (void *), NULL);
+  chPoolLoadArray(&mp2, mag_objects, MAGAZINE_POOL_SIZE);
+  chPoolMagazineObjectInit(&mag1, &mp2, MAGAZINE_BATCH);
+}
+
+static void oslib_test_007_005_execute(void) {
+  uint32_t n;
+
+  /* [7.5.1] Objects are allocated and released using chPoolAlloc() and
+     chPoolFree(), the score is printed.*/
+  test_set_step(1);
+  {
+    n = pool_loop(NULL);
+    test_print("--- Pool     : ");
+    test_printn(n);
+    test_println(" objects/S");
+  }
+  test_end_step(1);
+
+  /* [7.5.2] Objects are allocated and released using
+     chPoolMagazineAlloc() and chPoolMagazineFree(), the score is
+     printed.*/
+  test_set_step(2);
+  {
+    n = pool_loop(&mag1);
+    test_print("--- Magazine : ");
+    test_printn(n);
+    test_println(" objects/S");
+  }
+  test_end_step(2);
+
+  /* [7.5.3] Flushing the magazine, all objects must be back into the
+     pool.*/
+  test_set_step(3);
+  {
+    unsigned i;
+
+    chPoolMagazineFlush(&mag1);
+    for (i = 0U; i < MAGAZINE_POOL_SIZE; i++) {
+      test_assert(chPoolAlloc(&mp2) != NULL, "list empty");
+    }
+    test_assert(chPoolAlloc(&mp2) == NULL, "list not empty");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t oslib_test_007_005 = {
+  "Memory pool throughput",
+  oslib_test_007_005_setup,
+  NULL,
+  oslib_test_007_005_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -303,6 +516,8 @@ const testcase_t * const oslib_test_sequence_007_array[] = {
 #if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
   &oslib_test_007_003,
 #endif
+  &oslib_test_007_004,
+  &oslib_test_007_005,
   NULL
 };
 
@@ -38,6 +38,7 @@
  * <h2>Test Cases</h2>
  * - @subpage oslib_test_008_001
  * - @subpage oslib_test_008_002
+ * - @subpage oslib_test_008_003
  * .
  */
 
@@ -48,11 +49,41 @@
  ****************************************************************************/
 
 #define ALLOC_SIZE 16
-#define HEAP_SIZE (ALLOC_SIZE * 8)
+#define HEAP_SIZE (ALLOC_SIZE * 16)
 
 static memory_heap_t test_heap;
 static uint8_t test_heap_buffer[HEAP_SIZE];
 
+#define BENCH_HEAP_SIZE (ALLOC_SIZE * 128)
+#define BENCH_SLOTS 16
+#define BENCH_CYCLES 2000
+
+static uint8_t bench_heap_buffer[BENCH_HEAP_SIZE];
+static void *bench_slots[BENCH_SLOTS];
+static uint32_t bench_seed;
+
+#if PORT_SUPPORTS_RT == TRUE
+#define bench_now() chSysGetRealtimeCounterX()
+#else
+#define bench_now() ((rtcnt_t)0)
+#endif
+
+static uint32_t bench_rand(void) {
+
+  bench_seed = (bench_seed * 1103515245U) + 12345U;
+  return bench_seed >> 16;
+}
+
+static size_t bench_size(void) {
+  uint32_t r = bench_rand();
+
+  /* Mostly small objects, some larger ones.*/
+  if ((r % 10U) < 7U) {
+    return (size_t)ALLOC_SIZE + (size_t)((r >> 4) % (ALLOC_SIZE * 2U));
+  }
+  return (size_t)(ALLOC_SIZE * 6U) + (size_t)((r >> 4) % (ALLOC_SIZE * 6U));
+}
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -268,6 +299,138 @@ static const testcase_t oslib_test_008_002 = {
   oslib_test_008_002_execute
 };
 
+/**
+ * @page oslib_test_008_003 [8.3] Allocator benchmark
+ *
+ * <h2>Description</h2>
+ * A pseudo-random sequence of mixed size allocations and releases is
+ * performed on a small heap. The number of failed allocations, the
+ * resulting fragmentation and the worst case allocation and release
+ * times are printed, the allocators are compared by running the test
+ * with @p CH_CFG_USE_HEAP_TLSF enabled and disabled.
+ *
+ * <h2>Test Steps</h2>
+ * - [8.3.1] Printing the allocator in use.
+ * - [8.3.2] Running the allocations and releases sequence, failures
+ *   and worst case times are recorded then printed.
+ * - [8.3.3] Printing the heap fragmentation state at the end of the
+ *   sequence.
+ * - [8.3.4] Releasing all blocks, the heap must not be fragmented.
+ * .
+ */
+
+static void oslib_test_008_003_setup(void) {
+  unsigned i;
+
+  chHeapObjectInit(&test_heap, bench_heap_buffer, sizeof(bench_heap_buffer));
+  for (i = 0U; i < BENCH_SLOTS; i++) {
+    bench_slots[i] = NULL;
+  }
+  bench_seed = 0x12345678U;
+}
+
+static void oslib_test_008_003_execute(void) {
+  unsigned i;
+  size_t n, total_size, largest_size;
+
+  /* [8.3.1] Printing the allocator in use.*/
+  test_set_step(1);
+  {
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+    test_println("--- Allocator: TLSF");
+#else
+    test_println("--- Allocator: first-fit");
+#endif
+  }
+  test_end_step(1);
+
+  /* [8.3.2] Running the allocations and releases sequence, failures
+     and worst case times are recorded then printed.*/
+  test_set_step(2);
+  {
+    uint32_t fails = 0U;
+    rtcnt_t t, amax = (rtcnt_t)0, fmax = (rtcnt_t)0;
+
+    for (i = 0U; i < BENCH_CYCLES; i++) {
+      unsigned k = (unsigned)(bench_rand() % BENCH_SLOTS);
+
+      if (bench_slots[k] != NULL) {
+        t = bench_now();
+        chHeapFree(bench_slots[k]);
+        t = bench_now() - t;
+        bench_slots[k] = NULL;
+        if (t > fmax) {
+          fmax = t;
+        }
+      }
+      else {
+        size_t size = bench_size();
+
+        t = bench_now();
+        bench_slots[k] = chHeapAlloc(&test_heap, size);
+        t = bench_now() - t;
+        if (bench_slots[k] == NULL) {
+          fails++;
+        }
+        if (t > amax) {
+          amax = t;
+        }
+      }
+    }
+
+    test_print("--- Failures: ");
+    test_printn(fails);
+    test_println("");
+#if PORT_SUPPORTS_RT == TRUE
+    test_print("--- Alloc   : ");
+    test_printn((uint32_t)amax);
+    test_println(" cycles worst");
+    test_print("--- Release : ");
+    test_printn((uint32_t)fmax);
+    test_println(" cycles worst");
+#else
+    (void)amax;
+    (void)fmax;
+#endif
+  }
+  test_end_step(2);
+
+  /* [8.3.3] Printing the heap fragmentation state at the end of the
+     sequence.*/
+  test_set_step(3);
+  {
+    n = chHeapStatus(&test_heap, &total_size, &largest_size);
+    test_print("--- Frags   : ");
+    test_printn((uint32_t)n);
+    test_println("");
+    test_print("--- Free    : ");
+    test_printn((uint32_t)total_size);
+    test_print(" bytes, largest ");
+    test_printn((uint32_t)largest_size);
+    test_println(" bytes");
+  }
+  test_end_step(3);
+
+  /* [8.3.4] Releasing all blocks, the heap must not be fragmented.*/
+  test_set_step(4);
+  {
+    for (i = 0U; i < BENCH_SLOTS; i++) {
+      if (bench_slots[i] != NULL) {
+        chHeapFree(bench_slots[i]);
+      }
+    }
+    test_assert(chHeapStatus(&test_heap, NULL, NULL) == 1, "heap fragmented");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t oslib_test_008_003 = {
+  "Allocator benchmark",
+  oslib_test_008_003_setup,
+  NULL,
+  oslib_test_008_003_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -278,6 +441,7 @@ static const testcase_t oslib_test_008_002 = {
 const testcase_t * const oslib_test_sequence_008_array[] = {
   &oslib_test_008_001,
   &oslib_test_008_002,
+  &oslib_test_008_003,
   NULL
 };
 
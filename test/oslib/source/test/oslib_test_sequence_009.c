@@ -42,6 +42,7 @@
  * - @subpage oslib_test_009_004
  * - @subpage oslib_test_009_005
  * - @subpage oslib_test_009_006
+ * - @subpage oslib_test_009_007
  * .
  */
 
@@ -51,6 +52,78 @@
  * Shared code.
  ****************************************************************************/
 
+#if CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE
+#define FACTORY_BENCH_MAX 256U
+
+static registered_object_t *bench_objs[FACTORY_BENCH_MAX];
+
+static void bench_name(char *name, unsigned i) {
+
+  name[0] = 'o';
+  name[1] = (char)('0' + ((i / 100U) % 10U));
+  name[2] = (char)('0' + ((i / 10U) % 10U));
+  name[3] = (char)('0' + (i % 10U));
+  name[4] = (char)0;
+}
+
+static bool bench_register(unsigned n) {
+  char name[8];
+  unsigned i;
+
+  for (i = 0U; i < n; i++) {
+    bench_name(name, i);
+    bench_objs[i] = chFactoryRegisterObject(name, (void *)&bench_objs[i]);
+    if (bench_objs[i] == NULL) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void bench_release(unsigned n) {
+  unsigned i;
+
+  for (i = 0U; i < n; i++) {
+    if (bench_objs[i] != NULL) {
+      chFactoryReleaseObject(bench_objs[i]);
+      bench_objs[i] = NULL;
+    }
+  }
+}
+
+static uint32_t factory_find_loop(unsigned n) {
+  systime_t start, end;
+  registered_object_t *rop;
+  char name[8];
+  uint32_t cnt = 0U;
+  unsigned i;
+
+  if (bench_register(n)) {
+    bench_release(n);
+    return 0U;
+  }
+
+  chThdSleep((sysinterval_t)1);
+  start = chVTGetSystemTimeX();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    for (i = 0U; i < n; i++) {
+      bench_name(name, i);
+      rop = chFactoryFindObject(name);
+      chFactoryReleaseObject(rop);
+    }
+    cnt += n;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  bench_release(n);
+
+  return cnt;
+}
+#endif
 
 /****************************************************************************
  * Test cases.
@@ -777,6 +850,107 @@ static const testcase_t oslib_test_009_006 = {
 };
 #endif /* CH_CFG_FACTORY_PIPES == TRUE */
 
+#if (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_009_007 [9.7] Objects Registry lookup scaling
+ *
+ * <h2>Description</h2>
+ * Many objects are registered then looked up by name, the number of
+ * lookups performed in a one second time window is measured for an
+ * increasing number of registered objects and the results printed on
+ * the output log.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [9.7.1] Registering the maximum number of objects, each object must
+ *   be found by name and a second registration with the same name must
+ *   fail, then the objects are released and must no more be found.
+ * - [9.7.2] Lookups with 16 registered objects, the score is printed.
+ * - [9.7.3] Lookups with 64 registered objects, the score is printed.
+ * - [9.7.4] Lookups with 256 registered objects, the score is printed.
+ * .
+ */
+
+static void oslib_test_009_007_teardown(void) {
+  bench_release(FACTORY_BENCH_MAX);
+}
+
+static void oslib_test_009_007_execute(void) {
+  uint32_t n;
+
+  /* [9.7.1] Registering the maximum number of objects, each object must
+     be found by name and a second registration with the same name must
+     fail, then the objects are released and must no more be found.*/
+  test_set_step(1);
+  {
+    char name[8];
+    unsigned i;
+
+    test_assert(!bench_register(FACTORY_BENCH_MAX), "cannot register");
+    for (i = 0U; i < FACTORY_BENCH_MAX; i++) {
+      registered_object_t *rop;
+
+      bench_name(name, i);
+      rop = chFactoryFindObject(name);
+      test_assert(rop == bench_objs[i], "not found");
+      chFactoryReleaseObject(rop);
+      test_assert(chFactoryRegisterObject(name, NULL) == NULL, "can register");
+    }
+    bench_release(FACTORY_BENCH_MAX);
+    for (i = 0U; i < FACTORY_BENCH_MAX; i++) {
+      bench_name(name, i);
+      test_assert(chFactoryFindObject(name) == NULL, "found");
+    }
+  }
+  test_end_step(1);
+
+  /* [9.7.2] Lookups with 16 registered objects, the score is printed.*/
+  test_set_step(2);
+  {
+    n = factory_find_loop(16U);
+    test_assert(n > 0U, "cannot register");
+    test_print("--- 16 objs  : ");
+    test_printn(n);
+    test_println(" lookups/S");
+  }
+  test_end_step(2);
+
+  /* [9.7.3] Lookups with 64 registered objects, the score is printed.*/
+  test_set_step(3);
+  {
+    n = factory_find_loop(64U);
+    test_assert(n > 0U, "cannot register");
+    test_print("--- 64 objs  : ");
+    test_printn(n);
+    test_println(" lookups/S");
+  }
+  test_end_step(3);
+
+  /* [9.7.4] Lookups with 256 registered objects, the score is printed.*/
+  test_set_step(4);
+  {
+    n = factory_find_loop(256U);
+    test_assert(n > 0U, "cannot register");
+    test_print("--- 256 objs : ");
+    test_printn(n);
+    test_println(" lookups/S");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t oslib_test_009_007 = {
+  "Objects Registry lookup scaling",
+  NULL,
+  oslib_test_009_007_teardown,
+  oslib_test_009_007_execute
+};
+#endif /* CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -802,6 +976,9 @@ const testcase_t * const oslib_test_sequence_009_array[] = {
 #endif
 #if (CH_CFG_FACTORY_PIPES == TRUE) || defined(__DOXYGEN__)
   &oslib_test_009_006,
+#endif
+#if (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE) || defined(__DOXYGEN__)
+  &oslib_test_009_007,
 #endif
   NULL
 };
@@ -0,0 +1,432 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "oslib_test_root.h"
+
+/**
+ * @file    oslib_test_sequence_010.c
+ * @brief   Test Sequence 010 code.
+ *
+ * @page oslib_test_sequence_010 [10] Lock-free Rings
+ *
+ * File: @ref oslib_test_sequence_010.c
+ *
+ * <h2>Description</h2>
+ * This sequence tests the ChibiOS library functionalities related to
+ * single producer single consumer lock-free rings.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_RINGS == TRUE
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage oslib_test_010_001
+ * - @subpage oslib_test_010_002
+ * - @subpage oslib_test_010_003
+ * .
+ */
+
+#if (CH_CFG_USE_RINGS == TRUE) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+
+#define RING_SIZE 16
+#define RING_BENCH_SIZE 256
+#define RING_BENCH_CHUNK 32
+
+static uint8_t ring_buffer[RING_SIZE];
+static RING_DECL(ring1, ring_buffer, RING_SIZE);
+
+static const uint8_t ring_pattern[] = "0123456789ABCDEF";
+
+static uint8_t ring_bench_buffer[RING_BENCH_SIZE];
+static ring_t ring2;
+#if CH_CFG_USE_PIPES == TRUE
+static PIPE_DECL(pipe2, ring_bench_buffer, RING_BENCH_SIZE);
+#endif
+static volatile bool bench_stop;
+static volatile bool bench_error;
+
+static THD_WORKING_AREA(waRingThread, 256);
+static THD_FUNCTION(RingConsumerThread, arg) {
+  uint8_t expected = 0U;
+
+  (void)arg;
+
+  while (!bench_stop) {
+    uint8_t *p;
+    size_t i, n;
+
+    n = chRingReadPeekTimeout(&ring2, &p, TIME_MS2I(10));
+    for (i = 0U; i < n; i++) {
+      if (p[i] != expected++) {
+        bench_error = true;
+      }
+    }
+    chRingReadConsume(&ring2, n);
+  }
+}
+
+#if CH_CFG_USE_PIPES == TRUE
+static THD_FUNCTION(PipeConsumerThread, arg) {
+  uint8_t expected = 0U;
+  uint8_t buf[RING_BENCH_CHUNK];
+
+  (void)arg;
+
+  while (!bench_stop) {
+    size_t i, n;
+
+    n = chPipeReadTimeout(&pipe2, buf, RING_BENCH_CHUNK, TIME_MS2I(10));
+    for (i = 0U; i < n; i++) {
+      if (buf[i] != expected++) {
+        bench_error = true;
+      }
+    }
+  }
+}
+#endif
+
+static uint32_t ring_loop(tfunc_t funcp) {
+  systime_t start, end;
+  thread_t *tp;
+  uint32_t n = 0U;
+  uint8_t pattern = 0U;
+
+  thread_descriptor_t td = {
+    .name  = "consumer",
+    .wbase = waRingThread,
+    .wend  = THD_WORKING_AREA_END(waRingThread),
+    .prio  = chThdGetPriorityX() - 1,
+    .funcp = funcp,
+    .arg   = NULL
+  };
+
+  chRingObjectInit(&ring2, ring_bench_buffer, RING_BENCH_SIZE);
+  bench_stop  = false;
+  bench_error = false;
+  tp = chThdCreate(&td);
+
+  chThdSleep((sysinterval_t)1);
+  start = chVTGetSystemTimeX();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    uint8_t chunk[RING_BENCH_CHUNK];
+    uint8_t *p;
+    size_t i, k;
+
+    if (funcp == RingConsumerThread) {
+      k = chRingWriteReserveTimeout(&ring2, &p, TIME_INFINITE);
+      if (k > RING_BENCH_CHUNK) {
+        k = RING_BENCH_CHUNK;
+      }
+      for (i = 0U; i < k; i++) {
+        p[i] = pattern++;
+      }
+      chRingWriteCommit(&ring2, k);
+    }
+#if CH_CFG_USE_PIPES == TRUE
+    else {
+      k = RING_BENCH_CHUNK;
+      for (i = 0U; i < k; i++) {
+        chunk[i] = pattern++;
+      }
+      (void) chPipeWriteTimeout(&pipe2, chunk, k, TIME_INFINITE);
+    }
+#else
+    (void)chunk;
+#endif
+    n += (uint32_t)k;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  /* The consumer exits after draining the remaining data.*/
+  bench_stop = true;
+  (void)chThdWait(tp);
+
+  return n;
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page oslib_test_010_001 [10.1] Ring zero-copy API, non-blocking tests
+ *
+ * <h2>Description</h2>
+ * The ring reserve/commit and peek/consume functionality is tested by
+ * loading and emptying it, the contiguous areas returned at the buffer
+ * end are checked.
+ *
+ * <h2>Test Steps</h2>
+ * - [10.1.1] Reserving on an empty ring, the whole buffer must be
+ *   returned and no data must be available.
+ * - [10.1.2] Committing part of the reserved area, the data must become
+ *   visible to the consumer.
+ * - [10.1.3] Consuming part of the data then filling the ring, the
+ *   reserved areas must stop at the buffer end then restart from the
+ *   beginning.
+ * - [10.1.4] Peeking across the buffer end, the data areas must stop at
+ *   the buffer end then restart from the beginning.
+ * .
+ */
+
+static void oslib_test_010_001_setup(void) {
+  chRingObjectInit(&ring1, ring_buffer, RING_SIZE);
+}
+
+static void oslib_test_010_001_execute(void) {
+  uint8_t *p;
+  size_t n;
+
+  /* [10.1.1] Reserving on an empty ring, the whole buffer must be
+     returned and no data must be available.*/
+  test_set_step(1);
+  {
+    n = chRingWriteReserveX(&ring1, &p);
+    test_assert((n == RING_SIZE) && (p == ring_buffer), "wrong area");
+    n = chRingReadPeekX(&ring1, &p);
+    test_assert(n == 0U, "not empty");
+  }
+  test_end_step(1);
+
+  /* [10.1.2] Committing part of the reserved area, the data must become
+     visible to the consumer.*/
+  test_set_step(2);
+  {
+    n = chRingWriteReserveX(&ring1, &p);
+    memcpy(p, ring_pattern, 10U);
+    chRingWriteCommit(&ring1, 10U);
+    test_assert(chRingGetUsedCountX(&ring1) == 10U, "wrong count");
+    n = chRingReadPeekX(&ring1, &p);
+    test_assert((n == 10U) && (p == ring_buffer), "wrong area");
+    test_assert(memcmp(p, ring_pattern, n) == 0, "content mismatch");
+  }
+  test_end_step(2);
+
+  /* [10.1.3] Consuming part of the data then filling the ring, the
+     reserved areas must stop at the buffer end then restart from the
+     beginning.*/
+  test_set_step(3);
+  {
+    chRingReadConsume(&ring1, 8U);
+    n = chRingWriteReserveX(&ring1, &p);
+    test_assert((n == RING_SIZE - 10U) && (p == &ring_buffer[10]),
+                "wrong area");
+    memcpy(p, ring_pattern, n);
+    chRingWriteCommit(&ring1, n);
+    n = chRingWriteReserveX(&ring1, &p);
+    test_assert((n == 8U) && (p == ring_buffer), "wrong area");
+    memcpy(p, &ring_pattern[RING_SIZE - 10U], n);
+    chRingWriteCommit(&ring1, n);
+    n = chRingWriteReserveX(&ring1, &p);
+    test_assert(n == 0U, "not full");
+    test_assert(chRingGetFreeCountX(&ring1) == 0U, "not full");
+  }
+  test_end_step(3);
+
+  /* [10.1.4] Peeking across the buffer end, the data areas must stop at
+     the buffer end then restart from the beginning.*/
+  test_set_step(4);
+  {
+    n = chRingReadPeekX(&ring1, &p);
+    test_assert((n == 8U) && (p == &ring_buffer[8]), "wrong area");
+    test_assert(memcmp(p, "89012345", n) == 0, "content mismatch");
+    chRingReadConsume(&ring1, n);
+    n = chRingReadPeekX(&ring1, &p);
+    test_assert((n == 8U) && (p == ring_buffer), "wrong area");
+    test_assert(memcmp(p, "6789ABCD", n) == 0, "content mismatch");
+    chRingReadConsume(&ring1, n);
+    n = chRingReadPeekX(&ring1, &p);
+    test_assert(n == 0U, "not empty");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t oslib_test_010_001 = {
+  "Ring zero-copy API, non-blocking tests",
+  oslib_test_010_001_setup,
+  NULL,
+  oslib_test_010_001_execute
+};
+
+/**
+ * @page oslib_test_010_002 [10.2] Ring copy API and timeouts
+ *
+ * <h2>Description</h2>
+ * The ring copy functions are tested, the timeouts on full and empty
+ * rings are checked.
+ *
+ * <h2>Test Steps</h2>
+ * - [10.2.1] Moving the ring pointers away from the buffer start.
+ * - [10.2.2] Writing more data than the ring size, only the free space
+ *   must be filled.
+ * - [10.2.3] Reading the whole ring content across the buffer end, the
+ *   data must match.
+ * - [10.2.4] Reading from an empty ring, a timeout is expected.
+ * .
+ */
+
+static void oslib_test_010_002_setup(void) {
+  chRingObjectInit(&ring1, ring_buffer, RING_SIZE);
+}
+
+static void oslib_test_010_002_execute(void) {
+  uint8_t buf[RING_SIZE];
+  uint8_t *p;
+  size_t n;
+
+  /* [10.2.1] Moving the ring pointers away from the buffer start.*/
+  test_set_step(1);
+  {
+    n = chRingWriteTimeout(&ring1, ring_pattern, 4U, TIME_IMMEDIATE);
+    test_assert(n == 4U, "wrong size");
+    n = chRingReadTimeout(&ring1, buf, 4U, TIME_IMMEDIATE);
+    test_assert(n == 4U, "wrong size");
+  }
+  test_end_step(1);
+
+  /* [10.2.2] Writing more data than the ring size, only the free space
+     must be filled.*/
+  test_set_step(2);
+  {
+    n = chRingWriteTimeout(&ring1, ring_pattern, RING_SIZE, TIME_IMMEDIATE);
+    test_assert(n == RING_SIZE, "wrong size");
+    n = chRingWriteTimeout(&ring1, ring_pattern, 1U, TIME_MS2I(10));
+    test_assert(n == 0U, "not full");
+    n = chRingWriteReserveTimeout(&ring1, &p, TIME_MS2I(10));
+    test_assert(n == 0U, "not full");
+  }
+  test_end_step(2);
+
+  /* [10.2.3] Reading the whole ring content across the buffer end, the
+     data must match.*/
+  test_set_step(3);
+  {
+    n = chRingReadTimeout(&ring1, buf, RING_SIZE, TIME_IMMEDIATE);
+    test_assert(n == RING_SIZE, "wrong size");
+    test_assert(memcmp(buf, ring_pattern, RING_SIZE) == 0, "content mismatch");
+  }
+  test_end_step(3);
+
+  /* [10.2.4] Reading from an empty ring, a timeout is expected.*/
+  test_set_step(4);
+  {
+    n = chRingReadTimeout(&ring1, buf, 1U, TIME_MS2I(10));
+    test_assert(n == 0U, "not empty");
+    n = chRingReadPeekTimeout(&ring1, &p, TIME_MS2I(10));
+    test_assert(n == 0U, "not empty");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t oslib_test_010_002 = {
+  "Ring copy API and timeouts",
+  oslib_test_010_002_setup,
+  NULL,
+  oslib_test_010_002_execute
+};
+
+/**
+ * @page oslib_test_010_003 [10.3] Ring streaming throughput
+ *
+ * <h2>Description</h2>
+ * A consumer thread is created with a lower priority than the producer,
+ * a byte stream is transferred through a ring using the zero-copy API
+ * then, if available, through a pipe. The stream content is verified by
+ * the consumer, the number of bytes transferred in a one second time
+ * window is measured and the results printed on the output log.
+ *
+ * <h2>Test Steps</h2>
+ * - [10.3.1] Streaming through a ring using reserve/commit and
+ *   peek/consume, the score is printed.
+ * - [10.3.2] Streaming through a pipe using write and read, the score
+ *   is printed.
+ * .
+ */
+
+static void oslib_test_010_003_execute(void) {
+  uint32_t n;
+
+  /* [10.3.1] Streaming through a ring using reserve/commit and
+     peek/consume, the score is printed.*/
+  test_set_step(1);
+  {
+    n = ring_loop(RingConsumerThread);
+    test_assert(!bench_error, "stream corrupted");
+    test_print("--- Ring  : ");
+    test_printn(n);
+    test_println(" bytes/S");
+  }
+  test_end_step(1);
+
+  /* [10.3.2] Streaming through a pipe using write and read, the score
+     is printed.*/
+  test_set_step(2);
+  {
+#if CH_CFG_USE_PIPES == TRUE
+    n = ring_loop(PipeConsumerThread);
+    test_assert(!bench_error, "stream corrupted");
+    test_print("--- Pipe  : ");
+    test_printn(n);
+    test_println(" bytes/S");
+#else
+    (void)n;
+#endif
+  }
+  test_end_step(2);
+}
+
+static const testcase_t oslib_test_010_003 = {
+  "Ring streaming throughput",
+  NULL,
+  NULL,
+  oslib_test_010_003_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const oslib_test_sequence_010_array[] = {
+  &oslib_test_010_001,
+  &oslib_test_010_002,
+  &oslib_test_010_003,
+  NULL
+};
+
+/**
+ * @brief   Lock-free Rings
+ */
+const testsequence_t oslib_test_sequence_010 = {
+  "Lock-free Rings",
+  oslib_test_sequence_010_array
+};
+
+#endif /* CH_CFG_USE_RINGS == TRUE */
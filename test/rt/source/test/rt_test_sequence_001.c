@@ -177,6 +177,9 @@ static void rt_test_001_003_execute(void) {
     test_print("--- CH_CFG_ST_TIMEDELTA:                ");
     test_printn(CH_CFG_ST_TIMEDELTA);
     test_println("");
+    test_print("--- CH_CFG_VT_WHEEL_SLOTS:              ");
+    test_printn(CH_CFG_VT_WHEEL_SLOTS);
+    test_println("");
     test_print("--- CH_CFG_TIME_QUANTUM:                ");
     test_printn(CH_CFG_TIME_QUANTUM);
     test_println("");
@@ -189,12 +192,21 @@ static void rt_test_001_003_execute(void) {
     test_print("--- CH_CFG_OPTIMIZE_SPEED:              ");
     test_printn(CH_CFG_OPTIMIZE_SPEED);
     test_println("");
+    test_print("--- CH_CFG_USE_READY_BITMAP:            ");
+    test_printn(CH_CFG_USE_READY_BITMAP);
+    test_println("");
     test_print("--- CH_CFG_USE_TM:                      ");
     test_printn(CH_CFG_USE_TM);
     test_println("");
+    test_print("--- CH_CFG_USE_TM_HISTOGRAMS:           ");
+    test_printn(CH_CFG_USE_TM_HISTOGRAMS);
+    test_println("");
     test_print("--- CH_CFG_USE_REGISTRY:                ");
     test_printn(CH_CFG_USE_REGISTRY);
     test_println("");
+    test_print("--- CH_CFG_REGISTRY_HASH_SIZE:          ");
+    test_printn(CH_CFG_REGISTRY_HASH_SIZE);
+    test_println("");
     test_print("--- CH_CFG_USE_WAITEXIT:                ");
     test_printn(CH_CFG_USE_WAITEXIT);
     test_println("");
@@ -231,6 +243,9 @@ static void rt_test_001_003_execute(void) {
     test_print("--- CH_CFG_USE_DYNAMIC:                 ");
     test_printn(CH_CFG_USE_DYNAMIC);
     test_println("");
+    test_print("--- CH_CFG_USE_THREAD_POOLS:            ");
+    test_printn(CH_CFG_USE_THREAD_POOLS);
+    test_println("");
     test_print("--- CH_DBG_STATISTICS:                  ");
     test_printn(CH_DBG_STATISTICS);
     test_println("");
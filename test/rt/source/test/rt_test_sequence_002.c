@@ -36,6 +36,7 @@
  * - @subpage rt_test_002_001
  * - @subpage rt_test_002_002
  * - @subpage rt_test_002_003
+ * - @subpage rt_test_002_004
  * .
  */
 
@@ -63,6 +64,39 @@ static void vtcb(virtual_timer_t *vtp, void *p) {
 }
 #endif
 
+#if (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) &&                    \
+    ((CH_DBG_TRACE_MASK & CH_DBG_TRACE_MASK_USER) != 0U)
+/* Trace classes other than user records.*/
+#define TRACE_OTHERS_MASK                                                   \
+  ((uint16_t)(CH_DBG_TRACE_MASK & ~CH_DBG_TRACE_MASK_USER))
+
+static trace_event_t trace_events[CH_DBG_TRACE_BUFFER_SIZE];
+
+/* Writes user records numbered starting from the specified value.*/
+static void trace_write_seq(unsigned first, unsigned n) {
+  unsigned i;
+
+  for (i = 0U; i < n; i++) {
+    chTraceWrite((void *)(uintptr_t)(first + i), NULL);
+  }
+}
+
+/* Checks that the records are user records numbered starting from the
+   specified value.*/
+static bool trace_check_seq(size_t n, unsigned first) {
+  size_t i;
+
+  for (i = (size_t)0; i < n; i++) {
+    if ((trace_events[i].type != CH_TRACE_TYPE_USER) ||
+        (trace_events[i].u.user.up1 != (void *)(uintptr_t)(first + i))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -251,6 +285,93 @@ static const testcase_t rt_test_002_003 = {
   rt_test_002_003_execute
 };
 
+#if ((CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) && ((CH_DBG_TRACE_MASK & CH_DBG_TRACE_MASK_USER) != 0U)) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_002_004 [2.4] Trace buffer drain functionality
+ *
+ * <h2>Description</h2>
+ * The trace buffer is drained using chTraceRead(), user records are written
+ * and read back checking their order, the buffer wrap-around and the lost
+ * records count. The other trace classes are suspended during the test.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) && ((CH_DBG_TRACE_MASK & CH_DBG_TRACE_MASK_USER) != 0U)
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [2.4.1] Draining the buffer, it must be empty afterward.
+ * - [2.4.2] Writing four user records then reading them two at time, they
+ *   must be returned in order and none lost.
+ * - [2.4.3] Overflowing the buffer by five records, the oldest records must
+ *   be counted as lost and the others read in order across the buffer end.
+ * .
+ */
+
+static void rt_test_002_004_setup(void) {
+  chTraceSuspend(TRACE_OTHERS_MASK);
+}
+
+static void rt_test_002_004_teardown(void) {
+  chTraceResume(TRACE_OTHERS_MASK);
+}
+
+static void rt_test_002_004_execute(void) {
+  uint32_t lost;
+  size_t n;
+
+  /* [2.4.1] Draining the buffer, it must be empty afterward.*/
+  test_set_step(1);
+  {
+    while (chTraceRead(trace_events, CH_DBG_TRACE_BUFFER_SIZE) > (size_t)0) {
+    }
+    n = chTraceRead(trace_events, CH_DBG_TRACE_BUFFER_SIZE);
+    test_assert(n == (size_t)0, "buffer not empty");
+  }
+  test_end_step(1);
+
+  /* [2.4.2] Writing four user records then reading them two at time, they
+     must be returned in order and none lost.*/
+  test_set_step(2);
+  {
+    lost = chTraceGetLostX();
+    trace_write_seq(1U, 4U);
+    n = chTraceRead(trace_events, (size_t)2);
+    test_assert(n == (size_t)2, "wrong records count");
+    test_assert(trace_check_seq(n, 1U), "wrong records");
+    n = chTraceRead(trace_events, CH_DBG_TRACE_BUFFER_SIZE);
+    test_assert(n == (size_t)2, "wrong records count");
+    test_assert(trace_check_seq(n, 3U), "wrong records");
+    test_assert(chTraceGetLostX() == lost, "records lost");
+  }
+  test_end_step(2);
+
+  /* [2.4.3] Overflowing the buffer by five records, the oldest records must
+     be counted as lost and the others read in order across the buffer end.*/
+  test_set_step(3);
+  {
+    lost = chTraceGetLostX();
+    trace_write_seq(1U, CH_DBG_TRACE_BUFFER_SIZE + 4U);
+    n = chTraceRead(trace_events, CH_DBG_TRACE_BUFFER_SIZE);
+    test_assert(n == (size_t)CH_DBG_TRACE_BUFFER_SIZE - (size_t)1,
+                "wrong records count");
+    test_assert(trace_check_seq(n, 6U), "wrong records");
+    test_assert(chTraceGetLostX() - lost == 5U, "wrong lost count");
+    n = chTraceRead(trace_events, CH_DBG_TRACE_BUFFER_SIZE);
+    test_assert(n == (size_t)0, "buffer not empty");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t rt_test_002_004 = {
+  "Trace buffer drain functionality",
+  rt_test_002_004_setup,
+  rt_test_002_004_teardown,
+  rt_test_002_004_execute
+};
+#endif /* (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) && ((CH_DBG_TRACE_MASK & CH_DBG_TRACE_MASK_USER) != 0U) */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -264,6 +385,9 @@ const testcase_t * const rt_test_sequence_002_array[] = {
   &rt_test_002_002,
 #endif
   &rt_test_002_003,
+#if ((CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) && ((CH_DBG_TRACE_MASK & CH_DBG_TRACE_MASK_USER) != 0U)) || defined(__DOXYGEN__)
+  &rt_test_002_004,
+#endif
   NULL
 };
 
@@ -32,6 +32,7 @@
  * <h2>Test Cases</h2>
  * - @subpage rt_test_003_001
  * - @subpage rt_test_003_002
+ * - @subpage rt_test_003_003
  * .
  */
 
@@ -41,6 +42,14 @@
 
 #include "ch.h"
 
+static virtual_timer_t vt;
+
+static void vtcb(virtual_timer_t *vtp, void *p) {
+
+  (void)vtp;
+  (void)p;
+}
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -153,6 +162,71 @@ static const testcase_t rt_test_003_002 = {
   rt_test_003_002_execute
 };
 
+/**
+ * @page rt_test_003_003 [3.3] Long virtual timer delays
+ *
+ * <h2>Description</h2>
+ * A virtual timer is armed with a delay exceeding half of the system
+ * time range, the delay must not be shortened.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.3.1] The timer is armed with a delay exceeding half of the
+ *   system time range, the remaining interval is checked.
+ * - [3.3.2] If the delay is short enough then the timer is waited, it
+ *   must not trigger before the delay.
+ * .
+ */
+
+static void rt_test_003_003_setup(void) {
+  chVTObjectInit(&vt);
+}
+
+static void rt_test_003_003_teardown(void) {
+  chVTReset(&vt);
+}
+
+static void rt_test_003_003_execute(void) {
+  systime_t start;
+  sysinterval_t delay;
+
+  /* [3.3.1] The timer is armed with a delay exceeding half of the
+     system time range, the remaining interval is checked.*/
+  test_set_step(1);
+  {
+    sysinterval_t remaining;
+
+    delay = (sysinterval_t)(TIME_MAX_SYSTIME / 2U) + TIME_MS2I(100);
+    chSysLock();
+    start = chVTGetSystemTimeX();
+    chVTSetI(&vt, delay, vtcb, NULL);
+    remaining = chVTGetRemainingIntervalI(&vt);
+    chSysUnlock();
+    test_assert(remaining > (sysinterval_t)(TIME_MAX_SYSTIME / 2U),
+                "delay shortened");
+  }
+  test_end_step(1);
+
+  /* [3.3.2] If the delay is short enough then the timer is waited, it
+     must not trigger before the delay.*/
+  test_set_step(2);
+  {
+    if (delay <= TIME_S2I(10)) {
+      while (chVTIsArmed(&vt)) {
+        chThdSleepMilliseconds(100);
+      }
+      test_assert(chVTTimeElapsedSinceX(start) >= delay, "triggered early");
+    }
+  }
+  test_end_step(2);
+}
+
+static const testcase_t rt_test_003_003 = {
+  "Long virtual timer delays",
+  rt_test_003_003_setup,
+  rt_test_003_003_teardown,
+  rt_test_003_003_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -163,6 +237,7 @@ static const testcase_t rt_test_003_002 = {
 const testcase_t * const rt_test_sequence_003_array[] = {
   &rt_test_003_001,
   &rt_test_003_002,
+  &rt_test_003_003,
   NULL
 };
 
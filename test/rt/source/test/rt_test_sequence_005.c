@@ -34,6 +34,7 @@
  * - @subpage rt_test_005_002
  * - @subpage rt_test_005_003
  * - @subpage rt_test_005_004
+ * - @subpage rt_test_005_005
  * .
  */
 
@@ -162,6 +163,9 @@ static const testcase_t rt_test_005_001 = {
  *   sequence is tested.
  * - [5.2.3] Creating 5 threads with pseudo-random priority, execution
  *   sequence is tested.
+ * - [5.2.4] Creating 5 threads on two priority levels, execution
+ *   sequence is tested, threads with equal priority are expected to
+ *   run in FIFO order.
  * .
  */
 
@@ -208,6 +212,21 @@ static void rt_test_005_002_execute(void) {
     test_assert_sequence("ABCDE", "invalid sequence");
   }
   test_end_step(3);
+
+  /* [5.2.4] Creating 5 threads on two priority levels, execution
+     sequence is tested, threads with equal priority are expected to
+     run in FIFO order.*/
+  test_set_step(4);
+  {
+    threads[2] = chThdCreateStatic(wa[2], WA_SIZE, chThdGetPriorityX()-2, thread, "C");
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, chThdGetPriorityX()-1, thread, "A");
+    threads[3] = chThdCreateStatic(wa[3], WA_SIZE, chThdGetPriorityX()-2, thread, "D");
+    threads[1] = chThdCreateStatic(wa[1], WA_SIZE, chThdGetPriorityX()-1, thread, "B");
+    threads[4] = chThdCreateStatic(wa[4], WA_SIZE, chThdGetPriorityX()-2, thread, "E");
+    test_wait_threads();
+    test_assert_sequence("ABCDE", "invalid sequence");
+  }
+  test_end_step(4);
 }
 
 static const testcase_t rt_test_005_002 = {
@@ -339,6 +358,117 @@ static const testcase_t rt_test_005_004 = {
 };
 #endif /* CH_CFG_USE_MUTEXES == TRUE */
 
+#if (CH_CFG_USE_REGISTRY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_005_005 [5.5] Threads lookup by name
+ *
+ * <h2>Description</h2>
+ * Threads are named and then retrieved by name using the registry,
+ * renaming a thread must make it reachable only under the new name.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_REGISTRY == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.5.1] Renaming the current thread, it must be found under the new
+ *   name, the original name is restored.
+ * - [5.5.2] Creating four lower priority threads and naming them, each
+ *   thread must be found by name.
+ * - [5.5.3] Renaming a thread from a critical zone, the old name must
+ *   not be found, the new name must be found.
+ * - [5.5.4] Waiting for the threads to terminate, their names must no
+ *   more be found.
+ * .
+ */
+
+static void rt_test_005_005_execute(void) {
+  thread_t *tp;
+
+  /* [5.5.1] Renaming the current thread, it must be found under the new
+     name, the original name is restored.*/
+  test_set_step(1);
+  {
+    const char *name = chRegGetThreadNameX(chThdGetSelfX());
+
+    chRegSetThreadName("regtest");
+    tp = chRegFindThreadByName("regtest");
+    test_assert(tp == chThdGetSelfX(), "not found");
+#if CH_CFG_USE_DYNAMIC == TRUE
+    chThdRelease(tp);
+#endif
+    chRegSetThreadName(name);
+    tp = chRegFindThreadByName("regtest");
+    test_assert(tp == NULL, "found");
+  }
+  test_end_step(1);
+
+  /* [5.5.2] Creating four lower priority threads and naming them, each
+     thread must be found by name.*/
+  test_set_step(2);
+  {
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, chThdGetPriorityX()-1, thread, "A");
+    threads[1] = chThdCreateStatic(wa[1], WA_SIZE, chThdGetPriorityX()-1, thread, "B");
+    threads[2] = chThdCreateStatic(wa[2], WA_SIZE, chThdGetPriorityX()-1, thread, "C");
+    threads[3] = chThdCreateStatic(wa[3], WA_SIZE, chThdGetPriorityX()-1, thread, "D");
+    chRegSetThreadNameX(threads[0], "thdA");
+    chRegSetThreadNameX(threads[1], "thdB");
+    chRegSetThreadNameX(threads[2], "thdC");
+    chRegSetThreadNameX(threads[3], "thdD");
+    tp = chRegFindThreadByName("thdC");
+    test_assert(tp == threads[2], "not found");
+#if CH_CFG_USE_DYNAMIC == TRUE
+    chThdRelease(tp);
+#endif
+    tp = chRegFindThreadByName("thdA");
+    test_assert(tp == threads[0], "not found");
+#if CH_CFG_USE_DYNAMIC == TRUE
+    chThdRelease(tp);
+#endif
+  }
+  test_end_step(2);
+
+  /* [5.5.3] Renaming a thread from a critical zone, the old name must
+     not be found, the new name must be found.*/
+  test_set_step(3);
+  {
+    chSysLock();
+    chRegSetThreadNameI(threads[1], "thdX");
+    chSysUnlock();
+    tp = chRegFindThreadByName("thdB");
+    test_assert(tp == NULL, "found");
+    tp = chRegFindThreadByName("thdX");
+    test_assert(tp == threads[1], "not found");
+#if CH_CFG_USE_DYNAMIC == TRUE
+    chThdRelease(tp);
+#endif
+  }
+  test_end_step(3);
+
+  /* [5.5.4] Waiting for the threads to terminate, their names must no
+     more be found.*/
+  test_set_step(4);
+  {
+    test_wait_threads();
+    test_assert_sequence("ABCD", "invalid sequence");
+    tp = chRegFindThreadByName("thdD");
+    test_assert(tp == NULL, "found");
+    tp = chRegFindThreadByName("thdX");
+    test_assert(tp == NULL, "found");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t rt_test_005_005 = {
+  "Threads lookup by name",
+  NULL,
+  NULL,
+  rt_test_005_005_execute
+};
+#endif /* CH_CFG_USE_REGISTRY == TRUE */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -352,6 +482,9 @@ const testcase_t * const rt_test_sequence_005_array[] = {
   &rt_test_005_003,
 #if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
   &rt_test_005_004,
+#endif
+#if (CH_CFG_USE_REGISTRY == TRUE) || defined(__DOXYGEN__)
+  &rt_test_005_005,
 #endif
   NULL
 };
@@ -45,6 +45,7 @@
  * - @subpage rt_test_008_007
  * - @subpage rt_test_008_008
  * - @subpage rt_test_008_009
+ * - @subpage rt_test_008_010
  * .
  */
 
@@ -59,6 +60,9 @@ static MUTEX_DECL(m2);
 #if CH_CFG_USE_CONDVARS || defined(__DOXYGEN__)
 static CONDVAR_DECL(c1);
 #endif
+#if CH_CFG_USE_SEMAPHORES || defined(__DOXYGEN__)
+static SEMAPHORE_DECL(s1, 0);
+#endif
 
 #if CH_DBG_THREADS_PROFILING || defined(__DOXYGEN__)
 /**
@@ -228,6 +232,17 @@ static THD_FUNCTION(thread9, p) {
 }
 #endif /* CH_CFG_USE_CONDVARS */
 
+#if CH_CFG_USE_SEMAPHORES || defined(__DOXYGEN__)
+static THD_FUNCTION(thread10, p) {
+
+  /* The mutex is never unlocked by this thread, it is released by the
+     tester using chMtxForceReleaseS().*/
+  chMtxLock(&m1);
+  chSemWait(&s1);
+  test_emit_token(*(char *)p);
+}
+#endif /* CH_CFG_USE_SEMAPHORES */
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -1078,6 +1093,97 @@ static const testcase_t rt_test_008_009 = {
 };
 #endif /* CH_CFG_USE_CONDVARS == TRUE */
 
+#if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_008_010 [8.10] Mutex force release test
+ *
+ * <h2>Description</h2>
+ * This test case verifies the forced release of a mutex owned by a
+ * boosted thread which is in the ready list, the owner must be moved
+ * back to its base priority level. The created threads perform the
+ * following operations: TA{lock(M1), wait(S1)}, TB{lock(M1),
+ * unlock(M1)}.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_SEMAPHORES == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [8.10.1] Reading current base priority.
+ * - [8.10.2] Thread A is created at priority P(+1), it locks M1 and
+ *   goes to wait on S1.
+ * - [8.10.3] Thread B is created at priority P(+2), it enqueues on M1
+ *   and boosts TA priority at P(+2).
+ * - [8.10.4] Signaling S1 without rescheduling, TA enters the ready
+ *   list at priority P(+2). M1 is then forcibly released, TA goes back
+ *   to P(+1) and TB acquires M1 and must run first.
+ * - [8.10.5] Checking the order of operations.
+ * .
+ */
+
+static void rt_test_008_010_setup(void) {
+  chMtxObjectInit(&m1);
+  chSemObjectInit(&s1, 0);
+}
+
+static void rt_test_008_010_execute(void) {
+  tprio_t prio;
+
+  /* [8.10.1] Reading current base priority.*/
+  test_set_step(1);
+  {
+    prio = chThdGetPriorityX();
+  }
+  test_end_step(1);
+
+  /* [8.10.2] Thread A is created at priority P(+1), it locks M1 and
+     goes to wait on S1.*/
+  test_set_step(2);
+  {
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, prio+1, thread10, "A");
+  }
+  test_end_step(2);
+
+  /* [8.10.3] Thread B is created at priority P(+2), it enqueues on M1
+     and boosts TA priority at P(+2).*/
+  test_set_step(3);
+  {
+    threads[1] = chThdCreateStatic(wa[1], WA_SIZE, prio+2, thread1, "B");
+    test_assert(threads[0]->hdr.pqueue.prio == prio+2, "not boosted");
+  }
+  test_end_step(3);
+
+  /* [8.10.4] Signaling S1 without rescheduling, TA enters the ready
+     list at priority P(+2). M1 is then forcibly released, TA goes back
+     to P(+1) and TB acquires M1 and must run first.*/
+  test_set_step(4);
+  {
+    chSysLock();
+    chSemSignalI(&s1);
+    chMtxForceReleaseS(&m1);
+    chSysUnlock();
+  }
+  test_end_step(4);
+
+  /* [8.10.5] Checking the order of operations.*/
+  test_set_step(5);
+  {
+    test_wait_threads();
+    test_assert_sequence("BA", "invalid sequence");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t rt_test_008_010 = {
+  "Mutex force release test",
+  rt_test_008_010_setup,
+  NULL,
+  rt_test_008_010_execute
+};
+#endif /* CH_CFG_USE_SEMAPHORES == TRUE */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -1108,6 +1214,9 @@ const testcase_t * const rt_test_sequence_008_array[] = {
 #endif
 #if (CH_CFG_USE_CONDVARS == TRUE) || defined(__DOXYGEN__)
   &rt_test_008_009,
+#endif
+#if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
+  &rt_test_008_010,
 #endif
   NULL
 };
@@ -38,6 +38,7 @@
  * <h2>Test Cases</h2>
  * - @subpage rt_test_011_001
  * - @subpage rt_test_011_002
+ * - @subpage rt_test_011_003
  * .
  */
 
@@ -59,6 +60,18 @@ static THD_FUNCTION(dyn_thread1, p) {
   test_emit_token(*(char *)p);
 }
 
+#if CH_CFG_USE_THREAD_POOLS
+static thread_pool_t tp1;
+static thread_t *tp1_threads[3];
+static thread_task_t tasks1[4];
+
+static msg_t pool_task1(void *p) {
+
+  test_emit_token(*(char *)p);
+  return (msg_t)*(char *)p;
+}
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -276,6 +289,109 @@ static const testcase_t rt_test_011_002 = {
 };
 #endif /* CH_CFG_USE_MEMPOOLS == TRUE */
 
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_011_003 [11.3] Thread pool
+ *
+ * <h2>Description</h2>
+ * A thread pool is started from a memory pool containing two working
+ * areas, then four tasks are submitted and joined.<br> The test expects
+ * two threads to be started, the tasks to be executed in submission
+ * order and the working areas to be returned to the memory pool when
+ * the thread pool is stopped.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_THREAD_POOLS == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [11.3.1] Adding two working areas to the memory pool.
+ * - [11.3.2] Starting the thread pool, only two threads are expected to
+ *   be started because the memory pool runs out of working areas.
+ * - [11.3.3] Submitting four tasks then joining them, the results and
+ *   the execution sequence are checked.
+ * - [11.3.4] Joining a task already completed, the result is expected
+ *   to be returned immediately.
+ * - [11.3.5] Stopping the pool then testing that the memory pool
+ *   contains two elements again.
+ * .
+ */
+
+static void rt_test_011_003_setup(void) {
+  chPoolObjectInit(&mp1, THD_WORKING_AREA_SIZE(THREADS_STACK_SIZE), NULL);
+  chThdPoolObjectInit(&tp1, tp1_threads, 3U);
+}
+
+static void rt_test_011_003_execute(void) {
+  unsigned i;
+
+  /* [11.3.1] Adding two working areas to the memory pool.*/
+  test_set_step(1);
+  {
+    for (i = 0; i < 2; i++)
+      chPoolFree(&mp1, wa[i]);
+  }
+  test_end_step(1);
+
+  /* [11.3.2] Starting the thread pool, only two threads are expected to
+     be started because the memory pool runs out of working areas.*/
+  test_set_step(2);
+  {
+    test_assert(chThdPoolStart(&tp1, &mp1, "pool", chThdGetPriorityX() - 1) == 2U,
+                "wrong number of threads");
+    test_assert(chThdPoolGetSizeX(&tp1) == 2U, "wrong pool size");
+  }
+  test_end_step(2);
+
+  /* [11.3.3] Submitting four tasks then joining them, the results and
+     the execution sequence are checked.*/
+  test_set_step(3);
+  {
+    static const char tokens[] = "ABCD";
+
+    for (i = 0; i < 4; i++) {
+      chThdTaskObjectInit(&tasks1[i], pool_task1, (void *)&tokens[i]);
+      chThdPoolSubmit(&tp1, &tasks1[i]);
+    }
+    for (i = 0; i < 4; i++) {
+      test_assert(chThdTaskJoin(&tasks1[i]) == (msg_t)tokens[i], "wrong result");
+    }
+    test_assert_sequence("ABCD", "invalid sequence");
+  }
+  test_end_step(3);
+
+  /* [11.3.4] Joining a task already completed, the result is expected
+     to be returned immediately.*/
+  test_set_step(4);
+  {
+    test_assert(chThdTaskIsDoneX(&tasks1[0]), "not done");
+    test_assert(chThdTaskJoin(&tasks1[0]) == (msg_t)'A', "wrong result");
+  }
+  test_end_step(4);
+
+  /* [11.3.5] Stopping the pool then testing that the memory pool
+     contains two elements again.*/
+  test_set_step(5);
+  {
+    chThdPoolStop(&tp1);
+    test_assert(chThdPoolGetSizeX(&tp1) == 0U, "pool not stopped");
+    for (i = 0; i < 2; i++)
+      test_assert(chPoolAlloc(&mp1) != NULL, "pool list empty");
+    test_assert(chPoolAlloc(&mp1) == NULL, "pool list not empty");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t rt_test_011_003 = {
+  "Thread pool",
+  rt_test_011_003_setup,
+  NULL,
+  rt_test_011_003_execute
+};
+#endif /* CH_CFG_USE_THREAD_POOLS == TRUE */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -289,6 +405,9 @@ const testcase_t * const rt_test_sequence_011_array[] = {
 #endif
 #if (CH_CFG_USE_MEMPOOLS == TRUE) || defined(__DOXYGEN__)
   &rt_test_011_002,
+#endif
+#if (CH_CFG_USE_THREAD_POOLS == TRUE) || defined(__DOXYGEN__)
+  &rt_test_011_003,
 #endif
   NULL
 };
@@ -46,6 +46,10 @@
  * - @subpage rt_test_012_010
  * - @subpage rt_test_012_011
  * - @subpage rt_test_012_012
+ * - @subpage rt_test_012_013
+ * - @subpage rt_test_012_014
+ * - @subpage rt_test_012_015
+ * - @subpage rt_test_012_016
  * .
  */
 
@@ -138,6 +142,93 @@ static THD_FUNCTION(bmk_thread8, p) {
   } while(!chThdShouldTerminateX());
 }
 
+#if (CH_CFG_USE_TM_HISTOGRAMS == TRUE) && (CH_CFG_USE_SEMAPHORES == TRUE)
+static tm_histogram_t hist1;
+static volatile rtcnt_t wakeup_stamp;
+
+static THD_FUNCTION(bmk_thread9, p) {
+
+  (void)p;
+  while (!chThdShouldTerminateX()) {
+    if (chSemWait(&sem1) == MSG_OK) {
+      chTMHistogramRecordX(&hist1,
+                           chSysGetRealtimeCounterX() - wakeup_stamp);
+    }
+  }
+}
+#endif
+
+#if (CH_CFG_USE_DYNAMIC == TRUE) && (CH_CFG_USE_THREAD_POOLS == TRUE)
+static memory_pool_t mp1;
+static thread_pool_t tp1;
+static thread_t *tp1_threads[1];
+static thread_task_t task1;
+
+static msg_t bmk_task1(void *p) {
+
+  (void)p;
+  return MSG_OK;
+}
+#endif
+
+#if (CH_CFG_USE_MUTEXES == TRUE) && (CH_CFG_USE_SEMAPHORES == TRUE)
+static mutex_t mtxs1[4];
+static semaphore_t sem2, sem3;
+static unsigned chain_depth;
+
+static THD_FUNCTION(bmk_thread10, p) {
+  unsigned i = (unsigned)(uintptr_t)p;
+
+  while (!chThdShouldTerminateX()) {
+    chMtxLock(&mtxs1[i]);
+    if (i == 0U) {
+      /* The chain is complete, the test thread can start.*/
+      chSemSignal(&sem2);
+    }
+    if (i + 1U < chain_depth) {
+      chMtxLock(&mtxs1[i + 1U]);
+      chMtxUnlock(&mtxs1[i + 1U]);
+    }
+    else {
+      chSemWait(&sem3);
+    }
+    chMtxUnlock(&mtxs1[i]);
+  }
+}
+
+NOINLINE static uint32_t mtx_chain_test(unsigned depth) {
+  systime_t start, end;
+  tprio_t prio = chThdGetPriorityX() - (tprio_t)depth;
+  unsigned i;
+
+  /* The deeper threads have higher priority so the chain is built
+     starting from its end.*/
+  chain_depth = depth;
+  for (i = 0U; i < depth; i++) {
+    threads[i] = chThdCreateStatic(wa[i], WA_SIZE, prio + (tprio_t)i,
+                                   bmk_thread10, (void *)(uintptr_t)i);
+  }
+
+  uint32_t n = 0;
+  start = test_wait_tick();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    chSemWait(&sem2);
+    chSemSignal(&sem3);
+    chMtxLock(&mtxs1[0]);
+    chMtxUnlock(&mtxs1[0]);
+    n++;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  test_terminate_threads();
+  test_wait_threads();
+  return n;
+}
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -1038,6 +1129,424 @@ static const testcase_t rt_test_012_012 = {
   rt_test_012_012_execute
 };
 
+#if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_012_013 [12.13] Mass reschedule performance, equal priorities
+ *
+ * <h2>Description</h2>
+ * Five threads with equal priority are created and atomically
+ * rescheduled by resetting the semaphore where they are waiting on,
+ * each thread is inserted in the ready list behind its peers. The
+ * operation is performed into a continuous loop.<br> The performance
+ * is calculated by measuring the number of iterations after a second
+ * of continuous operations.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_SEMAPHORES == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [12.13.1] Five threads are created at higher priority, all with
+ *   the same priority level, that immediately enqueue on a semaphore.
+ * - [12.13.2] The semaphore is reset waking up the five threads. The
+ *   operation is repeated continuously in a one-second time window.
+ * - [12.13.3] The five threads are terminated.
+ * - [12.13.4] The score is printed.
+ * .
+ */
+
+static void rt_test_012_013_setup(void) {
+  chSemObjectInit(&sem1, 0);
+}
+
+static void rt_test_012_013_execute(void) {
+  uint32_t n;
+
+  /* [12.13.1] Five threads are created at higher priority, all with
+     the same priority level, that immediately enqueue on a semaphore.*/
+  test_set_step(1);
+  {
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, chThdGetPriorityX()+1, bmk_thread7, NULL);
+    threads[1] = chThdCreateStatic(wa[1], WA_SIZE, chThdGetPriorityX()+1, bmk_thread7, NULL);
+    threads[2] = chThdCreateStatic(wa[2], WA_SIZE, chThdGetPriorityX()+1, bmk_thread7, NULL);
+    threads[3] = chThdCreateStatic(wa[3], WA_SIZE, chThdGetPriorityX()+1, bmk_thread7, NULL);
+    threads[4] = chThdCreateStatic(wa[4], WA_SIZE, chThdGetPriorityX()+1, bmk_thread7, NULL);
+  }
+  test_end_step(1);
+
+  /* [12.13.2] The semaphore is reset waking up the five threads. The
+     operation is repeated continuously in a one-second time window.*/
+  test_set_step(2);
+  {
+    systime_t start, end;
+
+    n = 0;
+    start = test_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      chSemReset(&sem1, 0);
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+  }
+  test_end_step(2);
+
+  /* [12.13.3] The five threads are terminated.*/
+  test_set_step(3);
+  {
+    test_terminate_threads();
+    chSemReset(&sem1, 0);
+    test_wait_threads();
+  }
+  test_end_step(3);
+
+  /* [12.13.4] The score is printed.*/
+  test_set_step(4);
+  {
+    test_print("--- Score : ");
+    test_printn(n);
+    test_print(" reschedules/S, ");
+    test_printn(n * 6);
+    test_println(" ctxswc/S");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t rt_test_012_013 = {
+  "Mass reschedule performance, equal priorities",
+  rt_test_012_013_setup,
+  NULL,
+  rt_test_012_013_execute
+};
+#endif /* CH_CFG_USE_SEMAPHORES == TRUE */
+
+#if ((CH_CFG_USE_TM_HISTOGRAMS == TRUE) && (CH_CFG_USE_SEMAPHORES == TRUE)) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_012_014 [12.14] Wakeup latency distribution
+ *
+ * <h2>Description</h2>
+ * The histogram percentiles are checked against a known set of values,
+ * then a thread at higher priority is repeatedly woken up from a
+ * semaphore and the latency between the signal and the thread execution
+ * is recorded in an histogram for one second. The latency percentiles
+ * are printed in realtime counter cycles.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (CH_CFG_USE_TM_HISTOGRAMS == TRUE) && (CH_CFG_USE_SEMAPHORES == TRUE)
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [12.14.1] Recording the values from zero to 999, the percentiles
+ *   must not be below the exact value and must be within the buckets
+ *   resolution, the percentiles of a measurement must not exceed its
+ *   worst value.
+ * - [12.14.2] A thread is created at higher priority, it immediately
+ *   waits on a semaphore.
+ * - [12.14.3] The semaphore is signaled waking up the thread which
+ *   records the latency. The operation is repeated continuously in a
+ *   one-second time window.
+ * - [12.14.4] The thread is terminated.
+ * - [12.14.5] The percentiles are printed.
+ * .
+ */
+
+static void rt_test_012_014_setup(void) {
+  chSemObjectInit(&sem1, 0);
+  chTMHistogramObjectInit(&hist1);
+}
+
+static void rt_test_012_014_execute(void) {
+  uint32_t n;
+
+  /* [12.14.1] Recording the values from zero to 999, the percentiles
+     must not be below the exact value and must be within the buckets
+     resolution, the percentiles of a measurement must not exceed its
+     worst value.*/
+  test_set_step(1);
+  {
+    unsigned i;
+    rtcnt_t v;
+    time_measurement_t tm;
+
+    for (i = 0U; i < 1000U; i++) {
+      chTMHistogramRecordX(&hist1, (rtcnt_t)i);
+    }
+    test_assert(chTMHistogramGetCountX(&hist1) == 1000U, "wrong count");
+    v = chTMHistogramGetPercentileX(&hist1, 5000U);
+    test_assert((v >= 499U) && (v <= 499U + (499U / TM_HISTOGRAM_SUB_BUCKETS)),
+                "wrong p50");
+    v = chTMHistogramGetPercentileX(&hist1, 9990U);
+    test_assert((v >= 998U) && (v <= 998U + (998U / TM_HISTOGRAM_SUB_BUCKETS)),
+                "wrong p99.9");
+    chTMObjectInit(&tm);
+    chTMSetHistogramX(&tm, &hist1);
+    tm.worst = (rtcnt_t)999;
+    test_assert(chTMGetPercentileX(&tm, 10000U) == (rtcnt_t)999,
+                "above worst");
+    chTMHistogramRecordX(&hist1, (rtcnt_t)-1);
+    test_assert(chTMHistogramGetPercentileX(&hist1, 10000U) == (rtcnt_t)-1,
+                "wrong max");
+    for (i = 1U; i < TM_HISTOGRAM_BUCKETS; i++) {
+      test_assert(chTMHistogramGetBucketBaseX(i) >
+                  chTMHistogramGetBucketBaseX(i - 1U), "not monotonic");
+    }
+    chTMHistogramObjectInit(&hist1);
+  }
+  test_end_step(1);
+
+  /* [12.14.2] A thread is created at higher priority, it immediately
+     waits on a semaphore.*/
+  test_set_step(2);
+  {
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, chThdGetPriorityX()+1, bmk_thread9, NULL);
+  }
+  test_end_step(2);
+
+  /* [12.14.3] The semaphore is signaled waking up the thread which
+     records the latency. The operation is repeated continuously in a
+     one-second time window.*/
+  test_set_step(3);
+  {
+    systime_t start, end;
+
+    n = 0;
+    start = test_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      wakeup_stamp = chSysGetRealtimeCounterX();
+      chSemSignal(&sem1);
+      n++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+  }
+  test_end_step(3);
+
+  /* [12.14.4] The thread is terminated.*/
+  test_set_step(4);
+  {
+    test_terminate_threads();
+    chSemReset(&sem1, 0);
+    test_wait_threads();
+  }
+  test_end_step(4);
+
+  /* [12.14.5] The percentiles are printed.*/
+  test_set_step(5);
+  {
+    test_assert(chTMHistogramGetCountX(&hist1) == n, "wrong count");
+    test_print("--- p50   : ");
+    test_printn(chTMHistogramGetPercentileX(&hist1, 5000U));
+    test_println(" cycles");
+    test_print("--- p99   : ");
+    test_printn(chTMHistogramGetPercentileX(&hist1, 9900U));
+    test_println(" cycles");
+    test_print("--- p99.9 : ");
+    test_printn(chTMHistogramGetPercentileX(&hist1, 9990U));
+    test_println(" cycles");
+    test_print("--- Max   : ");
+    test_printn(chTMHistogramGetPercentileX(&hist1, 10000U));
+    test_println(" cycles");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t rt_test_012_014 = {
+  "Wakeup latency distribution",
+  rt_test_012_014_setup,
+  NULL,
+  rt_test_012_014_execute
+};
+#endif /* (CH_CFG_USE_TM_HISTOGRAMS == TRUE) && (CH_CFG_USE_SEMAPHORES == TRUE) */
+
+#if ((CH_CFG_USE_DYNAMIC == TRUE) && (CH_CFG_USE_THREAD_POOLS == TRUE)) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_012_015 [12.15] Thread pool performance, full cycle
+ *
+ * <h2>Description</h2>
+ * The cost of a task executed by a thread pool is compared with the
+ * cost of creating a dynamic thread for the same work. Threads are
+ * continuously created from a memory pool and waited into a loop, then
+ * tasks are continuously submitted to a thread pool and joined.<br> The
+ * performance is calculated by measuring the number of iterations after
+ * a second of continuous operations.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (CH_CFG_USE_DYNAMIC == TRUE) && (CH_CFG_USE_THREAD_POOLS == TRUE)
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [12.15.1] A thread is created from the memory pool at a lower
+ *   priority level and its termination detected using @p chThdWait().
+ *   The operation is repeated continuously in a one-second time window.
+ * - [12.15.2] A thread pool with a single thread is started from the
+ *   same memory pool at a lower priority level, a task is submitted and
+ *   joined. The operation is repeated continuously in a one-second time
+ *   window.
+ * - [12.15.3] Scores are printed.
+ * .
+ */
+
+static void rt_test_012_015_setup(void) {
+  chPoolObjectInit(&mp1, WA_SIZE, NULL);
+  chPoolFree(&mp1, wa[0]);
+  chThdPoolObjectInit(&tp1, tp1_threads, 1U);
+}
+
+static void rt_test_012_015_execute(void) {
+  uint32_t n1, n2;
+  tprio_t prio = chThdGetPriorityX() - 1;
+  systime_t start, end;
+
+  /* [12.15.1] A thread is created from the memory pool at a lower
+     priority level and its termination detected using @p chThdWait().
+     The operation is repeated continuously in a one-second time window.*/
+  test_set_step(1);
+  {
+    n1 = 0;
+    start = test_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      chThdWait(chThdCreateFromMemoryPool(&mp1, "bmk", prio, bmk_thread3, NULL));
+      n1++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+  }
+  test_end_step(1);
+
+  /* [12.15.2] A thread pool with a single thread is started from the
+     same memory pool at a lower priority level, a task is submitted and
+     joined. The operation is repeated continuously in a one-second time
+     window.*/
+  test_set_step(2);
+  {
+    test_assert(chThdPoolStart(&tp1, &mp1, "bmk", prio) == 1U,
+                "pool not started");
+    chThdTaskObjectInit(&task1, bmk_task1, NULL);
+    n2 = 0;
+    start = test_wait_tick();
+    end = chTimeAddX(start, TIME_MS2I(1000));
+    do {
+      chThdPoolSubmit(&tp1, &task1);
+      (void) chThdTaskJoin(&task1);
+      n2++;
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    } while (chVTIsSystemTimeWithinX(start, end));
+    chThdPoolStop(&tp1);
+  }
+  test_end_step(2);
+
+  /* [12.15.3] Scores are printed.*/
+  test_set_step(3);
+  {
+    test_print("--- Threads: ");
+    test_printn(n1);
+    test_println(" threads/S");
+    test_print("--- Tasks  : ");
+    test_printn(n2);
+    test_println(" tasks/S");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t rt_test_012_015 = {
+  "Thread pool performance, full cycle",
+  rt_test_012_015_setup,
+  NULL,
+  rt_test_012_015_execute
+};
+#endif /* (CH_CFG_USE_DYNAMIC == TRUE) && (CH_CFG_USE_THREAD_POOLS == TRUE) */
+
+#if ((CH_CFG_USE_MUTEXES == TRUE) && (CH_CFG_USE_SEMAPHORES == TRUE)) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_012_016 [12.16] Mutexes priority inheritance chains performance
+ *
+ * <h2>Description</h2>
+ * A chain of threads is built where each thread owns a mutex and waits
+ * on the mutex owned by the next thread, the last thread waits on a
+ * semaphore. The test thread locks the first mutex boosting the whole
+ * chain, the chain then unwinds and the mutex is handed to the test
+ * thread. The operation is repeated continuously for chains of one and
+ * four threads and the number of iterations after a second of
+ * continuous operations is printed.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (CH_CFG_USE_MUTEXES == TRUE) && (CH_CFG_USE_SEMAPHORES == TRUE)
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [12.16.1] Chain of one thread.
+ * - [12.16.2] Chain of four threads.
+ * - [12.16.3] Scores are printed.
+ * .
+ */
+
+static void rt_test_012_016_setup(void) {
+  unsigned i;
+
+  for (i = 0; i < 4; i++) {
+    chMtxObjectInit(&mtxs1[i]);
+  }
+  chSemObjectInit(&sem2, 0);
+  chSemObjectInit(&sem3, 0);
+}
+
+static void rt_test_012_016_execute(void) {
+  uint32_t n1, n4;
+
+  /* [12.16.1] Chain of one thread.*/
+  test_set_step(1);
+  {
+    n1 = mtx_chain_test(1U);
+    test_assert(mtxs1[0].owner == NULL, "mutex still owned");
+  }
+  test_end_step(1);
+
+  /* [12.16.2] Chain of four threads.*/
+  test_set_step(2);
+  {
+    n4 = mtx_chain_test(4U);
+    test_assert(mtxs1[0].owner == NULL, "mutex still owned");
+    test_assert(mtxs1[3].owner == NULL, "mutex still owned");
+  }
+  test_end_step(2);
+
+  /* [12.16.3] Scores are printed.*/
+  test_set_step(3);
+  {
+    test_print("--- Depth 1: ");
+    test_printn(n1);
+    test_println(" locks/S");
+    test_print("--- Depth 4: ");
+    test_printn(n4);
+    test_println(" locks/S");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t rt_test_012_016 = {
+  "Mutexes priority inheritance chains performance",
+  rt_test_012_016_setup,
+  NULL,
+  rt_test_012_016_execute
+};
+#endif /* (CH_CFG_USE_MUTEXES == TRUE) && (CH_CFG_USE_SEMAPHORES == TRUE) */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -1070,6 +1579,18 @@ const testcase_t * const rt_test_sequence_012_array[] = {
   &rt_test_012_011,
 #endif
   &rt_test_012_012,
+#if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
+  &rt_test_012_013,
+#endif
+#if ((CH_CFG_USE_TM_HISTOGRAMS == TRUE) && (CH_CFG_USE_SEMAPHORES == TRUE)) || defined(__DOXYGEN__)
+  &rt_test_012_014,
+#endif
+#if ((CH_CFG_USE_DYNAMIC == TRUE) && (CH_CFG_USE_THREAD_POOLS == TRUE)) || defined(__DOXYGEN__)
+  &rt_test_012_015,
+#endif
+#if ((CH_CFG_USE_MUTEXES == TRUE) && (CH_CFG_USE_SEMAPHORES == TRUE)) || defined(__DOXYGEN__)
+  &rt_test_012_016,
+#endif
   NULL
 };
 
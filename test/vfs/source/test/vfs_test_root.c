@@ -0,0 +1,84 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @mainpage Test Suite Specification
+ * Test suite for ChibiOS/VFS. The application is expected to mount a
+ * writable file system as VFS root before running the suite.
+ *
+ * <h2>Test Sequences</h2>
+ * - @subpage vfs_test_sequence_001
+ * - @subpage vfs_test_sequence_002
+ * - @subpage vfs_test_sequence_003
+ * .
+ */
+
+/**
+ * @file    vfs_test_root.c
+ * @brief   Test Suite root structures code.
+ */
+
+#include "hal.h"
+#include "vfs_test_root.h"
+
+#if !defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Array of test sequences.
+ */
+const testsequence_t * const vfs_test_suite_array[] = {
+  &vfs_test_sequence_001,
+  &vfs_test_sequence_002,
+#if (VFS_CFG_ENABLE_ASYNC == TRUE) || defined(__DOXYGEN__)
+  &vfs_test_sequence_003,
+#endif
+  NULL
+};
+
+/**
+ * @brief   Test suite root structure.
+ */
+const testsuite_t vfs_test_suite = {
+  "ChibiOS/VFS Test Suite",
+  vfs_test_suite_array
+};
+
+/*===========================================================================*/
+/* Shared code.                                                              */
+/*===========================================================================*/
+
+#include "vfs.h"
+
+uint8_t vfs_test_buffer[VFS_TEST_BUFFER_SIZE];
+uint8_t vfs_test_file_buffer[512];
+
+void test_print_vfs_info(void) {
+
+}
+
+void vfs_test_fill(uint8_t *p, vfs_offset_t offset, size_t n) {
+
+  while (n-- > 0U) {
+    *p++ = (uint8_t)((offset * 7) + (offset >> 8));
+    offset++;
+  }
+}
+
+#endif /* !defined(__DOXYGEN__) */
@@ -0,0 +1,190 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "vfs_test_root.h"
+
+/**
+ * @file    vfs_test_sequence_001.c
+ * @brief   Test Sequence 001 code.
+ *
+ * @page vfs_test_sequence_001 [1] Buffered files.
+ *
+ * File: @ref vfs_test_sequence_001.c
+ *
+ * <h2>Description</h2>
+ * The file buffering layer of the VFS API is tested for correctness.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage vfs_test_001_001
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+#include "vfs.h"
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page vfs_test_001_001 [1.1] Buffered file access
+ *
+ * <h2>Description</h2>
+ * A file is written and read through a file buffer using transfers not
+ * aligned to the buffer size, the file content and positions are
+ * verified.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.1.1] Creating the file and associating a 512 bytes buffer to it.
+ * - [1.1.2] Writing 4000 bytes in blocks of 37 bytes, the file position
+ *   is checked after each write then the file is synchronized.
+ * - [1.1.3] Reading back from offset 100 in blocks of 13 bytes, the
+ *   content is verified and the end of file is checked.
+ * - [1.1.4] Moving back by 1000 bytes and overwriting 10 bytes, the
+ *   file position is checked.
+ * - [1.1.5] Reopening the file with a buffer and reading it with a
+ *   single transfer, the content is verified.
+ * .
+ */
+
+static void vfs_test_001_001_execute(void) {
+  vfs_file_node_c *file;
+  vfs_file_buffer_t fb;
+  vfs_offset_t offset;
+  size_t chunk;
+  ssize_t n;
+  msg_t ret;
+
+  /* [1.1.1] Creating the file and associating a 512 bytes buffer to it.*/
+  test_set_step(1);
+  {
+    ret = vfsOpenFile("/vtest1.bin", O_RDWR | O_CREAT, &file);
+    test_assert(CH_RET_IS_SUCCESS(ret), "open failed");
+    ret = vfsSetFileBuffer(file, &fb, vfs_test_file_buffer,
+                           sizeof vfs_test_file_buffer);
+    test_assert(ret == CH_RET_SUCCESS, "buffer not accepted");
+  }
+  test_end_step(1);
+
+  /* [1.1.2] Writing 4000 bytes in blocks of 37 bytes, the file position
+     is checked after each write then the file is synchronized.*/
+  test_set_step(2);
+  {
+    for (offset = 0; offset < 4000; offset += (vfs_offset_t)chunk) {
+      chunk = (size_t)(4000 - offset) < 37U ? (size_t)(4000 - offset) : 37U;
+      vfs_test_fill(vfs_test_buffer, offset, chunk);
+      n = vfsWriteFile(file, vfs_test_buffer, chunk);
+      test_assert(n == (ssize_t)chunk, "write failed");
+      test_assert(vfsGetFilePosition(file) == offset + (vfs_offset_t)chunk,
+                  "wrong position");
+    }
+    ret = vfsSyncFile(file);
+    test_assert(ret == CH_RET_SUCCESS, "sync failed");
+  }
+  test_end_step(2);
+
+  /* [1.1.3] Reading back from offset 100 in blocks of 13 bytes, the
+     content is verified and the end of file is checked.*/
+  test_set_step(3);
+  {
+    ret = vfsSetFilePosition(file, 100, VFS_SEEK_SET);
+    test_assert(ret == CH_RET_SUCCESS, "seek failed");
+    for (offset = 100; offset < 4000; offset += (vfs_offset_t)chunk) {
+      chunk = (size_t)(4000 - offset) < 13U ? (size_t)(4000 - offset) : 13U;
+      n = vfsReadFile(file, vfs_test_buffer, chunk);
+      test_assert(n == (ssize_t)chunk, "read failed");
+      vfs_test_fill(vfs_test_buffer + 2048, offset, chunk);
+      test_assert(memcmp(vfs_test_buffer, vfs_test_buffer + 2048, chunk) == 0,
+                  "wrong data");
+    }
+    n = vfsReadFile(file, vfs_test_buffer, 16);
+    test_assert(n == 0, "not at end of file");
+  }
+  test_end_step(3);
+
+  /* [1.1.4] Moving back by 1000 bytes and overwriting 10 bytes, the
+     file position is checked.*/
+  test_set_step(4);
+  {
+    ret = vfsSetFilePosition(file, -1000, VFS_SEEK_CUR);
+    test_assert(ret == CH_RET_SUCCESS, "seek failed");
+    test_assert(vfsGetFilePosition(file) == 3000, "wrong position");
+    memset(vfs_test_buffer, 0x55, 10);
+    n = vfsWriteFile(file, vfs_test_buffer, 10);
+    test_assert(n == 10, "write failed");
+    test_assert(vfsGetFilePosition(file) == 3010, "wrong position");
+    vfsClose((vfs_node_c *)file);
+  }
+  test_end_step(4);
+
+  /* [1.1.5] Reopening the file with a buffer and reading it with a
+     single transfer, the content is verified.*/
+  test_set_step(5);
+  {
+    ret = vfsOpenFile("/vtest1.bin", O_RDONLY, &file);
+    test_assert(CH_RET_IS_SUCCESS(ret), "open failed");
+    ret = vfsSetFileBuffer(file, &fb, vfs_test_file_buffer,
+                           sizeof vfs_test_file_buffer);
+    test_assert(ret == CH_RET_SUCCESS, "buffer not accepted");
+    n = vfsReadFile(file, vfs_test_buffer, VFS_TEST_BUFFER_SIZE);
+    test_assert(n == 4000, "read failed");
+    for (offset = 0; offset < 4000; offset++) {
+      uint8_t b;
+
+      vfs_test_fill(&b, offset, 1U);
+      if ((offset >= 3000) && (offset < 3010)) {
+        b = 0x55U;
+      }
+      test_assert(vfs_test_buffer[offset] == b, "wrong data");
+    }
+    vfsClose((vfs_node_c *)file);
+    ret = vfsUnlink("/vtest1.bin");
+    test_assert(ret == CH_RET_SUCCESS, "unlink failed");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t vfs_test_001_001 = {
+  "Buffered file access",
+  NULL,
+  NULL,
+  vfs_test_001_001_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const vfs_test_sequence_001_array[] = {
+  &vfs_test_001_001,
+  NULL
+};
+
+/**
+ * @brief   Buffered files.
+ */
+const testsequence_t vfs_test_sequence_001 = {
+  "Buffered files.",
+  vfs_test_sequence_001_array
+};
@@ -0,0 +1,381 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "vfs_test_root.h"
+
+/**
+ * @file    vfs_test_sequence_002.c
+ * @brief   Test Sequence 002 code.
+ *
+ * @page vfs_test_sequence_002 [2] Benchmarks.
+ *
+ * File: @ref vfs_test_sequence_002.c
+ *
+ * <h2>Description</h2>
+ * Performance measurements of the VFS file access, results are printed
+ * on the output log.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage vfs_test_002_001
+ * - @subpage vfs_test_002_002
+ * - @subpage vfs_test_002_003
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include "vfs.h"
+
+static uint32_t vfs_test_write_loop(vfs_file_node_c *file) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  (void) vfsSetFilePosition(file, 0, VFS_SEEK_SET);
+  chThdSleep(1);
+  start = chVTGetSystemTimeX();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    if (vfsWriteFile(file, vfs_test_buffer, 32U) != 32) {
+      return 0U;
+    }
+    n++;
+    if ((n & 2047U) == 0U) {
+      (void) vfsSetFilePosition(file, 0, VFS_SEEK_SET);
+    }
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  return n;
+}
+
+static uint32_t vfs_test_read_loop(vfs_file_node_c *file) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  (void) vfsSetFilePosition(file, 0, VFS_SEEK_SET);
+  chThdSleep(1);
+  start = chVTGetSystemTimeX();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    if (vfsReadFile(file, vfs_test_buffer, 32U) != 32) {
+      return 0U;
+    }
+    n++;
+    if ((n & 2047U) == 0U) {
+      (void) vfsSetFilePosition(file, 0, VFS_SEEK_SET);
+    }
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  return n;
+}
+
+static uint32_t vfs_test_stat_loop(const char *path) {
+  systime_t start, end;
+  vfs_stat_t st;
+  uint32_t n = 0U;
+
+  chThdSleep(1);
+  start = chVTGetSystemTimeX();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    if (vfsStat(path, &st) != CH_RET_SUCCESS) {
+      return 0U;
+    }
+    n++;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  return n;
+}
+
+static uint32_t vfs_test_open_loop(const char *path) {
+  systime_t start, end;
+  vfs_file_node_c *file;
+  uint32_t n = 0U;
+
+  chThdSleep(1);
+  start = chVTGetSystemTimeX();
+  end = chTimeAddX(start, TIME_MS2I(1000));
+  do {
+    if (CH_RET_IS_ERROR(vfsOpenFile(path, O_RDONLY, &file))) {
+      return 0U;
+    }
+    vfsClose((vfs_node_c *)file);
+    n++;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  return n;
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page vfs_test_002_001 [2.1] Small writes throughput
+ *
+ * <h2>Description</h2>
+ * A file is written in blocks of 32 bytes for one second, without and
+ * with a file buffer, the throughput is printed on the output log.
+ *
+ * <h2>Test Steps</h2>
+ * - [2.1.1] Creating the file.
+ * - [2.1.2] Writing 32 bytes blocks without buffering for one second,
+ *   the file is rewound every 64kB.
+ * - [2.1.3] Writing 32 bytes blocks using a 512 bytes buffer for one
+ *   second, the file is rewound every 64kB.
+ * .
+ */
+
+static void vfs_test_002_001_execute(void) {
+  vfs_file_node_c *file;
+  vfs_file_buffer_t fb;
+  msg_t ret;
+
+  /* [2.1.1] Creating the file.*/
+  test_set_step(1);
+  {
+    ret = vfsOpenFile("/vtest2.bin", O_RDWR | O_CREAT, &file);
+    test_assert(CH_RET_IS_SUCCESS(ret), "open failed");
+    vfs_test_fill(vfs_test_buffer, 0, 32U);
+  }
+  test_end_step(1);
+
+  /* [2.1.2] Writing 32 bytes blocks without buffering for one second,
+     the file is rewound every 64kB.*/
+  test_set_step(2);
+  {
+    uint32_t n = vfs_test_write_loop(file);
+    test_print("--- Unbuffered : ");
+    test_printn((n * 32U) / 1024U);
+    test_println(" kB/S");
+  }
+  test_end_step(2);
+
+  /* [2.1.3] Writing 32 bytes blocks using a 512 bytes buffer for one
+     second, the file is rewound every 64kB.*/
+  test_set_step(3);
+  {
+    uint32_t n;
+
+    ret = vfsSetFileBuffer(file, &fb, vfs_test_file_buffer,
+                           sizeof vfs_test_file_buffer);
+    test_assert(ret == CH_RET_SUCCESS, "buffer not accepted");
+    n = vfs_test_write_loop(file);
+    test_print("--- Buffered   : ");
+    test_printn((n * 32U) / 1024U);
+    test_println(" kB/S");
+    vfsClose((vfs_node_c *)file);
+    ret = vfsUnlink("/vtest2.bin");
+    test_assert(ret == CH_RET_SUCCESS, "unlink failed");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t vfs_test_002_001 = {
+  "Small writes throughput",
+  NULL,
+  NULL,
+  vfs_test_002_001_execute
+};
+
+/**
+ * @page vfs_test_002_002 [2.2] Small reads throughput
+ *
+ * <h2>Description</h2>
+ * A 64kB file is read in blocks of 32 bytes for one second, without and
+ * with a file buffer, the throughput is printed on the output log.
+ *
+ * <h2>Test Steps</h2>
+ * - [2.2.1] Creating a 64kB file.
+ * - [2.2.2] Reading 32 bytes blocks without buffering for one second,
+ *   the file is rewound at the end.
+ * - [2.2.3] Reading 32 bytes blocks using a 512 bytes buffer for one
+ *   second, the file is rewound at the end.
+ * .
+ */
+
+static void vfs_test_002_002_execute(void) {
+  vfs_file_node_c *file;
+  vfs_file_buffer_t fb;
+  unsigned i;
+  ssize_t n;
+  msg_t ret;
+
+  /* [2.2.1] Creating a 64kB file.*/
+  test_set_step(1);
+  {
+    ret = vfsOpenFile("/vtest3.bin", O_RDWR | O_CREAT, &file);
+    test_assert(CH_RET_IS_SUCCESS(ret), "open failed");
+    vfs_test_fill(vfs_test_buffer, 0, VFS_TEST_BUFFER_SIZE);
+    for (i = 0U; i < 65536U / VFS_TEST_BUFFER_SIZE; i++) {
+      n = vfsWriteFile(file, vfs_test_buffer, VFS_TEST_BUFFER_SIZE);
+      test_assert(n == VFS_TEST_BUFFER_SIZE, "write failed");
+    }
+  }
+  test_end_step(1);
+
+  /* [2.2.2] Reading 32 bytes blocks without buffering for one second,
+     the file is rewound at the end.*/
+  test_set_step(2);
+  {
+    uint32_t count = vfs_test_read_loop(file);
+    test_print("--- Unbuffered : ");
+    test_printn((count * 32U) / 1024U);
+    test_println(" kB/S");
+  }
+  test_end_step(2);
+
+  /* [2.2.3] Reading 32 bytes blocks using a 512 bytes buffer for one
+     second, the file is rewound at the end.*/
+  test_set_step(3);
+  {
+    uint32_t count;
+
+    ret = vfsSetFileBuffer(file, &fb, vfs_test_file_buffer,
+                           sizeof vfs_test_file_buffer);
+    test_assert(ret == CH_RET_SUCCESS, "buffer not accepted");
+    count = vfs_test_read_loop(file);
+    test_print("--- Buffered   : ");
+    test_printn((count * 32U) / 1024U);
+    test_println(" kB/S");
+    vfsClose((vfs_node_c *)file);
+    ret = vfsUnlink("/vtest3.bin");
+    test_assert(ret == CH_RET_SUCCESS, "unlink failed");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t vfs_test_002_002 = {
+  "Small reads throughput",
+  NULL,
+  NULL,
+  vfs_test_002_002_execute
+};
+
+/**
+ * @page vfs_test_002_003 [2.3] Open and stat latency
+ *
+ * <h2>Description</h2>
+ * A file two directory levels below the root is examined with vfsStat()
+ * and opened and closed for one second each, the average latency of each
+ * operation is printed on the output log.
+ *
+ * <h2>Test Steps</h2>
+ * - [2.3.1] Creating a file two directory levels below the root.
+ * - [2.3.2] Calling vfsStat() on the file for one second, the average
+ *   latency is printed.
+ * - [2.3.3] Opening and closing the file for one second, the average
+ *   latency is printed.
+ * - [2.3.4] Removing the file and the directories.
+ * .
+ */
+
+static void vfs_test_002_003_execute(void) {
+  vfs_file_node_c *file;
+  msg_t ret;
+
+  /* [2.3.1] Creating a file two directory levels below the root.*/
+  test_set_step(1);
+  {
+    ret = vfsMkdir("/vbench", 0777U);
+    test_assert(ret == CH_RET_SUCCESS, "mkdir failed");
+    ret = vfsMkdir("/vbench/sub", 0777U);
+    test_assert(ret == CH_RET_SUCCESS, "mkdir failed");
+    ret = vfsOpenFile("/vbench/sub/vtest6.bin", O_RDWR | O_CREAT, &file);
+    test_assert(CH_RET_IS_SUCCESS(ret), "open failed");
+    vfsClose((vfs_node_c *)file);
+  }
+  test_end_step(1);
+
+  /* [2.3.2] Calling vfsStat() on the file for one second, the average
+     latency is printed.*/
+  test_set_step(2);
+  {
+    uint32_t n = vfs_test_stat_loop("/vbench/sub/vtest6.bin");
+    test_assert(n > 0U, "stat failed");
+    test_print("--- Stat       : ");
+    test_printn(1000000000U / n);
+    test_println(" nS");
+  }
+  test_end_step(2);
+
+  /* [2.3.3] Opening and closing the file for one second, the average
+     latency is printed.*/
+  test_set_step(3);
+  {
+    uint32_t n = vfs_test_open_loop("/vbench/sub/vtest6.bin");
+    test_assert(n > 0U, "open failed");
+    test_print("--- Open+close : ");
+    test_printn(1000000000U / n);
+    test_println(" nS");
+  }
+  test_end_step(3);
+
+  /* [2.3.4] Removing the file and the directories.*/
+  test_set_step(4);
+  {
+    ret = vfsUnlink("/vbench/sub/vtest6.bin");
+    test_assert(ret == CH_RET_SUCCESS, "unlink failed");
+    ret = vfsRmdir("/vbench/sub");
+    test_assert(ret == CH_RET_SUCCESS, "rmdir failed");
+    ret = vfsRmdir("/vbench");
+    test_assert(ret == CH_RET_SUCCESS, "rmdir failed");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t vfs_test_002_003 = {
+  "Open and stat latency",
+  NULL,
+  NULL,
+  vfs_test_002_003_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const vfs_test_sequence_002_array[] = {
+  &vfs_test_002_001,
+  &vfs_test_002_002,
+  &vfs_test_002_003,
+  NULL
+};
+
+/**
+ * @brief   Benchmarks.
+ */
+const testsequence_t vfs_test_sequence_002 = {
+  "Benchmarks.",
+  vfs_test_sequence_002_array
+};
@@ -0,0 +1,235 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "vfs_test_root.h"
+
+/**
+ * @file    vfs_test_sequence_003.c
+ * @brief   Test Sequence 003 code.
+ *
+ * @page vfs_test_sequence_003 [3] Asynchronous I/O.
+ *
+ * File: @ref vfs_test_sequence_003.c
+ *
+ * <h2>Description</h2>
+ * This sequence tests the VFS asynchronous I/O API.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - VFS_CFG_ENABLE_ASYNC == TRUE
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage vfs_test_003_001
+ * .
+ */
+
+#if (VFS_CFG_ENABLE_ASYNC == TRUE) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include "vfs.h"
+
+static THD_WORKING_AREA(vfs_test_async_wa, 2048);
+static vfs_async_worker_t vfs_test_worker;
+static vfs_async_request_t vfs_test_requests[4];
+static unsigned vfs_test_completions;
+
+static void vfs_test_async_cb(vfs_async_request_t *arp) {
+
+  (void)arp;
+
+  chSysLock();
+  vfs_test_completions++;
+  chSysUnlock();
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page vfs_test_003_001 [3.1] Asynchronous file access
+ *
+ * <h2>Description</h2>
+ * A file is written and read back using asynchronous requests served by
+ * a worker thread with lower priority than the test thread, request
+ * states, ordering, completion callbacks and data are verified.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.1.1] Creating the file, waiting on a request never submitted
+ *   must fail.
+ * - [3.1.2] Writing 4096 bytes using eight 512 bytes requests, the four
+ *   request objects are reused after waiting for their completion.
+ * - [3.1.3] The last requests are still pending because the worker has
+ *   lower priority, submitting a pending request must fail.
+ * - [3.1.4] Waiting for all requests then synchronizing the file, all
+ *   completion callbacks must have been called.
+ * - [3.1.5] Reading back the file using four 1024 bytes requests and
+ *   verifying the content.
+ * - [3.1.6] Closing and removing the file.
+ * .
+ */
+
+static void vfs_test_003_001_setup(void) {
+  vfsAsyncStart(&vfs_test_worker, vfs_test_async_wa,
+                sizeof vfs_test_async_wa, chThdGetPriorityX() - 1);
+  for (unsigned i = 0U; i < 4U; i++) {
+    vfsAsyncObjectInit(&vfs_test_requests[i], vfs_test_async_cb, NULL);
+  }
+  vfs_test_completions = 0U;
+}
+
+static void vfs_test_003_001_teardown(void) {
+  vfsAsyncStop(&vfs_test_worker);
+}
+
+static void vfs_test_003_001_execute(void) {
+  vfs_file_node_c *file;
+  unsigned i;
+  msg_t ret;
+
+  /* [3.1.1] Creating the file, waiting on a request never submitted
+     must fail.*/
+  test_set_step(1);
+  {
+    ret = vfsOpenFile("/vtest5.bin", O_RDWR | O_CREAT, &file);
+    test_assert(CH_RET_IS_SUCCESS(ret), "open failed");
+    ret = vfsAsyncWait(&vfs_test_requests[0], TIME_IMMEDIATE);
+    test_assert(ret == CH_RET_EINVAL, "unexpected wait result");
+  }
+  test_end_step(1);
+
+  /* [3.1.2] Writing 4096 bytes using eight 512 bytes requests, the four
+     request objects are reused after waiting for their completion.*/
+  test_set_step(2);
+  {
+    vfs_test_fill(vfs_test_buffer, 0, 4096U);
+    for (i = 0U; i < 8U; i++) {
+      vfs_async_request_t *arp = &vfs_test_requests[i & 3U];
+
+      if (i >= 4U) {
+        ret = vfsAsyncWait(arp, TIME_INFINITE);
+        test_assert(ret == CH_RET_SUCCESS, "wait failed");
+        test_assert(vfsAsyncGetResult(arp) == 512, "write failed");
+      }
+      ret = vfsAsyncWriteFile(&vfs_test_worker, arp, file,
+                              vfs_test_buffer + (i * 512U), 512U);
+      test_assert(ret == CH_RET_SUCCESS, "submit failed");
+    }
+  }
+  test_end_step(2);
+
+  /* [3.1.3] The last requests are still pending because the worker has
+     lower priority, submitting a pending request must fail.*/
+  test_set_step(3);
+  {
+    test_assert(!vfsAsyncIsDone(&vfs_test_requests[3]), "already done");
+    ret = vfsAsyncWriteFile(&vfs_test_worker, &vfs_test_requests[3], file,
+                            vfs_test_buffer, 512U);
+    test_assert(ret == CH_RET_EBUSY, "not busy");
+  }
+  test_end_step(3);
+
+  /* [3.1.4] Waiting for all requests then synchronizing the file, all
+     completion callbacks must have been called.*/
+  test_set_step(4);
+  {
+    for (i = 0U; i < 4U; i++) {
+      ret = vfsAsyncWait(&vfs_test_requests[i], TIME_INFINITE);
+      test_assert(ret == CH_RET_SUCCESS, "wait failed");
+      test_assert(vfsAsyncGetResult(&vfs_test_requests[i]) == 512,
+                  "write failed");
+    }
+    ret = vfsAsyncSyncFile(&vfs_test_worker, &vfs_test_requests[0], file);
+    test_assert(ret == CH_RET_SUCCESS, "submit failed");
+    ret = vfsAsyncWait(&vfs_test_requests[0], TIME_INFINITE);
+    test_assert(ret == CH_RET_SUCCESS, "wait failed");
+    test_assert(vfsAsyncGetResult(&vfs_test_requests[0]) == CH_RET_SUCCESS,
+                "sync failed");
+    test_assert(vfs_test_completions == 9U, "missing callbacks");
+    test_assert(vfsGetFilePosition(file) == 4096, "wrong position");
+  }
+  test_end_step(4);
+
+  /* [3.1.5] Reading back the file using four 1024 bytes requests and
+     verifying the content.*/
+  test_set_step(5);
+  {
+    ret = vfsSetFilePosition(file, 0, VFS_SEEK_SET);
+    test_assert(ret == CH_RET_SUCCESS, "seek failed");
+    memset(vfs_test_buffer, 0, 4096U);
+    for (i = 0U; i < 4U; i++) {
+      ret = vfsAsyncReadFile(&vfs_test_worker, &vfs_test_requests[i], file,
+                             vfs_test_buffer + (i * 1024U), 1024U);
+      test_assert(ret == CH_RET_SUCCESS, "submit failed");
+    }
+    for (i = 0U; i < 4U; i++) {
+      ret = vfsAsyncWait(&vfs_test_requests[i], TIME_INFINITE);
+      test_assert(ret == CH_RET_SUCCESS, "wait failed");
+      test_assert(vfsAsyncGetResult(&vfs_test_requests[i]) == 1024,
+                  "read failed");
+    }
+    for (i = 0U; i < 8U; i++) {
+      vfs_test_fill(vfs_test_file_buffer, (vfs_offset_t)(i * 512U), 512U);
+      test_assert(memcmp(vfs_test_buffer + (i * 512U),
+                         vfs_test_file_buffer, 512U) == 0, "data mismatch");
+    }
+  }
+  test_end_step(5);
+
+  /* [3.1.6] Closing and removing the file.*/
+  test_set_step(6);
+  {
+    vfsClose((vfs_node_c *)file);
+    ret = vfsUnlink("/vtest5.bin");
+    test_assert(ret == CH_RET_SUCCESS, "unlink failed");
+  }
+  test_end_step(6);
+}
+
+static const testcase_t vfs_test_003_001 = {
+  "Asynchronous file access",
+  vfs_test_003_001_setup,
+  vfs_test_003_001_teardown,
+  vfs_test_003_001_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const vfs_test_sequence_003_array[] = {
+  &vfs_test_003_001,
+  NULL
+};
+
+/**
+ * @brief   Asynchronous I/O.
+ */
+const testsequence_t vfs_test_sequence_003 = {
+  "Asynchronous I/O.",
+  vfs_test_sequence_003_array
+};
+
+#endif /* VFS_CFG_ENABLE_ASYNC == TRUE */
@@ -0,0 +1,27 @@
+/*
+    ChibiOS - Copyright (C) 2006-2026 Giovanni Di Sirio.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    vfs_test_sequence_003.h
+ * @brief   Test Sequence 003 header.
+ */
+
+#ifndef VFS_TEST_SEQUENCE_003_H
+#define VFS_TEST_SEQUENCE_003_H
+
+extern const testsequence_t vfs_test_sequence_003;
+
+#endif /* VFS_TEST_SEQUENCE_003_H */
@@ -103,6 +103,21 @@
 #define CH_CFG_ST_TIMEDELTA                 12
 #endif
 
+/**
+ * @brief   Virtual timers wheel slots.
+ * @details If non-zero then virtual timers are hashed in a timing wheel
+ *          with the specified number of slots instead of being kept in
+ *          the delta list, arming and disarming a timer become constant
+ *          time operations regardless of the number of armed timers.
+ * @note    The value must be zero or a power of two.
+ * @note    The delay of a timer is limited to half of the system time
+ *          numeric range, longer delays are shortened.
+ * @note    The default is zero, the delta list is used.
+ */
+#if !defined(CH_CFG_VT_WHEEL_SLOTS)
+#define CH_CFG_VT_WHEEL_SLOTS               0
+#endif
+
 /** @} */
 
 /*===========================================================================*/
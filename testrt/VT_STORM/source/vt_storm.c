@@ -54,6 +54,10 @@ static virtual_timer_t wrapper;
 static virtual_timer_t sweeper0, sweeperm1, sweeperp1, sweeperm3, sweeperp3;
 static virtual_timer_t guard0, guard1, guard2, guard3;
 static virtual_timer_t continuous;
+#if VT_STORM_CFG_BENCHMARK != FALSE
+static virtual_timer_t loaders[VT_STORM_CFG_BENCH_TIMERS];
+static virtual_timer_t bench;
+#endif
 static volatile sysinterval_t delay;
 static volatile bool saturated;
 static uint32_t vtcus;
@@ -166,6 +170,53 @@ static void guard_cb(virtual_timer_t *vtp, void *p) {
   (void)p;
 }
 
+#if VT_STORM_CFG_BENCHMARK != FALSE
+static void bench_print(const char *name, unsigned n, time_measurement_t *tmp) {
+
+  chprintf(config->out, "%s, %3u timers: best %u worst %u average %u cycles\r\n",
+           name, n, tmp->best, tmp->worst,
+           (unsigned)(tmp->cumulative / (rttime_t)tmp->n));
+}
+
+static void bench_execute(unsigned n) {
+  time_measurement_t tmset, tmreset;
+  sysinterval_t base;
+  unsigned i;
+
+  /* Loader timers are spread one tick apart after the base delay, the
+     benchmarked timer is armed after all of them, this is the worst case
+     for the delta list.*/
+  base = TIME_MS2I(500);
+  chSysLock();
+  for (i = 0U; i < n; i++) {
+    chVTSetI(&loaders[i], base + (sysinterval_t)i, guard_cb, NULL);
+  }
+  chSysUnlock();
+
+  chTMObjectInit(&tmset);
+  chTMObjectInit(&tmreset);
+  for (i = 0U; i < VT_STORM_CFG_BENCH_CYCLES; i++) {
+    chSysLock();
+    chTMStartMeasurementX(&tmset);
+    chVTDoSetI(&bench, base + (sysinterval_t)n, guard_cb, NULL);
+    chTMStopMeasurementX(&tmset);
+    chTMStartMeasurementX(&tmreset);
+    chVTDoResetI(&bench);
+    chTMStopMeasurementX(&tmreset);
+    chSysUnlock();
+  }
+
+  chSysLock();
+  for (i = 0U; i < n; i++) {
+    chVTResetI(&loaders[i]);
+  }
+  chSysUnlock();
+
+  bench_print("Set  ", n, &tmset);
+  bench_print("Reset", n, &tmreset);
+}
+#endif
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -213,7 +264,21 @@ void vt_storm_execute(const vt_storm_config_t *cfg) {
   chprintf(cfg->out, "*** Intervals size:   %d bits\r\n", CH_CFG_INTERVALS_SIZE);
   chprintf(cfg->out, "*** SysTick:          %d Hz\r\n", CH_CFG_ST_FREQUENCY);
   chprintf(cfg->out, "*** Delta:            %d ticks\r\n", CH_CFG_ST_TIMEDELTA);
+#if CH_CFG_VT_WHEEL_SLOTS > 0
+  chprintf(cfg->out, "*** VT Backend:       wheel, %d slots\r\n", CH_CFG_VT_WHEEL_SLOTS);
+#else
+  chprintf(cfg->out, "*** VT Backend:       delta list\r\n");
+#endif
+  chprintf(cfg->out, "\r\n");
+
+#if VT_STORM_CFG_BENCHMARK != FALSE
+  /* Timers set/reset benchmark, empty and loaded timers list.*/
+  chprintf(cfg->out, "Benchmark\r\n");
+  bench_execute(0U);
+  bench_execute(VT_STORM_CFG_BENCH_TIMERS / 4U);
+  bench_execute(VT_STORM_CFG_BENCH_TIMERS);
   chprintf(cfg->out, "\r\n");
+#endif
 
 #if VT_STORM_CFG_HAMMERS
   /* Starting hammer timers.*/
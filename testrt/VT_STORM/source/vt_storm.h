@@ -64,6 +64,30 @@
 #if !defined(VT_STORM_CFG_HAMMERS) || defined(__DOXYGEN__)
 #define VT_STORM_CFG_HAMMERS                FALSE
 #endif
+
+/**
+ * @brief   Enable the timers set/reset benchmark.
+ * @details The benchmark measures the cost of arming and disarming a timer
+ *          while other timers are armed, the result depends on the virtual
+ *          timers backend selected by @p CH_CFG_VT_WHEEL_SLOTS.
+ */
+#if !defined(VT_STORM_CFG_BENCHMARK) || defined(__DOXYGEN__)
+#define VT_STORM_CFG_BENCHMARK              TRUE
+#endif
+
+/**
+ * @brief   Number of armed timers during the benchmark.
+ */
+#if !defined(VT_STORM_CFG_BENCH_TIMERS) || defined(__DOXYGEN__)
+#define VT_STORM_CFG_BENCH_TIMERS           64
+#endif
+
+/**
+ * @brief   Number of benchmark cycles.
+ */
+#if !defined(VT_STORM_CFG_BENCH_CYCLES) || defined(__DOXYGEN__)
+#define VT_STORM_CFG_BENCH_CYCLES           1000
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -74,6 +98,10 @@
 #error "invalid VT_STORM_CFG_MIN_DELAY value"
 #endif
 
+#if (VT_STORM_CFG_BENCHMARK != FALSE) && (CH_CFG_USE_TM == FALSE)
+#error "VT_STORM_CFG_BENCHMARK requires CH_CFG_USE_TM"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -66,6 +66,13 @@
 #define VFS_CFG_PATHBUFS_NUM                ${doc.VFS_CFG_PATHBUFS_NUM!"1"}
 #endif
 
+/**
+ * @brief   Enables the asynchronous I/O API.
+ */
+#if !defined(VFS_CFG_ENABLE_ASYNC) || defined(__DOXYGEN__)
+#define VFS_CFG_ENABLE_ASYNC                ${doc.VFS_CFG_ENABLE_ASYNC!"FALSE"}
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -0,0 +1,260 @@
+#!/usr/bin/env python
+
+"""
+Converts a binary trace stream, as written by the trace exporter in
+os/various/trace_export.c, in the Chrome/Perfetto JSON trace format. The
+result can be opened with https://ui.perfetto.dev or chrome://tracing.
+
+Each thread is shown as a track with a slice for each interval where it
+was running, interrupt handlers are shown on a separate track, thread
+readiness, user events and halts are shown as instant events.
+
+To get help on usage, possible options and their descriptions, use
+the following command:
+
+    trace2json.py --help
+
+An example of converting a trace captured in a file:
+
+    trace2json.py trace.bin -o trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+HEADER = struct.Struct('<II')
+# Parameters size as announced in the stream header.
+PARAMS = {4: struct.Struct('<II'), 8: struct.Struct('<QQ')}
+MAGIC = 0x52544843
+
+TYPE_EXT = 0
+TYPE_READY = 1
+TYPE_SWITCH = 2
+TYPE_ISR_ENTER = 3
+TYPE_ISR_LEAVE = 4
+TYPE_HALT = 5
+TYPE_USER = 6
+
+EXT_STRING = 1
+EXT_THREAD = 2
+EXT_LOST = 3
+EXT_HEADER = 4
+
+STATES = ['READY', 'CURRENT', 'WTSTART', 'SUSPENDED', 'QUEUED', 'WTSEM',
+          'WTMTX', 'WTCOND', 'SLEEPING', 'WTEXIT', 'WTOREVT', 'WTANDEVT',
+          'SNDMSGQ', 'SNDMSG', 'WTMSG', 'FINAL']
+
+PID = 1
+ISR_TID = 0
+
+
+class Clock:
+    """
+    Converts the record time stamps in microseconds. The 24 bits real time
+    stamp is unwrapped and used when the counter frequency is known, the
+    system time is used otherwise and to detect multiple wraps between
+    records.
+    """
+
+    def __init__(self, st_freq, st_bits, rt_freq):
+        self.st_freq = st_freq or 1000
+        self.st_mask = (1 << st_bits) - 1
+        self.rt_freq = rt_freq
+        self.st_last = None
+        self.st_total = 0
+        self.rt_last = None
+        self.rt_total = 0
+
+    def now(self, time, rtstamp):
+        if self.st_last is None:
+            self.st_last = time
+            self.rt_last = rtstamp
+        st_delta = (time - self.st_last) & self.st_mask
+        self.st_total += st_delta
+        self.st_last = time
+        if not self.rt_freq:
+            return self.st_total * 1e6 / self.st_freq
+        rt_delta = (rtstamp - self.rt_last) & 0xFFFFFF
+        # Adding the wraps not visible in the 24 bits stamp.
+        wrap = 0x1000000
+        expected = st_delta * self.rt_freq / self.st_freq
+        rt_delta += int(max(0, expected - rt_delta) / wrap + 0.5) * wrap
+        self.rt_total += rt_delta
+        self.rt_last = rtstamp
+        return self.rt_total * 1e6 / self.rt_freq
+
+
+class Decoder:
+
+    def __init__(self, args):
+        self.args = args
+        self.events = []
+        self.strings = {}
+        self.threads = {}
+        self.clock = None
+        self.current = None
+        self.since = None
+        self.isr_depth = 0
+        self.lost = 0
+        self.records = 0
+        self.psize = None
+
+    def hexid(self, value):
+        return '0x%0*x' % (self.psize * 2, value)
+
+    def signed(self, value):
+        bits = self.psize * 8
+        return value - (1 << bits) if value >> (bits - 1) else value
+
+    def thread_tid(self, tid):
+        if tid not in self.threads:
+            self.threads[tid] = self.hexid(tid)
+        return tid
+
+    def instant(self, ts, tid, name, args=None, scope='t'):
+        event = {'ph': 'i', 'pid': PID, 'tid': tid, 'ts': ts, 'name': name,
+                 's': scope}
+        if args:
+            event['args'] = args
+        self.events.append(event)
+
+    def switch(self, ts, ntp, state, wtobjp):
+        if self.current is not None:
+            self.events.append({
+                'ph': 'X', 'pid': PID, 'tid': self.thread_tid(self.current),
+                'ts': self.since, 'dur': ts - self.since,
+                'name': self.threads[self.current],
+                'args': {'out_state': STATES[state % len(STATES)],
+                         'wtobj': self.hexid(wtobjp)}})
+        self.current = ntp
+        self.since = ts
+        self.thread_tid(ntp)
+
+    def record(self, w0, time, p1, p2, stream):
+        type_ = w0 & 7
+        state = (w0 >> 3) & 0x1F
+        rtstamp = w0 >> 8
+
+        if type_ == TYPE_EXT:
+            if state == EXT_HEADER:
+                if p2 != MAGIC:
+                    raise ValueError('bad stream header')
+                self.clock = Clock(time, self.args.st_bits,
+                                   p1 if not self.args.systime else 0)
+            elif state in (EXT_STRING, EXT_THREAD):
+                name = stream.read(p2).decode('ascii', 'replace')
+                if state == EXT_THREAD:
+                    self.threads[p1] = name
+                else:
+                    self.strings[p1] = name
+            elif state == EXT_LOST:
+                self.lost += p1
+                if self.clock is not None and self.clock.st_last is not None:
+                    ts = self.clock.st_total * 1e6 / self.clock.st_freq
+                    if self.since is not None:
+                        ts = max(ts, self.since)
+                    self.instant(ts, ISR_TID, 'lost', {'records': p1}, 'g')
+                # The running thread and the ISR nesting are unknown until
+                # the next switch.
+                self.current = None
+                self.isr_depth = 0
+            return
+
+        if self.clock is None:
+            raise ValueError('missing stream header')
+        ts = self.clock.now(time, rtstamp)
+        self.records += 1
+
+        if type_ == TYPE_SWITCH:
+            self.switch(ts, p1, state, p2)
+        elif type_ == TYPE_READY:
+            self.instant(ts, self.thread_tid(p1), 'ready',
+                         {'msg': self.signed(p2)})
+        elif type_ == TYPE_ISR_ENTER:
+            self.isr_depth += 1
+            self.events.append({'ph': 'B', 'pid': PID, 'tid': ISR_TID,
+                                'ts': ts,
+                                'name': self.strings.get(p1, 'ISR')})
+        elif type_ == TYPE_ISR_LEAVE:
+            # Leaves without a matching enter are possible after losses or
+            # at the start of the stream.
+            if self.isr_depth > 0:
+                self.isr_depth -= 1
+                self.events.append({'ph': 'E', 'pid': PID, 'tid': ISR_TID,
+                                    'ts': ts})
+        elif type_ == TYPE_HALT:
+            self.instant(ts, ISR_TID,
+                         'halt: ' + self.strings.get(p1, '?'), None, 'g')
+        elif type_ == TYPE_USER:
+            tid = self.current if self.current is not None else ISR_TID
+            self.instant(ts, tid, 'user',
+                         {'up1': self.hexid(p1), 'up2': self.hexid(p2)})
+
+    def decode(self, stream):
+        while True:
+            data = stream.read(HEADER.size)
+            if len(data) < HEADER.size:
+                break
+            w0, time = HEADER.unpack(data)
+            if self.psize is None:
+                # The header record carries the parameters size in the
+                # real time stamp field.
+                if (w0 & 7) != TYPE_EXT or ((w0 >> 3) & 0x1F) != EXT_HEADER:
+                    raise ValueError('missing stream header')
+                if (w0 >> 8) not in PARAMS:
+                    raise ValueError('bad parameters size')
+                self.psize = w0 >> 8
+            params = PARAMS[self.psize]
+            data = stream.read(params.size)
+            if len(data) < params.size:
+                break
+            self.record(w0, time, *params.unpack(data), stream=stream)
+
+    def result(self):
+        events = [{'ph': 'M', 'pid': PID, 'name': 'process_name',
+                   'args': {'name': 'ChibiOS'}},
+                  {'ph': 'M', 'pid': PID, 'tid': ISR_TID,
+                   'name': 'thread_name', 'args': {'name': 'ISR'}}]
+        for tid, name in sorted(self.threads.items()):
+            events.append({'ph': 'M', 'pid': PID, 'tid': tid,
+                           'name': 'thread_name', 'args': {'name': name}})
+        return {'traceEvents': events + self.events,
+                'displayTimeUnit': 'ns',
+                'otherData': {'records': self.records, 'lost': self.lost}}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Convert a binary trace stream in Chrome/Perfetto JSON')
+    parser.add_argument('input', nargs='?', default='-',
+                        help='Binary trace file, "-" for stdin.')
+    parser.add_argument('-o', '--output', default='-',
+                        help='JSON output file, "-" for stdout.')
+    parser.add_argument('--st-bits', type=int, default=32,
+                        help='Size of systime_t in bits (default 32).')
+    parser.add_argument('--systime', action='store_true',
+                        help='Use the system time instead of the real '
+                             'time stamps.')
+    args = parser.parse_args()
+
+    decoder = Decoder(args)
+    if args.input == '-':
+        decoder.decode(sys.stdin.buffer)
+    else:
+        with open(args.input, 'rb') as stream:
+            decoder.decode(stream)
+
+    if args.output == '-':
+        json.dump(decoder.result(), sys.stdout)
+    else:
+        with open(args.output, 'w') as out:
+            json.dump(decoder.result(), out)
+
+    sys.stderr.write('%d records, %d lost\n' % (decoder.records,
+                                                 decoder.lost))
+
+
+if __name__ == '__main__':
+    main()